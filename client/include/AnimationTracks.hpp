@@ -0,0 +1,74 @@
+#ifndef MU_ANIMATION_TRACKS_HPP
+#define MU_ANIMATION_TRACKS_HPP
+
+#include "BMDUtils.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Baked bone tracks of one BMD, shared by every instance of the model. Each
+// action is sampled SAMPLES_PER_KEY times per keyframe into world-space bone
+// rotations (quaternions) and positions. A sample is baked the first time any
+// instance needs it and kept with the model, so 30 spiders in the same idle
+// loop pay for the hierarchy walk once per sample instead of once per spider
+// per frame; Sample() then slerps each bone between the two neighbouring
+// samples and rebuilds its matrix.
+// Only single-action poses without body angle are baked: cross-action blends
+// still go through ComputeBoneMatricesBlended.
+// Sample() may run on several job threads at once (see JobSystem.hpp); Init()
+// may not. Baking takes a lock, reading an already baked sample does not.
+class AnimationTracks {
+public:
+  static constexpr int SAMPLES_PER_KEY = 4;
+
+  // Tracks for `bmd` (not owned, must outlive this); nothing is baked yet
+  void Init(const BMDData *bmd);
+  bool IsValid() const { return m_bmd != nullptr; }
+
+  // ComputeBoneMatricesInterpolated(bmd, action, frame, out) from the baked
+  // samples: equal on a sample, close in between (the slerp is of world-space
+  // rotations, not of each bone's local one). Actions without keys fall
+  // through to the direct computation.
+  void Sample(int action, float frame, std::vector<BoneWorldMatrix> &out);
+
+  // Sample() totals for this process, summed over per-thread counters
+  struct Stats {
+    uint64_t lookups = 0; // Sample() calls
+    uint64_t hits = 0;    // Served from already baked samples only
+    uint64_t baked = 0;   // Samples baked
+    int64_t cpuNs = 0;    // Time in Sample() (baking included) while timed
+  };
+  static Stats GetStats();
+  // Only while no Sample() is running (between frames)
+  static void ResetStats();
+  // Time every Sample() call into Stats::cpuNs (off by default: two clock
+  // reads per call)
+  static void SetTiming(bool on);
+
+private:
+  struct BoneKey {
+    glm::vec4 rot{0.0f, 0.0f, 0.0f, 1.0f}; // World-space quaternion (x,y,z,w)
+    glm::vec3 pos{0.0f};                   // World-space position
+  };
+
+  struct Track {
+    int numSamples = 0;
+    // Allocated on first use (ready), then each sample baked once. The
+    // release stores publish the poses to threads reading without the lock.
+    std::atomic<bool> ready{false};
+    std::unique_ptr<BoneKey[]> poses;            // numSamples x bones
+    std::unique_ptr<std::atomic<uint8_t>[]> baked; // Per sample
+  };
+
+  // Bone keys of one sample, baking it if needed
+  const BoneKey *Pose(Track &track, int action, int sample,
+                              bool &hit);
+
+  const BMDData *m_bmd = nullptr;
+  int m_numBones = 0;
+  int m_numActions = 0;
+  std::unique_ptr<Track[]> m_tracks; // Per action
+};
+
+#endif // MU_ANIMATION_TRACKS_HPP
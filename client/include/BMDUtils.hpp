@@ -29,6 +29,12 @@ void AngleQuaternion(const glm::vec3 &angles, float q[4]);
 // Quaternion -> 3x4 rotation matrix  (matches ZzzMathLib QuaternionMatrix)
 void QuaternionMatrix(const float q[4], float m[3][4]);
 
+// Rotation part of a 3x4 matrix -> quaternion (inverse of QuaternionMatrix)
+glm::vec4 MatrixQuaternion(const float m[3][4]);
+
+// Quaternion spherical linear interpolation (shortest path)
+glm::vec4 QuaternionSlerp(const glm::vec4 &q1, const glm::vec4 &q2, float t);
+
 // Concatenate two 3x4 transforms: out = in1 * in2  (matches R_ConcatTransforms)
 void ConcatTransforms(const float in1[3][4], const float in2[3][4],
                       float out[3][4]);
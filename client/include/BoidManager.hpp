@@ -1,6 +1,7 @@
 #ifndef BOID_MANAGER_HPP
 #define BOID_MANAGER_HPP
 
+#include "AnimationTracks.hpp"
 #include "BMDParser.hpp"
 #include "BMDUtils.hpp"
 #include "HeroCharacter.hpp" // For PointLight
@@ -120,21 +121,27 @@ private:
   std::unique_ptr<BMDData> m_birdBmd;
   std::vector<MeshBuffers> m_birdMeshes;
   std::vector<BoneWorldMatrix> m_birdBones;
+  AnimationTracks m_birdTracks;
 
   // Bat model (Main 5.2: MODEL_BAT01 = Object2/Bat01.bmd)
   std::unique_ptr<BMDData> m_batBmd;
   std::vector<MeshBuffers> m_batMeshes;
   std::vector<BoneWorldMatrix> m_batBones;
+  AnimationTracks m_batTracks;
 
   // Butterfly model (Main 5.2: MODEL_BUTTERFLY01 = Object1/Butterfly01.bmd)
   std::unique_ptr<BMDData> m_butterflyBmd;
   std::vector<MeshBuffers> m_butterflyMeshes;
   std::vector<BoneWorldMatrix> m_butterflyBones;
+  AnimationTracks m_butterflyTracks;
 
   // Fish model
   std::unique_ptr<BMDData> m_fishBmd;
   std::vector<MeshBuffers> m_fishMeshes;
   std::vector<BoneWorldMatrix> m_fishBones;
+  AnimationTracks m_fishTracks;
+
+  std::vector<BoneWorldMatrix> m_pose; // Sampled bones of the boid being drawn
 
   // Shadow mesh buffers (one per boid for bird, one per fish)
   struct ShadowMesh {
@@ -147,6 +154,7 @@ private:
   ShadowMesh m_fishShadow;
 
   std::unique_ptr<Shader> m_shader;
+  std::unique_ptr<Shader> m_skinnedShader; // GPU-skinned creature meshes
   std::unique_ptr<Shader> m_shadowShader;
 
   const TerrainData *m_terrainData = nullptr;
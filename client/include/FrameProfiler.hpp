@@ -0,0 +1,58 @@
+#ifndef MU_FRAME_PROFILER_HPP
+#define MU_FRAME_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Per-subsystem CPU time and draw calls of each frame, for --headless-bench.
+// A section is timed by a Scope on the stack (Next() hands it on to the
+// following section); time spent under the same name within a frame adds
+// up. Draw calls are the SubmitDraw() calls made inside the section (see
+// Shader.hpp). A Scope on a null profiler does nothing, so the render path
+// stays instrumented in normal play at no cost.
+class FrameProfiler {
+public:
+  class Scope {
+  public:
+    Scope(FrameProfiler *profiler, const char *name);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    // Close this section and time the code that follows as `name`
+    void Next(const char *name);
+
+  private:
+    FrameProfiler *m_profiler;
+    int m_section = -1;
+    uint32_t m_draws = 0;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  void BeginFrame();
+  void EndFrame();
+  int GetFrameCount() const { return (int)m_frameMs.size(); }
+
+  // Table of avg/p50/p99/max ms and draws per frame, one row per section
+  void Report(const char *title) const;
+
+private:
+  struct Section {
+    const char *name; // String literal, compared by address
+    std::vector<float> ms;
+    std::vector<uint32_t> draws;
+  };
+
+  int SectionIndex(const char *name);
+  void Add(int section, float ms, uint32_t draws);
+
+  std::vector<Section> m_sections;
+  std::vector<float> m_frameMs;
+  std::vector<uint32_t> m_frameDraws;
+  std::chrono::steady_clock::time_point m_frameStart;
+  uint32_t m_frameStartDraws = 0;
+  bool m_inFrame = false;
+};
+
+#endif // MU_FRAME_PROFILER_HPP
@@ -4,6 +4,7 @@
 #include "BMDParser.hpp"
 #include "BMDUtils.hpp"
 #include "MeshBuffers.hpp"
+#include "PathFinder.hpp"
 #include "Shader.hpp"
 #include "TerrainParser.hpp"
 #include "ViewerCommon.hpp"
@@ -97,7 +98,8 @@ public:
   void Render(const glm::mat4 &view, const glm::mat4 &proj,
               const glm::vec3 &camPos, float deltaTime);
   void RenderShadow(const glm::mat4 &view, const glm::mat4 &proj);
-  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram);
+  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                         bgfx::ProgramHandle skinnedDepthProgram);
   void SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &lightMtx);
   void ProcessMovement(float deltaTime);
   void MoveTo(const glm::vec3 &target);
@@ -276,6 +278,12 @@ public:
   void SetPosition(const glm::vec3 &pos) { m_pos = pos; }
   float GetFacing() const { return m_facing; }
   bool IsMoving() const { return m_moving; }
+  // Grid route being walked (gx = worldZ / 100, start exclusive) and the index
+  // of the cell currently headed for. The version changes with every new
+  // route, so the caller knows when to send MOVE_PATH.
+  const std::vector<GridPoint> &GetRoute() const { return m_route; }
+  size_t GetRouteStep() const { return m_routeStep; }
+  uint32_t GetRouteVersion() const { return m_routeVersion; }
   Shader *GetShader() { return m_shader.get(); }
 
   // Terrain linkage
@@ -315,6 +323,11 @@ private:
   float m_targetFacing = 0.0f;
   float m_speed = 334.0f;
   bool m_moving = false;
+  static constexpr int MAX_ROUTE = 128; // Cells per click
+  std::vector<GridPoint> m_route;
+  size_t m_routeStep = 0;
+  GridPoint m_routeDest;
+  uint32_t m_routeVersion = 0;
 
   // Animation
   int m_action = 1; // PLAYER_STOP1 (male idle)
@@ -553,6 +566,7 @@ private:
   BodyPart m_baseHead; // Base head model (HelmClassXX.bmd) for accessory helms
   bool m_showBaseHead = false; // True when equipped helm needs face visible
   std::unique_ptr<Shader> m_shader;
+  std::unique_ptr<Shader> m_skinnedShader; // GPU-skinned mesh buffers
 
   // Shadow map state
   bgfx::TextureHandle m_shadowMapTex = BGFX_INVALID_HANDLE;
@@ -0,0 +1,65 @@
+#ifndef MU_JOB_SYSTEM_HPP
+#define MU_JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for per-frame CPU work (animation, skinning).
+// ParallelFor() splits a range into chunks spread over the workers' queues;
+// a worker takes from the back of its own queue and steals from the front
+// of the others', and the calling thread works through the chunks too
+// until all are done. Jobs must not call bgfx: they fill CPU-side buffers
+// and the render-submit thread issues the draws after ParallelFor returns.
+// ParallelFor is called from one thread (the render-submit thread) and
+// must not be nested inside a job. Without workers (Start(0) or never
+// started) everything runs inline.
+class JobSystem {
+public:
+  ~JobSystem() { Stop(); }
+
+  // workers < 0 = one per hardware thread besides the caller
+  void Start(int workers = -1);
+  void Stop();
+  int GetWorkerCount() const { return (int)m_workers.size(); }
+
+  // fn(begin, end) over [0, count) in chunks of at most `grain` items.
+  // Returns once every chunk has run.
+  void ParallelFor(int count, int grain,
+                   const std::function<void(int, int)> &fn);
+
+private:
+  struct Batch {
+    const std::function<void(int, int)> *fn;
+    std::atomic<int> pending{0};
+  };
+  struct Chunk {
+    Batch *batch;
+    int begin, end;
+  };
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Chunk> chunks;
+  };
+
+  bool PopOwn(int queue, Chunk &out);
+  bool Steal(int thief, Chunk &out);
+  void Run(const Chunk &chunk);
+  void WorkerLoop(int index);
+
+  std::vector<std::thread> m_workers;
+  std::vector<std::unique_ptr<Queue>> m_queues; // One per worker
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  std::atomic<int> m_queued{0}; // Chunks waiting in any queue
+  std::atomic<bool> m_stop{false};
+  uint32_t m_nextQueue = 0;
+};
+
+#endif // MU_JOB_SYSTEM_HPP
@@ -3,6 +3,7 @@
 
 #include "TextureLoader.hpp" // TexHandle, TexValid, kInvalidTex
 #include <string>
+#include <vector>
 
 struct MeshBuffers {
   bgfx::VertexBufferHandle        vbo    = BGFX_INVALID_HANDLE; // Static meshes
@@ -11,6 +12,12 @@ struct MeshBuffers {
   int indexCount = 0;
   int vertexCount = 0;    // For dynamic VBO re-upload sizing
   bool isDynamic = false;  // True = uses dynVbo for per-frame bone animation
+
+  // GPU skinning (UploadSkinnedMesh): vbo holds bind-space vertices with a
+  // bone index, bonePalette the current pose (3 rows = 12 floats per bone)
+  bool isSkinned = false;
+  int boneCount = 0;              // Bones referenced by this mesh
+  std::vector<float> bonePalette; // Set by RetransformMeshWithBones
   TexHandle texture = kInvalidTex;
 
   // Per-mesh rendering flags (parsed from texture name suffixes)
@@ -1,9 +1,11 @@
 #ifndef MONSTER_MANAGER_HPP
 #define MONSTER_MANAGER_HPP
 
+#include "AnimationTracks.hpp"
 #include "BMDParser.hpp"
 #include "BMDUtils.hpp"
 #include "HeroCharacter.hpp" // For PointLight
+#include "JobSystem.hpp"
 #include "MeshBuffers.hpp"
 #include "PathFinder.hpp"
 #include "Shader.hpp"
@@ -75,7 +77,8 @@ public:
   void RenderDepthPrepass(const glm::mat4 &view, const glm::mat4 &proj,
                           const glm::vec3 &camPos);
   void RenderShadows(const glm::mat4 &view, const glm::mat4 &proj);
-  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram);
+  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                         bgfx::ProgramHandle skinnedDepthProgram);
   void SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &lightMtx);
   void RenderSilhouetteOutline(int monsterIndex, const glm::mat4 &view,
                                const glm::mat4 &proj);
@@ -156,6 +159,11 @@ public:
   void SetLuminosity(float l) { m_luminosity = l; }
   void SetMapId(int mapId) { m_mapId = mapId; }
   void SetVFXManager(VFXManager *vfx) { m_vfxManager = vfx; }
+  // Crowd path (on by default): draw monsters from baked animation textures,
+  // one instanced submit per model mesh
+  void SetCrowdRendering(bool enabled) { m_crowdRendering = enabled; }
+  // Pool for the per-monster pose update in Render (nullptr = serial)
+  void SetJobSystem(JobSystem *jobs) { m_jobs = jobs; }
 
 private:
   // Weapon attached to a monster bone (Main 5.2: c->Weapon[n])
@@ -179,6 +187,7 @@ private:
     float collisionHeight = 80.0f;
     float bodyOffset = 0.0f;
     int rootBone = -1; // Index of root bone (Parent == -1) for LockPositions
+    AnimationTracks tracks; // Baked poses of getAnimBmd(), shared by instances
     std::vector<MeshBuffers> meshBuffers;
     // Stats from Monster.txt (used for display/UI only — combat is server-side)
     int level = 1;
@@ -200,6 +209,18 @@ private:
     // AABB from mesh upload — actual model bounding box for nameplate positioning
     AABB meshBounds{};
 
+    // Crowd rendering (bakeCrowd): poses of the 7 monster actions baked into
+    // a bone-matrix texture, one row per AnimationTracks sample, and one
+    // shared bind-pose copy of the skinned meshes. Invalid animTex = the
+    // model always draws per instance.
+    struct CrowdBake {
+      bgfx::TextureHandle animTex = BGFX_INVALID_HANDLE;
+      int width = 0, rows = 0;
+      int actionRow[7] = {};     // First row of each monster action
+      int actionSamples[7] = {}; // Rows baked for that action
+      std::vector<MeshBuffers> meshBuffers;
+    } crowd;
+
     // Helper: get the BMD to use for bone/animation computation
     BMDData *getAnimBmd() const { return animBmd ? animBmd : bmd; }
   };
@@ -269,18 +290,9 @@ private:
     // Per-weapon mesh buffers (parallel to model.weaponDefs)
     struct WeaponMeshSet {
       std::vector<MeshBuffers> meshBuffers;
+      std::vector<BoneWorldMatrix> bones; // This frame's, from animateMonster
     };
     std::vector<WeaponMeshSet> weaponMeshes;
-    struct ShadowMesh {
-      bgfx::DynamicVertexBufferHandle vbo = BGFX_INVALID_HANDLE;
-      int vertexCount = 0;
-    };
-    std::vector<ShadowMesh> shadowMeshes;
-    // Per-weapon shadow meshes (parallel to weaponMeshes)
-    struct WeaponShadowSet {
-      std::vector<ShadowMesh> meshes;
-    };
-    std::vector<WeaponShadowSet> weaponShadowMeshes;
     std::vector<BoneWorldMatrix> cachedBones;
   };
 
@@ -311,9 +323,32 @@ private:
   std::vector<DebrisInstance> m_debris;
   std::vector<ArrowProjectile> m_arrows;
 
+  // Crowd instances gathered by Render(), drawn after the per-instance pass
+  struct CrowdInstance {
+    glm::mat4 model;
+    glm::vec3 light;
+    float alpha;
+    float row0, row1, blend; // Baked rows around the frame, lerp factor
+  };
+  struct CrowdBatch {
+    int modelIdx;
+    glm::vec3 tint; // u_baseTint, per monster type
+    std::vector<CrowdInstance> instances;
+  };
+  std::vector<CrowdBatch> m_crowdBatches; // Kept between frames for capacity
+  bool m_crowdRendering = true;
+
+  JobSystem *m_jobs = nullptr;
+  std::vector<int> m_visibleMonsters; // Render: indices past culling
+  static constexpr int ANIM_JOB_GRAIN = 8; // Monsters per job chunk
+
   std::unique_ptr<Shader> m_shader;
-  std::unique_ptr<Shader> m_shadowShader;
+  std::unique_ptr<Shader> m_skinnedShader;        // GPU-skinned meshBuffers
+  std::unique_ptr<Shader> m_crowdShader;          // Instanced crowd meshes
+  std::unique_ptr<Shader> m_shadowShader;         // Planar, posed vertices
+  std::unique_ptr<Shader> m_skinnedShadowShader;  // Planar, bone palette
   std::unique_ptr<Shader> m_outlineShader;
+  std::unique_ptr<Shader> m_skinnedOutlineShader;
   VFXManager *m_vfxManager = nullptr;
 
   // Shadow map state
@@ -396,6 +431,10 @@ private:
   void renderArrows(const glm::mat4 &view, const glm::mat4 &projection,
                     const glm::vec3 &camPos);
   void setAction(MonsterInstance &mon, int action);
+  void animateMonster(MonsterInstance &mon, float deltaTime);
+  void bakeCrowd(MonsterModel &mdl);
+  void renderCrowds(const glm::vec3 &eye, const glm::vec4 &fogParams,
+                    const glm::vec4 &fogColor, int plCount);
 };
 
 #endif // MONSTER_MANAGER_HPP
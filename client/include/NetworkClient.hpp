@@ -23,14 +23,28 @@ public:
     void Flush();
 
     // Packet callback: called for each complete MU packet received
-    // Parameters: raw packet data, packet size
+    // Parameters: raw packet data, packet size. COMPRESSED packets arrive
+    // already decoded.
     std::function<void(const uint8_t *, int)> onPacket;
 
+    // COMPRESSED packets received this connection (logged on disconnect)
+    struct CompressionStats {
+        uint64_t packets = 0;
+        uint64_t wireBytes = 0;
+        uint64_t rawBytes = 0;
+        int64_t decodeUs = 0;
+    };
+    const CompressionStats &GetCompressionStats() const { return m_compressStats; }
+
 private:
+    void Deliver(const uint8_t *pkt, int size);
+
     int m_fd = -1;
     bool m_connected = false;
     std::vector<uint8_t> m_recvBuf;
     std::vector<uint8_t> m_sendBuf;
+    std::vector<uint8_t> m_decodeBuf;
+    CompressionStats m_compressStats;
 };
 
 #endif // NETWORK_CLIENT_HPP
@@ -1,8 +1,10 @@
 #ifndef NPC_MANAGER_HPP
 #define NPC_MANAGER_HPP
 
+#include "AnimationTracks.hpp"
 #include "BMDParser.hpp"
 #include "BMDUtils.hpp"
+#include "JobSystem.hpp"
 #include "MeshBuffers.hpp"
 #include "Shader.hpp"
 #include "TerrainParser.hpp"
@@ -52,7 +54,8 @@ public:
   void Render(const glm::mat4 &view, const glm::mat4 &proj,
               const glm::vec3 &camPos, float deltaTime);
   void RenderShadows(const glm::mat4 &view, const glm::mat4 &proj);
-  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram);
+  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                         bgfx::ProgramHandle skinnedDepthProgram);
   void SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &lightMtx);
   void RenderLabels(ImDrawList *dl, const glm::mat4 &view, const glm::mat4 &proj,
                     int winW, int winH, const glm::vec3 &camPos, int hoveredNpc);
@@ -72,6 +75,8 @@ public:
   void SetLuminosity(float l) { m_luminosity = l; }
   void SetMapId(int mapId) { m_mapId = mapId; }
   void SetVFXManager(VFXManager *vfx) { m_vfxManager = vfx; }
+  // Pool for the per-NPC pose update in Render (nullptr = serial)
+  void SetJobSystem(JobSystem *jobs) { m_jobs = jobs; }
   int GetNpcCount() const { return (int)m_npcs.size(); }
   NpcInfo GetNpcInfo(int index) const;
 
@@ -101,6 +106,7 @@ private:
     int weaponAttachBone = -1;     // -1 = no weapon, 33 = R hand, 42 = L hand
     int defaultAction = 0;        // Starting action (6 = spear idle for guards)
     int rootBone = -1;            // Root bone index for LockPositions
+    AnimationTracks tracks;       // Baked skeleton poses, shared by instances
     std::vector<BoneWorldMatrix> cachedWeaponBones; // Static weapon bind-pose (computed once)
   };
 
@@ -134,17 +140,10 @@ private:
     };
     std::vector<BodyPart> bodyParts;
 
-    // Shadow
-    struct ShadowMesh {
-      bgfx::DynamicVertexBufferHandle vbo = BGFX_INVALID_HANDLE;
-      int vertexCount = 0;
-    };
-    std::vector<ShadowMesh> shadowMeshes;
     std::vector<BoneWorldMatrix> cachedBones;
 
     // Weapon (guards only — attached to hand bone)
     std::vector<MeshBuffers> weaponMeshBuffers;
-    std::vector<ShadowMesh> weaponShadowMeshes;
   };
 
   std::vector<std::unique_ptr<BMDData>> m_ownedBmds; // Owns all loaded BMDs
@@ -152,7 +151,9 @@ private:
   std::vector<NpcInstance> m_npcs;
 
   std::unique_ptr<Shader> m_shader;
-  std::unique_ptr<Shader> m_shadowShader;
+  std::unique_ptr<Shader> m_skinnedShader; // GPU-skinned mesh buffers
+  std::unique_ptr<Shader> m_shadowShader;        // Planar, posed vertices
+  std::unique_ptr<Shader> m_skinnedShadowShader; // Planar, bone palette
   std::unique_ptr<Shader> m_outlineShader;
 
   // Shadow map state
@@ -171,6 +172,9 @@ private:
   float m_luminosity = 1.0f;
   int m_mapId = 0;
   VFXManager *m_vfxManager = nullptr;
+  JobSystem *m_jobs = nullptr;
+  std::vector<int> m_visibleNpcs; // Render: indices past culling
+  static constexpr int POSE_JOB_GRAIN = 4; // NPCs per job chunk
 
   // NPC type → model index mapping (for server-spawned NPCs)
   std::unordered_map<uint16_t, int> m_typeToModel;
@@ -190,6 +194,7 @@ private:
   void addNpc(int modelIdx, int gridX, int gridY, int dir, float scale = 1.0f);
   float snapToTerrain(float worldX, float worldZ);
   glm::vec3 sampleTerrainLightAt(const glm::vec3 &worldPos) const;
+  void poseNpc(NpcInstance &npc);
   // Quest marker state (3 chains)
   // Precomputed quest markers per guard NPC type
   std::vector<GuardMarker> m_guardMarkers;
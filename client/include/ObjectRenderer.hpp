@@ -1,6 +1,7 @@
 #ifndef OBJECT_RENDERER_HPP
 #define OBJECT_RENDERER_HPP
 
+#include "AnimationTracks.hpp"
 #include "BMDParser.hpp"
 #include "BMDUtils.hpp"
 #include "MeshBuffers.hpp"
@@ -25,6 +26,10 @@ public:
   void Render(const glm::mat4 &view, const glm::mat4 &projection,
               const glm::vec3 &cameraPos, float currentTime = 0.0f);
   void Cleanup();
+  // Static casters for the cached shadow layer: opaque meshes of the
+  // objects that never move or fade, inside the light frustum
+  void RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                         const glm::mat4 &lightMtx);
   void SetPointLights(const std::vector<glm::vec3> &positions,
                       const std::vector<glm::vec3> &colors,
                       const std::vector<float> &ranges);
@@ -39,9 +44,24 @@ public:
   void SetFogRange(float near_, float far_) { m_fogNear = near_; m_fogFar = far_; }
   void SetTypeFilter(const std::vector<int> &types) { m_typeFilter.assign(types.begin(), types.end()); }
   void SetMapId(int mapId) { m_mapId = mapId; }
+  // Off: no instanced batches, one submit per mesh per instance (bench
+  // comparison). Takes effect at the next LoadObjects.
+  void SetInstancing(bool on) { m_instancing = on; }
 
   int GetInstanceCount() const { return (int)instances.size(); }
   int GetModelCount() const { return (int)modelCache.size(); }
+  int GetBatchCount() const { return (int)m_batches.size(); }
+
+  // Culling done by Render since the last ResetCullStats() (headless bench)
+  struct CullStats {
+    uint64_t calls = 0;      // Render calls
+    uint64_t leaves = 0;     // Grid leaves that passed the frustum test
+    uint64_t instances = 0;  // Instances in those leaves (batched + unbatched)
+    uint64_t visible = 0;    // Instances that passed their own bounds test
+    int64_t cullNs = 0;      // Grid walk, bounds tests, instance data copies
+  };
+  const CullStats &GetCullStats() const { return m_cullStats; }
+  void ResetCullStats() { m_cullStats = {}; }
 
   // Interactive objects (sittable chairs, pose boxes) — Main 5.2 OPERATE system
   enum class InteractType { SIT, POSE };
@@ -99,15 +119,23 @@ private:
     std::vector<BoneWorldMatrix> boneMatrices;
     int blendMeshTexId = -1; // BlendMesh texture ID for window light marking
 
-    // CPU animation support (cloth, signs, mechanical)
+    // CPU animation (wall flags, and models with more bones than the
+    // skinned shaders take)
     bool isAnimated = false;
     std::unique_ptr<BMDData> bmdData; // retained for re-skinning / GPU bone compute
+    AnimationTracks tracks;           // Baked poses of bmdData
     int numAnimationKeys = 0;
 
-    // GPU skeletal animation (trees — too many instances for CPU re-skinning)
+    // GPU skeletal animation (trees, cloth, signs, mechanical)
     bool isGPUAnimated = false;
-    std::vector<glm::mat4> gpuBoneMatrices; // Computed each frame, uploaded as uniforms
+    bool sway = false; // Trees: per-instance phase and vertex shader sway
+    int gpuPoses = 1;  // TREE_PHASE_POSES for trees, else one shared pose
+    // gpuPoses poses of gpuBoneCount matrices each (48 apart), computed each
+    // frame and shared by the instanced batches of this type
+    std::vector<glm::mat4> gpuBoneMatrices;
+    int gpuBoneCount = 0;
 
+    AABB bounds; // Model space, rest pose (culling)
   };
   std::unordered_map<int, ModelCache> modelCache;
 
@@ -120,6 +148,44 @@ private:
 
   std::vector<ObjectInstance> instances;
 
+  // Instanced batches: one draw per (type, mesh, pass[, tree pose]) for all
+  // instances that need no per-instance uniforms. Instance data is built
+  // once at load time; each frame the visible instances of a group are
+  // copied into one transient buffer shared by its batches. The rest (doors,
+  // cliffs, Dungeon torches) stays on the per-instance path.
+  static constexpr int TREE_PHASE_POSES = 8; // Animation phases per tree type
+  struct InstanceGroup {          // Instances of one (type, pose)
+    int type;
+    std::vector<int> members;        // Instance indices, sorted by grid leaf
+    std::vector<glm::vec4> data;     // 5 per member (i_data0-4)
+    std::vector<uint32_t> cellStart; // Per grid leaf: first member
+    bgfx::InstanceDataBuffer idb;    // Visible members, this frame
+    uint32_t visible = 0;
+  };
+  struct InstanceBatch {
+    int type;
+    int meshIdx;
+    int pass;      // 0 = opaque, 1 = alpha/additive
+    int pose;      // GPU-animated types: phase pose 0..7, else -1
+    int group;     // Index into m_groups
+  };
+  std::vector<InstanceGroup> m_groups;
+  std::vector<InstanceBatch> m_batches; // Sorted by pass/texture/model/mesh
+  std::vector<bool> m_instanceBatched;  // Parallel to instances
+
+  // Static quadtree for culling (see BuildInstanceBatches): tight bounds per
+  // instance and per node, leaves in Morton order
+  std::vector<AABB> m_instanceBounds;          // Parallel to instances
+  std::vector<std::vector<AABB>> m_gridNodes;  // [level][node], 0 = root
+  std::vector<std::vector<int>> m_cellUnbatched; // Per leaf: unbatched instances
+  std::vector<std::pair<uint32_t, uint32_t>> m_visibleRuns; // Leaf ranges, per frame
+  CullStats m_cullStats;
+
+  // Per-frame animation shared by every draw (set at the top of Render)
+  float m_flickerBase = 1.0f;
+  float m_uvScroll = 0.0f;
+  float m_dungeonWaterScroll = 0.0f;
+
   std::vector<glm::vec3> plPositions, plColors;
   std::vector<float> plRanges;
   int plCount = 0;
@@ -135,6 +201,7 @@ private:
   float m_fogFar = 3500.0f;
   std::vector<int> m_typeFilter; // If non-empty, only render these types
   int m_mapId = 0; // 0=Lorencia, 1=Dungeon
+  bool m_instancing = true;
   std::vector<InteractiveObject> m_interactiveObjects;
   TexHandle m_lightmapTex = kInvalidTex; // Terrain lightmap GPU texture for per-pixel lighting
   TexHandle m_chromeTexture = kInvalidTex;
@@ -150,8 +217,33 @@ private:
 
   std::unique_ptr<Shader> shader;
   std::unique_ptr<Shader> skinnedShader; // GPU-skinned program (bone matrices + tree sway)
+  std::unique_ptr<Shader> instancedShader;        // Batches of static meshes
+  std::unique_ptr<Shader> skinnedInstancedShader; // Batches of GPU-skinned trees
   bgfx::UniformHandle u_boneMatrices = BGFX_INVALID_HANDLE;
 
+  // Types never drawn on the current map / hidden by SetTypeFilter
+  bool IsTypeSkipped(int type) const;
+  bool IsTypeFiltered(int type) const;
+
+  // Group the batchable instances into m_batches and build the cull grid
+  // (end of LoadObjects*)
+  void BuildInstanceBatches();
+  void DestroyInstanceBatches();
+  // Collect the visible leaf ranges of a node's subtree into m_visibleRuns
+  void CullGrid(const glm::vec4 frustum[6], int level, uint32_t node,
+                bool inside);
+  void RenderBatches(int pass, const glm::vec3 &cameraPos, float currentTime);
+
+  // Blend state, BlendMesh intensity and UV offset of one mesh of `type`.
+  // instX: world X of the instance (Dungeon torch flicker phase)
+  uint64_t MeshDrawState(int type, int meshIdx, const MeshBuffers &mb,
+                         float instX, float currentTime, float &blendLight,
+                         glm::vec2 &texOffset) const;
+  void SetDrawUniforms(Shader *s, float alpha, float blendLight,
+                       const glm::vec2 &texOffset, const glm::vec4 &params2,
+                       const glm::vec3 &terrainLight,
+                       const glm::vec3 &cameraPos);
+
   void UploadMesh(const Mesh_t &mesh, const std::string &baseDir,
                   const std::vector<BoneWorldMatrix> &bones,
                   std::vector<MeshBuffers> &out, bool dynamic = false,
@@ -159,7 +251,8 @@ private:
 
   // GPU-skinned upload: stores RAW vertex positions + bone indices (no CPU transform)
   void UploadMeshGPUSkinned(const Mesh_t &mesh, const std::string &baseDir,
-                            std::vector<MeshBuffers> &out);
+                            std::vector<MeshBuffers> &out,
+                            const std::string &fallbackTexDir = "");
 
   void RetransformMesh(const Mesh_t &mesh,
                        const std::vector<BoneWorldMatrix> &bones,
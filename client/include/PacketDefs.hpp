@@ -45,10 +45,13 @@ constexpr uint8_t MON_VIEWPORT_V2 = 0x34;
 constexpr uint8_t MON_MOVE = 0x35;
 constexpr uint8_t MOVE = 0xD4;
 constexpr uint8_t PRECISE_POS = 0xD7;
+constexpr uint8_t MOVE_PATH = 0xD6; // C->S: planned route, server simulates
+constexpr uint8_t TOWN_RETURN = 0xD8; // C->S: same-map return to town
 
 // Character & Equipment
 constexpr uint8_t EQUIPMENT = 0x24;
 constexpr uint8_t CHARSTATS = 0x25;
+constexpr uint8_t CHARSTATS_DELTA = 0x49; // S->C: changed vitals/XP only
 constexpr uint8_t CHARSAVE = 0x26;
 constexpr uint8_t EQUIP = 0x27;
 constexpr uint8_t STAT_ALLOC = 0x37;
@@ -117,6 +120,10 @@ constexpr uint8_t CHAT_LOG_SAVE = 0x61;    // C->S: save chat message
 
 // Client settings
 constexpr uint8_t CLIENT_SETTINGS = 0x63; // C->S: client settings (camera zoom)
+
+// Transport options (see PacketCompression.hpp)
+constexpr uint8_t NET_OPTIONS = 0x64; // C->S: opt into transport features
+constexpr uint8_t COMPRESSED = 0xF9;  // S->C: compressed C2 packet (C2)
 } // namespace Opcode
 
 // =====================================================
@@ -147,6 +154,22 @@ struct PWMSG_HEAD {
   uint8_t headcode; // Main opcode
 };
 
+// S->C: Compressed packet (0xF9), only after NET_OPT_COMPRESS. Followed by the
+// LZ-encoded original packet, header included.
+struct PMSG_COMPRESSED_HEAD {
+  PWMSG_HEAD h;     // C2:0xF9
+  uint16_t rawSize; // Size of the original packet
+};
+
+// C->S: Transport options (0x64)
+enum NetOptionFlag : uint8_t {
+  NET_OPT_COMPRESS = 0x01, // Accept COMPRESSED packets
+};
+struct PMSG_NET_OPTIONS {
+  PBMSG_HEAD h;  // C1:0x64
+  uint8_t flags; // NetOptionFlag bits
+};
+
 // =====================================================
 // Section 2: Authentication & Character Selection
 // =====================================================
@@ -336,6 +359,24 @@ struct PMSG_CHARSTATS_SEND {
   int8_t rmcSkillId;
 };
 
+// S->C: Character Stats Delta (0x49, variable size)
+// Header, then one value per set bit of `fields` in bit order: uint16_t, except
+// STATS_XP which is a uint64_t. Full stats still go out as CHARSTATS (0x25).
+enum StatsField : uint16_t {
+  STATS_HP = 1 << 0,
+  STATS_MAX_HP = 1 << 1,
+  STATS_MANA = 1 << 2,
+  STATS_MAX_MANA = 1 << 3,
+  STATS_AG = 1 << 4,
+  STATS_MAX_AG = 1 << 5,
+  STATS_XP = 1 << 6,
+};
+
+struct PMSG_CHARSTATS_DELTA_HEAD {
+  PBMSG_HEAD h;    // C1:0x49
+  uint16_t fields; // StatsField bits
+};
+
 // C->S: Character Save (0x26)
 struct PMSG_CHARSAVE_RECV {
   PBMSG_HEAD h; // C1:0x26
@@ -652,6 +693,19 @@ struct PMSG_MOVE_RECV {
   uint8_t path[8];
 };
 
+// C->S: Path Move (0xD6, variable size: 6 + count * 2)
+// Sent when the hero starts a route and again for each further chunk of it.
+// count = 0: stop where you are; count = 1: destination only (server paths to
+// it); count > 1: the client's route as adjacent cells, re-pathed by the
+// server if invalid.
+struct PMSG_MOVE_PATH_RECV {
+  PBMSG_HEAD h; // C1:0xD6
+  uint8_t startX; // Grid cell the client is in (gx = worldZ / 100)
+  uint8_t startY; // (gy = worldX / 100)
+  uint8_t count;
+  uint8_t path[32][2]; // x, y per waypoint (only `count` entries are sent)
+};
+
 // C->S: Precise Position (0xD7)
 struct PMSG_PRECISE_POS_RECV {
   PBMSG_HEAD h; // C1:0xD7
@@ -659,6 +713,12 @@ struct PMSG_PRECISE_POS_RECV {
   float worldZ;
 };
 
+// C->S: Return to Town (0xD8). The server picks the town cell and moves the
+// player there; the client lands on the same cell without reporting it.
+struct PMSG_TOWN_RETURN_RECV {
+  PBMSG_HEAD h; // C1:0xD8
+};
+
 // S->C: Position Update (0x15)
 struct PMSG_POSITION_SEND {
   PBMSG_HEAD h; // C1:0x15
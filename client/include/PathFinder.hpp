@@ -33,6 +33,14 @@ public:
                                   bool canEnterSafeZone = false,
                                   const bool *occupancyGrid = nullptr) const;
 
+  // Route to a destination farther than FindPath's 16-cell scope: chains
+  // FindPath over waypoints on the straight line to `end`, pulling a waypoint
+  // back toward the current cell while it cannot be reached. Returns up to
+  // maxSteps cells (start exclusive); stops early where no segment is found.
+  std::vector<GridPoint> FindRoute(GridPoint start, GridPoint end,
+                                   const uint8_t *terrainAttribs, int maxSteps,
+                                   bool canEnterSafeZone = false) const;
+
   // Chebyshev distance (max of |dx|, |dy|) — used for all range checks
   static int ChebyshevDist(uint8_t ax, uint8_t ay, uint8_t bx, uint8_t by);
   static int ChebyshevDist(GridPoint a, GridPoint b);
@@ -40,6 +48,7 @@ public:
   // Terrain attribute flags (from _define.h)
   static constexpr uint8_t TW_SAFEZONE = 0x01;
   static constexpr uint8_t TW_NOMOVE = 0x04;
+  static constexpr uint8_t TW_NOGROUND = 0x08;
   static constexpr int TERRAIN_SIZE = 256;
 };
 
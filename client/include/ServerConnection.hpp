@@ -18,6 +18,7 @@ public:
 
   // Typed sends (build packet internally)
   void SendPrecisePosition(float worldX, float worldZ);
+  void SendTownReturn();
   void SendAttack(uint16_t monsterIndex);
   void SendSkillAttack(uint16_t monsterIndex, uint8_t skillId,
                        float targetX = 0, float targetZ = 0);
@@ -37,6 +38,10 @@ public:
   void SendItemUse(uint8_t slot);
   void SendDropItem(uint8_t bagSlot);
   void SendGridMove(uint8_t gridX, uint8_t gridY);
+  // Planned route from (startX, startY): count x/y pairs in pathXY. One pair =
+  // destination only, zero = stop.
+  void SendMovePath(uint8_t startX, uint8_t startY, const uint8_t *pathXY,
+                    uint8_t count);
 
   // Character Select
   void SendCharCreate(const char *name, uint8_t classCode);
@@ -176,4 +176,16 @@ private:
 // Type alias so game code can use "Shader" in both paths
 using Shader = BgfxShader;
 
+// Draw calls submitted so far. World renderers submit through SubmitDraw so
+// the headless benchmark can count them itself: the Noop renderer leaves
+// bgfx::Stats::numDraw at 0. `flags` are the bgfx discard flags, so several
+// draws can share one set of bindings (BGFX_DISCARD_INDEX_BUFFER).
+inline uint32_t g_submittedDraws = 0;
+
+inline void SubmitDraw(bgfx::ViewId view, bgfx::ProgramHandle program,
+                       uint8_t flags = BGFX_DISCARD_ALL) {
+  ++g_submittedDraws;
+  bgfx::submit(view, program, 0, flags);
+}
+
 #endif // SHADER_HPP
@@ -48,6 +48,19 @@ public:
   // GPU lightmap texture handle (for per-pixel lighting on world objects)
   TexHandle GetLightmapTexture() const { return lightmapTex; }
 
+  // Chunks/triangles submitted by Render and RenderToView since the last
+  // ResetDrawStats() (headless bench)
+  struct DrawStats {
+    uint64_t calls = 0;     // Render/RenderToView calls
+    uint64_t chunks = 0;    // Chunks that passed the frustum test
+    uint64_t triangles = 0; // Triangles submitted, skirts included
+    uint64_t draws = 0;     // Submits after merging adjacent index ranges
+  };
+  const DrawStats &GetDrawStats() const { return m_drawStats; }
+  void ResetDrawStats() { m_drawStats = {}; }
+  // Triangles of the whole map at full detail
+  size_t GetFullTriangleCount() const { return indexCount / 3; }
+
 private:
   void setupMesh(const std::vector<float> &heightmap,
                  const std::vector<glm::vec3> &lightmap,
@@ -58,6 +71,11 @@ private:
                  const std::vector<float> &bridgeDist = {});
   void setupTextures(const TerrainData &data, const std::string &base_path);
   void applyDynamicLights();
+  // Cull the chunks against viewProj, pick each one's LOD by distance to
+  // viewPos and submit the index ranges. State, vertex buffer, transform and
+  // textures must be set; they are shared by all the submits.
+  void submitChunks(bgfx::ViewId viewId, const glm::mat4 &viewProj,
+                    const glm::vec3 &viewPos, bgfx::ProgramHandle program);
 
   int debugMode = 0;
   float m_luminosity = 1.0f;
@@ -86,6 +104,25 @@ private:
   bgfx::VertexBufferHandle vbo = BGFX_INVALID_HANDLE;
   bgfx::IndexBufferHandle ebo = BGFX_INVALID_HANDLE;
 
+  // The map is cut into CHUNK_CELLS x CHUNK_CELLS cell chunks. ebo holds
+  // every chunk at each LOD (LOD-major, chunks row-major inside a LOD, so
+  // neighbouring chunks at the same LOD merge into one draw). LOD n samples
+  // every 2^n-th vertex; coarse chunks hang skirts from their borders to
+  // cover the cracks against finer neighbours. Chunks with void holes always
+  // draw at full detail and hang skirts as well.
+  static constexpr int CHUNK_CELLS = 16;
+  static constexpr int LOD_COUNT = 3;
+  struct Chunk {
+    glm::vec3 boundsMin, boundsMax;
+    uint32_t first[LOD_COUNT] = {};
+    uint32_t count[LOD_COUNT] = {};
+    bool hasHoles = false;
+  };
+  std::vector<Chunk> m_chunks; // Row-major, m_chunksPerSide^2
+  int m_chunksPerSide = 0;
+  std::vector<std::pair<uint32_t, uint32_t>> m_drawRanges; // Scratch
+  DrawStats m_drawStats;
+
   // Separate void floor mesh (own vertices, not shared with main terrain)
   bgfx::VertexBufferHandle voidVbo = BGFX_INVALID_HANDLE;
   bgfx::IndexBufferHandle voidEbo = BGFX_INVALID_HANDLE;
@@ -41,10 +41,36 @@ void UploadMeshWithBones(const Mesh_t &mesh, const std::string &textureDir,
                          bool dynamic = false);
 
 // Re-skin an already-uploaded dynamic mesh with new bone matrices.
+// GPU-skinned meshes only take the new bone palette.
 void RetransformMeshWithBones(const Mesh_t &mesh,
                               const std::vector<BoneWorldMatrix> &bones,
                               MeshBuffers &mb);
 
+// GPU skinning: the mesh keeps bind-space vertices plus a bone index in a
+// static buffer and the vertex shader applies the bone palette (see
+// shaders/bgfx/skinning.sh), so re-posing costs 48 bytes per bone instead
+// of a vertex upload. Draw with BindMesh() and a *_skinned vertex shader.
+// Meshes referencing more than MAX_SKIN_BONES bones fall back to
+// UploadMeshWithBones(dynamic = true).
+static constexpr int MAX_SKIN_BONES = 96; // Keep in sync with skinning.sh
+const bgfx::VertexLayout &GetSkinnedVertexLayout();
+void UploadSkinnedMesh(const Mesh_t &mesh, const std::string &textureDir,
+                       const std::vector<BoneWorldMatrix> &bones,
+                       std::vector<MeshBuffers> &out, AABB &aabb);
+
+// Meshes that took the CPU fallback above: distinct meshes (texture dir +
+// texture name, logged once each) and total uploads including re-uploads
+// for every monster/NPC instance.
+struct SkinFallbackStats {
+  int meshes = 0;
+  int uploads = 0;
+  int maxBones = 0;
+};
+const SkinFallbackStats &GetSkinFallbackStats();
+
+// Set vertex/index buffers of a model mesh (and its bone palette if skinned)
+void BindMesh(const MeshBuffers &mb);
+
 // Delete GPU resources for a list of MeshBuffers
 void CleanupMeshBuffers(std::vector<MeshBuffers> &buffers);
 
@@ -1,4 +1,4 @@
-$input v_texcoord0, v_normal, v_fragpos
+$input v_texcoord0, v_normal, v_fragpos, v_color0
 
 #include <bgfx_shader.sh>
 
@@ -23,6 +23,9 @@ uniform vec4 u_lightColor;    // xyz = sun color
 uniform vec4 u_fogParams;
 uniform vec4 u_fogColor;
 
+// Per-instance terrain light (xyz) and alpha (w) arrive in v_color0 from the
+// instanced vertex shaders; the other vertex shaders pass 1.0.
+
 // Terrain lightmap: xyz = lightmap color (per-object uniform fallback),
 // w = useLightmapTex flag (1.0 = sample from s_lightMap per-pixel)
 uniform vec4 u_terrainLight;
@@ -49,7 +52,7 @@ float computeEdgeFog(vec3 worldPos) {
 
 void main()
 {
-    float objectAlpha   = u_params.x;
+    float objectAlpha   = u_params.x * v_color0.a;
     float blendMeshLit  = u_params.y;
     float chromeMode    = u_params.z;
     float chromeTime    = u_params.w;
@@ -77,7 +80,7 @@ void main()
         tLight = vec3_splat(mix(lmBright, voidBright, voidMix));
     } else {
         // Per-object uniform (characters/monsters/NPCs)
-        tLight = max(u_terrainLight.xyz, vec3_splat(0.30));
+        tLight = max(u_terrainLight.xyz * v_color0.rgb, vec3_splat(0.30));
     }
     vec3 sunLit = diff * u_lightColor.xyz * tLight;
 
@@ -0,0 +1,28 @@
+#ifndef MU_PLANAR_SHADOW_SH
+#define MU_PLANAR_SHADOW_SH
+
+// Main 5.2 planar character shadow (RenderBodyShadow), formerly computed
+// per vertex on the CPU: scale and face the model-space vertex, slant it
+// away from a fixed light, then flatten it just above the ground. The model
+// matrix supplies position and the MU->world axis swap.
+
+uniform vec4 u_shadowProj; // x = scale, y = cos(facing), z = sin(facing)
+
+vec3 projectPlanarShadow(vec3 p)
+{
+    const float sx = 2000.0;
+    const float sy = 4000.0;
+    p *= u_shadowProj.x;
+    float c = u_shadowProj.y;
+    float s = u_shadowProj.z;
+    p.xy = vec2(p.x * c - p.y * s, p.x * s + p.y * c);
+    if (p.z < sy) {
+        float factor = 1.0 / (p.z - sy);
+        p.x += p.z * (p.x + sx) * factor;
+        p.y += p.z * (p.y + sx) * factor;
+    }
+    p.z = 5.0;
+    return p;
+}
+
+#endif // MU_PLANAR_SHADOW_SH
@@ -0,0 +1,35 @@
+#ifndef MU_SKINNING_SH
+#define MU_SKINNING_SH
+
+// Bone palette skinning for characters, monsters, NPCs and their items.
+// Each bone is a 3x4 affine matrix in MU row layout (BoneWorldMatrix),
+// uploaded as three vec4 rows by BindMesh() in ViewerCommon.cpp. Vertices
+// carry one bone index in a_texcoord1.x; a negative index keeps the
+// bind-space vertex, as the CPU path does for unskinned vertices.
+
+#define MAX_SKIN_BONES 96 // Keep in sync with ViewerCommon.hpp
+
+uniform vec4 u_bonePalette[MAX_SKIN_BONES * 3];
+
+vec3 skinPosition(float bone, vec3 p)
+{
+    int b = int(bone);
+    if (b < 0 || b >= MAX_SKIN_BONES)
+        return p;
+    vec4 hp = vec4(p, 1.0);
+    return vec3(dot(u_bonePalette[b * 3 + 0], hp),
+                dot(u_bonePalette[b * 3 + 1], hp),
+                dot(u_bonePalette[b * 3 + 2], hp));
+}
+
+vec3 skinNormal(float bone, vec3 n)
+{
+    int b = int(bone);
+    if (b < 0 || b >= MAX_SKIN_BONES)
+        return n;
+    return vec3(dot(u_bonePalette[b * 3 + 0].xyz, n),
+                dot(u_bonePalette[b * 3 + 1].xyz, n),
+                dot(u_bonePalette[b * 3 + 2].xyz, n));
+}
+
+#endif // MU_SKINNING_SH
@@ -15,3 +15,5 @@ vec4 a_color0    : COLOR0;
 vec4 i_data0     : TEXCOORD7;
 vec4 i_data1     : TEXCOORD6;
 vec4 i_data2     : TEXCOORD5;
+vec4 i_data3     : TEXCOORD4;
+vec4 i_data4     : TEXCOORD3;
@@ -0,0 +1,11 @@
+$input a_position, a_texcoord1
+
+#include <bgfx_shader.sh>
+#include "skinning.sh"
+
+void main()
+{
+    vec3 pos = skinPosition(a_texcoord1.x, a_position);
+    vec4 worldPos = mul(u_model[0], vec4(pos, 1.0));
+    gl_Position = mul(u_viewProj, worldPos);
+}
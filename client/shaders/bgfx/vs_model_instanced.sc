@@ -0,0 +1,25 @@
+$input a_position, a_normal, a_texcoord0, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_texcoord0, v_normal, v_fragpos, v_color0
+
+#include <bgfx_shader.sh>
+
+// Instanced static world objects (ObjectRenderer batches)
+// i_data0-3: model matrix columns (i_data0.w = sway phase, unused here)
+// i_data4:   xyz = terrain light, w = alpha (passed to fs_model in v_color0)
+
+uniform vec4 u_texCoordOffset; // xy = offset, zw unused
+
+void main()
+{
+    mat4 model = mtxFromCols(vec4(i_data0.xyz, 0.0), vec4(i_data1.xyz, 0.0),
+                             vec4(i_data2.xyz, 0.0), vec4(i_data3.xyz, 1.0));
+    vec4 worldPos = mul(model, vec4(a_position, 1.0));
+    gl_Position = mul(u_viewProj, worldPos);
+    v_fragpos = worldPos.xyz;
+
+    // Normal transform: upper-left 3x3 of model matrix (uniform scale)
+    v_normal = mul(model, vec4(a_normal, 0.0)).xyz;
+
+    v_texcoord0 = a_texcoord0 + u_texCoordOffset.xy;
+    v_color0 = i_data4;
+}
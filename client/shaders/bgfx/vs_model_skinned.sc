@@ -1,5 +1,5 @@
 $input a_position, a_normal, a_texcoord0, a_texcoord1
-$output v_texcoord0, v_normal, v_fragpos
+$output v_texcoord0, v_normal, v_fragpos, v_color0
 
 #include <bgfx_shader.sh>
 
@@ -50,4 +50,5 @@ void main()
     v_normal = mul(u_model[0], vec4(localNorm, 0.0)).xyz;
 
     v_texcoord0 = a_texcoord0 + u_texCoordOffset.xy;
+    v_color0 = vec4_splat(1.0); // No per-instance light/alpha
 }
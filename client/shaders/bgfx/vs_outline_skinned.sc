@@ -0,0 +1,19 @@
+$input a_position, a_normal, a_texcoord1
+$output v_fragpos
+
+#include <bgfx_shader.sh>
+#include "skinning.sh"
+
+// u_outlineParams: x=outlineThickness
+uniform vec4 u_outlineParams;
+
+void main()
+{
+    // Extrude along the posed normal, like vs_outline on CPU-skinned meshes
+    vec3 pos = skinPosition(a_texcoord1.x, a_position);
+    vec3 nrm = skinNormal(a_texcoord1.x, a_normal);
+    vec3 extruded = pos + nrm * u_outlineParams.x;
+    vec4 worldPos = mul(u_model[0], vec4(extruded, 1.0));
+    gl_Position = mul(u_viewProj, worldPos);
+    v_fragpos = worldPos.xyz;
+}
@@ -0,0 +1,12 @@
+$input a_position
+
+#include <bgfx_shader.sh>
+#include "planar_shadow.sh"
+
+// Planar shadow of a mesh whose vertices are already posed (CPU-skinned)
+
+void main()
+{
+    vec3 pos = projectPlanarShadow(a_position);
+    gl_Position = mul(u_modelViewProj, vec4(pos, 1.0));
+}
@@ -0,0 +1,13 @@
+$input a_position, a_texcoord1
+
+#include <bgfx_shader.sh>
+#include "skinning.sh"
+#include "planar_shadow.sh"
+
+// Planar shadow of a GPU-skinned mesh (bone palette bound by BindMesh)
+
+void main()
+{
+    vec3 pos = projectPlanarShadow(skinPosition(a_texcoord1.x, a_position));
+    gl_Position = mul(u_modelViewProj, vec4(pos, 1.0));
+}
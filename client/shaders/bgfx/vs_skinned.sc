@@ -0,0 +1,23 @@
+$input a_position, a_normal, a_texcoord0, a_texcoord1
+$output v_texcoord0, v_normal, v_fragpos, v_color0
+
+#include <bgfx_shader.sh>
+#include "skinning.sh"
+
+// vs_model with the bone palette applied first (pairs with fs_model)
+
+uniform vec4 u_texCoordOffset; // xy = offset, zw unused
+
+void main()
+{
+    vec3 pos = skinPosition(a_texcoord1.x, a_position);
+    vec3 nrm = skinNormal(a_texcoord1.x, a_normal);
+
+    vec4 worldPos = mul(u_model[0], vec4(pos, 1.0));
+    gl_Position = mul(u_viewProj, worldPos);
+    v_fragpos = worldPos.xyz;
+    v_normal = mul(u_model[0], vec4(nrm, 0.0)).xyz;
+
+    v_texcoord0 = a_texcoord0 + u_texCoordOffset.xy;
+    v_color0 = vec4_splat(1.0); // No per-instance light/alpha
+}
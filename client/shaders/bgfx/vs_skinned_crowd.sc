@@ -0,0 +1,64 @@
+$input a_position, a_normal, a_texcoord0, a_texcoord1, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_texcoord0, v_normal, v_fragpos, v_color0
+
+#include <bgfx_shader.sh>
+
+// Instanced monster crowds (MonsterManager::renderCrowds): the pose comes
+// from the model's baked animation texture instead of the bone palette.
+// Texture row = one baked pose, bone b in texels 3b..3b+2 (BoneWorldMatrix
+// rows, as in skinning.sh).
+// i_data0-3: model matrix columns; i_data0.w / i_data1.w = rows of the two
+//            baked poses around the frame, i_data2.w = lerp between them
+// i_data4:   xyz = terrain light, w = alpha (passed to fs_model in v_color0)
+
+SAMPLER2D(s_animTex, 4);
+
+uniform vec4 u_texCoordOffset; // xy = offset, zw unused
+uniform vec4 u_animTexSize;    // xy = 1 / texture size in texels, zw unused
+
+vec4 boneRow(float texel, float row)
+{
+    vec2 uv = (vec2(texel, row) + 0.5) * u_animTexSize.xy;
+    return texture2DLod(s_animTex, uv, 0.0);
+}
+
+void main()
+{
+    vec3 pos = a_position;
+    vec3 nrm = a_normal;
+
+    float bone = a_texcoord1.x;
+    if (bone >= 0.0) {
+        float t = i_data2.w;
+        float texel = bone * 3.0;
+        vec4 r0 = mix(boneRow(texel, i_data0.w), boneRow(texel, i_data1.w), t);
+        vec4 r1 = mix(boneRow(texel + 1.0, i_data0.w),
+                      boneRow(texel + 1.0, i_data1.w), t);
+        vec4 r2 = mix(boneRow(texel + 2.0, i_data0.w),
+                      boneRow(texel + 2.0, i_data1.w), t);
+        // Lerped rotations shrink (by cos(angle / 2) midway, visible where a
+        // loop wraps back to key 0); one Newton step of the polar
+        // decomposition, 0.5 * (R + R^-T), makes them orthonormal again
+        vec3 c0 = cross(r1.xyz, r2.xyz);
+        vec3 c1 = cross(r2.xyz, r0.xyz);
+        vec3 c2 = cross(r0.xyz, r1.xyz);
+        float invDet = 1.0 / dot(r0.xyz, c0);
+        r0 = vec4(0.5 * (r0.xyz + c0 * invDet), r0.w);
+        r1 = vec4(0.5 * (r1.xyz + c1 * invDet), r1.w);
+        r2 = vec4(0.5 * (r2.xyz + c2 * invDet), r2.w);
+        vec4 hp = vec4(a_position, 1.0);
+        pos = vec3(dot(r0, hp), dot(r1, hp), dot(r2, hp));
+        nrm = vec3(dot(r0.xyz, a_normal), dot(r1.xyz, a_normal),
+                   dot(r2.xyz, a_normal));
+    }
+
+    mat4 model = mtxFromCols(vec4(i_data0.xyz, 0.0), vec4(i_data1.xyz, 0.0),
+                             vec4(i_data2.xyz, 0.0), vec4(i_data3.xyz, 1.0));
+    vec4 worldPos = mul(model, vec4(pos, 1.0));
+    gl_Position = mul(u_viewProj, worldPos);
+    v_fragpos = worldPos.xyz;
+    v_normal = mul(model, vec4(nrm, 0.0)).xyz;
+
+    v_texcoord0 = a_texcoord0 + u_texCoordOffset.xy;
+    v_color0 = i_data4;
+}
@@ -0,0 +1,161 @@
+#include "AnimationTracks.hpp"
+#include "BMDParser.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+// Sample() runs on every job thread, so each thread counts into its own
+// block (only it writes there, no shared cache line); GetStats() sums them
+struct Counters {
+  std::atomic<uint64_t> lookups{0}, hits{0}, baked{0};
+  std::atomic<int64_t> cpuNs{0};
+};
+
+static std::mutex s_countersMutex;
+static std::vector<std::shared_ptr<Counters>> s_counters;
+static std::atomic<bool> s_timing{false};
+
+static Counters &threadCounters() {
+  thread_local std::shared_ptr<Counters> counters = [] {
+    auto c = std::make_shared<Counters>();
+    std::lock_guard<std::mutex> lock(s_countersMutex);
+    s_counters.push_back(c);
+    return c;
+  }();
+  return *counters;
+}
+
+// Owner thread only: a plain load + store, no locked read-modify-write
+template <typename T> static void add(std::atomic<T> &counter, T n) {
+  counter.store(counter.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+}
+
+// Baking is rare (first use of each sample), one lock for all models
+static std::mutex s_bakeMutex;
+
+void AnimationTracks::Init(const BMDData *bmd) {
+  m_bmd = bmd;
+  m_numBones = bmd ? (int)bmd->Bones.size() : 0;
+  m_numActions = bmd ? (int)bmd->Actions.size() : 0;
+  m_tracks.reset();
+  if (!bmd)
+    return;
+  m_tracks = std::make_unique<Track[]>(m_numActions);
+  for (int a = 0; a < m_numActions; ++a) {
+    int keys = bmd->Actions[a].NumAnimationKeys;
+    m_tracks[a].numSamples = keys > 0 ? keys * SAMPLES_PER_KEY : 0;
+  }
+}
+
+const AnimationTracks::BoneKey *
+AnimationTracks::Pose(Track &track, int action, int sample, bool &hit) {
+  if (!track.ready.load(std::memory_order_acquire) ||
+      !track.baked[sample].load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(s_bakeMutex);
+    if (!track.ready.load(std::memory_order_relaxed)) {
+      track.poses =
+          std::make_unique<BoneKey[]>((size_t)track.numSamples * m_numBones);
+      track.baked = std::make_unique<std::atomic<uint8_t>[]>(track.numSamples);
+      for (int s = 0; s < track.numSamples; ++s)
+        track.baked[s].store(0, std::memory_order_relaxed);
+      track.ready.store(true, std::memory_order_release);
+    }
+    if (!track.baked[sample].load(std::memory_order_relaxed)) {
+      std::vector<BoneWorldMatrix> bones;
+      ComputeBoneMatricesInterpolated(
+          m_bmd, action, (float)sample / (float)SAMPLES_PER_KEY, bones);
+      // Bone matrices are rigid (rotation + translation), so the quaternion
+      // and position rebuild them exactly
+      BoneKey *keys = &track.poses[(size_t)sample * m_numBones];
+      int n = std::min((int)bones.size(), m_numBones);
+      for (int b = 0; b < n; ++b) {
+        const auto *m = (const float(*)[4])bones[b].data();
+        keys[b].rot = MuMath::MatrixQuaternion(m);
+        keys[b].pos = glm::vec3(m[0][3], m[1][3], m[2][3]);
+      }
+      track.baked[sample].store(1, std::memory_order_release);
+      add<uint64_t>(threadCounters().baked, 1);
+      hit = false;
+    }
+  }
+  return &track.poses[(size_t)sample * m_numBones];
+}
+
+void AnimationTracks::Sample(int action, float frame,
+                             std::vector<BoneWorldMatrix> &out) {
+  bool timed = s_timing.load(std::memory_order_relaxed);
+  std::chrono::steady_clock::time_point start;
+  if (timed)
+    start = std::chrono::steady_clock::now();
+  Counters &counters = threadCounters();
+  add<uint64_t>(counters.lookups, 1);
+
+  if (action < 0 || action >= m_numActions ||
+      m_tracks[action].numSamples == 0 || m_numBones == 0) {
+    ComputeBoneMatricesInterpolated(m_bmd, action, frame, out);
+  } else {
+    // Same wrap as GetInterpolatedBoneData: the last key blends into key 0
+    Track &track = m_tracks[action];
+    float f = frame * (float)SAMPLES_PER_KEY;
+    float whole = std::floor(f);
+    float t = f - whole;
+    int s0 = (int)whole % track.numSamples;
+    if (s0 < 0)
+      s0 += track.numSamples;
+    int s1 = (s0 + 1) % track.numSamples;
+
+    bool hit = true;
+    const BoneKey *p0 = Pose(track, action, s0, hit);
+    const BoneKey *p1 = Pose(track, action, s1, hit);
+    if (hit)
+      add<uint64_t>(counters.hits, 1);
+
+    out.resize(m_numBones);
+    for (int b = 0; b < m_numBones; ++b) {
+      glm::vec4 q = MuMath::QuaternionSlerp(p0[b].rot, p1[b].rot, t);
+      glm::vec3 pos = p0[b].pos + t * (p1[b].pos - p0[b].pos);
+      float quat[4] = {q.x, q.y, q.z, q.w};
+      float m[3][4];
+      MuMath::QuaternionMatrix(quat, m);
+      m[0][3] = pos.x;
+      m[1][3] = pos.y;
+      m[2][3] = pos.z;
+      memcpy(out[b].data(), m, sizeof(m));
+    }
+  }
+
+  if (timed)
+    add<int64_t>(counters.cpuNs,
+                 std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count());
+}
+
+AnimationTracks::Stats AnimationTracks::GetStats() {
+  Stats st;
+  std::lock_guard<std::mutex> lock(s_countersMutex);
+  for (const auto &c : s_counters) {
+    st.lookups += c->lookups.load(std::memory_order_relaxed);
+    st.hits += c->hits.load(std::memory_order_relaxed);
+    st.baked += c->baked.load(std::memory_order_relaxed);
+    st.cpuNs += c->cpuNs.load(std::memory_order_relaxed);
+  }
+  return st;
+}
+
+void AnimationTracks::ResetStats() {
+  std::lock_guard<std::mutex> lock(s_countersMutex);
+  for (const auto &c : s_counters) {
+    c->lookups.store(0, std::memory_order_relaxed);
+    c->hits.store(0, std::memory_order_relaxed);
+    c->baked.store(0, std::memory_order_relaxed);
+    c->cpuNs.store(0, std::memory_order_relaxed);
+  }
+}
+
+void AnimationTracks::SetTiming(bool on) {
+  s_timing.store(on, std::memory_order_relaxed);
+}
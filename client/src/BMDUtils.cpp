@@ -28,6 +28,29 @@ void QuaternionMatrix(const float q[4], float m[3][4]) {
   m[0][3] = m[1][3] = m[2][3] = 0.0f;
 }
 
+glm::vec4 MatrixQuaternion(const float m[3][4]) {
+  glm::vec4 q;
+  float trace = m[0][0] + m[1][1] + m[2][2];
+  if (trace > 0.0f) {
+    float s = sqrtf(trace + 1.0f) * 2.0f;
+    q = {(m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s,
+         (m[1][0] - m[0][1]) / s, 0.25f * s};
+  } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+    float s = sqrtf(1.0f + m[0][0] - m[1][1] - m[2][2]) * 2.0f;
+    q = {0.25f * s, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s,
+         (m[2][1] - m[1][2]) / s};
+  } else if (m[1][1] > m[2][2]) {
+    float s = sqrtf(1.0f + m[1][1] - m[0][0] - m[2][2]) * 2.0f;
+    q = {(m[0][1] + m[1][0]) / s, 0.25f * s, (m[1][2] + m[2][1]) / s,
+         (m[0][2] - m[2][0]) / s};
+  } else {
+    float s = sqrtf(1.0f + m[2][2] - m[0][0] - m[1][1]) * 2.0f;
+    q = {(m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, 0.25f * s,
+         (m[1][0] - m[0][1]) / s};
+  }
+  return glm::normalize(q);
+}
+
 void ConcatTransforms(const float in1[3][4], const float in2[3][4],
                       float out[3][4]) {
   out[0][0] =
@@ -177,9 +200,8 @@ std::vector<BoneWorldMatrix> ComputeBoneMatrices(const BMDData *bmd, int action,
   return world;
 }
 
-// Quaternion spherical linear interpolation (shortest path)
-static glm::vec4 QuaternionSlerp(const glm::vec4 &q1, const glm::vec4 &q2,
-                                 float t) {
+glm::vec4 MuMath::QuaternionSlerp(const glm::vec4 &q1, const glm::vec4 &q2,
+                                  float t) {
   float dot = q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
   glm::vec4 q2adj = q2;
   if (dot < 0.0f) {
@@ -227,7 +249,7 @@ bool GetInterpolatedBoneData(const BMDData *bmd, int action, float frame,
   int f0 = (frame0 < (int)bm.Position.size()) ? frame0 : 0;
   int f1 = (frame1 < (int)bm.Position.size()) ? frame1 : 0;
 
-  outQuat = QuaternionSlerp(bm.Quaternion[f0], bm.Quaternion[f1], t);
+  outQuat = MuMath::QuaternionSlerp(bm.Quaternion[f0], bm.Quaternion[f1], t);
   outPos = bm.Position[f0] * (1.0f - t) + bm.Position[f1] * t;
   return true;
 }
@@ -318,7 +340,7 @@ void ComputeBoneMatricesBlended(const BMDData *bmd, int action1, float frame1,
 
     if (v1 && v2) {
       posInterp = pos1 * (1.0f - blendAlpha) + pos2 * blendAlpha;
-      qInterp = QuaternionSlerp(q1, q2, blendAlpha);
+      qInterp = MuMath::QuaternionSlerp(q1, q2, blendAlpha);
     } else if (v1) {
       posInterp = pos1;
       qInterp = q1;
@@ -87,6 +87,7 @@ void BoidManager::alphaFade(float &alpha, float target, float dt) {
 void BoidManager::Init(const std::string &dataPath) {
   // Load shaders (same as NPC/Monster managers)
   m_shader = Shader::Load("vs_model.bin", "fs_model.bin");
+  m_skinnedShader = Shader::Load("vs_skinned.bin", "fs_model.bin");
   m_shadowShader = Shader::Load("vs_shadow.bin", "fs_shadow.bin");
 
   // Load bird model: Data/Object1/Bird01.bmd + bird.ozt
@@ -94,11 +95,12 @@ void BoidManager::Init(const std::string &dataPath) {
   auto birdBmd = BMDParser::Parse(birdPath);
   if (birdBmd) {
     m_birdBmd = std::move(birdBmd);
+    m_birdTracks.Init(m_birdBmd.get());
     std::string texDir = dataPath + "/Object1/";
     m_birdBones = ComputeBoneMatrices(m_birdBmd.get());
     AABB aabb{};
     for (auto &mesh : m_birdBmd->Meshes) {
-      UploadMeshWithBones(mesh, texDir, m_birdBones, m_birdMeshes, aabb, true);
+      UploadSkinnedMesh(mesh, texDir, m_birdBones, m_birdMeshes, aabb);
     }
 
     // Create shadow buffer (shared, re-uploaded per instance)
@@ -126,11 +128,12 @@ void BoidManager::Init(const std::string &dataPath) {
   auto batBmd = BMDParser::Parse(batPath);
   if (batBmd) {
     m_batBmd = std::move(batBmd);
+    m_batTracks.Init(m_batBmd.get());
     std::string texDir = dataPath + "/Object2/";
     m_batBones = ComputeBoneMatrices(m_batBmd.get());
     AABB aabb{};
     for (auto &mesh : m_batBmd->Meshes) {
-      UploadMeshWithBones(mesh, texDir, m_batBones, m_batMeshes, aabb, true);
+      UploadSkinnedMesh(mesh, texDir, m_batBones, m_batMeshes, aabb);
     }
 
     // Create shadow buffer
@@ -160,11 +163,12 @@ void BoidManager::Init(const std::string &dataPath) {
   auto fishBmd = BMDParser::Parse(fishPath);
   if (fishBmd) {
     m_fishBmd = std::move(fishBmd);
+    m_fishTracks.Init(m_fishBmd.get());
     std::string texDir = dataPath + "/Object1/";
     m_fishBones = ComputeBoneMatrices(m_fishBmd.get());
     AABB aabb{};
     for (auto &mesh : m_fishBmd->Meshes) {
-      UploadMeshWithBones(mesh, texDir, m_fishBones, m_fishMeshes, aabb, true);
+      UploadSkinnedMesh(mesh, texDir, m_fishBones, m_fishMeshes, aabb);
     }
 
     // Create shadow buffer
@@ -194,11 +198,12 @@ void BoidManager::Init(const std::string &dataPath) {
   auto bflyBmd = BMDParser::Parse(bflyPath);
   if (bflyBmd) {
     m_butterflyBmd = std::move(bflyBmd);
+    m_butterflyTracks.Init(m_butterflyBmd.get());
     std::string texDir = dataPath + "/Object1/";
     m_butterflyBones = ComputeBoneMatrices(m_butterflyBmd.get());
     AABB aabb{};
     for (auto &mesh : m_butterflyBmd->Meshes) {
-      UploadMeshWithBones(mesh, texDir, m_butterflyBones, m_butterflyMeshes, aabb, true);
+      UploadSkinnedMesh(mesh, texDir, m_butterflyBones, m_butterflyMeshes, aabb);
     }
 
     // Create shadow buffer
@@ -1045,8 +1050,8 @@ void BoidManager::renderBoid(const Boid &b, const glm::mat4 &view,
   if (!b.live || b.alpha <= 0.001f || !m_birdBmd)
     return;
 
-  auto bones = ComputeBoneMatricesInterpolated(m_birdBmd.get(), b.action,
-                                                b.animFrame);
+  m_birdTracks.Sample(b.action, b.animFrame, m_pose);
+  const auto &bones = m_pose;
   for (int mi = 0; mi < (int)m_birdMeshes.size() && mi < (int)m_birdBmd->Meshes.size(); ++mi) {
     RetransformMeshWithBones(m_birdBmd->Meshes[mi], bones, m_birdMeshes[mi]);
   }
@@ -1062,9 +1067,7 @@ void BoidManager::renderBoid(const Boid &b, const glm::mat4 &view,
   for (auto &mb : m_birdMeshes) {
     if (mb.indexCount == 0 || mb.hidden) continue;
     bgfx::setTransform(glm::value_ptr(model));
-    if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-    else bgfx::setVertexBuffer(0, mb.vbo);
-    bgfx::setIndexBuffer(mb.ebo);
+    BindMesh(mb);
     m_shader->setTexture(0, "s_texColor", mb.texture);
     m_shader->setVec4("u_params", glm::vec4(b.alpha, 1.0f, 0.0f, 0.0f));
     m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -1081,7 +1084,7 @@ void BoidManager::renderBoid(const Boid &b, const glm::mat4 &view,
                    | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_MSAA
                    | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
   }
 }
 
@@ -1090,8 +1093,8 @@ void BoidManager::renderBat(const Boid &b, const glm::mat4 &view,
   if (!b.live || b.alpha <= 0.001f || !m_batBmd)
     return;
 
-  auto bones = ComputeBoneMatricesInterpolated(m_batBmd.get(), b.action,
-                                                b.animFrame);
+  m_batTracks.Sample(b.action, b.animFrame, m_pose);
+  const auto &bones = m_pose;
   for (int mi = 0; mi < (int)m_batMeshes.size() && mi < (int)m_batBmd->Meshes.size(); ++mi) {
     RetransformMeshWithBones(m_batBmd->Meshes[mi], bones, m_batMeshes[mi]);
   }
@@ -1106,9 +1109,7 @@ void BoidManager::renderBat(const Boid &b, const glm::mat4 &view,
   for (auto &mb : m_batMeshes) {
     if (mb.indexCount == 0 || mb.hidden) continue;
     bgfx::setTransform(glm::value_ptr(model));
-    if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-    else bgfx::setVertexBuffer(0, mb.vbo);
-    bgfx::setIndexBuffer(mb.ebo);
+    BindMesh(mb);
     m_shader->setTexture(0, "s_texColor", mb.texture);
     m_shader->setVec4("u_params", glm::vec4(b.alpha, 1.0f, 0.0f, 0.0f));
     m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -1125,7 +1126,7 @@ void BoidManager::renderBat(const Boid &b, const glm::mat4 &view,
                    | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_MSAA
                    | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
   }
 }
 
@@ -1134,8 +1135,8 @@ void BoidManager::renderButterfly(const Boid &b, const glm::mat4 &view,
   if (!b.live || b.alpha <= 0.001f || !m_butterflyBmd)
     return;
 
-  auto bones = ComputeBoneMatricesInterpolated(m_butterflyBmd.get(), b.action,
-                                                b.animFrame);
+  m_butterflyTracks.Sample(b.action, b.animFrame, m_pose);
+  const auto &bones = m_pose;
   for (int mi = 0; mi < (int)m_butterflyMeshes.size() && mi < (int)m_butterflyBmd->Meshes.size(); ++mi) {
     RetransformMeshWithBones(m_butterflyBmd->Meshes[mi], bones, m_butterflyMeshes[mi]);
   }
@@ -1150,9 +1151,7 @@ void BoidManager::renderButterfly(const Boid &b, const glm::mat4 &view,
   for (auto &mb : m_butterflyMeshes) {
     if (mb.indexCount == 0 || mb.hidden) continue;
     bgfx::setTransform(glm::value_ptr(model));
-    if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-    else bgfx::setVertexBuffer(0, mb.vbo);
-    bgfx::setIndexBuffer(mb.ebo);
+    BindMesh(mb);
     m_shader->setTexture(0, "s_texColor", mb.texture);
     m_shader->setVec4("u_params", glm::vec4(b.alpha, 1.0f, 0.0f, 0.0f));
     m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -1169,7 +1168,7 @@ void BoidManager::renderButterfly(const Boid &b, const glm::mat4 &view,
                    | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_MSAA
                    | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
   }
 }
 
@@ -1178,8 +1177,8 @@ void BoidManager::renderFish(const Fish &f, const glm::mat4 &view,
   if (!f.live || f.alpha <= 0.001f || !m_fishBmd)
     return;
 
-  auto bones = ComputeBoneMatricesInterpolated(m_fishBmd.get(), f.action,
-                                                f.animFrame);
+  m_fishTracks.Sample(f.action, f.animFrame, m_pose);
+  const auto &bones = m_pose;
   for (int mi = 0; mi < (int)m_fishMeshes.size() && mi < (int)m_fishBmd->Meshes.size(); ++mi) {
     RetransformMeshWithBones(m_fishBmd->Meshes[mi], bones, m_fishMeshes[mi]);
   }
@@ -1194,9 +1193,7 @@ void BoidManager::renderFish(const Fish &f, const glm::mat4 &view,
   for (auto &mb : m_fishMeshes) {
     if (mb.indexCount == 0 || mb.hidden) continue;
     bgfx::setTransform(glm::value_ptr(model));
-    if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-    else bgfx::setVertexBuffer(0, mb.vbo);
-    bgfx::setIndexBuffer(mb.ebo);
+    BindMesh(mb);
     m_shader->setTexture(0, "s_texColor", mb.texture);
     m_shader->setVec4("u_params", glm::vec4(f.alpha, 1.0f, 0.0f, 0.0f));
     m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -1213,13 +1210,13 @@ void BoidManager::renderFish(const Fish &f, const glm::mat4 &view,
                    | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_MSAA
                    | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
   }
 }
 
 void BoidManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
                           const glm::vec3 &camPos) {
-  if (!m_shader)
+  if (!m_shader || !m_skinnedShader)
     return;
 
   if (m_mapId == 0) {
@@ -1261,8 +1258,8 @@ void BoidManager::RenderShadows(const glm::mat4 &view, const glm::mat4 &proj) {
       if (!b.live || b.alpha <= 0.001f)
         continue;
 
-      auto bones = ComputeBoneMatricesInterpolated(m_birdBmd.get(), b.action,
-                                                    b.animFrame);
+      m_birdTracks.Sample(b.action, b.animFrame, m_pose);
+      const auto &bones = m_pose;
 
       glm::mat4 model = glm::translate(glm::mat4(1.0f), b.position);
       model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 0, 1));
@@ -1329,7 +1326,7 @@ void BoidManager::RenderShadows(const glm::mat4 &view, const glm::mat4 &proj) {
         bgfx::setVertexBuffer(0, m_birdShadow.vbo, 0, (uint32_t)shadowVerts.size());
         bgfx::setState(shadowState);
         bgfx::setStencil(shadowStencil);
-        bgfx::submit(0, m_shadowShader->program);
+        SubmitDraw(0, m_shadowShader->program);
       }
     }
   }
@@ -1341,8 +1338,8 @@ void BoidManager::RenderShadows(const glm::mat4 &view, const glm::mat4 &proj) {
       if (!f.live || f.alpha <= 0.001f)
         continue;
 
-      auto bones = ComputeBoneMatricesInterpolated(m_fishBmd.get(), f.action,
-                                                    f.animFrame);
+      m_fishTracks.Sample(f.action, f.animFrame, m_pose);
+      const auto &bones = m_pose;
 
       glm::mat4 model = glm::translate(glm::mat4(1.0f), f.position);
       model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 0, 1));
@@ -1409,7 +1406,7 @@ void BoidManager::RenderShadows(const glm::mat4 &view, const glm::mat4 &proj) {
         bgfx::setVertexBuffer(0, m_fishShadow.vbo, 0, (uint32_t)shadowVerts.size());
         bgfx::setState(shadowState);
         bgfx::setStencil(shadowStencil);
-        bgfx::submit(0, m_shadowShader->program);
+        SubmitDraw(0, m_shadowShader->program);
       }
     }
   }
@@ -1474,7 +1471,7 @@ void BoidManager::RenderLeaves(const glm::mat4 &view, const glm::mat4 &proj) {
                      | BGFX_STATE_DEPTH_TEST_LESS
                      | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
   bgfx::setState(leafState);
-  bgfx::submit(0, m_leafShader->program);
+  SubmitDraw(0, m_leafShader->program);
 }
 
 // ── Cleanup ──────────────────────────────────────────────────────────
@@ -1501,6 +1498,7 @@ void BoidManager::Cleanup() {
   m_batBmd.reset();
   m_fishBmd.reset();
   m_shader.reset();
+  m_skinnedShader.reset();
   m_shadowShader.reset();
   m_leafShader.reset();
 }
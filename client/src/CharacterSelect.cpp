@@ -495,7 +495,7 @@ static void RenderFaceToFBO() {
     bgfx::setIndexBuffer(mb.ebo);
     s_modelShader->setTexture(0, "s_texColor", mb.texture);
     bgfx::setState(state);
-    bgfx::submit(FACE_VIEW_ID, s_modelShader->program);
+    SubmitDraw(FACE_VIEW_ID, s_modelShader->program);
   }
   s_faceRendered = true;
 }
@@ -1608,7 +1608,7 @@ void Render(int windowWidth, int windowHeight) {
           else bgfx::setVertexBuffer(0, mb.vbo);
           bgfx::setIndexBuffer(mb.ebo);
           bgfx::setState(depthState);
-          bgfx::submit(CS_SHADOW_VIEW, s_depthShader->program);
+          SubmitDraw(CS_SHADOW_VIEW, s_depthShader->program);
           shadowDraws++;
         }
       };
@@ -1678,7 +1678,7 @@ void Render(int windowWidth, int windowHeight) {
     bgfx::setIndexBuffer(s_spotEBO);
     s_spotlightShader->setTexture(0, "s_texColor", s_spotlightTex);
     bgfx::setState(spotState);
-    bgfx::submit(0, s_spotlightShader->program);
+    SubmitDraw(0, s_spotlightShader->program);
 
     // Inner cylinder (brighter core, scaled 0.6)
     glm::mat4 innerModel = glm::translate(glm::mat4(1.0f),
@@ -1691,7 +1691,7 @@ void Render(int windowWidth, int windowHeight) {
     bgfx::setIndexBuffer(s_spotEBO);
     s_spotlightShader->setTexture(0, "s_texColor", s_spotlightTex);
     bgfx::setState(spotState);
-    bgfx::submit(0, s_spotlightShader->program);
+    SubmitDraw(0, s_spotlightShader->program);
   }
 
   // ── Character models ──
@@ -1774,7 +1774,7 @@ void Render(int windowWidth, int windowHeight) {
         if (bgfx::isValid(s_shadowColorTex))
           s_modelShader->setTexture(1, "s_shadowMap", s_shadowColorTex);
         bgfx::setState(state);
-        bgfx::submit(0, s_modelShader->program);
+        SubmitDraw(0, s_modelShader->program);
       };
 
       // Body parts
@@ -1867,7 +1867,7 @@ void Render(int windowWidth, int windowHeight) {
                 else bgfx::setVertexBuffer(0, mb.vbo);
                 bgfx::setIndexBuffer(mb.ebo);
                 bgfx::setState(stAdd);
-                bgfx::submit(0, s_modelShader->program);
+                SubmitDraw(0, s_modelShader->program);
               }
             }
           }
@@ -1892,7 +1892,7 @@ void Render(int windowWidth, int windowHeight) {
                 else bgfx::setVertexBuffer(0, mb.vbo);
                 bgfx::setIndexBuffer(mb.ebo);
                 bgfx::setState(stAdd);
-                bgfx::submit(0, s_modelShader->program);
+                SubmitDraw(0, s_modelShader->program);
                 wmi++;
               }
             }
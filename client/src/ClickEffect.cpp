@@ -185,7 +185,7 @@ void ClickEffect::Render(const glm::mat4 &view, const glm::mat4 &proj,
     shader->setVec4("u_fogParams", glm::vec4(0.0f));
     shader->setVec4("u_fogColor", glm::vec4(0.0f));
     bgfx::setState(groundState);
-    bgfx::submit(0, shader->program);
+    SubmitDraw(0, shader->program);
   };
 
   // Pass 1: Ground glow (Magic_Ground1)
@@ -236,7 +236,7 @@ void ClickEffect::Render(const glm::mat4 &view, const glm::mat4 &proj,
     shader->setVec4("u_fogParams", glm::vec4(0.0f));
     shader->setVec4("u_fogColor", glm::vec4(0.0f));
     bgfx::setState(groundState);
-    bgfx::submit(0, shader->program);
+    SubmitDraw(0, shader->program);
   }
 }
 
@@ -1023,6 +1023,55 @@ void HandleGamePacket(const uint8_t *pkt, int pktSize) {
       }
     }
 
+    // Character stats delta (vitals/XP changed this server tick)
+    if (headcode == Opcode::CHARSTATS_DELTA &&
+        pktSize >= (int)sizeof(PMSG_CHARSTATS_DELTA_HEAD)) {
+      auto *head = reinterpret_cast<const PMSG_CHARSTATS_DELTA_HEAD *>(pkt);
+      int off = sizeof(PMSG_CHARSTATS_DELTA_HEAD);
+      auto read16 = [&](uint16_t bit, int *dst) {
+        if (!(head->fields & bit) || off + 2 > pktSize)
+          return;
+        uint16_t v;
+        memcpy(&v, pkt + off, 2);
+        off += 2;
+        if (dst)
+          *dst = v;
+      };
+      int oldHP = *g_state->serverHP;
+      // Bit order = wire order
+      read16(STATS_HP, g_state->serverHP);
+      read16(STATS_MAX_HP, g_state->serverMaxHP);
+      read16(STATS_MANA, g_state->serverMP);
+      read16(STATS_MAX_MANA, g_state->serverMaxMP);
+      read16(STATS_AG, g_state->serverAG);
+      read16(STATS_MAX_AG, g_state->serverMaxAG);
+      if ((head->fields & STATS_XP) && off + 8 <= pktSize) {
+        uint64_t xp;
+        memcpy(&xp, pkt + off, 8);
+        *g_state->serverXP = (int64_t)xp;
+      }
+
+      g_state->hero->LoadStats(
+          *g_state->serverLevel, *g_state->serverStr, *g_state->serverDex,
+          *g_state->serverVit, *g_state->serverEne,
+          (uint64_t)*g_state->serverXP, *g_state->serverLevelUpPoints,
+          *g_state->serverHP, *g_state->serverMaxHP, *g_state->serverMP,
+          *g_state->serverMaxMP,
+          g_state->serverAG ? *g_state->serverAG : g_state->hero->GetAG(),
+          g_state->serverMaxAG ? *g_state->serverMaxAG
+                               : g_state->hero->GetMaxAG(),
+          g_state->hero->GetClass());
+
+      // Floating heal text if HP increased
+      if (*g_state->serverHP > oldHP && oldHP > 0) {
+        int healed = *g_state->serverHP - oldHP;
+        if (g_state->spawnDamageNumber)
+          g_state->spawnDamageNumber(g_state->hero->GetPosition(), healed, 10);
+        SystemMessageLog::Log(MSG_COMBAT, IM_COL32(80, 255, 80, 255),
+                              "Restored %d HP", healed);
+      }
+    }
+
     // Shop Buy Result
     if (headcode == Opcode::SHOP_BUY_RESULT &&
         pktSize >= (int)sizeof(PMSG_SHOP_BUY_RESULT_SEND)) {
@@ -324,7 +324,7 @@ void FireEffect::submitBatch(const std::vector<InstanceData> &batch,
                  | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA,
                                          BGFX_STATE_BLEND_ONE);
   bgfx::setState(state);
-  bgfx::submit(0, billboardShader->program);
+  SubmitDraw(0, billboardShader->program);
 }
 
 void FireEffect::Render(const glm::mat4 &view, const glm::mat4 &projection) {
@@ -0,0 +1,103 @@
+#include "FrameProfiler.hpp"
+#include "Shader.hpp"
+#include <algorithm>
+#include <cstdio>
+
+static float ElapsedMs(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration<float, std::milli>(
+             std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+// ─── Scope ───
+
+FrameProfiler::Scope::Scope(FrameProfiler *profiler, const char *name)
+    : m_profiler(profiler && profiler->m_inFrame ? profiler : nullptr) {
+  if (!m_profiler)
+    return;
+  m_section = m_profiler->SectionIndex(name);
+  m_draws = g_submittedDraws;
+  m_start = std::chrono::steady_clock::now();
+}
+
+FrameProfiler::Scope::~Scope() {
+  if (m_profiler)
+    m_profiler->Add(m_section, ElapsedMs(m_start),
+                    g_submittedDraws - m_draws);
+}
+
+void FrameProfiler::Scope::Next(const char *name) {
+  if (!m_profiler)
+    return;
+  m_profiler->Add(m_section, ElapsedMs(m_start), g_submittedDraws - m_draws);
+  m_section = m_profiler->SectionIndex(name);
+  m_draws = g_submittedDraws;
+  m_start = std::chrono::steady_clock::now();
+}
+
+// ─── Frames ───
+
+int FrameProfiler::SectionIndex(const char *name) {
+  for (int i = 0; i < (int)m_sections.size(); ++i)
+    if (m_sections[i].name == name)
+      return i;
+  // First seen mid-run: earlier frames spent nothing in it
+  Section s;
+  s.name = name;
+  s.ms.assign(m_frameMs.size() + 1, 0.0f);
+  s.draws.assign(m_frameMs.size() + 1, 0);
+  m_sections.push_back(std::move(s));
+  return (int)m_sections.size() - 1;
+}
+
+void FrameProfiler::Add(int section, float ms, uint32_t draws) {
+  Section &s = m_sections[section];
+  s.ms.back() += ms;
+  s.draws.back() += draws;
+}
+
+void FrameProfiler::BeginFrame() {
+  for (auto &s : m_sections) {
+    s.ms.push_back(0.0f);
+    s.draws.push_back(0);
+  }
+  m_frameStart = std::chrono::steady_clock::now();
+  m_frameStartDraws = g_submittedDraws;
+  m_inFrame = true;
+}
+
+void FrameProfiler::EndFrame() {
+  if (!m_inFrame)
+    return;
+  m_frameMs.push_back(ElapsedMs(m_frameStart));
+  m_frameDraws.push_back(g_submittedDraws - m_frameStartDraws);
+  m_inFrame = false;
+}
+
+// ─── Report ───
+
+static void PrintRow(const char *name, std::vector<float> ms,
+                     const std::vector<uint32_t> &draws, size_t frames) {
+  ms.resize(frames);
+  double sumMs = 0.0, sumDraws = 0.0;
+  for (size_t i = 0; i < frames; ++i) {
+    sumMs += ms[i];
+    sumDraws += draws[i];
+  }
+  std::sort(ms.begin(), ms.end());
+  auto pct = [&](double p) { return ms[(size_t)(p * (frames - 1))]; };
+  printf("  %-16s %8.3f %8.3f %8.3f %8.3f %10.1f\n", name, sumMs / frames,
+         pct(0.50), pct(0.99), ms.back(), sumDraws / frames);
+}
+
+void FrameProfiler::Report(const char *title) const {
+  size_t frames = m_frameMs.size();
+  printf("[Bench] %s: %zu frames\n", title, frames);
+  if (frames == 0)
+    return;
+  printf("  %-16s %8s %8s %8s %8s %10s\n", "section", "avg ms", "p50",
+         "p99", "max", "draws/frm");
+  for (const auto &s : m_sections)
+    PrintRow(s.name, s.ms, s.draws, frames);
+  PrintRow("frame total", m_frameMs, m_frameDraws, frames);
+}
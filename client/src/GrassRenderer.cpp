@@ -295,7 +295,7 @@ void GrassRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
 
   bgfx::setVertexBuffer(0, vbo);
   bgfx::setIndexBuffer(ebo);
-  bgfx::submit(0, shader->program);
+  SubmitDraw(0, shader->program);
 }
 
 void GrassRenderer::Cleanup() {
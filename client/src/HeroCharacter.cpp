@@ -504,8 +504,8 @@ void HeroCharacter::Init(const std::string &dataPath) {
     }
 
     for (auto &mesh : bmd->Meshes) {
-      UploadMeshWithBones(mesh, playerPath, bones, m_parts[p].meshBuffers,
-                          totalAABB, true);
+      UploadSkinnedMesh(mesh, playerPath, bones, m_parts[p].meshBuffers,
+                        totalAABB);
     }
     m_parts[p].shadowMeshes = createShadowMeshes(bmd.get());
     m_parts[p].bmd = std::move(bmd);
@@ -514,6 +514,7 @@ void HeroCharacter::Init(const std::string &dataPath) {
 
   // Create shader (same model.vert/frag as ObjectRenderer)
   m_shader = Shader::Load("vs_model.bin", "fs_model.bin");
+  m_skinnedShader = Shader::Load("vs_skinned.bin", "fs_model.bin");
 
   // Cache root bone index and log walk animation info
   if (m_skeleton) {
@@ -554,7 +555,7 @@ void HeroCharacter::Init(const std::string &dataPath) {
 
 void HeroCharacter::Render(const glm::mat4 &view, const glm::mat4 &proj,
                            const glm::vec3 &camPos, float deltaTime) {
-  if (!m_skeleton || !m_shader)
+  if (!m_skeleton || !m_shader || !m_skinnedShader)
     return;
 
   m_weaponTrailValid = false; // Reset each frame
@@ -882,14 +883,12 @@ void HeroCharacter::Render(const glm::mat4 &view, const glm::mat4 &proj,
   // BGFX draw helper
   auto bgfxDrawMesh = [&](MeshBuffers &mb, uint64_t state) {
     bgfx::setTransform(glm::value_ptr(model));
-    if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-    else bgfx::setVertexBuffer(0, mb.vbo);
-    bgfx::setIndexBuffer(mb.ebo);
+    BindMesh(mb);
     m_shader->setTexture(0, "s_texColor", mb.texture);
     if (bgfx::isValid(m_shadowMapTex))
       m_shader->setTexture(1, "s_shadowMap", m_shadowMapTex);
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
   };
 
   uint64_t stateAlpha = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z
@@ -965,12 +964,10 @@ void HeroCharacter::Render(const glm::mat4 &view, const glm::mat4 &proj,
             if (mb.indexCount == 0 || mb.hidden) continue;
             setHeroUniforms(1.0f, (float)passes[gp].chromeMode, t, passes[gp].color);
             bgfx::setTransform(glm::value_ptr(model));
-            if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-            else bgfx::setVertexBuffer(0, mb.vbo);
-            bgfx::setIndexBuffer(mb.ebo);
+            BindMesh(mb);
             m_shader->setTexture(0, "s_texColor", passes[gp].texture);
             bgfx::setState(stateAdditive);
-            bgfx::submit(0, m_shader->program);
+            SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
           }
         }
       }
@@ -1126,12 +1123,10 @@ void HeroCharacter::Render(const glm::mat4 &view, const glm::mat4 &proj,
           if (m_weaponBlendMesh >= 0 && mi2 == m_weaponBlendMesh) continue;
           setHeroUniforms(1.0f, (float)passes[gp].chromeMode, t, passes[gp].color);
           bgfx::setTransform(glm::value_ptr(model));
-          if (mb2.isDynamic) bgfx::setVertexBuffer(0, mb2.dynVbo);
-          else bgfx::setVertexBuffer(0, mb2.vbo);
-          bgfx::setIndexBuffer(mb2.ebo);
+          BindMesh(mb2);
           m_shader->setTexture(0, "s_texColor", passes[gp].texture);
           bgfx::setState(stateAdditive);
-          bgfx::submit(0, m_shader->program);
+          SubmitDraw(0, (mb2.isSkinned ? m_skinnedShader : m_shader)->program);
         }
       }
     }
@@ -1215,12 +1210,10 @@ void HeroCharacter::Render(const glm::mat4 &view, const glm::mat4 &proj,
             if (mb.indexCount == 0) continue;
             setHeroUniforms(1.0f, (float)passes[gp].chromeMode, t, passes[gp].color);
             bgfx::setTransform(glm::value_ptr(model));
-            if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-            else bgfx::setVertexBuffer(0, mb.vbo);
-            bgfx::setIndexBuffer(mb.ebo);
+            BindMesh(mb);
             m_shader->setTexture(0, "s_texColor", passes[gp].texture);
             bgfx::setState(stateAdditive);
-            bgfx::submit(0, m_shader->program);
+            SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
           }
         }
       }
@@ -1444,13 +1437,11 @@ void HeroCharacter::Render(const glm::mat4 &view, const glm::mat4 &proj,
       for (auto &mb : m_ghostWeaponMeshBuffers) {
         if (mb.indexCount == 0) continue;
         bgfx::setTransform(glm::value_ptr(ghostModel));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         m_shader->setTexture(0, "s_texColor", mb.texture);
         setHeroUniforms(1.0f, 0.0f, 0.0f, glm::vec3(0.0f), glm::vec3(1.0f), g.alpha);
         bgfx::setState(ghostState);
-        bgfx::submit(0, m_shader->program);
+        SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
       }
     }
 
@@ -1600,7 +1591,7 @@ void HeroCharacter::RenderShadow(const glm::mat4 &view, const glm::mat4 &proj) {
         bgfx::setVertexBuffer(0, sm.vbo, 0, (uint32_t)shadowVerts.size());
         bgfx::setState(shadowState);
         bgfx::setStencil(shadowStencil);
-        bgfx::submit(0, m_shadowShader->program);
+        SubmitDraw(0, m_shadowShader->program);
       }
     }
   };
@@ -1762,7 +1753,7 @@ void HeroCharacter::RenderShadow(const glm::mat4 &view, const glm::mat4 &proj) {
         bgfx::setVertexBuffer(0, sm.vbo, 0, (uint32_t)shadowVerts.size());
         bgfx::setState(shadowState);
         bgfx::setStencil(shadowStencil);
-        bgfx::submit(0, m_shadowShader->program);
+        SubmitDraw(0, m_shadowShader->program);
       }
     }
   }
@@ -1774,7 +1765,8 @@ void HeroCharacter::SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &light
   m_lightMtx = lightMtx;
 }
 
-void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram) {
+void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                                      bgfx::ProgramHandle skinnedDepthProgram) {
   if (!m_skeleton || m_cachedBones.empty())
     return;
 
@@ -1784,8 +1776,10 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
   model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 1, 0));
   model = glm::rotate(model, m_facing, glm::vec3(0, 0, 1));
 
+  // BLEND_MIN: objects in the static layer may be nearer the light
   uint64_t state = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z
-                 | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CCW;
+                 | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CCW
+                 | BGFX_STATE_BLEND_MIN;
 
   // Submit body parts
   for (int p = 0; p < PART_COUNT; ++p) {
@@ -1793,11 +1787,9 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
     for (auto &mb : m_parts[p].meshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
   // Base head (accessory helms)
@@ -1805,11 +1797,9 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
     for (auto &mb : m_baseHead.meshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
   // Weapon
@@ -1817,11 +1807,9 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
     for (auto &mb : m_weaponMeshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
   // Shield
@@ -1829,11 +1817,9 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
     for (auto &mb : m_shieldMeshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
   // Wings
@@ -1841,11 +1827,9 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
     for (auto &mb : m_wingMeshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
   // Mount
@@ -1853,11 +1837,9 @@ void HeroCharacter::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthP
     for (auto &mb : m_mount.meshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
 }
@@ -1866,7 +1848,20 @@ void HeroCharacter::ProcessMovement(float deltaTime) {
   if (!m_terrainData || !m_moving || IsDead())
     return;
 
-  glm::vec3 dir = m_target - m_pos;
+  // Walk the route cell centre by cell centre, like the server's simulation;
+  // the last cell is walked to the exact target
+  glm::vec3 goal = m_target;
+  while (m_routeStep + 1 < m_route.size()) {
+    const GridPoint &cell = m_route[m_routeStep];
+    glm::vec3 centre((cell.y + 0.5f) * 100.0f, m_pos.y, (cell.x + 0.5f) * 100.0f);
+    if (glm::length(glm::vec2(centre.x - m_pos.x, centre.z - m_pos.z)) >= 10.0f) {
+      goal = centre;
+      break;
+    }
+    m_routeStep++;
+  }
+
+  glm::vec3 dir = goal - m_pos;
   dir.y = 0;
   float dist = glm::length(dir);
 
@@ -1928,6 +1923,26 @@ void HeroCharacter::MoveTo(const glm::vec3 &target) {
   if (m_sittingOrPosing)
     CancelSitPose();
   m_target = target;
+
+  // Route on the terrain grid (the same cells are sent to the server). Keep
+  // the current route while the destination cell is unchanged.
+  GridPoint from{(uint8_t)(m_pos.z / 100.0f), (uint8_t)(m_pos.x / 100.0f)};
+  GridPoint to{(uint8_t)(target.z / 100.0f), (uint8_t)(target.x / 100.0f)};
+  if (!m_moving || m_routeDest != to) {
+    m_route.clear();
+    m_routeStep = 0;
+    m_routeDest = to;
+    m_routeVersion++;
+    if (m_terrainData && !m_terrainData->mapping.attributes.empty() && from != to)
+      m_route = PathFinder().FindRoute(from, to,
+                                       m_terrainData->mapping.attributes.data(),
+                                       MAX_ROUTE, /*canEnterSafeZone=*/true);
+  }
+  // Destination out of reach: stop in the last cell the route gets to
+  if (!m_route.empty() && m_route.back() != to)
+    m_target = glm::vec3((m_route.back().y + 0.5f) * 100.0f, target.y,
+                         (m_route.back().x + 0.5f) * 100.0f);
+
   // Only reset walk animation if not already walking
   int walkAction = (isMountRiding() || (!m_inSafeZone && m_weaponBmd))
                        ? weaponWalkAction()
@@ -2061,15 +2076,15 @@ void HeroCharacter::EquipWeapon(const WeaponEquipInfo &weapon) {
 
   AABB weaponAABB{};
   for (auto &mesh : bmd->Meshes) {
-    UploadMeshWithBones(mesh, m_dataPath + "/Item/", {}, m_weaponMeshBuffers,
-                        weaponAABB, true);
+    UploadSkinnedMesh(mesh, m_dataPath + "/Item/", {}, m_weaponMeshBuffers,
+                      weaponAABB);
   }
 
   // Ghost weapon mesh buffers for Twisting Slash VFX (static bind-pose copy)
   AABB ghostAABB{};
   for (auto &mesh : bmd->Meshes) {
-    UploadMeshWithBones(mesh, m_dataPath + "/Item/", {}, m_ghostWeaponMeshBuffers,
-                        ghostAABB, true);
+    UploadSkinnedMesh(mesh, m_dataPath + "/Item/", {}, m_ghostWeaponMeshBuffers,
+                      ghostAABB);
   }
 
   // Shadow meshes for weapon
@@ -2196,8 +2211,8 @@ void HeroCharacter::EquipShield(const WeaponEquipInfo &shield) {
 
   CleanupMeshBuffers(m_shieldMeshBuffers);
   for (auto &mesh : m_shieldBmd->Meshes) {
-    UploadMeshWithBones(mesh, texPath, shieldBones, m_shieldMeshBuffers,
-                        shieldAABB, true);
+    UploadSkinnedMesh(mesh, texPath, shieldBones, m_shieldMeshBuffers,
+                      shieldAABB);
   }
 
   std::cout << "[Hero] Shield equipped: " << shield.modelFile << " ("
@@ -2267,8 +2282,8 @@ void HeroCharacter::EquipWings(const WeaponEquipInfo &wing) {
   // Re-upload with bones pre-applied
   CleanupMeshBuffers(m_wingMeshBuffers);
   for (auto &mesh : m_wingBmd->Meshes) {
-    UploadMeshWithBones(mesh, texPath, m_wingLocalBones, m_wingMeshBuffers,
-                        wingAABB, true);
+    UploadSkinnedMesh(mesh, texPath, m_wingLocalBones, m_wingMeshBuffers,
+                      wingAABB);
   }
 
   // Main 5.2: Wing05/06 (biped, >60 bones) use standard RENDER_TEXTURE —
@@ -2357,8 +2372,8 @@ void HeroCharacter::EquipBodyPart(int partIndex, const std::string &modelFile,
   AABB partAABB{};
 
   for (auto &mesh : bmd->Meshes) {
-    UploadMeshWithBones(mesh, m_dataPath + "/Player/", bones,
-                        m_parts[partIndex].meshBuffers, partAABB, true);
+    UploadSkinnedMesh(mesh, m_dataPath + "/Player/", bones,
+                      m_parts[partIndex].meshBuffers, partAABB);
   }
 
   // Shadow meshes for body part
@@ -2408,8 +2423,8 @@ void HeroCharacter::EquipBodyPart(int partIndex, const std::string &modelFile,
       if (headBmd) {
         AABB headAABB{};
         for (auto &mesh : headBmd->Meshes) {
-          UploadMeshWithBones(mesh, m_dataPath + "/Player/", bones,
-                              m_baseHead.meshBuffers, headAABB, true);
+          UploadSkinnedMesh(mesh, m_dataPath + "/Player/", bones,
+                            m_baseHead.meshBuffers, headAABB);
         }
         m_baseHead.shadowMeshes = createShadowMeshes(headBmd.get());
         m_baseHead.bmd = std::move(headBmd);
@@ -3522,6 +3537,7 @@ void HeroCharacter::Cleanup() {
   m_pet.active = false;
 
   m_shader.reset();
+  m_skinnedShader.reset();
   m_shadowShader.reset();
   m_skeleton.reset();
 }
@@ -148,9 +148,7 @@ void HeroCharacter::renderMountModel(const glm::mat4 &view, const glm::mat4 &pro
       // BGFX: per-submit uniforms and state
       auto mountDrawMesh = [&](MeshBuffers &mb, float bml, uint64_t state) {
         bgfx::setTransform(glm::value_ptr(mountModel));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         m_shader->setTexture(0, "s_texColor", mb.texture);
         m_shader->setVec4("u_params", glm::vec4(m_mount.alpha, bml, 0.0f, 0.0f));
         m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -160,7 +158,7 @@ void HeroCharacter::renderMountModel(const glm::mat4 &view, const glm::mat4 &pro
         m_shader->setVec4("u_fogParams", glm::vec4(0.0f));
         m_shader->setVec4("u_fogColor", glm::vec4(0.0f));
         bgfx::setState(state);
-        bgfx::submit(0, m_shader->program);
+        SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
       };
 
       uint64_t normalState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
@@ -277,8 +275,8 @@ void HeroCharacter::EquipMount(uint8_t itemIndex) {
   auto mountBones = ComputeBoneMatrices(bmd.get());
   for (int mi = 0; mi < (int)bmd->Meshes.size(); ++mi) {
     auto &mesh = bmd->Meshes[mi];
-    UploadMeshWithBones(mesh, texDir, mountBones,
-                        m_mount.meshBuffers, mountAABB, true);
+    UploadSkinnedMesh(mesh, texDir, mountBones,
+                      m_mount.meshBuffers, mountAABB);
 
     auto &mb = m_mount.meshBuffers.back();
     if (!TexValid(mb.texture)) {
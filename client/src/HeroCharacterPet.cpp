@@ -321,9 +321,7 @@ void HeroCharacter::renderPetCompanion(const glm::mat4 &view, const glm::mat4 &p
 
     auto petDrawMesh = [&](MeshBuffers &mb, float bml, uint64_t state) {
       bgfx::setTransform(glm::value_ptr(petModel));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       m_shader->setTexture(0, "s_texColor", mb.texture);
       m_shader->setVec4("u_params", glm::vec4(m_pet.alpha, bml, 0.0f, 0.0f));
       m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -333,7 +331,7 @@ void HeroCharacter::renderPetCompanion(const glm::mat4 &view, const glm::mat4 &p
       m_shader->setVec4("u_fogParams", glm::vec4(0.0f));
       m_shader->setVec4("u_fogColor", glm::vec4(0.0f));
       bgfx::setState(state);
-      bgfx::submit(0, m_shader->program);
+      SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
     };
 
     uint64_t normalState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
@@ -394,8 +392,8 @@ void HeroCharacter::EquipPet(uint8_t itemIndex) {
     auto &mesh = bmd->Meshes[mi];
 
     // Try Player/ first, then Item/ fallback for this specific mesh's texture
-    UploadMeshWithBones(mesh, m_dataPath + "/Player/", petBones,
-                        m_pet.meshBuffers, petAABB, true);
+    UploadSkinnedMesh(mesh, m_dataPath + "/Player/", petBones,
+                      m_pet.meshBuffers, petAABB);
 
     // Check if the just-uploaded mesh buffer got a valid texture
     auto &mb = m_pet.meshBuffers.back();
@@ -493,7 +493,7 @@ void ItemModelManager::RenderItemUI(const std::string &modelFile,
     shader->setVec4("u_shadowParams", glm::vec4(0.0f));
 
     bgfx::setState(state);
-    bgfx::submit(viewId, shader->program);
+    SubmitDraw(viewId, shader->program);
 
     if (isGlowMesh)
       blendLight = 1.0f;
@@ -544,7 +544,7 @@ void ItemModelManager::RenderItemUI(const std::string &modelFile,
                              | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE,
                                                       BGFX_STATE_BLEND_ONE);
           bgfx::setState(glowState);
-          bgfx::submit(viewId, shader->program);
+          SubmitDraw(viewId, shader->program);
         }
       }
     }
@@ -622,7 +622,7 @@ void ItemModelManager::RenderItemWorld(const std::string &filename,
     shader->setVec4("u_texCoordOffset", glm::vec4(0.0f));
 
     bgfx::setState(state);
-    bgfx::submit(0, shader->program);
+    SubmitDraw(0, shader->program);
   }
 }
 
@@ -739,6 +739,6 @@ void ItemModelManager::RenderItemWorldShadow(const std::string &filename,
     bgfx::setVertexBuffer(0, sm.vbo, 0, (uint32_t)shadowVerts.size());
     bgfx::setState(shadowState);
     bgfx::setStencil(shadowStencil);
-    bgfx::submit(0, s_shadowShader->program);
+    SubmitDraw(0, s_shadowShader->program);
   }
 }
@@ -0,0 +1,116 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <iostream>
+
+void JobSystem::Start(int workers) {
+  Stop();
+  if (workers < 0)
+    workers = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+  m_stop = false;
+  for (int i = 0; i < workers; ++i)
+    m_queues.push_back(std::make_unique<Queue>());
+  for (int i = 0; i < workers; ++i)
+    m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+  std::cout << "[Jobs] " << workers << " worker threads" << std::endl;
+}
+
+void JobSystem::Stop() {
+  if (m_workers.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto &t : m_workers)
+    t.join();
+  m_workers.clear();
+  m_queues.clear();
+}
+
+// ─── Queues ───
+
+bool JobSystem::PopOwn(int queue, Chunk &out) {
+  Queue &q = *m_queues[queue];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if (q.chunks.empty())
+    return false;
+  out = q.chunks.back();
+  q.chunks.pop_back();
+  m_queued--;
+  return true;
+}
+
+bool JobSystem::Steal(int thief, Chunk &out) {
+  int n = (int)m_queues.size();
+  for (int i = 1; i <= n; ++i) {
+    Queue &q = *m_queues[(thief + i) % n];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.chunks.empty())
+      continue;
+    out = q.chunks.front();
+    q.chunks.pop_front();
+    m_queued--;
+    return true;
+  }
+  return false;
+}
+
+void JobSystem::Run(const Chunk &chunk) {
+  (*chunk.batch->fn)(chunk.begin, chunk.end);
+  chunk.batch->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// ─── Workers ───
+
+void JobSystem::WorkerLoop(int index) {
+  for (;;) {
+    Chunk chunk;
+    if (PopOwn(index, chunk) || Steal(index, chunk)) {
+      Run(chunk);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_wake.wait(lock, [&] { return m_stop || m_queued > 0; });
+    if (m_stop)
+      return;
+  }
+}
+
+void JobSystem::ParallelFor(int count, int grain,
+                            const std::function<void(int, int)> &fn) {
+  if (count <= 0)
+    return;
+  grain = std::max(1, grain);
+  if (m_workers.empty() || count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  Batch batch;
+  batch.fn = &fn;
+  int chunks = (count + grain - 1) / grain;
+  batch.pending = chunks;
+  int n = (int)m_queues.size();
+  for (int c = 0; c < chunks; ++c) {
+    Queue &q = *m_queues[m_nextQueue++ % n];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.chunks.push_back({&batch, c * grain, std::min(count, (c + 1) * grain)});
+    m_queued++;
+  }
+  {
+    // Pairs with the predicate check in WorkerLoop so no wakeup is lost
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+  }
+  m_wake.notify_all();
+
+  // The caller steals too rather than idling; only chunks of this batch
+  // can be queued since ParallelFor is not reentrant from jobs
+  Chunk chunk;
+  while (batch.pending.load(std::memory_order_acquire) > 0) {
+    if (Steal(0, chunk))
+      Run(chunk);
+    else
+      std::this_thread::yield(); // Last chunks still running on workers
+  }
+}
@@ -174,8 +174,14 @@ void MonsterManager::InitModels(const std::string &dataPath) {
 
   // Create shaders (same as NPC — model.vert/frag, shadow.vert/frag)
   m_shader = Shader::Load("vs_model.bin", "fs_model.bin");
-  m_shadowShader = Shader::Load("vs_shadow.bin", "fs_shadow.bin");
+  m_skinnedShader = Shader::Load("vs_skinned.bin", "fs_model.bin");
+  m_shadowShader = Shader::Load("vs_shadow_planar.bin", "fs_shadow.bin");
+  m_skinnedShadowShader =
+      Shader::Load("vs_shadow_planar_skinned.bin", "fs_shadow.bin");
   m_outlineShader = Shader::Load("vs_outline.bin", "fs_outline.bin");
+  m_skinnedOutlineShader =
+      Shader::Load("vs_outline_skinned.bin", "fs_outline.bin");
+  m_crowdShader = Shader::Load("vs_skinned_crowd.bin", "fs_model.bin");
 
   // Bull Fighter: server type 0, Monster01.bmd (CreateMonsterClient: scale 0.8)
   // BBox: (-60,-60,0) to (50,50,150) — default
@@ -836,9 +842,102 @@ void MonsterManager::InitModels(const std::string &dataPath) {
   m_arrowModelIdx = loadMonsterModel("../Skill/Arrow01.bmd", "Arrow", 0.8f, 0,
                                      0, 0.0f, skillPath);
 
+  // Crowd animation textures for every model a server type can spawn
+  int crowdModels = 0;
+  for (auto &[type, idx] : m_typeToModel) {
+    if (idx < 0 || bgfx::isValid(m_models[idx].crowd.animTex))
+      continue;
+    bakeCrowd(m_models[idx]);
+    if (bgfx::isValid(m_models[idx].crowd.animTex))
+      crowdModels++;
+  }
+
   m_modelsLoaded = true;
-  std::cout << "[Monster] Models loaded: " << m_models.size() << " types"
-            << std::endl;
+  std::cout << "[Monster] Models loaded: " << m_models.size() << " types, "
+            << crowdModels << " crowd-baked" << std::endl;
+}
+
+// Bake the 7 monster actions of a model into its crowd animation texture.
+// Row r is one pose: bone b in texels 3b..3b+2 as RGBA32F BoneWorldMatrix
+// rows, with the LockPositions root correction of Render() already applied.
+// Rows are the AnimationTracks samples (SAMPLES_PER_KEY per key). The crowd
+// shader lerps the matrices of two rows where AnimationTracks::Sample()
+// slerps, then re-orthonormalizes the rotation; the rows are only a quarter
+// key apart, so the two stay close.
+// Models with weapons or a BlendMesh need per-instance work and are skipped,
+// as are meshes too large for GPU skinning.
+void MonsterManager::bakeCrowd(MonsterModel &mdl) {
+  const bgfx::Caps *caps = bgfx::getCaps();
+  if (!m_crowdShader || !(caps->supported & BGFX_CAPS_INSTANCING) ||
+      !(caps->formats[bgfx::TextureFormat::RGBA32F] &
+        BGFX_CAPS_FORMAT_TEXTURE_VERTEX))
+    return;
+  if (!mdl.weaponDefs.empty() || mdl.blendMesh >= 0)
+    return;
+
+  BMDData *animBmd = mdl.getAnimBmd();
+  int numBones = (int)animBmd->Bones.size();
+  auto &cb = mdl.crowd;
+  cb.width = numBones * 3;
+  cb.rows = 0;
+  for (int a = 0; a < 7; ++a) {
+    int mapped = mdl.actionMap[a];
+    int numKeys = 1;
+    if (mapped >= 0 && mapped < (int)animBmd->Actions.size())
+      numKeys = std::max(1, (int)animBmd->Actions[mapped].NumAnimationKeys);
+    cb.actionRow[a] = cb.rows;
+    cb.actionSamples[a] = numKeys * AnimationTracks::SAMPLES_PER_KEY;
+    cb.rows += cb.actionSamples[a];
+  }
+  int maxSize = (int)caps->limits.maxTextureSize;
+  if (numBones == 0 || cb.width > maxSize || cb.rows > maxSize)
+    return;
+
+  // Shared bind-pose meshes; every one must take the GPU skinning path
+  auto bindPose = ComputeBoneMatrices(mdl.bmd);
+  AABB aabb{};
+  for (auto &mesh : mdl.bmd->Meshes)
+    UploadSkinnedMesh(mesh, mdl.texDir, bindPose, cb.meshBuffers, aabb);
+  for (auto &mb : cb.meshBuffers) {
+    if (!mb.isSkinned) {
+      CleanupMeshBuffers(cb.meshBuffers);
+      return;
+    }
+  }
+
+  std::vector<float> texels((size_t)cb.width * cb.rows * 4);
+  std::vector<BoneWorldMatrix> bones;
+  for (int a = 0; a < 7; ++a) {
+    int mapped = mdl.actionMap[a];
+    bool lockPos = mapped >= 0 && mapped < (int)animBmd->Actions.size() &&
+                   animBmd->Actions[mapped].LockPositions;
+    for (int s = 0; s < cb.actionSamples[a]; ++s) {
+      ComputeBoneMatricesInterpolated(
+          animBmd, mapped, (float)s / AnimationTracks::SAMPLES_PER_KEY, bones);
+      if (lockPos && mdl.rootBone >= 0 && mdl.rootBone < (int)bones.size()) {
+        auto &bm = animBmd->Bones[mdl.rootBone].BoneMatrixes[mapped];
+        if (!bm.Position.empty()) {
+          float dx = bones[mdl.rootBone][0][3] - bm.Position[0].x;
+          float dy = bones[mdl.rootBone][1][3] - bm.Position[0].y;
+          for (auto &b : bones) {
+            b[0][3] -= dx;
+            b[1][3] -= dy;
+          }
+        }
+      }
+      float *row = &texels[(size_t)(cb.actionRow[a] + s) * cb.width * 4];
+      for (int b = 0; b < numBones && b < (int)bones.size(); ++b)
+        for (int r = 0; r < 3; ++r)
+          for (int c = 0; c < 4; ++c)
+            row[(b * 3 + r) * 4 + c] = bones[b][r][c];
+    }
+  }
+
+  cb.animTex = bgfx::createTexture2D(
+      (uint16_t)cb.width, (uint16_t)cb.rows, false, 1,
+      bgfx::TextureFormat::RGBA32F,
+      BGFX_SAMPLER_POINT | BGFX_SAMPLER_UVW_CLAMP,
+      bgfx::copy(texels.data(), (uint32_t)(texels.size() * sizeof(float))));
 }
 
 void MonsterManager::AddMonster(uint16_t monsterType, uint8_t gridX,
@@ -901,32 +1000,7 @@ void MonsterManager::AddMonster(uint16_t monsterType, uint8_t gridX,
   // Upload meshes (mesh data from bmd, bones from animBmd)
   AABB aabb{};
   for (auto &mesh : mdl.bmd->Meshes) {
-    UploadMeshWithBones(mesh, mdl.texDir, bones, mon.meshBuffers, aabb, true);
-  }
-
-  // Create shadow mesh buffers — sized for triangle-expanded vertices
-  for (int mi = 0;
-       mi < (int)mdl.bmd->Meshes.size() && mi < (int)mon.meshBuffers.size();
-       ++mi) {
-    auto &mesh = mdl.bmd->Meshes[mi];
-    MonsterInstance::ShadowMesh sm;
-    // Count actual shadow vertices: 3 per tri, 6 per quad
-    int shadowVertCount = 0;
-    for (int t = 0; t < mesh.NumTriangles; ++t) {
-      shadowVertCount += (mesh.Triangles[t].Polygon == 4) ? 6 : 3;
-    }
-    sm.vertexCount = shadowVertCount;
-    if (sm.vertexCount == 0) {
-      mon.shadowMeshes.push_back(sm);
-      continue;
-    }
-    bgfx::VertexLayout shadowLayout;
-    shadowLayout.begin()
-        .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-        .end();
-    sm.vbo = bgfx::createDynamicVertexBuffer(
-        sm.vertexCount, shadowLayout, BGFX_BUFFER_ALLOW_RESIZE);
-    mon.shadowMeshes.push_back(sm);
+    UploadSkinnedMesh(mesh, mdl.texDir, bones, mon.meshBuffers, aabb);
   }
 
   mon.hp = hp;
@@ -945,33 +1019,10 @@ void MonsterManager::AddMonster(uint16_t monsterType, uint8_t gridX,
     if (wd.bmd) {
       AABB wpnAABB{};
       for (auto &mesh : wd.bmd->Meshes) {
-        UploadMeshWithBones(mesh, wd.texDir, {}, wms.meshBuffers, wpnAABB,
-                            true);
+        UploadSkinnedMesh(mesh, wd.texDir, {}, wms.meshBuffers, wpnAABB);
       }
     }
     mon.weaponMeshes.push_back(std::move(wms));
-
-    // Create shadow meshes for this weapon
-    MonsterInstance::WeaponShadowSet wss;
-    if (wd.bmd) {
-      for (auto &mesh : wd.bmd->Meshes) {
-        MonsterInstance::ShadowMesh sm;
-        int shadowVertCount = 0;
-        for (int t = 0; t < mesh.NumTriangles; ++t)
-          shadowVertCount += (mesh.Triangles[t].Polygon == 4) ? 6 : 3;
-        sm.vertexCount = shadowVertCount;
-        if (sm.vertexCount > 0) {
-          bgfx::VertexLayout shadowLayout;
-          shadowLayout.begin()
-              .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-              .end();
-          sm.vbo = bgfx::createDynamicVertexBuffer(
-              sm.vertexCount, shadowLayout, BGFX_BUFFER_ALLOW_RESIZE);
-        }
-        wss.meshes.push_back(sm);
-      }
-    }
-    mon.weaponShadowMeshes.push_back(std::move(wss));
   }
 
   m_monsters.push_back(std::move(mon));
@@ -1579,14 +1630,6 @@ void MonsterManager::ClearMonsters() {
     CleanupMeshBuffers(mon.meshBuffers);
     for (auto &wms : mon.weaponMeshes)
       CleanupMeshBuffers(wms.meshBuffers);
-    for (auto &sm : mon.shadowMeshes) {
-      if (bgfx::isValid(sm.vbo)) bgfx::destroy(sm.vbo);
-    }
-    for (auto &wss : mon.weaponShadowMeshes) {
-      for (auto &sm : wss.meshes) {
-        if (bgfx::isValid(sm.vbo)) bgfx::destroy(sm.vbo);
-      }
-    }
   }
   m_monsters.clear();
   m_arrows.clear();
@@ -2271,20 +2314,23 @@ void MonsterManager::Cleanup() {
     CleanupMeshBuffers(mon.meshBuffers);
     for (auto &wms : mon.weaponMeshes)
       CleanupMeshBuffers(wms.meshBuffers);
-    for (auto &sm : mon.shadowMeshes) {
-      if (bgfx::isValid(sm.vbo)) bgfx::destroy(sm.vbo);
-    }
-    for (auto &wss : mon.weaponShadowMeshes) {
-      for (auto &sm : wss.meshes) {
-        if (bgfx::isValid(sm.vbo)) bgfx::destroy(sm.vbo);
-      }
-    }
   }
   m_monsters.clear();
   m_arrows.clear();
+  for (auto &mdl : m_models) {
+    if (bgfx::isValid(mdl.crowd.animTex))
+      bgfx::destroy(mdl.crowd.animTex);
+    CleanupMeshBuffers(mdl.crowd.meshBuffers);
+  }
   m_models.clear();
+  m_crowdBatches.clear();
   m_ownedBmds.clear();
   m_playerBmd.reset();
   m_shader.reset();
+  m_skinnedShader.reset();
+  m_crowdShader.reset();
   m_shadowShader.reset();
+  m_skinnedShadowShader.reset();
+  m_outlineShader.reset();
+  m_skinnedOutlineShader.reset();
 }
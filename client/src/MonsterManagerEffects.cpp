@@ -89,9 +89,7 @@ void MonsterManager::renderDebris(const glm::mat4 &view,
       auto &mb = mdl.meshBuffers[i];
       if (mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       m_shader->setTexture(0, "s_texColor", mb.texture);
       m_shader->setVec4("u_params", glm::vec4(alpha, 1.0f, 0.0f, 0.0f));
       m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -101,7 +99,7 @@ void MonsterManager::renderDebris(const glm::mat4 &view,
       m_shader->setVec4("u_fogParams", fogParams);
       m_shader->setVec4("u_fogColor", fogColor);
       bgfx::setState(normalState);
-      bgfx::submit(0, m_shader->program);
+      SubmitDraw(0, m_shader->program);
     }
   }
 }
@@ -181,9 +179,7 @@ void MonsterManager::renderArrows(const glm::mat4 &view,
       if (mb.indexCount == 0) continue;
       bool isGlowMesh = (mb.bmdTextureId == 1);
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       m_shader->setTexture(0, "s_texColor", mb.texture);
       m_shader->setVec4("u_params", glm::vec4(1.0f, 1.0f, 0.0f, 0.0f));
       m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -193,7 +189,7 @@ void MonsterManager::renderArrows(const glm::mat4 &view,
       m_shader->setVec4("u_fogParams", fogParams);
       m_shader->setVec4("u_fogColor", fogColor);
       bgfx::setState(isGlowMesh ? additiveState : normalState);
-      bgfx::submit(0, m_shader->program);
+      SubmitDraw(0, m_shader->program);
     }
   }
 }
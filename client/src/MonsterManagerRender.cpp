@@ -8,7 +8,7 @@
 
 void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
                             const glm::vec3 &camPos, float deltaTime) {
-  if (!m_shader || m_monsters.empty())
+  if (!m_shader || !m_skinnedShader || m_monsters.empty())
     return;
 
   // Extract frustum planes from VP matrix for culling
@@ -52,9 +52,7 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
                          float objAlpha, float bml, const glm::vec3 &tLight,
                          uint64_t state, const glm::vec3 &baseTint = glm::vec3(1.0f)) {
     bgfx::setTransform(glm::value_ptr(modelMat));
-    if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-    else bgfx::setVertexBuffer(0, mb.vbo);
-    bgfx::setIndexBuffer(mb.ebo);
+    BindMesh(mb);
     m_shader->setTexture(0, "s_texColor", mb.texture);
     m_shader->setVec4("u_params", glm::vec4(objAlpha, bml, 0.0f, 0.0f));
     m_shader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
@@ -76,7 +74,7 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
       m_shader->setTexture(1, "s_shadowMap", m_shadowMapTex);
     }
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
   };
 
   // Standard depth test (no prepass). Fire glow meshes are replaced by VFX
@@ -90,7 +88,11 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
   uint64_t noneBlendState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
                            | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS;
 
-  for (auto &mon : m_monsters) {
+  // Pass 1: frustum culling; the pose tracks are set up here since Init()
+  // must not race with Sample() on the job threads
+  m_visibleMonsters.clear();
+  for (int i = 0; i < (int)m_monsters.size(); ++i) {
+    auto &mon = m_monsters[i];
     // Skip fully faded corpses
     if (mon.state == MonsterState::DEAD && mon.corpseAlpha <= 0.01f)
       continue;
@@ -114,149 +116,27 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
         continue;
     }
 
-    // Advance animation (use animBmd + actionMap for skeleton types)
-    BMDData *animBmd = mdl.getAnimBmd();
-    int mappedAction = (mon.action >= 0 && mon.action < 7)
-                           ? mdl.actionMap[mon.action]
-                           : mon.action;
-    int numKeys = 1;
-    bool lockPos = false;
-    if (mappedAction >= 0 && mappedAction < (int)animBmd->Actions.size()) {
-      numKeys = animBmd->Actions[mappedAction].NumAnimationKeys;
-      lockPos = animBmd->Actions[mappedAction].LockPositions;
-    }
-    if (numKeys > 1) {
-      float animSpeed = getAnimSpeed(mon.monsterType, mon.action);
-
-      // Scale walk animation speed to match actual movement speed.
-      // refMoveSpeed = the speed the walk animation was designed for.
-      // MU Online MoveSpeed=400 means 400ms per grid cell = 100/0.4 = 250 u/s.
-      float refMoveSpeed = 250.0f;
-      // Skeleton types 14-16 use Player.bmd walk animation (stride at player speed)
-      if (mon.monsterType >= 14 && mon.monsterType <= 16)
-        refMoveSpeed = 334.0f;
-
-      if (mon.action == ACTION_WALK) {
-        bool isOwnSummon = (mon.serverIndex == m_ownSummonIndex &&
-                            m_ownSummonIndex != 0);
-        if (isOwnSummon && (mon.state == MonsterState::WALKING ||
-                            mon.state == MonsterState::IDLE)) {
-          // Scale walk anim to actual movement speed (spring-damper velocity)
-          float actualSpeed = glm::length(glm::vec2(m_summonVelocity.x, m_summonVelocity.z));
-          // For server-driven WALKING, use chase speed as baseline
-          if (mon.state == MonsterState::WALKING && actualSpeed < 10.0f)
-            actualSpeed = CHASE_SPEED;
-          if (actualSpeed > 10.0f)
-            animSpeed *= actualSpeed / refMoveSpeed;
-          else
-            animSpeed *= 0.5f; // Gentle idle sway when nearly stopped
-        } else if (mon.state == MonsterState::WALKING) {
-          animSpeed *= WANDER_SPEED / refMoveSpeed;
-        } else if (mon.state == MonsterState::CHASING) {
-          animSpeed *= CHASE_SPEED / refMoveSpeed;
-        }
-      }
-
-      mon.animFrame += animSpeed * deltaTime;
-
-      // Die and hit animations clamp at last frame (don't loop)
-      if (mon.state == MonsterState::DYING || mon.state == MonsterState::DEAD ||
-          mon.state == MonsterState::HIT) {
-        if (mon.animFrame >= (float)(numKeys - 1))
-          mon.animFrame = (float)(numKeys - 1);
-      } else {
-        // LockPositions actions wrap at numKeys-1 (last frame == first frame)
-        int wrapKeys = lockPos ? (numKeys - 1) : numKeys;
-        if (wrapKeys < 1)
-          wrapKeys = 1;
-        if (mon.animFrame >= (float)wrapKeys)
-          mon.animFrame = std::fmod(mon.animFrame, (float)wrapKeys);
-      }
-    }
-
-    // Advance blending Alpha
-    if (mon.isBlending) {
-      mon.blendAlpha += deltaTime / mon.BLEND_DURATION;
-      if (mon.blendAlpha >= 1.0f) {
-        mon.blendAlpha = 1.0f;
-        mon.isBlending = false;
-      }
-    }
-
-    // Compute bone matrices with blending support (animBmd for skeleton types)
-    int mappedPrior = (mon.priorAction >= 0 && mon.priorAction < 7)
-                          ? mdl.actionMap[mon.priorAction]
-                          : mon.priorAction;
-    // Reuse pre-allocated bone buffer (no heap alloc after first frame)
-    auto &bones = mon.cachedBones;
-    if (mon.isBlending && mon.priorAction != -1) {
-      ComputeBoneMatricesBlended(animBmd, mappedPrior,
-                                 mon.priorAnimFrame, mappedAction,
-                                 mon.animFrame, mon.blendAlpha, bones);
-    } else {
-      ComputeBoneMatricesInterpolated(animBmd, mappedAction, mon.animFrame,
-                                      bones);
-    }
-
-    // LockPositions: cancel root bone X/Y displacement to prevent animation
-    // from physically moving the model. In blending mode, we interpolate the
-    // offset.
-    if (mdl.rootBone >= 0) {
-      int rb = mdl.rootBone;
-      float dx = 0.0f, dy = 0.0f;
-
-      if (mon.isBlending && mon.priorAction != -1) {
-        bool lock1 = mappedPrior < (int)animBmd->Actions.size() &&
-                     animBmd->Actions[mappedPrior].LockPositions;
-        bool lock2 = mappedAction < (int)animBmd->Actions.size() &&
-                     animBmd->Actions[mappedAction].LockPositions;
-
-        float dx1 = 0.0f, dy1 = 0.0f, dx2 = 0.0f, dy2 = 0.0f;
-        if (lock1) {
-          auto &bm1 = animBmd->Bones[rb].BoneMatrixes[mappedPrior];
-          if (!bm1.Position.empty()) {
-            glm::vec3 p;
-            glm::vec4 q;
-            if (GetInterpolatedBoneData(animBmd, mappedPrior,
-                                        mon.priorAnimFrame, rb, p, q)) {
-              dx1 = p.x - bm1.Position[0].x;
-              dy1 = p.y - bm1.Position[0].y;
-            }
-          }
-        }
-        if (lock2) {
-          auto &bm2 = animBmd->Bones[rb].BoneMatrixes[mappedAction];
-          if (!bm2.Position.empty()) {
-            glm::vec3 p;
-            glm::vec4 q;
-            if (GetInterpolatedBoneData(animBmd, mappedAction, mon.animFrame,
-                                        rb, p, q)) {
-              dx2 = p.x - bm2.Position[0].x;
-              dy2 = p.y - bm2.Position[0].y;
-            }
-          }
-        }
-        dx = dx1 * (1.0f - mon.blendAlpha) + dx2 * mon.blendAlpha;
-        dy = dy1 * (1.0f - mon.blendAlpha) + dy2 * mon.blendAlpha;
-      } else if (mappedAction >= 0 &&
-                 mappedAction < (int)animBmd->Actions.size() &&
-                 animBmd->Actions[mappedAction].LockPositions) {
-        auto &bm = animBmd->Bones[rb].BoneMatrixes[mappedAction];
-        if (!bm.Position.empty()) {
-          dx = bones[rb][0][3] - bm.Position[0].x;
-          dy = bones[rb][1][3] - bm.Position[0].y;
-        }
-      }
-
-      if (dx != 0.0f || dy != 0.0f) {
-        for (int b = 0; b < (int)bones.size(); ++b) {
-          bones[b][0][3] -= dx;
-          bones[b][1][3] -= dy;
-        }
-      }
-    }
+    if (!mdl.tracks.IsValid())
+      mdl.tracks.Init(mdl.getAnimBmd());
+    m_visibleMonsters.push_back(i);
+  }
 
-    mon.cachedBones = bones;
+  // Pass 2: animation, bone matrices and bone palettes, in parallel
+  auto animate = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i)
+      animateMonster(m_monsters[m_visibleMonsters[i]], deltaTime);
+  };
+  if (m_jobs)
+    m_jobs->ParallelFor((int)m_visibleMonsters.size(), ANIM_JOB_GRAIN,
+                        animate);
+  else
+    animate(0, (int)m_visibleMonsters.size());
+
+  // Pass 3: VFX, CPU-skinned meshes and draws, on this thread in order
+  for (int monIdx : m_visibleMonsters) {
+    auto &mon = m_monsters[monIdx];
+    auto &mdl = m_models[mon.modelIdx];
+    const auto &bones = mon.cachedBones;
 
     // Monster ambient VFX (Main 5.2: MoveCharacterVisual)
     if (m_vfxManager && mon.state != MonsterState::DYING &&
@@ -483,12 +363,13 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
       }
     }
 
-    // Re-skin meshes
+    // Re-skin CPU-skinned meshes (vertex upload, so not in animateMonster)
     for (int mi = 0;
          mi < (int)mon.meshBuffers.size() && mi < (int)mdl.bmd->Meshes.size();
          ++mi) {
-      RetransformMeshWithBones(mdl.bmd->Meshes[mi], bones,
-                               mon.meshBuffers[mi]);
+      if (!mon.meshBuffers[mi].isSkinned)
+        RetransformMeshWithBones(mdl.bmd->Meshes[mi], bones,
+                                 mon.meshBuffers[mi]);
     }
 
     // Build model matrix
@@ -536,6 +417,39 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
     if (renderAlpha <= 0.0f)
       continue;
 
+    // Crowd path: queue the instance with its two baked rows around the
+    // frame (same sampling as AnimationTracks::Sample); blends stay per
+    // instance since they mix two actions. The palette re-skin above still
+    // serves the depth prepass, shadow map and outline.
+    if (m_crowdRendering && bgfx::isValid(mdl.crowd.animTex) &&
+        !(mon.isBlending && mon.priorAction != -1) && mon.action >= 0 &&
+        mon.action < 7) {
+      const auto &cb = mdl.crowd;
+      int n = cb.actionSamples[mon.action];
+      float f = mon.animFrame * (float)AnimationTracks::SAMPLES_PER_KEY;
+      float whole = std::floor(f);
+      int s0 = (int)whole % n;
+      if (s0 < 0)
+        s0 += n;
+      int s1 = (s0 + 1) % n;
+
+      CrowdBatch *batch = nullptr;
+      for (auto &b : m_crowdBatches)
+        if (b.modelIdx == mon.modelIdx && b.tint == monTint) {
+          batch = &b;
+          break;
+        }
+      if (!batch) {
+        m_crowdBatches.push_back({mon.modelIdx, monTint, {}});
+        batch = &m_crowdBatches.back();
+      }
+      batch->instances.push_back({model, tLight, renderAlpha,
+                                  (float)(cb.actionRow[mon.action] + s0),
+                                  (float)(cb.actionRow[mon.action] + s1),
+                                  f - whole});
+      continue;
+    }
+
     // BlendMesh UV scroll (Main 5.2: Lich — texCoordV scrolls over time)
     // -(float)((int)(WorldTime)%2000)*0.0005f
     bool hasBlendMesh = (mdl.blendMesh >= 0);
@@ -573,37 +487,20 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
       }
     }
 
-    // Draw weapons (skeleton types)
+    // Draw weapons (skeleton types), posed by animateMonster
     for (int wi = 0;
          wi < (int)mdl.weaponDefs.size() && wi < (int)mon.weaponMeshes.size();
          ++wi) {
       auto &wd = mdl.weaponDefs[wi];
       auto &wms = mon.weaponMeshes[wi];
-      if (!wd.bmd || wms.meshBuffers.empty())
-        continue;
-      if (wd.attachBone >= (int)bones.size())
+      if (!wd.bmd || wms.bones.empty())
         continue;
-
-      const auto &parentBone = bones[wd.attachBone];
-      BoneWorldMatrix weaponLocal =
-          MuMath::BuildWeaponOffsetMatrix(wd.rot, wd.offset);
-      BoneWorldMatrix parentMat;
-      MuMath::ConcatTransforms((const float(*)[4])parentBone.data(),
-                               (const float(*)[4])weaponLocal.data(),
-                               (float(*)[4])parentMat.data());
-      const auto &wLocalBones = wd.cachedLocalBones;
-      std::vector<BoneWorldMatrix> wFinalBones(wLocalBones.size());
-      for (int bi = 0; bi < (int)wLocalBones.size(); ++bi) {
-        MuMath::ConcatTransforms((const float(*)[4])parentMat.data(),
-                                 (const float(*)[4])wLocalBones[bi].data(),
-                                 (float(*)[4])wFinalBones[bi].data());
-      }
       for (int mi = 0;
            mi < (int)wms.meshBuffers.size() && mi < (int)wd.bmd->Meshes.size();
            ++mi) {
-        RetransformMeshWithBones(wd.bmd->Meshes[mi], wFinalBones,
-                                 wms.meshBuffers[mi]);
         auto &mb = wms.meshBuffers[mi];
+        if (!mb.isSkinned)
+          RetransformMeshWithBones(wd.bmd->Meshes[mi], wms.bones, mb);
         if (mb.indexCount == 0)
           continue;
         monDrawMesh(model, mb, renderAlpha, 1.0f, tLight, normalState);
@@ -611,71 +508,308 @@ void MonsterManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
     }
   }
 
-
+  renderCrowds(eye, fogParams, fogColor, plCount);
   renderDebris(view, proj, camPos);
   renderArrows(view, proj, camPos);
 }
 
-void MonsterManager::RenderShadows(const glm::mat4 &view,
-                                   const glm::mat4 &proj) {
-  if (!m_shadowShader || m_monsters.empty())
-    return;
+// One instanced submit per mesh of each crowd batch. Per-instance terrain
+// light and alpha ride in i_data4 (fs_model multiplies u_terrainLight by
+// it), so u_terrainLight only carries the per-mesh factor.
+void MonsterManager::renderCrowds(const glm::vec3 &eye,
+                                  const glm::vec4 &fogParams,
+                                  const glm::vec4 &fogColor, int plCount) {
+  static constexpr uint16_t stride = 80; // 5 x vec4
+
+  uint64_t normalState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
+                        | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS
+                        | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
+  uint64_t additiveState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
+                          | BGFX_STATE_DEPTH_TEST_LESS
+                          | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_ONE);
+  uint64_t noneBlendState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
+                           | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS;
+  float shadowEnabled = bgfx::isValid(m_shadowMapTex) ? 1.0f : 0.0f;
+
+  for (auto &batch : m_crowdBatches) {
+    if (batch.instances.empty())
+      continue;
+    auto &mdl = m_models[batch.modelIdx];
+    const auto &cb = mdl.crowd;
+
+    uint32_t count = (uint32_t)batch.instances.size();
+    uint32_t avail = bgfx::getAvailInstanceDataBuffer(count, stride);
+    if (avail == 0) {
+      batch.instances.clear();
+      continue;
+    }
+    count = std::min(count, avail);
+    bgfx::InstanceDataBuffer idb;
+    bgfx::allocInstanceDataBuffer(&idb, count, stride);
+    float *d = (float *)idb.data;
+    for (uint32_t i = 0; i < count; ++i) {
+      const auto &ci = batch.instances[i];
+      // i_data0-3: model matrix columns, animation rows in the w slots
+      for (int c = 0; c < 4; ++c) {
+        d[c * 4 + 0] = ci.model[c][0];
+        d[c * 4 + 1] = ci.model[c][1];
+        d[c * 4 + 2] = ci.model[c][2];
+      }
+      d[3] = ci.row0;
+      d[7] = ci.row1;
+      d[11] = ci.blend;
+      d[15] = 0.0f;
+      // i_data4: terrain light, alpha
+      d[16] = ci.light.x;
+      d[17] = ci.light.y;
+      d[18] = ci.light.z;
+      d[19] = ci.alpha;
+      d += stride / sizeof(float);
+    }
+
+    for (auto &mb : cb.meshBuffers) {
+      if (mb.indexCount == 0 || mb.hidden)
+        continue;
+      if (mdl.hiddenMesh >= 0 && mb.bmdTextureId == mdl.hiddenMesh)
+        continue;
+
+      uint64_t state = normalState;
+      float meshLight = 1.0f;
+      if (mb.noneBlend) {
+        state = noneBlendState;
+      } else if (mb.bright) {
+        state = additiveState;
+        meshLight = 0.5f;
+      }
+
+      bgfx::setVertexBuffer(0, mb.vbo);
+      bgfx::setIndexBuffer(mb.ebo);
+      bgfx::setInstanceDataBuffer(&idb);
+      m_crowdShader->setTexture(0, "s_texColor", mb.texture);
+      m_crowdShader->setTexture(4, "s_animTex", cb.animTex);
+      m_crowdShader->setVec4("u_animTexSize",
+                             glm::vec4(1.0f / cb.width, 1.0f / cb.rows, 0.0f, 0.0f));
+      m_crowdShader->setVec4("u_params", glm::vec4(1.0f, 1.0f, 0.0f, 0.0f));
+      m_crowdShader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f));
+      m_crowdShader->setVec4("u_viewPos", glm::vec4(eye, 0.0f));
+      m_crowdShader->setVec4("u_lightPos", glm::vec4(eye + glm::vec3(0, 500, 0), 0.0f));
+      m_crowdShader->setVec4("u_lightColor", glm::vec4(1.0f, 1.0f, 1.0f, 0.0f));
+      m_crowdShader->setVec4("u_terrainLight", glm::vec4(glm::vec3(meshLight), 0.0f));
+      m_crowdShader->setVec4("u_glowColor", glm::vec4(0.0f));
+      m_crowdShader->setVec4("u_baseTint", glm::vec4(batch.tint, 0.0f));
+      m_crowdShader->setVec4("u_fogParams", fogParams);
+      m_crowdShader->setVec4("u_fogColor", fogColor);
+      m_crowdShader->setVec4("u_texCoordOffset", glm::vec4(0.0f));
+      m_crowdShader->uploadPointLights(plCount, m_pointLights.data());
+      m_crowdShader->setVec4("u_shadowParams", glm::vec4(shadowEnabled, 0.0f, 0.0f, 0.0f));
+      if (shadowEnabled > 0.5f) {
+        m_crowdShader->setMat4("u_lightMtx", m_lightMtx);
+        m_crowdShader->setTexture(1, "s_shadowMap", m_shadowMapTex);
+      }
+      bgfx::setState(state);
+      SubmitDraw(0, m_crowdShader->program);
+    }
+    batch.instances.clear();
+  }
+}
+
+// Per-frame pose of one visible monster: advance its animation, compute the
+// bone matrices (mon.cachedBones) and the weapon bones, and fill the bone
+// palettes of its GPU-skinned meshes. Runs on job threads (see Render), so
+// it touches nothing but `mon` and read-only model data: no bgfx calls, no
+// VFX, no rand(). CPU-skinned fallback meshes are re-skinned in Render.
+void MonsterManager::animateMonster(MonsterInstance &mon, float deltaTime) {
+  auto &mdl = m_models[mon.modelIdx];
+
+  // Advance animation (use animBmd + actionMap for skeleton types)
+  BMDData *animBmd = mdl.getAnimBmd();
+  int mappedAction = (mon.action >= 0 && mon.action < 7)
+                         ? mdl.actionMap[mon.action]
+                         : mon.action;
+  int numKeys = 1;
+  bool lockPos = false;
+  if (mappedAction >= 0 && mappedAction < (int)animBmd->Actions.size()) {
+    numKeys = animBmd->Actions[mappedAction].NumAnimationKeys;
+    lockPos = animBmd->Actions[mappedAction].LockPositions;
+  }
+  if (numKeys > 1) {
+    float animSpeed = getAnimSpeed(mon.monsterType, mon.action);
+
+    // Scale walk animation speed to match actual movement speed.
+    // refMoveSpeed = the speed the walk animation was designed for.
+    // MU Online MoveSpeed=400 means 400ms per grid cell = 100/0.4 = 250 u/s.
+    float refMoveSpeed = 250.0f;
+    // Skeleton types 14-16 use Player.bmd walk animation (stride at player speed)
+    if (mon.monsterType >= 14 && mon.monsterType <= 16)
+      refMoveSpeed = 334.0f;
+
+    if (mon.action == ACTION_WALK) {
+      bool isOwnSummon = (mon.serverIndex == m_ownSummonIndex &&
+                          m_ownSummonIndex != 0);
+      if (isOwnSummon && (mon.state == MonsterState::WALKING ||
+                          mon.state == MonsterState::IDLE)) {
+        // Scale walk anim to actual movement speed (spring-damper velocity)
+        float actualSpeed = glm::length(glm::vec2(m_summonVelocity.x, m_summonVelocity.z));
+        // For server-driven WALKING, use chase speed as baseline
+        if (mon.state == MonsterState::WALKING && actualSpeed < 10.0f)
+          actualSpeed = CHASE_SPEED;
+        if (actualSpeed > 10.0f)
+          animSpeed *= actualSpeed / refMoveSpeed;
+        else
+          animSpeed *= 0.5f; // Gentle idle sway when nearly stopped
+      } else if (mon.state == MonsterState::WALKING) {
+        animSpeed *= WANDER_SPEED / refMoveSpeed;
+      } else if (mon.state == MonsterState::CHASING) {
+        animSpeed *= CHASE_SPEED / refMoveSpeed;
+      }
+    }
+
+    mon.animFrame += animSpeed * deltaTime;
+
+    // Die and hit animations clamp at last frame (don't loop)
+    if (mon.state == MonsterState::DYING || mon.state == MonsterState::DEAD ||
+        mon.state == MonsterState::HIT) {
+      if (mon.animFrame >= (float)(numKeys - 1))
+        mon.animFrame = (float)(numKeys - 1);
+    } else {
+      // LockPositions actions wrap at numKeys-1 (last frame == first frame)
+      int wrapKeys = lockPos ? (numKeys - 1) : numKeys;
+      if (wrapKeys < 1)
+        wrapKeys = 1;
+      if (mon.animFrame >= (float)wrapKeys)
+        mon.animFrame = std::fmod(mon.animFrame, (float)wrapKeys);
+    }
+  }
+
+  // Advance blending Alpha
+  if (mon.isBlending) {
+    mon.blendAlpha += deltaTime / mon.BLEND_DURATION;
+    if (mon.blendAlpha >= 1.0f) {
+      mon.blendAlpha = 1.0f;
+      mon.isBlending = false;
+    }
+  }
+
+  // Compute bone matrices with blending support (animBmd for skeleton types)
+  int mappedPrior = (mon.priorAction >= 0 && mon.priorAction < 7)
+                        ? mdl.actionMap[mon.priorAction]
+                        : mon.priorAction;
+  // Reuse pre-allocated bone buffer (no heap alloc after first frame)
+  auto &bones = mon.cachedBones;
+  if (mon.isBlending && mon.priorAction != -1) {
+    ComputeBoneMatricesBlended(animBmd, mappedPrior,
+                               mon.priorAnimFrame, mappedAction,
+                               mon.animFrame, mon.blendAlpha, bones);
+  } else {
+    mdl.tracks.Sample(mappedAction, mon.animFrame, bones);
+  }
+
+  // LockPositions: cancel root bone X/Y displacement to prevent animation
+  // from physically moving the model. In blending mode, we interpolate the
+  // offset.
+  if (mdl.rootBone >= 0) {
+    int rb = mdl.rootBone;
+    float dx = 0.0f, dy = 0.0f;
 
-  const float sx = 2000.0f;
-  const float sy = 4000.0f;
-
-  // Lambda: project shadow vertices for a mesh using cached bones
-  auto buildShadowVerts = [&](const Mesh_t &mesh,
-                              const std::vector<BoneWorldMatrix> &cachedBones,
-                              float scale, float cosF, float sinF,
-                              std::vector<glm::vec3> &out) {
-    out.clear();
-    for (int i = 0; i < mesh.NumTriangles; ++i) {
-      auto &tri = mesh.Triangles[i];
-      int steps = (tri.Polygon == 3) ? 3 : 4;
-      for (int v = 0; v < 3; ++v) {
-        auto &srcVert = mesh.Vertices[tri.VertexIndex[v]];
-        glm::vec3 pos = srcVert.Position;
-        int boneIdx = srcVert.Node;
-        if (boneIdx >= 0 && boneIdx < (int)cachedBones.size())
-          pos = MuMath::TransformPoint(
-              (const float(*)[4])cachedBones[boneIdx].data(), pos);
-        pos *= scale;
-        float rx = pos.x * cosF - pos.y * sinF;
-        float ry = pos.x * sinF + pos.y * cosF;
-        pos.x = rx; pos.y = ry;
-        if (pos.z < sy) {
-          float factor = 1.0f / (pos.z - sy);
-          pos.x += pos.z * (pos.x + sx) * factor;
-          pos.y += pos.z * (pos.y + sx) * factor;
+    if (mon.isBlending && mon.priorAction != -1) {
+      bool lock1 = mappedPrior < (int)animBmd->Actions.size() &&
+                   animBmd->Actions[mappedPrior].LockPositions;
+      bool lock2 = mappedAction < (int)animBmd->Actions.size() &&
+                   animBmd->Actions[mappedAction].LockPositions;
+
+      float dx1 = 0.0f, dy1 = 0.0f, dx2 = 0.0f, dy2 = 0.0f;
+      if (lock1) {
+        auto &bm1 = animBmd->Bones[rb].BoneMatrixes[mappedPrior];
+        if (!bm1.Position.empty()) {
+          glm::vec3 p;
+          glm::vec4 q;
+          if (GetInterpolatedBoneData(animBmd, mappedPrior,
+                                      mon.priorAnimFrame, rb, p, q)) {
+            dx1 = p.x - bm1.Position[0].x;
+            dy1 = p.y - bm1.Position[0].y;
+          }
         }
-        pos.z = 5.0f;
-        out.push_back(pos);
       }
-      if (steps == 4) {
-        int quadIndices[3] = {0, 2, 3};
-        for (int v : quadIndices) {
-          auto &srcVert = mesh.Vertices[tri.VertexIndex[v]];
-          glm::vec3 pos = srcVert.Position;
-          int boneIdx = srcVert.Node;
-          if (boneIdx >= 0 && boneIdx < (int)cachedBones.size())
-            pos = MuMath::TransformPoint(
-                (const float(*)[4])cachedBones[boneIdx].data(), pos);
-          pos *= scale;
-          float rx = pos.x * cosF - pos.y * sinF;
-          float ry = pos.x * sinF + pos.y * cosF;
-          pos.x = rx; pos.y = ry;
-          if (pos.z < sy) {
-            float factor = 1.0f / (pos.z - sy);
-            pos.x += pos.z * (pos.x + sx) * factor;
-            pos.y += pos.z * (pos.y + sx) * factor;
+      if (lock2) {
+        auto &bm2 = animBmd->Bones[rb].BoneMatrixes[mappedAction];
+        if (!bm2.Position.empty()) {
+          glm::vec3 p;
+          glm::vec4 q;
+          if (GetInterpolatedBoneData(animBmd, mappedAction, mon.animFrame,
+                                      rb, p, q)) {
+            dx2 = p.x - bm2.Position[0].x;
+            dy2 = p.y - bm2.Position[0].y;
           }
-          pos.z = 5.0f;
-          out.push_back(pos);
         }
       }
+      dx = dx1 * (1.0f - mon.blendAlpha) + dx2 * mon.blendAlpha;
+      dy = dy1 * (1.0f - mon.blendAlpha) + dy2 * mon.blendAlpha;
+    } else if (mappedAction >= 0 &&
+               mappedAction < (int)animBmd->Actions.size() &&
+               animBmd->Actions[mappedAction].LockPositions) {
+      auto &bm = animBmd->Bones[rb].BoneMatrixes[mappedAction];
+      if (!bm.Position.empty()) {
+        dx = bones[rb][0][3] - bm.Position[0].x;
+        dy = bones[rb][1][3] - bm.Position[0].y;
+      }
     }
-  };
+
+    if (dx != 0.0f || dy != 0.0f) {
+      for (int b = 0; b < (int)bones.size(); ++b) {
+        bones[b][0][3] -= dx;
+        bones[b][1][3] -= dy;
+      }
+    }
+  }
+
+  // Bone palettes of GPU-skinned meshes (plain copies, no vertex upload)
+  for (int mi = 0;
+       mi < (int)mon.meshBuffers.size() && mi < (int)mdl.bmd->Meshes.size();
+       ++mi) {
+    if (mon.meshBuffers[mi].isSkinned)
+      RetransformMeshWithBones(mdl.bmd->Meshes[mi], bones,
+                               mon.meshBuffers[mi]);
+  }
+
+  // Weapon bones: weapon-local bind pose under the attach bone
+  for (int wi = 0;
+       wi < (int)mdl.weaponDefs.size() && wi < (int)mon.weaponMeshes.size();
+       ++wi) {
+    auto &wd = mdl.weaponDefs[wi];
+    auto &wms = mon.weaponMeshes[wi];
+    wms.bones.clear();
+    if (!wd.bmd || wms.meshBuffers.empty() ||
+        wd.attachBone >= (int)bones.size())
+      continue;
+
+    const auto &parentBone = bones[wd.attachBone];
+    BoneWorldMatrix weaponLocal =
+        MuMath::BuildWeaponOffsetMatrix(wd.rot, wd.offset);
+    BoneWorldMatrix parentMat;
+    MuMath::ConcatTransforms((const float(*)[4])parentBone.data(),
+                             (const float(*)[4])weaponLocal.data(),
+                             (float(*)[4])parentMat.data());
+    const auto &wLocalBones = wd.cachedLocalBones;
+    wms.bones.resize(wLocalBones.size());
+    for (int bi = 0; bi < (int)wLocalBones.size(); ++bi) {
+      MuMath::ConcatTransforms((const float(*)[4])parentMat.data(),
+                               (const float(*)[4])wLocalBones[bi].data(),
+                               (float(*)[4])wms.bones[bi].data());
+    }
+    for (int mi = 0;
+         mi < (int)wms.meshBuffers.size() && mi < (int)wd.bmd->Meshes.size();
+         ++mi) {
+      if (wms.meshBuffers[mi].isSkinned)
+        RetransformMeshWithBones(wd.bmd->Meshes[mi], wms.bones,
+                                 wms.meshBuffers[mi]);
+    }
+  }
+}
+
+void MonsterManager::RenderShadows(const glm::mat4 &view,
+                                   const glm::mat4 &proj) {
+  if (!m_shadowShader || !m_skinnedShadowShader || m_monsters.empty())
+    return;
 
   // BGFX: stencil-based shadow merging — draw each pixel at most once
   uint64_t shadowState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
@@ -688,81 +822,42 @@ void MonsterManager::RenderShadows(const glm::mat4 &view,
                          | BGFX_STENCIL_OP_FAIL_Z_KEEP
                          | BGFX_STENCIL_OP_PASS_Z_INCR;
 
-  static std::vector<glm::vec3> shadowVerts;
+  // The projection runs in the vertex shader (planar_shadow.sh) on the
+  // same buffers the model draws with: the bone palette of GPU-skinned
+  // meshes, or the posed vertices of CPU-skinned ones
+  auto drawShadow = [&](const MeshBuffers &mb, const glm::mat4 &model,
+                        const glm::vec4 &shadowProj) {
+    if (mb.indexCount == 0)
+      return;
+    Shader *shader =
+        mb.isSkinned ? m_skinnedShadowShader.get() : m_shadowShader.get();
+    bgfx::setTransform(glm::value_ptr(model));
+    BindMesh(mb);
+    shader->setVec4("u_shadowProj", shadowProj);
+    bgfx::setState(shadowState);
+    bgfx::setStencil(shadowStencil);
+    SubmitDraw(0, shader->program);
+  };
 
   for (auto &mon : m_monsters) {
     if (mon.cachedBones.empty()) continue;
     if (mon.state == MonsterState::DEAD && mon.corpseAlpha <= 0.01f) continue;
 
-    auto &mdl = m_models[mon.modelIdx];
+    // Facing goes through u_shadowProj, not the model matrix
     glm::mat4 model = glm::translate(glm::mat4(1.0f), mon.position);
     model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 0, 1));
     model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(mon.scale));
+    glm::vec4 shadowProj(mon.scale, cosf(mon.facing), sinf(mon.facing), 0.0f);
 
-    float cosF = cosf(mon.facing);
-    float sinF = sinf(mon.facing);
-
-    // Body mesh shadows
-    for (int mi = 0;
-         mi < (int)mdl.bmd->Meshes.size() && mi < (int)mon.shadowMeshes.size();
-         ++mi) {
-      auto &sm = mon.shadowMeshes[mi];
-      if (sm.vertexCount == 0 || !bgfx::isValid(sm.vbo)) continue;
-
-      buildShadowVerts(mdl.bmd->Meshes[mi], mon.cachedBones, mon.scale,
-                       cosF, sinF, shadowVerts);
-      if (shadowVerts.empty()) continue;
+    for (auto &mb : mon.meshBuffers)
+      drawShadow(mb, model, shadowProj);
 
-      bgfx::update(sm.vbo, 0,
-          bgfx::copy(shadowVerts.data(), (uint32_t)(shadowVerts.size() * sizeof(glm::vec3))));
-      bgfx::setTransform(glm::value_ptr(model));
-      bgfx::setVertexBuffer(0, sm.vbo, 0, (uint32_t)shadowVerts.size());
-      bgfx::setState(shadowState);
-      bgfx::setStencil(shadowStencil);
-      bgfx::submit(0, m_shadowShader->program);
-    }
-
-    // Weapon shadows
-    for (int wi = 0;
-         wi < (int)mdl.weaponDefs.size() && wi < (int)mon.weaponShadowMeshes.size();
-         ++wi) {
-      auto &wd = mdl.weaponDefs[wi];
-      auto &wss = mon.weaponShadowMeshes[wi];
-      if (!wd.bmd || wss.meshes.empty()) continue;
-      if (wd.attachBone >= (int)mon.cachedBones.size()) continue;
-
-      const auto &parentBone = mon.cachedBones[wd.attachBone];
-      BoneWorldMatrix weaponLocal = MuMath::BuildWeaponOffsetMatrix(wd.rot, wd.offset);
-      BoneWorldMatrix parentMat;
-      MuMath::ConcatTransforms((const float(*)[4])parentBone.data(),
-                               (const float(*)[4])weaponLocal.data(),
-                               (float(*)[4])parentMat.data());
-      const auto &wLocalBones = wd.cachedLocalBones;
-      std::vector<BoneWorldMatrix> wFinalBones(wLocalBones.size());
-      for (int bi = 0; bi < (int)wLocalBones.size(); ++bi)
-        MuMath::ConcatTransforms((const float(*)[4])parentMat.data(),
-                                 (const float(*)[4])wLocalBones[bi].data(),
-                                 (float(*)[4])wFinalBones[bi].data());
-
-      for (int wmi = 0;
-           wmi < (int)wd.bmd->Meshes.size() && wmi < (int)wss.meshes.size();
-           ++wmi) {
-        auto &wsm = wss.meshes[wmi];
-        if (wsm.vertexCount == 0 || !bgfx::isValid(wsm.vbo)) continue;
-
-        buildShadowVerts(wd.bmd->Meshes[wmi], wFinalBones, mon.scale,
-                         cosF, sinF, shadowVerts);
-        if (shadowVerts.empty()) continue;
-
-        bgfx::update(wsm.vbo, 0,
-            bgfx::copy(shadowVerts.data(), (uint32_t)(shadowVerts.size() * sizeof(glm::vec3))));
-        bgfx::setTransform(glm::value_ptr(model));
-        bgfx::setVertexBuffer(0, wsm.vbo, 0, (uint32_t)shadowVerts.size());
-        bgfx::setState(shadowState);
-        bgfx::setStencil(shadowStencil);
-        bgfx::submit(0, m_shadowShader->program);
-      }
+    // Weapons: posed with the body in animateMonster
+    for (auto &wms : mon.weaponMeshes) {
+      if (wms.bones.empty()) continue;
+      for (auto &mb : wms.meshBuffers)
+        drawShadow(mb, model, shadowProj);
     }
   }
 }
@@ -775,7 +870,7 @@ void MonsterManager::SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &ligh
 void MonsterManager::RenderDepthPrepass(const glm::mat4 &view,
                                          const glm::mat4 &proj,
                                          const glm::vec3 &camPos) {
-  if (!m_shader || m_monsters.empty())
+  if (!m_shader || !m_skinnedShader || m_monsters.empty())
     return;
 
   // Depth-only state: write Z but no color. The fragment shader still runs
@@ -828,23 +923,24 @@ void MonsterManager::RenderDepthPrepass(const glm::mat4 &view,
       if (mb.noneBlend || mb.bright) continue;
 
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       m_shader->setTexture(0, "s_texColor", mb.texture);
       // Minimal uniforms for shader alpha-test (discard)
       m_shader->setVec4("u_params", glm::vec4(1.0f, 1.0f, 0.0f, 0.0f));
       bgfx::setState(depthState);
-      bgfx::submit(0, m_shader->program);
+      SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
     }
   }
 }
 
-void MonsterManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram) {
+void MonsterManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                                       bgfx::ProgramHandle skinnedDepthProgram) {
   if (m_monsters.empty()) return;
 
+  // Min blend: drawn over the static shadow layer, nearer depth wins
   uint64_t state = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z
-                 | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CCW;
+                 | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CCW
+                 | BGFX_STATE_BLEND_MIN;
 
   for (auto &mon : m_monsters) {
     if (mon.cachedBones.empty()) continue;
@@ -861,22 +957,18 @@ void MonsterManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depth
     for (auto &mb : mon.meshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
     // Weapon meshes (skeleton/lich types)
     for (auto &wms : mon.weaponMeshes) {
       for (auto &mb : wms.meshBuffers) {
         if (mb.hidden || mb.indexCount == 0) continue;
         bgfx::setTransform(glm::value_ptr(model));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         bgfx::setState(state);
-        bgfx::submit(viewId, depthProgram);
+        SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
       }
     }
   }
@@ -885,7 +977,7 @@ void MonsterManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depth
 void MonsterManager::RenderSilhouetteOutline(int monsterIndex,
                                               const glm::mat4 &view,
                                               const glm::mat4 &proj) {
-  if (!m_outlineShader || monsterIndex < 0 ||
+  if (!m_outlineShader || !m_skinnedOutlineShader || monsterIndex < 0 ||
       monsterIndex >= (int)m_monsters.size())
     return;
 
@@ -913,14 +1005,13 @@ void MonsterManager::RenderSilhouetteOutline(int monsterIndex,
     for (auto &mb : mon.meshBuffers) {
       if (mb.indexCount == 0 || mb.hidden) continue;
       bgfx::setTransform(glm::value_ptr(stencilModel));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setStencil(stencilFront, stencilBack);
       bgfx::setState(state);
       m_outlineShader->setVec4("u_outlineParams", outlineParams);
       m_outlineShader->setVec4("u_outlineColor", outlineColor);
-      bgfx::submit(0, m_outlineShader->program);
+      SubmitDraw(0, (mb.isSkinned ? m_skinnedOutlineShader
+                                   : m_outlineShader)->program);
     }
     for (int wi = 0;
          wi < (int)mdl.weaponDefs.size() && wi < (int)mon.weaponMeshes.size();
@@ -928,14 +1019,13 @@ void MonsterManager::RenderSilhouetteOutline(int monsterIndex,
       for (auto &mb : mon.weaponMeshes[wi].meshBuffers) {
         if (mb.indexCount == 0) continue;
         bgfx::setTransform(glm::value_ptr(stencilModel));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         bgfx::setStencil(stencilFront, stencilBack);
         bgfx::setState(state);
         m_outlineShader->setVec4("u_outlineParams", outlineParams);
         m_outlineShader->setVec4("u_outlineColor", outlineColor);
-        bgfx::submit(0, m_outlineShader->program);
+        SubmitDraw(0, (mb.isSkinned ? m_skinnedOutlineShader
+                                     : m_outlineShader)->program);
       }
     }
   };
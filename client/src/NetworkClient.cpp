@@ -1,6 +1,9 @@
 #include "NetworkClient.hpp"
+#include "PacketCompression.hpp"
+#include "PacketDefs.hpp"
 #include <arpa/inet.h>
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <fcntl.h>
 #include <netinet/in.h>
@@ -54,11 +57,19 @@ bool NetworkClient::Connect(const char *host, uint16_t port) {
   m_connected = true;
   m_recvBuf.clear();
   m_sendBuf.clear();
+  m_compressStats = {};
   printf("[Net] Connected to %s:%d\n", host, port);
   return true;
 }
 
 void NetworkClient::Disconnect() {
+  if (m_compressStats.packets > 0) {
+    const auto &st = m_compressStats;
+    printf("[Net] Decompressed %llu packet(s): %llu -> %llu bytes, %.2f ms\n",
+           (unsigned long long)st.packets, (unsigned long long)st.wireBytes,
+           (unsigned long long)st.rawBytes, st.decodeUs / 1000.0);
+    m_compressStats = {};
+  }
   if (m_fd >= 0) {
     close(m_fd);
     m_fd = -1;
@@ -120,14 +131,35 @@ void NetworkClient::Poll() {
       break; // Incomplete packet, wait for more data
 
     // Complete packet — deliver to handler
-    if (onPacket) {
-      onPacket(m_recvBuf.data(), pktSize);
-    }
+    Deliver(m_recvBuf.data(), pktSize);
 
     m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + pktSize);
   }
 }
 
+void NetworkClient::Deliver(const uint8_t *pkt, int size) {
+  if (!onPacket)
+    return;
+  if (pkt[0] != 0xC2 || size < 4 || pkt[3] != Opcode::COMPRESSED) {
+    onPacket(pkt, size);
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  if (!PacketCompression::Decompress(pkt, size, m_decodeBuf)) {
+    printf("[Net] Dropping corrupt compressed packet (%d bytes)\n", size);
+    return;
+  }
+  m_compressStats.packets++;
+  m_compressStats.wireBytes += size;
+  m_compressStats.rawBytes += m_decodeBuf.size();
+  m_compressStats.decodeUs +=
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  onPacket(m_decodeBuf.data(), static_cast<int>(m_decodeBuf.size()));
+}
+
 void NetworkClient::Send(const void *data, size_t len) {
   if (!m_connected || len == 0)
     return;
@@ -144,7 +144,7 @@ void NpcManager::addNpc(int modelIdx, int gridX, int gridY, int dir,
     NpcInstance::BodyPart bp;
     bp.bmdIdx = -1; // skeleton
     for (auto &mesh : mdl.skeleton->Meshes) {
-      UploadMeshWithBones(mesh, texDir, bones, bp.meshBuffers, aabb, true);
+      UploadSkinnedMesh(mesh, texDir, bones, bp.meshBuffers, aabb);
     }
     npc.bodyParts.push_back(std::move(bp));
   }
@@ -156,7 +156,7 @@ void NpcManager::addNpc(int modelIdx, int gridX, int gridY, int dir,
     NpcInstance::BodyPart bp;
     bp.bmdIdx = pi;
     for (auto &mesh : mdl.parts[pi]->Meshes) {
-      UploadMeshWithBones(mesh, texDir, bones, bp.meshBuffers, aabb, true);
+      UploadSkinnedMesh(mesh, texDir, bones, bp.meshBuffers, aabb);
     }
     npc.bodyParts.push_back(std::move(bp));
   }
@@ -169,43 +169,8 @@ void NpcManager::addNpc(int modelIdx, int gridX, int gridY, int dir,
     const auto &wBones = mdl.cachedWeaponBones;
     AABB wAabb{};
     for (auto &mesh : mdl.weaponBmd->Meshes) {
-      UploadMeshWithBones(mesh, weaponTexDir, wBones, npc.weaponMeshBuffers,
-                          wAabb, true);
-    }
-    // Create weapon shadow mesh buffers
-    for (auto &mb : npc.weaponMeshBuffers) {
-      NpcInstance::ShadowMesh sm;
-      sm.vertexCount = mb.vertexCount;
-      if (sm.vertexCount == 0) {
-        npc.weaponShadowMeshes.push_back(sm);
-        continue;
-      }
-      bgfx::VertexLayout shadowLayout;
-      shadowLayout.begin()
-          .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-          .end();
-      sm.vbo = bgfx::createDynamicVertexBuffer(
-          sm.vertexCount, shadowLayout, BGFX_BUFFER_ALLOW_RESIZE);
-      npc.weaponShadowMeshes.push_back(sm);
-    }
-  }
-
-  // Create shadow mesh buffers
-  for (auto &bp : npc.bodyParts) {
-    for (auto &mb : bp.meshBuffers) {
-      NpcInstance::ShadowMesh sm;
-      sm.vertexCount = mb.vertexCount;
-      if (sm.vertexCount == 0) {
-        npc.shadowMeshes.push_back(sm);
-        continue;
-      }
-      bgfx::VertexLayout shadowLayout;
-      shadowLayout.begin()
-          .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-          .end();
-      sm.vbo = bgfx::createDynamicVertexBuffer(
-          sm.vertexCount, shadowLayout, BGFX_BUFFER_ALLOW_RESIZE);
-      npc.shadowMeshes.push_back(sm);
+      UploadSkinnedMesh(mesh, weaponTexDir, wBones, npc.weaponMeshBuffers,
+                        wAabb);
     }
   }
 
@@ -222,7 +187,10 @@ void NpcManager::InitModels(const std::string &dataPath) {
 
   // Create shaders
   m_shader = Shader::Load("vs_model.bin", "fs_model.bin");
-  m_shadowShader = Shader::Load("vs_shadow.bin", "fs_shadow.bin");
+  m_skinnedShader = Shader::Load("vs_skinned.bin", "fs_model.bin");
+  m_shadowShader = Shader::Load("vs_shadow_planar.bin", "fs_shadow.bin");
+  m_skinnedShadowShader =
+      Shader::Load("vs_shadow_planar_skinned.bin", "fs_shadow.bin");
   // m_outlineShader: not needed for BGFX (silhouette outline is GL-only)
 
   // Load NPC models for 0.97d Lorencia
@@ -396,7 +364,7 @@ void NpcManager::Init(const std::string &dataPath) {
 
 void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
                         const glm::vec3 &camPos, float deltaTime) {
-  if (!m_shader || m_npcs.empty())
+  if (!m_shader || !m_skinnedShader || m_npcs.empty())
     return;
 
   // Extract frustum planes from VP matrix for culling
@@ -437,6 +405,9 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
   int plCount = std::min((int)m_pointLights.size(), MAX_POINT_LIGHTS);
   m_shader->uploadPointLights(plCount, m_pointLights.data());
 
+  // Pass 1: animation clock, sounds, movement and frustum culling. Tracks
+  // are set up here since Init() must not race with Sample() on job threads
+  m_visibleNpcs.clear();
   for (int ni = 0; ni < (int)m_npcs.size(); ++ni) {
     auto &npc = m_npcs[ni];
     auto &mdl = m_models[npc.modelIdx];
@@ -588,31 +559,26 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
         continue;
     }
 
-    // Compute bone matrices
-    ComputeBoneMatricesInterpolated(mdl.skeleton, npc.action,
-                                    npc.animFrame, npc.cachedBones);
-    auto &bones = npc.cachedBones;
-
-    // LockPositions: cancel root bone X/Y displacement to prevent walk
-    // animation from physically moving the model (same as MonsterManager)
-    if (mdl.rootBone >= 0 && npc.action >= 0 &&
-        npc.action < (int)mdl.skeleton->Actions.size() &&
-        mdl.skeleton->Actions[npc.action].LockPositions) {
-      int rb = mdl.rootBone;
-      auto &bm = mdl.skeleton->Bones[rb].BoneMatrixes[npc.action];
-      if (!bm.Position.empty()) {
-        float dx = bones[rb][0][3] - bm.Position[0].x;
-        float dy = bones[rb][1][3] - bm.Position[0].y;
-        if (dx != 0.0f || dy != 0.0f) {
-          for (int b = 0; b < (int)bones.size(); ++b) {
-            bones[b][0][3] -= dx;
-            bones[b][1][3] -= dy;
-          }
-        }
-      }
-    }
+    if (!mdl.tracks.IsValid())
+      mdl.tracks.Init(mdl.skeleton);
+    m_visibleNpcs.push_back(ni);
+  }
 
-    npc.cachedBones = bones;
+  // Pass 2: bone matrices and bone palettes, in parallel
+  auto pose = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i)
+      poseNpc(m_npcs[m_visibleNpcs[i]]);
+  };
+  if (m_jobs)
+    m_jobs->ParallelFor((int)m_visibleNpcs.size(), POSE_JOB_GRAIN, pose);
+  else
+    pose(0, (int)m_visibleNpcs.size());
+
+  // Pass 3: VFX, CPU-skinned meshes and draws, on this thread in order
+  for (int ni : m_visibleNpcs) {
+    auto &npc = m_npcs[ni];
+    auto &mdl = m_models[npc.modelIdx];
+    const auto &bones = npc.cachedBones;
 
     // ── Blacksmith VFX (Main 5.2: ZzzCharacter.cpp:5917-5939) ──
     // MODEL_SMITH (NPC type 251): sparks from bone 17 during hammer frames 5-6
@@ -641,13 +607,14 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
       }
     }
 
-    // Re-skin meshes
+    // Re-skin CPU-skinned meshes (vertex upload, so not in poseNpc)
     for (auto &bp : npc.bodyParts) {
       BMDData *bmd = (bp.bmdIdx < 0) ? mdl.skeleton : mdl.parts[bp.bmdIdx];
       for (int mi = 0;
            mi < (int)bp.meshBuffers.size() && mi < (int)bmd->Meshes.size();
            ++mi) {
-        RetransformMeshWithBones(bmd->Meshes[mi], bones, bp.meshBuffers[mi]);
+        if (!bp.meshBuffers[mi].isSkinned)
+          RetransformMeshWithBones(bmd->Meshes[mi], bones, bp.meshBuffers[mi]);
       }
     }
 
@@ -704,9 +671,7 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
         bool forgeGlow = isBlacksmith && (mb.bmdTextureId == 4);
 
         bgfx::setTransform(glm::value_ptr(model));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         m_shader->setTexture(0, "s_texColor", mb.texture);
         setNpcUniforms(blendMeshLight, 0.0f, 0.0f, glm::vec3(0.0f));
 
@@ -722,7 +687,7 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
                 | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
         }
         bgfx::setState(state);
-        bgfx::submit(0, m_shader->program);
+        SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
       }
     }
 
@@ -745,13 +710,11 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
           for (auto &mb : bp.meshBuffers) {
             if (mb.indexCount == 0 || mb.hidden) continue;
             bgfx::setTransform(glm::value_ptr(model));
-            if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-            else bgfx::setVertexBuffer(0, mb.vbo);
-            bgfx::setIndexBuffer(mb.ebo);
+            BindMesh(mb);
             m_shader->setTexture(0, "s_texColor", passes[gp].texture);
             setNpcUniforms(blendMeshLight, (float)passes[gp].chromeMode, t, passes[gp].color);
             bgfx::setState(glowState);
-            bgfx::submit(0, m_shader->program);
+            SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
           }
         }
       }
@@ -789,9 +752,7 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
       for (auto &mb : npc.weaponMeshBuffers) {
         if (mb.indexCount == 0 || mb.hidden) continue;
         bgfx::setTransform(glm::value_ptr(model));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         m_shader->setTexture(0, "s_texColor", mb.texture);
         setNpcUniforms(1.0f, 0.0f, 0.0f, glm::vec3(0.0f));
         uint64_t wState;
@@ -804,7 +765,7 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
                  | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA);
         }
         bgfx::setState(wState);
-        bgfx::submit(0, m_shader->program);
+        SubmitDraw(0, (mb.isSkinned ? m_skinnedShader : m_shader)->program);
       }
     }
   }
@@ -813,8 +774,46 @@ void NpcManager::Render(const glm::mat4 &view, const glm::mat4 &proj,
   m_prevInteractingNpc = m_interactingNpc;
 }
 
+// Bone matrices (npc.cachedBones) and GPU-skinned body part palettes for
+// one visible NPC. Runs on job threads (see Render): touches only `npc` and
+// read-only model data.
+void NpcManager::poseNpc(NpcInstance &npc) {
+  auto &mdl = m_models[npc.modelIdx];
+  mdl.tracks.Sample(npc.action, npc.animFrame, npc.cachedBones);
+  auto &bones = npc.cachedBones;
+
+  // LockPositions: cancel root bone X/Y displacement to prevent walk
+  // animation from physically moving the model (same as MonsterManager)
+  if (mdl.rootBone >= 0 && npc.action >= 0 &&
+      npc.action < (int)mdl.skeleton->Actions.size() &&
+      mdl.skeleton->Actions[npc.action].LockPositions) {
+    int rb = mdl.rootBone;
+    auto &bm = mdl.skeleton->Bones[rb].BoneMatrixes[npc.action];
+    if (!bm.Position.empty()) {
+      float dx = bones[rb][0][3] - bm.Position[0].x;
+      float dy = bones[rb][1][3] - bm.Position[0].y;
+      if (dx != 0.0f || dy != 0.0f) {
+        for (int b = 0; b < (int)bones.size(); ++b) {
+          bones[b][0][3] -= dx;
+          bones[b][1][3] -= dy;
+        }
+      }
+    }
+  }
+
+  for (auto &bp : npc.bodyParts) {
+    BMDData *bmd = (bp.bmdIdx < 0) ? mdl.skeleton : mdl.parts[bp.bmdIdx];
+    for (int mi = 0;
+         mi < (int)bp.meshBuffers.size() && mi < (int)bmd->Meshes.size();
+         ++mi) {
+      if (bp.meshBuffers[mi].isSkinned)
+        RetransformMeshWithBones(bmd->Meshes[mi], bones, bp.meshBuffers[mi]);
+    }
+  }
+}
+
 void NpcManager::RenderShadows(const glm::mat4 &view, const glm::mat4 &proj) {
-  if (!m_shadowShader || m_npcs.empty())
+  if (!m_shadowShader || !m_skinnedShadowShader || m_npcs.empty())
     return;
 
   uint64_t shadowState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
@@ -827,103 +826,34 @@ void NpcManager::RenderShadows(const glm::mat4 &view, const glm::mat4 &proj) {
                          | BGFX_STENCIL_OP_FAIL_Z_KEEP
                          | BGFX_STENCIL_OP_PASS_Z_INCR;
 
-  const float sx = 2000.0f;
-  const float sy = 4000.0f;
-
   for (auto &npc : m_npcs) {
     if (npc.cachedBones.empty())
       continue;
 
-    auto &mdl = m_models[npc.modelIdx];
-
-    // Shadow model matrix (facing baked into vertices)
+    // Shadow model matrix (facing and planar projection in the vertex
+    // shader, on the body part buffers the model draws with)
     glm::mat4 model = glm::translate(glm::mat4(1.0f), npc.position);
     model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 0, 1));
     model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(0, 1, 0));
     if (npc.scale != 1.0f)
       model = glm::scale(model, glm::vec3(npc.scale));
+    glm::vec4 shadowProj(npc.scale, cosf(npc.facing), sinf(npc.facing), 0.0f);
 
-
-    float cosF = cosf(npc.facing);
-    float sinF = sinf(npc.facing);
-
-    int smIdx = 0;
     for (auto &bp : npc.bodyParts) {
-      BMDData *bmd = (bp.bmdIdx < 0) ? mdl.skeleton : mdl.parts[bp.bmdIdx];
-      for (int mi = 0;
-           mi < (int)bmd->Meshes.size() && smIdx < (int)npc.shadowMeshes.size();
-           ++mi, ++smIdx) {
-        auto &sm = npc.shadowMeshes[smIdx];
-        if (sm.vertexCount == 0 || !bgfx::isValid(sm.vbo))
+      for (auto &mb : bp.meshBuffers) {
+        if (mb.indexCount == 0)
           continue;
-
-        auto &mesh = bmd->Meshes[mi];
-        static std::vector<glm::vec3> shadowVerts;
-        shadowVerts.clear();
-
-        for (int i = 0; i < mesh.NumTriangles; ++i) {
-          auto &tri = mesh.Triangles[i];
-          int steps = (tri.Polygon == 3) ? 3 : 4;
-          for (int v = 0; v < 3; ++v) {
-            auto &srcVert = mesh.Vertices[tri.VertexIndex[v]];
-            glm::vec3 pos = srcVert.Position;
-            int boneIdx = srcVert.Node;
-            if (boneIdx >= 0 && boneIdx < (int)npc.cachedBones.size()) {
-              pos = MuMath::TransformPoint(
-                  (const float(*)[4])npc.cachedBones[boneIdx].data(), pos);
-            }
-            pos *= npc.scale;
-            float rx = pos.x * cosF - pos.y * sinF;
-            float ry = pos.x * sinF + pos.y * cosF;
-            pos.x = rx;
-            pos.y = ry;
-            if (pos.z < sy) {
-              float factor = 1.0f / (pos.z - sy);
-              pos.x += pos.z * (pos.x + sx) * factor;
-              pos.y += pos.z * (pos.y + sx) * factor;
-            }
-            pos.z = 5.0f;
-            shadowVerts.push_back(pos);
-          }
-          if (steps == 4) {
-            int quadIndices[3] = {0, 2, 3};
-            for (int v : quadIndices) {
-              auto &srcVert = mesh.Vertices[tri.VertexIndex[v]];
-              glm::vec3 pos = srcVert.Position;
-              int boneIdx = srcVert.Node;
-              if (boneIdx >= 0 && boneIdx < (int)npc.cachedBones.size()) {
-                pos = MuMath::TransformPoint(
-                    (const float(*)[4])npc.cachedBones[boneIdx].data(), pos);
-              }
-              pos *= npc.scale;
-              float rx = pos.x * cosF - pos.y * sinF;
-              float ry = pos.x * sinF + pos.y * cosF;
-              pos.x = rx;
-              pos.y = ry;
-              if (pos.z < sy) {
-                float factor = 1.0f / (pos.z - sy);
-                pos.x += pos.z * (pos.x + sx) * factor;
-                pos.y += pos.z * (pos.y + sx) * factor;
-              }
-              pos.z = 5.0f;
-              shadowVerts.push_back(pos);
-            }
-          }
-        }
-
-        if (!shadowVerts.empty()) {
-          bgfx::update(sm.vbo, 0,
-                       bgfx::copy(shadowVerts.data(), shadowVerts.size() * sizeof(glm::vec3)));
-          bgfx::setTransform(glm::value_ptr(model));
-          bgfx::setVertexBuffer(0, sm.vbo, 0, (uint32_t)shadowVerts.size());
-          bgfx::setState(shadowState);
-          bgfx::setStencil(shadowStencil);
-          bgfx::submit(0, m_shadowShader->program);
-        }
+        Shader *shader =
+            mb.isSkinned ? m_skinnedShadowShader.get() : m_shadowShader.get();
+        bgfx::setTransform(glm::value_ptr(model));
+        BindMesh(mb);
+        shader->setVec4("u_shadowProj", shadowProj);
+        bgfx::setState(shadowState);
+        bgfx::setStencil(shadowStencil);
+        SubmitDraw(0, shader->program);
       }
     }
   }
-
 }
 
 void NpcManager::SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &lightMtx) {
@@ -931,11 +861,14 @@ void NpcManager::SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &lightMtx
   m_lightMtx = lightMtx;
 }
 
-void NpcManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram) {
+void NpcManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProgram,
+                                   bgfx::ProgramHandle skinnedDepthProgram) {
   if (m_npcs.empty()) return;
 
+  // Min blend onto the static layer copy (RenderWorld)
   uint64_t state = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z
-                 | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CCW;
+                 | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CCW
+                 | BGFX_STATE_BLEND_MIN;
 
   for (auto &npc : m_npcs) {
     auto &mdl = m_models[npc.modelIdx];
@@ -949,22 +882,18 @@ void NpcManager::RenderToShadowMap(uint8_t viewId, bgfx::ProgramHandle depthProg
       for (auto &mb : bp.meshBuffers) {
         if (mb.hidden || mb.indexCount == 0) continue;
         bgfx::setTransform(glm::value_ptr(model));
-        if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-        else bgfx::setVertexBuffer(0, mb.vbo);
-        bgfx::setIndexBuffer(mb.ebo);
+        BindMesh(mb);
         bgfx::setState(state);
-        bgfx::submit(viewId, depthProgram);
+        SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
       }
     }
     // Weapon meshes (guards)
     for (auto &mb : npc.weaponMeshBuffers) {
       if (mb.hidden || mb.indexCount == 0) continue;
       bgfx::setTransform(glm::value_ptr(model));
-      if (mb.isDynamic) bgfx::setVertexBuffer(0, mb.dynVbo);
-      else bgfx::setVertexBuffer(0, mb.vbo);
-      bgfx::setIndexBuffer(mb.ebo);
+      BindMesh(mb);
       bgfx::setState(state);
-      bgfx::submit(viewId, depthProgram);
+      SubmitDraw(viewId, mb.isSkinned ? skinnedDepthProgram : depthProgram);
     }
   }
 }
@@ -1002,20 +931,16 @@ void NpcManager::Cleanup() {
   for (auto &npc : m_npcs) {
     for (auto &bp : npc.bodyParts)
       CleanupMeshBuffers(bp.meshBuffers);
-    for (auto &sm : npc.shadowMeshes) {
-      if (bgfx::isValid(sm.vbo)) bgfx::destroy(sm.vbo);
-    }
     // Weapon meshes (guards)
     CleanupMeshBuffers(npc.weaponMeshBuffers);
-    for (auto &sm : npc.weaponShadowMeshes) {
-      if (bgfx::isValid(sm.vbo)) bgfx::destroy(sm.vbo);
-    }
   }
   m_npcs.clear();
   m_models.clear();
   m_ownedBmds.clear();
   m_shader.reset();
+  m_skinnedShader.reset();
   m_shadowShader.reset();
+  m_skinnedShadowShader.reset();
 }
 
 void NpcManager::SetQuestMarkers(const std::vector<GuardMarker> &markers) {
@@ -1,10 +1,13 @@
 #include "ObjectRenderer.hpp"
 #include "SoundManager.hpp"
 #include "TextureLoader.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <tuple>
 
 // BlendMesh texture ID lookup — returns the BMD texture slot index
 // that identifies the "window light" mesh for each object type.
@@ -73,6 +76,12 @@ static bool IsDoorType(int type) {
   return type == 20 || type == 65 || type == 86 || type == 88;
 }
 
+// Animated types skinned on the GPU (u_boneMatrices holds 48 bones). Wall
+// flags blend toward rest and re-skin only their badge mesh: CPU path.
+static bool UsesGPUSkinning(int type, const BMDData *bmd) {
+  return type != 72 && type != 74 && (int)bmd->Bones.size() <= 48;
+}
+
 // Type-to-filename mapping based on reference _enum.h + MapManager.cpp
 // AccessModel(TYPE, dir, "BaseName", index):
 //   index == -1 → BaseName.bmd
@@ -158,7 +167,10 @@ std::string ObjectRenderer::GetObjectBMDFilename(int type) {
 void ObjectRenderer::Init() {
   shader = Shader::Load("vs_model.bin", "fs_model.bin");
   skinnedShader = Shader::Load("vs_model_skinned.bin", "fs_model.bin");
-  if (!shader || !skinnedShader)
+  instancedShader = Shader::Load("vs_model_instanced.bin", "fs_model.bin");
+  skinnedInstancedShader =
+      Shader::Load("vs_model_skinned_instanced.bin", "fs_model.bin");
+  if (!shader || !skinnedShader || !instancedShader || !skinnedInstancedShader)
     std::cerr << "[ObjectRenderer] Failed to load BGFX shaders" << std::endl;
 }
 
@@ -271,7 +283,8 @@ void ObjectRenderer::UploadMesh(const Mesh_t &mesh, const std::string &baseDir,
 
 void ObjectRenderer::UploadMeshGPUSkinned(const Mesh_t &mesh,
                                            const std::string &baseDir,
-                                           std::vector<MeshBuffers> &out) {
+                                           std::vector<MeshBuffers> &out,
+                                           const std::string &fallbackTexDir) {
   MeshBuffers mb;
 
   struct BgfxSkinnedVertex {
@@ -346,6 +359,8 @@ void ObjectRenderer::UploadMeshGPUSkinned(const Mesh_t &mesh,
       bgfx::copy(indices.data(), ibSize), BGFX_BUFFER_INDEX32);
 
   auto texResult = TextureLoader::ResolveWithInfo(baseDir, mesh.TextureName);
+  if (!TexValid(texResult.textureID) && !fallbackTexDir.empty())
+    texResult = TextureLoader::ResolveWithInfo(fallbackTexDir, mesh.TextureName);
   mb.texture = texResult.textureID;
   mb.hasAlpha = texResult.hasAlpha;
   mb.textureName = mesh.TextureName;
@@ -383,11 +398,12 @@ void ObjectRenderer::LoadObjects(const std::vector<ObjectData> &objects,
 
       ModelCache cache;
       cache.boneMatrices = ComputeBoneMatrices(bmd.get());
+      cache.bounds = ComputeTransformedAABB(bmd.get(), cache.boneMatrices);
       cache.blendMeshTexId = GetBlendMeshTexId(obj.type, m_mapId);
 
       // Detect animated models (>1 keyframe in first action)
-      auto shouldCPUAnimate = [](int t) {
-        // CPU re-skinning: low instance count types only
+      auto shouldAnimate = [](int t) {
+        // Animated props besides trees
         return t == 56 || t == 57 ||   // MerchantAnimal01-02
                t == 60 ||              // Ship01
                t == 72 || t == 74 ||   // StoneWall04/06 (flag banners)
@@ -401,20 +417,24 @@ void ObjectRenderer::LoadObjects(const std::vector<ObjectData> &objects,
                t == 120 ||             // Tent01
                t == 150;               // Candle01
       };
-      // GPU skinning: high instance count animated types (trees)
+      // GPU skinning: trees (per-instance phase + sway) and the props
+      // above (one pose per type); see UsesGPUSkinning for the exceptions
       bool isTree = (obj.type >= 0 && obj.type <= 19);
       bool hasAnim = !bmd->Actions.empty() && bmd->Actions[0].NumAnimationKeys > 1;
 
-      if (hasAnim && isTree) {
+      if (hasAnim && (isTree || (shouldAnimate(obj.type) &&
+                                 UsesGPUSkinning(obj.type, bmd.get())))) {
         // GPU-skinned path: store raw vertices + bone indices
         cache.isGPUAnimated = true;
+        cache.sway = isTree;
+        cache.gpuPoses = isTree ? TREE_PHASE_POSES : 1;
         cache.numAnimationKeys = bmd->Actions[0].NumAnimationKeys;
         for (int mi = 0; mi < (int)bmd->Meshes.size(); ++mi) {
           UploadMeshGPUSkinned(bmd->Meshes[mi], objectDir + "/",
                                cache.meshBuffers);
         }
       } else {
-        if (hasAnim && shouldCPUAnimate(obj.type)) {
+        if (hasAnim && shouldAnimate(obj.type)) {
           cache.isAnimated = true;
           cache.numAnimationKeys = bmd->Actions[0].NumAnimationKeys;
         }
@@ -436,6 +456,7 @@ void ObjectRenderer::LoadObjects(const std::vector<ObjectData> &objects,
       // Retain BMD data for animated types (CPU re-skinning or GPU bone compute)
       if (cache.isAnimated || cache.isGPUAnimated) {
         cache.bmdData = std::move(bmd);
+        cache.tracks.Init(cache.bmdData.get());
         std::cout << "  [" << (cache.isGPUAnimated ? "GPU-Anim" : "CPU-Anim")
                   << "] type " << obj.type
                   << " keys=" << cache.numAnimationKeys << std::endl;
@@ -571,6 +592,7 @@ void ObjectRenderer::LoadObjects(const std::vector<ObjectData> &objects,
             << " unique models, " << m_interactiveObjects.size()
             << " interactive objects, skipped " << skipped << std::endl;
 
+  BuildInstanceBatches();
 }
 
 void ObjectRenderer::LoadObjectsGeneric(
@@ -618,20 +640,21 @@ void ObjectRenderer::LoadObjectsGeneric(
 
       ModelCache cache;
       cache.boneMatrices = ComputeBoneMatrices(bmd.get());
+      cache.bounds = ComputeTransformedAABB(bmd.get(), cache.boneMatrices);
       cache.blendMeshTexId = GetBlendMeshTexId(obj.type, m_mapId);
 
       // GPU tree sway only for Lorencia (LoadObjects path). Non-Lorencia tree
       // BMDs (ObjectXX.bmd) have different bone/animation structures that the
-      // sway shader misinterprets, causing severe distortion.
-      bool isTree = false;
+      // sway shader misinterprets, causing severe distortion; here every
+      // animated type is skinned on the GPU with one shared pose, no sway.
       bool hasAnim = !bmd->Actions.empty() && bmd->Actions[0].NumAnimationKeys > 1;
 
-      if (hasAnim && isTree) {
-        // GPU-skinned path for trees (enables vertex shader sway)
+      if (hasAnim && UsesGPUSkinning(obj.type, bmd.get())) {
         cache.isGPUAnimated = true;
         cache.numAnimationKeys = bmd->Actions[0].NumAnimationKeys;
         for (int mi = 0; mi < (int)bmd->Meshes.size(); ++mi) {
-          UploadMeshGPUSkinned(bmd->Meshes[mi], texDir, cache.meshBuffers);
+          UploadMeshGPUSkinned(bmd->Meshes[mi], texDir, cache.meshBuffers,
+                               fallbackTexDir);
         }
       } else {
         // CPU animation: retransform shared mesh once per type per frame.
@@ -656,9 +679,11 @@ void ObjectRenderer::LoadObjectsGeneric(
         }
       }
 
-      if (cache.isAnimated) {
+      if (cache.isAnimated || cache.isGPUAnimated) {
         cache.bmdData = std::move(bmd);
-        std::cout << "  [CPU-Anim] type " << obj.type
+        cache.tracks.Init(cache.bmdData.get());
+        std::cout << "  [" << (cache.isGPUAnimated ? "GPU-Anim" : "CPU-Anim")
+                  << "] type " << obj.type
                   << " keys=" << cache.numAnimationKeys << std::endl;
       }
 
@@ -819,6 +844,8 @@ void ObjectRenderer::LoadObjectsGeneric(
             << " instances, " << modelCache.size() << " unique models ("
             << fromFallback << " from fallback), skipped " << skipped
             << std::endl;
+
+  BuildInstanceBatches();
 }
 
 void ObjectRenderer::SetTerrainLightmap(
@@ -930,14 +957,210 @@ void ObjectRenderer::RetransformMesh(const Mesh_t &mesh,
 }
 
 
-void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
-                            const glm::vec3 &cameraPos, float currentTime) {
-  if (instances.empty() || !shader)
-    return;
+// Bone matrices in the GPU layout (column-major, affine) — max 48
+static int ToGPUBones(const std::vector<BoneWorldMatrix> &bones,
+                      glm::mat4 *out) {
+  int count = std::min((int)bones.size(), 48);
+  for (int bi = 0; bi < count; ++bi) {
+    auto &bm = bones[bi];
+    out[bi][0] = glm::vec4(bm[0][0], bm[1][0], bm[2][0], 0.0f);
+    out[bi][1] = glm::vec4(bm[0][1], bm[1][1], bm[2][1], 0.0f);
+    out[bi][2] = glm::vec4(bm[0][2], bm[1][2], bm[2][2], 0.0f);
+    out[bi][3] = glm::vec4(bm[0][3], bm[1][3], bm[2][3], 1.0f);
+  }
+  return count;
+}
 
-  // Extract frustum planes from VP matrix for culling
-  glm::mat4 vp = projection * view;
-  glm::vec4 frustum[6];
+bool ObjectRenderer::IsTypeSkipped(int type) const {
+  if (type == 133 || (type >= 130 && type <= 132))
+    return true;
+  if (m_mapId == 1 && (type == 39 || type == 40 || type == 51 ||
+       type == 52 || type == 60))
+    return true;
+  if (m_mapId == 2 && (type == 91 || type == 100))
+    return true;
+  if (m_mapId == 3 && type == 38) // Noria pose box (HiddenMesh=-2)
+    return true;
+  return false;
+}
+
+bool ObjectRenderer::IsTypeFiltered(int type) const {
+  if (m_typeFilter.empty())
+    return false;
+  for (int t : m_typeFilter)
+    if (type == t)
+      return false;
+  return true;
+}
+
+uint64_t ObjectRenderer::MeshDrawState(int type, int meshIdx,
+                                       const MeshBuffers &mb, float instX,
+                                       float currentTime, float &blendLight,
+                                       glm::vec2 &texOffset) const {
+  blendLight = 1.0f;
+  texOffset = glm::vec2(0.0f);
+
+  bool hasUVScroll = (type == 118 || type == 119 || type == 105);
+  // Noria flowing objects with UV scroll (Main 5.2 MoveObject)
+  bool isNoriaFlowing = (m_mapId == 3 &&
+      (type == 18 || type == 41 || type == 42 || type == 43));
+  if (m_mapId == 3 && type == 41) hasUVScroll = true;
+  bool isDungeonWater = (m_mapId == 1 && type >= 22 && type <= 24);
+  bool disableCullForObj = (m_mapId == 1 &&
+      ((type >= 44 && type <= 46) || (type >= 22 && type <= 24) ||
+       type == 11 || type == 53));
+
+  uint64_t state = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
+                 | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS
+                 | BGFX_STATE_MSAA;
+
+  // Dungeon water: mesh index 1 gets additive UV scroll
+  if (isDungeonWater && meshIdx == 1) {
+    texOffset = glm::vec2(0.0f, m_dungeonWaterScroll);
+    state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
+    state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
+  } else if (isNoriaFlowing && meshIdx == 0) {
+    // Noria stream/flowing objects (Main 5.2 MoveObject):
+    // Type 18: V scroll, Type 41: BlendMesh+V scroll (handled below),
+    // Type 42: StreamMesh U scroll, Type 43: StreamMesh U scroll (opposite)
+    int wt;
+    if (type == 18) {
+      wt = (int)(currentTime * 1000.0f) % 1000;
+      texOffset = glm::vec2(0.0f, (float)wt * 0.001f);
+    } else if (type == 42) {
+      wt = (int)(currentTime * 1000.0f) % 500;
+      texOffset = glm::vec2(-(float)wt * 0.002f, 0.0f);
+    } else if (type == 43) {
+      wt = (int)(currentTime * 1000.0f) % 500;
+      texOffset = glm::vec2((float)wt * 0.002f, 0.0f);
+    }
+    state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
+    state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
+  } else if (mb.isWindowLight) {
+    // BlendMesh (only marked on types with a BlendMesh texture id):
+    // additive blending with intensity flicker
+    float intensity = m_flickerBase;
+    if (type == 52)
+      intensity = 0.70f + 0.12f * std::sin(currentTime * 6.3f)
+                        + 0.08f * std::sin(currentTime * 14.1f + 0.7f)
+                        + 0.05f * std::sin(currentTime * 27.3f + 2.1f);
+    if (type == 90)
+      intensity = 0.7f + 0.1f * std::sin(currentTime * 5.3f);
+    if (type == 150 || type == 98 || type == 105)
+      intensity = 1.0f;
+    if (m_mapId == 1 && (type == 41 || type == 42)) {
+      // Dungeon torches: phase-shifted flicker
+      float phase = instX * 0.013f;
+      intensity = 0.78f + 0.10f * std::sin(currentTime * 3.8f + phase)
+                        + 0.06f * std::sin(currentTime * 9.5f + phase * 2.1f);
+    }
+    // Noria BlendMesh objects: steady glow
+    if (m_mapId == 3) intensity = 1.0f;
+    blendLight = intensity;
+    if (hasUVScroll) {
+      if (m_mapId == 3 && type == 41) {
+        // Noria type 41: slower V scroll (Main 5.2: WorldTime%2000*0.0005)
+        int wt = (int)(currentTime * 1000.0f) % 2000;
+        texOffset = glm::vec2(0.0f, (float)wt * 0.0005f);
+      } else {
+        texOffset = glm::vec2(0.0f, m_uvScroll);
+      }
+    }
+    state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
+    state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
+  } else if (mb.bright) {
+    state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
+    state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
+  } else if (mb.noneBlend) {
+    // No blending, opaque
+    state |= BGFX_STATE_CULL_CW;
+  } else {
+    // Normal mesh: cull backfaces unless alpha or special double-sided
+    if (!mb.hasAlpha && !disableCullForObj) {
+      state |= BGFX_STATE_CULL_CW;
+    }
+    if (mb.hasAlpha) {
+      state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA,
+                                      BGFX_STATE_BLEND_INV_SRC_ALPHA);
+    }
+  }
+  return state;
+}
+
+void ObjectRenderer::SetDrawUniforms(Shader *s, float alpha, float blendLight,
+                                     const glm::vec2 &texOffset,
+                                     const glm::vec4 &params2,
+                                     const glm::vec3 &terrainLight,
+                                     const glm::vec3 &cameraPos) {
+  // u_params: x=objectAlpha, y=blendMeshLight, z=chromeMode, w=chromeTime
+  glm::vec3 sunPos = cameraPos + glm::vec3(0, 8000, 0);
+  float useFog = m_fogEnabled ? 1.0f : 0.0f;
+  s->setVec4("u_params", glm::vec4(alpha, blendLight, 0.0f, 0.0f));
+  s->setVec4("u_params2", params2);
+  s->setVec4("u_lightPos", glm::vec4(sunPos, 0.0f));
+  s->setVec4("u_lightColor", glm::vec4(1.0f, 1.0f, 1.0f, 0.0f));
+  s->setVec4("u_viewPos", glm::vec4(cameraPos, 0.0f));
+  // w=1.0 enables per-pixel lightmap sampling in shader (smooth across meshes)
+  if (TexValid(m_lightmapTex)) {
+    s->setVec4("u_terrainLight", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    s->setTexture(2, "s_lightMap", m_lightmapTex);
+  } else {
+    s->setVec4("u_terrainLight", glm::vec4(terrainLight, 0.0f));
+  }
+  s->setVec4("u_glowColor", glm::vec4(0.0f));
+  s->setVec4("u_baseTint", glm::vec4(1.0f, 1.0f, 1.0f, 0.0f));
+  s->setVec4("u_fogParams", glm::vec4(m_fogNear, m_fogFar, useFog, 0.0f));
+  s->setVec4("u_fogColor", glm::vec4(m_fogColor, 0.0f));
+  s->setVec4("u_texCoordOffset", glm::vec4(texOffset, 0.0f, 0.0f));
+  s->setVec4("u_shadowParams", glm::vec4(0.0f)); // no shadow on world objects
+}
+
+// ─── Instanced batches + spatial grid ───
+
+// Quadtree over the 256x256-tile terrain: GRID_CELLS x GRID_CELLS leaves of
+// 8x8 tiles, numbered in Morton order so that every node covers a
+// contiguous range of leaves.
+static constexpr int GRID_LEVELS = 5;
+static constexpr int GRID_CELLS = 1 << GRID_LEVELS;
+static constexpr int GRID_LEAVES = GRID_CELLS * GRID_CELLS;
+static constexpr float GRID_CELL_SIZE = 25600.0f / GRID_CELLS;
+// Sliding doors move up to 400 units from their origin (UpdateDoors)
+static constexpr float DOOR_REACH = 400.0f;
+// Largest model-space sway offset of vs_model_skinned*.sc (3.0 + 1.2)
+static constexpr float TREE_SWAY = 4.2f;
+
+static uint32_t GridLeaf(const glm::vec3 &pos) {
+  int cx = std::clamp((int)(pos.x / GRID_CELL_SIZE), 0, GRID_CELLS - 1);
+  int cz = std::clamp((int)(pos.z / GRID_CELL_SIZE), 0, GRID_CELLS - 1);
+  uint32_t m = 0;
+  for (int b = 0; b < GRID_LEVELS; ++b)
+    m |= ((uint32_t)(cx >> b) & 1u) << (2 * b) |
+         ((uint32_t)(cz >> b) & 1u) << (2 * b + 1);
+  return m;
+}
+
+static bool IsEmpty(const AABB &b) { return b.min.x > b.max.x; }
+
+static void Grow(AABB &b, const AABB &other) {
+  b.min = glm::min(b.min, other.min);
+  b.max = glm::max(b.max, other.max);
+}
+
+// World bounds of a model-space box under an affine transform
+static AABB TransformBounds(const AABB &box, const glm::mat4 &m) {
+  glm::vec3 c = glm::vec3(m * glm::vec4(box.center(), 1.0f));
+  glm::vec3 e = (box.max - box.min) * 0.5f;
+  glm::vec3 we = glm::abs(glm::vec3(m[0])) * e.x +
+                 glm::abs(glm::vec3(m[1])) * e.y +
+                 glm::abs(glm::vec3(m[2])) * e.z;
+  AABB out;
+  out.min = c - we;
+  out.max = c + we;
+  return out;
+}
+
+// Normalized frustum planes of a view-projection matrix
+static void ExtractFrustum(const glm::mat4 &vp, glm::vec4 frustum[6]) {
   frustum[0] = glm::vec4(vp[0][3] + vp[0][0], vp[1][3] + vp[1][0],
                           vp[2][3] + vp[2][0], vp[3][3] + vp[3][0]);
   frustum[1] = glm::vec4(vp[0][3] - vp[0][0], vp[1][3] - vp[1][0],
@@ -952,8 +1175,295 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
                           vp[2][3] - vp[2][2], vp[3][3] - vp[3][2]);
   for (int i = 0; i < 6; ++i)
     frustum[i] /= glm::length(glm::vec3(frustum[i]));
+}
+
+// -1 = outside, 0 = intersecting, 1 = fully inside
+static int ClassifyBounds(const glm::vec4 frustum[6], const AABB &b) {
+  bool inside = true;
+  for (int p = 0; p < 6; ++p) {
+    const glm::vec4 &f = frustum[p];
+    // Box corners farthest along / against the plane normal
+    glm::vec3 pv(f.x >= 0 ? b.max.x : b.min.x, f.y >= 0 ? b.max.y : b.min.y,
+                 f.z >= 0 ? b.max.z : b.min.z);
+    glm::vec3 nv(f.x >= 0 ? b.min.x : b.max.x, f.y >= 0 ? b.min.y : b.max.y,
+                 f.z >= 0 ? b.min.z : b.max.z);
+    if (glm::dot(glm::vec3(f), pv) + f.w < 0.0f)
+      return -1;
+    if (glm::dot(glm::vec3(f), nv) + f.w < 0.0f)
+      inside = false;
+  }
+  return inside ? 1 : 0;
+}
+
+void ObjectRenderer::BuildInstanceBatches() {
+  DestroyInstanceBatches();
+  m_instanceBatched.assign(instances.size(), false);
+
+  // Model-space bounds per type: the rest pose, or for animated types the
+  // looping action at 4 steps per baked sample (the interpolated poses in
+  // between can leave the samples' bounds), plus the tree sway
+  std::unordered_map<int, AABB> typeBounds;
+  for (auto &[type, cache] : modelCache) {
+    AABB local = cache.bounds;
+    if (!IsEmpty(local) && cache.bmdData && cache.numAnimationKeys > 0) {
+      std::vector<BoneWorldMatrix> bones;
+      const int perKey = AnimationTracks::SAMPLES_PER_KEY * 4;
+      for (int s = 0; s < cache.numAnimationKeys * perKey; ++s) {
+        cache.tracks.Sample(0, (float)s / perKey, bones);
+        Grow(local, ComputeTransformedAABB(cache.bmdData.get(), bones));
+      }
+      if (cache.sway) {
+        local.min -= glm::vec3(TREE_SWAY, TREE_SWAY, 0.0f);
+        local.max += glm::vec3(TREE_SWAY, TREE_SWAY, 0.0f);
+      }
+    }
+    typeBounds[type] = local;
+  }
+
+  // Tight world bounds per instance
+  std::vector<bool> isDoor(instances.size(), false);
+  for (auto &door : m_doors)
+    if (door.instanceIdx >= 0 && door.instanceIdx < (int)instances.size())
+      isDoor[door.instanceIdx] = true;
+  m_instanceBounds.resize(instances.size());
+  for (size_t i = 0; i < instances.size(); ++i) {
+    const auto &inst = instances[i];
+    auto it = typeBounds.find(inst.type);
+    AABB local;
+    if (it != typeBounds.end() && !IsEmpty(it->second))
+      local = it->second;
+    else
+      local.min = local.max = glm::vec3(0.0f);
+    if (isDoor[i]) {
+      // Swinging/sliding: anything the door can reach around its origin
+      float scale = glm::length(glm::vec3(inst.modelMatrix[0]));
+      float reach = std::max(glm::length(local.min), glm::length(local.max)) *
+                        scale + DOOR_REACH;
+      glm::vec3 pos = glm::vec3(inst.modelMatrix[3]);
+      m_instanceBounds[i].min = pos - glm::vec3(reach);
+      m_instanceBounds[i].max = pos + glm::vec3(reach);
+    } else {
+      m_instanceBounds[i] = TransformBounds(local, inst.modelMatrix);
+    }
+  }
+
+  // Instances that need per-instance uniforms or transforms stay unbatched
+  std::vector<bool> perInstance = isDoor;
+  if (!m_instancing)
+    perInstance.assign(instances.size(), true);
+  for (size_t i = 0; i < instances.size(); ++i) {
+    int type = instances[i].type;
+    if (type == 11 && terrainHeightmap.size() >= 256 * 256)
+      perInstance[i] = true; // Cliff fade: per-instance top height
+    if (m_mapId == 1 && (type == 41 || type == 42))
+      perInstance[i] = true; // Dungeon torches: per-instance flicker phase
+  }
+
+  // Grid leaves: bounds of everything whose origin lies in the leaf
+  std::vector<uint32_t> leafOf(instances.size());
+  m_gridNodes.assign(GRID_LEVELS + 1, {});
+  m_gridNodes[GRID_LEVELS].assign(GRID_LEAVES, AABB{});
+  m_cellUnbatched.assign(GRID_LEAVES, {});
+
+  // Group instance indices by (type, pose)
+  std::unordered_map<int, std::vector<int>> groups;
+  for (size_t i = 0; i < instances.size(); ++i) {
+    const auto &inst = instances[i];
+    if (IsTypeSkipped(inst.type))
+      continue;
+    auto it = modelCache.find(inst.type);
+    if (it == modelCache.end() || it->second.meshBuffers.empty())
+      continue;
+    leafOf[i] = GridLeaf(glm::vec3(inst.modelMatrix[3]));
+    Grow(m_gridNodes[GRID_LEVELS][leafOf[i]], m_instanceBounds[i]);
+    if (perInstance[i]) {
+      m_cellUnbatched[leafOf[i]].push_back((int)i);
+      continue;
+    }
+    int pose = -1;
+    if (it->second.isGPUAnimated && it->second.bmdData)
+      pose = std::clamp((int)(inst.animPhaseOffset * it->second.gpuPoses), 0,
+                        it->second.gpuPoses - 1);
+    groups[inst.type * TREE_PHASE_POSES + std::max(pose, 0)].push_back((int)i);
+  }
+
+  // Inner nodes: union of their four children
+  for (int level = GRID_LEVELS - 1; level >= 0; --level) {
+    auto &nodes = m_gridNodes[level];
+    nodes.assign((size_t)1 << (2 * level), AABB{});
+    for (size_t n = 0; n < nodes.size(); ++n)
+      for (int k = 0; k < 4; ++k) {
+        const AABB &child = m_gridNodes[level + 1][n * 4 + k];
+        if (!IsEmpty(child))
+          Grow(nodes[n], child);
+      }
+  }
+
+  int batchedInstances = 0;
+  for (auto &[key, idxs] : groups) {
+    int type = key / TREE_PHASE_POSES;
+    const auto &cache = modelCache[type];
+    bool gpuAnim = cache.isGPUAnimated && cache.bmdData;
+
+    bool drawable = false;
+    for (const auto &mb : cache.meshBuffers)
+      drawable |= mb.indexCount > 0 && !mb.hidden && TexValid(mb.texture);
+    if (!drawable)
+      continue;
+
+    // Leaf order: each grid node is one contiguous range of members
+    std::stable_sort(idxs.begin(), idxs.end(),
+                     [&](int a, int b) { return leafOf[a] < leafOf[b]; });
+    InstanceGroup group;
+    group.type = type;
+    group.cellStart.assign(GRID_LEAVES + 1, 0);
+    for (int i : idxs)
+      group.cellStart[leafOf[i] + 1]++;
+    for (int c = 0; c < GRID_LEAVES; ++c)
+      group.cellStart[c + 1] += group.cellStart[c];
+
+    // i_data0-3: model matrix columns (i_data0.w = sway phase),
+    // i_data4: xyz = terrain light, w = alpha
+    group.data.resize(idxs.size() * 5);
+    for (size_t k = 0; k < idxs.size(); ++k) {
+      const auto &inst = instances[idxs[k]];
+      glm::vec4 *d = &group.data[k * 5];
+      for (int c = 0; c < 4; ++c)
+        d[c] = inst.modelMatrix[c];
+      d[0].w = cache.sway ? inst.animPhaseOffset * 6.2832f : -1.0f;
+      d[4] = glm::vec4(inst.terrainLight, 1.0f);
+      m_instanceBatched[idxs[k]] = true;
+    }
+    batchedInstances += (int)idxs.size();
+    group.members = std::move(idxs);
+    m_groups.push_back(std::move(group));
+
+    // One batch per drawable mesh, all sharing the group's instance buffer
+    for (int mi = 0; mi < (int)cache.meshBuffers.size(); ++mi) {
+      const auto &mb = cache.meshBuffers[mi];
+      if (mb.indexCount == 0 || mb.hidden || !TexValid(mb.texture))
+        continue;
+      InstanceBatch b;
+      b.type = type;
+      b.meshIdx = mi;
+      b.pass = (mb.hasAlpha || mb.isWindowLight || mb.bright) ? 1 : 0;
+      b.pose = gpuAnim ? key % TREE_PHASE_POSES : -1;
+      b.group = (int)m_groups.size() - 1;
+      m_batches.push_back(b);
+    }
+  }
 
-  // Upload point lights
+  // Draw order: pass, then texture, model and mesh (fewest state changes)
+  std::sort(m_batches.begin(), m_batches.end(),
+            [&](const InstanceBatch &a, const InstanceBatch &b) {
+              uint16_t ta = modelCache[a.type].meshBuffers[a.meshIdx].texture.idx;
+              uint16_t tb = modelCache[b.type].meshBuffers[b.meshIdx].texture.idx;
+              return std::tie(a.pass, ta, a.type, a.meshIdx, a.pose) <
+                     std::tie(b.pass, tb, b.type, b.meshIdx, b.pose);
+            });
+
+  std::cout << "[ObjectRenderer] Instanced " << batchedInstances << " of "
+            << instances.size() << " instances into " << m_batches.size()
+            << " batches (" << GRID_CELLS << "x" << GRID_CELLS << " cull grid)"
+            << std::endl;
+}
+
+void ObjectRenderer::DestroyInstanceBatches() {
+  m_groups.clear();
+  m_batches.clear();
+  m_instanceBatched.clear();
+  m_instanceBounds.clear();
+  m_gridNodes.clear();
+  m_cellUnbatched.clear();
+  m_visibleRuns.clear();
+}
+
+void ObjectRenderer::CullGrid(const glm::vec4 frustum[6], int level,
+                              uint32_t node, bool inside) {
+  const AABB &box = m_gridNodes[level][node];
+  if (IsEmpty(box))
+    return;
+  if (!inside) {
+    int c = ClassifyBounds(frustum, box);
+    if (c < 0)
+      return;
+    inside = c > 0;
+  }
+  if (inside || level == GRID_LEVELS) {
+    // Whole subtree visible: its leaves are one contiguous range
+    int shift = 2 * (GRID_LEVELS - level);
+    uint32_t first = node << shift, last = (node + 1) << shift;
+    if (!m_visibleRuns.empty() && m_visibleRuns.back().second == first)
+      m_visibleRuns.back().second = last;
+    else
+      m_visibleRuns.push_back({first, last});
+    return;
+  }
+  for (uint32_t k = 0; k < 4; ++k)
+    CullGrid(frustum, level + 1, node * 4 + k, false);
+}
+
+void ObjectRenderer::RenderBatches(int pass, const glm::vec3 &cameraPos,
+                                   float currentTime) {
+  for (const auto &b : m_batches) {
+    if (b.pass != pass || IsTypeFiltered(b.type))
+      continue;
+
+    float typeAlpha = 1.0f;
+    auto alphaIt = typeAlphaMap.find(b.type);
+    if (alphaIt != typeAlphaMap.end()) {
+      typeAlpha = alphaIt->second;
+      if (typeAlpha < 0.01f) continue;
+    }
+
+    auto &cache = modelCache[b.type];
+    const auto &mb = cache.meshBuffers[b.meshIdx];
+    const auto &group = m_groups[b.group];
+    if (group.visible == 0)
+      continue;
+    Shader *s = b.pose >= 0 ? skinnedInstancedShader.get()
+                            : instancedShader.get();
+    if (!s) continue;
+    if (b.pose >= 0 && cache.gpuBoneCount == 0) continue;
+
+    float blendLight;
+    glm::vec2 texOffset;
+    uint64_t state = MeshDrawState(b.type, b.meshIdx, mb, 0.0f, currentTime,
+                                   blendLight, texOffset);
+    if (b.pose >= 0) {
+      bgfx::setUniform(u_boneMatrices,
+                       glm::value_ptr(cache.gpuBoneMatrices[b.pose * 48]),
+                       cache.gpuBoneCount);
+      s->setVec4("u_skinParams", glm::vec4(0.0f, currentTime, 0.0f, 0.0f));
+    }
+    // Instance terrain light comes from i_data4 (scaled by this uniform)
+    SetDrawUniforms(s, typeAlpha, blendLight, texOffset,
+                    glm::vec4(m_luminosity, 0.0f, 0.0f, 0.0f),
+                    glm::vec3(1.0f), cameraPos);
+    if (mb.isDynamic)
+      bgfx::setVertexBuffer(0, mb.dynVbo);
+    else
+      bgfx::setVertexBuffer(0, mb.vbo);
+    bgfx::setIndexBuffer(mb.ebo);
+    bgfx::setInstanceDataBuffer(&group.idb);
+    s->setTexture(0, "s_texColor", mb.texture);
+    bgfx::setState(state);
+    SubmitDraw(0, s->program);
+  }
+}
+
+// ─── Render ───
+
+void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
+                            const glm::vec3 &cameraPos, float currentTime) {
+  if (instances.empty() || !shader)
+    return;
+
+  // Extract frustum planes from VP matrix for culling
+  glm::vec4 frustum[6];
+  ExtractFrustum(projection * view, frustum);
+
+  // Upload point lights (uniforms are shared by all programs)
   shader->uploadPointLights(plCount, plPositions.data(), plColors.data(), plRanges.data());
 
   // Lazy-init bone matrix uniform handle
@@ -973,7 +1483,7 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
 
         if (cache.isGPUAnimated) {
           auto &state = animStates[type];
-          state.frame += TREE_ANIM_SPEED * dt;
+          state.frame += (cache.sway ? TREE_ANIM_SPEED : ANIM_SPEED) * dt;
           if (state.frame >= (float)cache.numAnimationKeys)
             state.frame = std::fmod(state.frame, (float)cache.numAnimationKeys);
           continue;
@@ -987,7 +1497,8 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
         if (state.frame >= (float)cache.numAnimationKeys)
           state.frame = std::fmod(state.frame, (float)cache.numAnimationKeys);
 
-        auto bones = ComputeBoneMatricesInterpolated(cache.bmdData.get(), 0, state.frame);
+        std::vector<BoneWorldMatrix> bones;
+        cache.tracks.Sample(0, state.frame, bones);
 
         bool isWallFlag = (type == 72 || type == 74);
         if (isWallFlag) {
@@ -1009,54 +1520,103 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
       }
     }
     lastAnimTime = currentTime;
+
+    // GPU poses shared by the instanced batches: TREE_PHASE_POSES phase
+    // offsets per tree type instead of one skeleton evaluation per tree,
+    // a single pose for other types
+    for (auto &[type, cache] : modelCache) {
+      if (!cache.isGPUAnimated || !cache.bmdData)
+        continue;
+      float numKeys = (float)cache.numAnimationKeys;
+      float frame = animStates[type].frame;
+      cache.gpuBoneMatrices.resize(cache.gpuPoses * 48);
+      std::vector<BoneWorldMatrix> bones;
+      for (int p = 0; p < cache.gpuPoses; ++p) {
+        float phase = cache.sway ? ((float)p + 0.5f) / (float)cache.gpuPoses
+                                 : 0.0f;
+        cache.tracks.Sample(0, std::fmod(frame + phase * numKeys, numKeys),
+                            bones);
+        cache.gpuBoneCount = ToGPUBones(bones, &cache.gpuBoneMatrices[p * 48]);
+      }
+    }
   }
 
   // BlendMesh flicker + UV scroll (pure math, same as GL)
-  float flickerBase = 0.72f + 0.09f * std::sin(currentTime * 4.7f)
-                            + 0.07f * std::sin(currentTime * 11.3f + 1.3f)
-                            + 0.04f * std::sin(currentTime * 21.7f + 3.7f);
-  float uvScroll = -std::fmod(currentTime, 1.0f);
+  m_flickerBase = 0.72f + 0.09f * std::sin(currentTime * 4.7f)
+                        + 0.07f * std::sin(currentTime * 11.3f + 1.3f)
+                        + 0.04f * std::sin(currentTime * 21.7f + 3.7f);
+  m_uvScroll = -std::fmod(currentTime, 1.0f);
 
-  float dungeonWaterScroll = 0.0f;
+  m_dungeonWaterScroll = 0.0f;
   if (m_mapId == 1) {
     int wt = (int)(currentTime * 1000.0f) % 1000;
-    dungeonWaterScroll = -(float)wt * 0.001f;
+    m_dungeonWaterScroll = -(float)wt * 0.001f;
   }
 
-  // Common uniforms (BGFX uniforms persist within a frame until overwritten)
-  glm::vec3 sunPos = cameraPos + glm::vec3(0, 8000, 0);
-
-  for (auto &inst : instances) {
-    if (inst.type == 133 || (inst.type >= 130 && inst.type <= 132))
+  // Visible grid leaves: a fully visible node takes its whole subtree
+  // without further tests
+  auto cullStart = std::chrono::steady_clock::now();
+  m_visibleRuns.clear();
+  if (!m_gridNodes.empty())
+    CullGrid(frustum, 0, 0, false);
+
+  // Instances in the visible leaves, tested on their own bounds: per-instance
+  // objects into a list, batched ones into their group's transient buffer
+  std::vector<int> unbatched;
+  uint64_t leafInstances = 0;
+  for (const auto &run : m_visibleRuns)
+    for (uint32_t leaf = run.first; leaf < run.second; ++leaf) {
+      leafInstances += m_cellUnbatched[leaf].size();
+      for (int ii : m_cellUnbatched[leaf])
+        if (ClassifyBounds(frustum, m_instanceBounds[ii]) >= 0)
+          unbatched.push_back(ii);
+    }
+  uint64_t visibleInstances = unbatched.size();
+  const uint16_t instStride = 5 * sizeof(glm::vec4);
+  std::vector<uint32_t> slots;
+  for (auto &group : m_groups) {
+    group.visible = 0;
+    if (IsTypeFiltered(group.type))
       continue;
-    if (m_mapId == 1 && (inst.type == 39 || inst.type == 40 || inst.type == 51 ||
-         inst.type == 52 || inst.type == 60))
+    slots.clear();
+    for (const auto &run : m_visibleRuns) {
+      uint32_t start = group.cellStart[run.first];
+      uint32_t end = group.cellStart[run.second];
+      leafInstances += end - start;
+      for (uint32_t k = start; k < end; ++k)
+        if (ClassifyBounds(frustum, m_instanceBounds[group.members[k]]) >= 0)
+          slots.push_back(k);
+    }
+    if (slots.empty())
       continue;
-    if (m_mapId == 2 && (inst.type == 91 || inst.type == 100))
+    uint32_t count = (uint32_t)slots.size();
+    count = std::min(count, bgfx::getAvailInstanceDataBuffer(count, instStride));
+    if (count == 0)
       continue;
-    if (m_mapId == 3 && inst.type == 38) // Noria pose box (HiddenMesh=-2)
+    bgfx::allocInstanceDataBuffer(&group.idb, count, instStride);
+    glm::vec4 *d = (glm::vec4 *)group.idb.data;
+    for (uint32_t i = 0; i < count; ++i)
+      std::copy_n(&group.data[slots[i] * 5], 5, d + i * 5);
+    group.visible = count;
+    visibleInstances += count;
+  }
+  m_cullStats.cullNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - cullStart)
+                            .count();
+  m_cullStats.calls++;
+  m_cullStats.instances += leafInstances;
+  m_cullStats.visible += visibleInstances;
+  for (const auto &run : m_visibleRuns)
+    m_cullStats.leaves += run.second - run.first;
+
+  // Instanced opaque meshes first (write depth), then the per-instance
+  // objects in their own two passes, then instanced alpha/additive meshes.
+  RenderBatches(0, cameraPos, currentTime);
+
+  for (int ii : unbatched) {
+    auto &inst = instances[ii];
+    if (IsTypeFiltered(inst.type))
       continue;
-    if (!m_typeFilter.empty()) {
-      bool allowed = false;
-      for (int t : m_typeFilter)
-        if (inst.type == t) { allowed = true; break; }
-      if (!allowed) continue;
-    }
-
-    // Frustum culling
-    {
-      glm::vec3 objPos = glm::vec3(inst.modelMatrix[3]);
-      float cullRadius = 500.0f;
-      bool outside = false;
-      for (int p = 0; p < 6; ++p) {
-        if (frustum[p].x * objPos.x + frustum[p].y * objPos.y +
-                frustum[p].z * objPos.z + frustum[p].w < -cullRadius) {
-          outside = true;
-          break;
-        }
-      }
-      if (outside) continue;
-    }
 
     auto it = modelCache.find(inst.type);
     if (it == modelCache.end()) continue;
@@ -1073,39 +1633,45 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
     Shader *activeShader = useGPUSkin ? skinnedShader.get() : shader.get();
     if (!activeShader) continue;
 
-    // GPU skinning: compute and upload per-instance bone matrices
-    if (useGPUSkin) {
+    // GPU skinning: trees get their own phase, other types the shared pose
+    if (useGPUSkin && !it->second.sway) {
+      if (it->second.gpuBoneCount == 0) continue;
+      bgfx::setUniform(u_boneMatrices,
+                       glm::value_ptr(it->second.gpuBoneMatrices[0]),
+                       it->second.gpuBoneCount);
+      activeShader->setVec4("u_skinParams",
+                            glm::vec4(-1.0f, currentTime, 0.0f, 0.0f));
+    } else if (useGPUSkin) {
       auto &state = animStates[inst.type];
       float numKeys = (float)it->second.numAnimationKeys;
       float instFrame = std::fmod(state.frame + inst.animPhaseOffset * numKeys, numKeys);
 
-      auto bones = ComputeBoneMatricesInterpolated(it->second.bmdData.get(), 0, instFrame);
-      int count = std::min((int)bones.size(), 48);
-      static std::vector<glm::mat4> tmpMats;
-      tmpMats.resize(count);
-      for (int bi = 0; bi < count; ++bi) {
-        auto &bm = bones[bi];
-        tmpMats[bi][0] = glm::vec4(bm[0][0], bm[1][0], bm[2][0], 0.0f);
-        tmpMats[bi][1] = glm::vec4(bm[0][1], bm[1][1], bm[2][1], 0.0f);
-        tmpMats[bi][2] = glm::vec4(bm[0][2], bm[1][2], bm[2][2], 0.0f);
-        tmpMats[bi][3] = glm::vec4(bm[0][3], bm[1][3], bm[2][3], 1.0f);
-      }
+      std::vector<BoneWorldMatrix> bones;
+      it->second.tracks.Sample(0, instFrame, bones);
+      glm::mat4 tmpMats[48];
+      int count = ToGPUBones(bones, tmpMats);
       bgfx::setUniform(u_boneMatrices, glm::value_ptr(tmpMats[0]), count);
       activeShader->setVec4("u_skinParams",
           glm::vec4(inst.animPhaseOffset * 6.2832f, currentTime, 0.0f, 0.0f));
     }
 
-    bool hasBlendMesh = it->second.blendMeshTexId >= 0;
-    bool hasUVScroll = (inst.type == 118 || inst.type == 119 || inst.type == 105);
-    // Noria flowing objects with UV scroll (Main 5.2 MoveObject)
-    bool isNoriaFlowing = (m_mapId == 3 &&
-        (inst.type == 18 || inst.type == 41 || inst.type == 42 || inst.type == 43));
-    if (m_mapId == 3 && inst.type == 41) hasUVScroll = true;
-    bool isDungeonWater = (m_mapId == 1 && inst.type >= 22 && inst.type <= 24);
-    bool disableCullForObj = (m_mapId == 1 &&
-        ((inst.type >= 44 && inst.type <= 46) ||
-         (inst.type >= 22 && inst.type <= 24) ||
-         inst.type == 11 || inst.type == 53));
+    // Cliff bottom fade (type 11): darken below the surrounding terrain top
+    float cliffFadeFlag = 0.0f;
+    float cliffTopH = 0.0f;
+    if (inst.type == 11 && terrainHeightmap.size() >= 256 * 256) {
+      cliffFadeFlag = 1.0f;
+      float wx = inst.modelMatrix[3][0];
+      float wz = inst.modelMatrix[3][2];
+      int cz = std::clamp((int)(wx / 100.0f), 0, 255);
+      int cx = std::clamp((int)(wz / 100.0f), 0, 255);
+      for (int dz = -3; dz <= 3; dz++)
+        for (int dx = -3; dx <= 3; dx++) {
+          int iz = std::clamp(cz + dz, 0, 255);
+          int ix = std::clamp(cx + dx, 0, 255);
+          cliffTopH = std::max(cliffTopH, terrainHeightmap[iz * 256 + ix]);
+        }
+    }
+    glm::vec4 params2(m_luminosity, 0.0f, cliffFadeFlag, cliffTopH);
 
     // Two-pass rendering: opaque meshes first (write depth), then
     // alpha/additive meshes (read depth only).
@@ -1113,13 +1679,13 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
 
     int passOrder[2] = {0, 1}; // 0=opaque pass, 1=alpha pass
     for (int pass : passOrder) {
-    int meshIdx = 0;
-    for (auto &mb : meshBufs) {
-      if (mb.indexCount == 0 || mb.hidden) { ++meshIdx; continue; }
-      if (!TexValid(mb.texture)) { ++meshIdx; continue; }
+    for (int meshIdx = 0; meshIdx < (int)meshBufs.size(); ++meshIdx) {
+      auto &mb = meshBufs[meshIdx];
+      if (mb.indexCount == 0 || mb.hidden) continue;
+      if (!TexValid(mb.texture)) continue;
       bool isTransparent = mb.hasAlpha || mb.isWindowLight || mb.bright;
-      if (pass == 0 && isTransparent) { ++meshIdx; continue; }
-      if (pass == 1 && !isTransparent) { ++meshIdx; continue; }
+      if (pass == 0 && isTransparent) continue;
+      if (pass == 1 && !isTransparent) continue;
       bgfx::setTransform(glm::value_ptr(inst.modelMatrix));
 
       // Bind vertex/index buffers
@@ -1133,133 +1699,71 @@ void ObjectRenderer::Render(const glm::mat4 &view, const glm::mat4 &projection,
       // Set texture
       activeShader->setTexture(0, "s_texColor", mb.texture);
 
-      // Common uniforms for this draw call
-      // u_params: x=objectAlpha, y=blendMeshLight, z=chromeMode, w=chromeTime
-      float blendLight = 1.0f;
-      float useFog = m_fogEnabled ? 1.0f : 0.0f;
-      glm::vec2 texOffset(0.0f);
-
-      // Determine blend state
-      uint64_t state = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A
-                     | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS
-                     | BGFX_STATE_MSAA;
-      bool isAdditive = false;
-
-      // Dungeon water: mesh index 1 gets additive UV scroll
-      if (isDungeonWater && meshIdx == 1) {
-        texOffset = glm::vec2(0.0f, dungeonWaterScroll);
-        state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
-        state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
-        isAdditive = true;
-      } else if (isNoriaFlowing && meshIdx == 0) {
-        // Noria stream/flowing objects (Main 5.2 MoveObject):
-        // Type 18: V scroll, Type 41: BlendMesh+V scroll (handled below),
-        // Type 42: StreamMesh U scroll, Type 43: StreamMesh U scroll (opposite)
-        int wt;
-        if (inst.type == 18) {
-          wt = (int)(currentTime * 1000.0f) % 1000;
-          texOffset = glm::vec2(0.0f, (float)wt * 0.001f);
-        } else if (inst.type == 42) {
-          wt = (int)(currentTime * 1000.0f) % 500;
-          texOffset = glm::vec2(-(float)wt * 0.002f, 0.0f);
-        } else if (inst.type == 43) {
-          wt = (int)(currentTime * 1000.0f) % 500;
-          texOffset = glm::vec2((float)wt * 0.002f, 0.0f);
-        }
-        state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
-        state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
-        isAdditive = true;
-      } else if (mb.isWindowLight && hasBlendMesh) {
-        // BlendMesh: additive blending with intensity flicker
-        float intensity = flickerBase;
-        if (inst.type == 52)
-          intensity = 0.70f + 0.12f * std::sin(currentTime * 6.3f)
-                            + 0.08f * std::sin(currentTime * 14.1f + 0.7f)
-                            + 0.05f * std::sin(currentTime * 27.3f + 2.1f);
-        if (inst.type == 90)
-          intensity = 0.7f + 0.1f * std::sin(currentTime * 5.3f);
-        if (inst.type == 150 || inst.type == 98 || inst.type == 105)
-          intensity = 1.0f;
-        if (m_mapId == 1 && (inst.type == 41 || inst.type == 42)) {
-          // Dungeon torches: phase-shifted flicker
-          float phase = inst.modelMatrix[3][0] * 0.013f;
-          intensity = 0.78f + 0.10f * std::sin(currentTime * 3.8f + phase)
-                            + 0.06f * std::sin(currentTime * 9.5f + phase * 2.1f);
-        }
-        // Noria BlendMesh objects: steady glow
-        if (m_mapId == 3) intensity = 1.0f;
-        blendLight = intensity;
-        if (hasUVScroll) {
-          if (m_mapId == 3 && inst.type == 41) {
-            // Noria type 41: slower V scroll (Main 5.2: WorldTime%2000*0.0005)
-            int wt = (int)(currentTime * 1000.0f) % 2000;
-            texOffset = glm::vec2(0.0f, (float)wt * 0.0005f);
-          } else {
-            texOffset = glm::vec2(0.0f, uvScroll);
-          }
-        }
-        state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
-        state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
-        isAdditive = true;
-      } else if (mb.bright) {
-        state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE, BGFX_STATE_BLEND_ONE);
-        state &= ~(uint64_t)BGFX_STATE_WRITE_Z;
-        isAdditive = true;
-      } else if (mb.noneBlend) {
-        // No blending, opaque
-        state |= BGFX_STATE_CULL_CW;
-      } else {
-        // Normal mesh: cull backfaces unless alpha or special double-sided
-        if (!mb.hasAlpha && !disableCullForObj) {
-          state |= BGFX_STATE_CULL_CW;
-        }
-        if (mb.hasAlpha) {
-          state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA,
-                                          BGFX_STATE_BLEND_INV_SRC_ALPHA);
-        }
-      }
-
-      // Set uniforms
-      activeShader->setVec4("u_params", glm::vec4(instAlpha, blendLight, 0.0f, 0.0f));
-      float cliffFadeFlag = 0.0f;
-      float cliffTopH = 0.0f;
-      if (inst.type == 11 && terrainHeightmap.size() >= 256 * 256) {
-        cliffFadeFlag = 1.0f;
-        float wx = inst.modelMatrix[3][0];
-        float wz = inst.modelMatrix[3][2];
-        int cz = std::clamp((int)(wx / 100.0f), 0, 255);
-        int cx = std::clamp((int)(wz / 100.0f), 0, 255);
-        for (int dz = -3; dz <= 3; dz++)
-          for (int dx = -3; dx <= 3; dx++) {
-            int iz = std::clamp(cz + dz, 0, 255);
-            int ix = std::clamp(cx + dx, 0, 255);
-            cliffTopH = std::max(cliffTopH, terrainHeightmap[iz * 256 + ix]);
-          }
-      }
-      activeShader->setVec4("u_params2", glm::vec4(m_luminosity, 0.0f, cliffFadeFlag, cliffTopH));
-      activeShader->setVec4("u_lightPos", glm::vec4(sunPos, 0.0f));
-      activeShader->setVec4("u_lightColor", glm::vec4(1.0f, 1.0f, 1.0f, 0.0f));
-      activeShader->setVec4("u_viewPos", glm::vec4(cameraPos, 0.0f));
-      // w=1.0 enables per-pixel lightmap sampling in shader (smooth across meshes)
-      if (TexValid(m_lightmapTex)) {
-        activeShader->setVec4("u_terrainLight", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-        activeShader->setTexture(2, "s_lightMap", m_lightmapTex);
-      } else {
-        activeShader->setVec4("u_terrainLight", glm::vec4(inst.terrainLight, 0.0f));
-      }
-      activeShader->setVec4("u_glowColor", glm::vec4(0.0f));
-      activeShader->setVec4("u_baseTint", glm::vec4(1.0f, 1.0f, 1.0f, 0.0f));
-      activeShader->setVec4("u_fogParams", glm::vec4(m_fogNear, m_fogFar, useFog, 0.0f));
-      activeShader->setVec4("u_fogColor", glm::vec4(m_fogColor, 0.0f));
-      activeShader->setVec4("u_texCoordOffset", glm::vec4(texOffset, 0.0f, 0.0f));
-      activeShader->setVec4("u_shadowParams", glm::vec4(0.0f)); // no shadow on world objects
+      float blendLight;
+      glm::vec2 texOffset;
+      uint64_t state = MeshDrawState(inst.type, meshIdx, mb,
+                                     inst.modelMatrix[3][0], currentTime,
+                                     blendLight, texOffset);
+      SetDrawUniforms(activeShader, instAlpha, blendLight, texOffset, params2,
+                      inst.terrainLight, cameraPos);
 
       bgfx::setState(state);
-      bgfx::submit(0, activeShader->program);
-      ++meshIdx;
+      SubmitDraw(0, activeShader->program);
     }
     } // end pass loop
   }
+
+  RenderBatches(1, cameraPos, currentTime);
+}
+
+// ── Shadow map casters (static layer) ──
+
+void ObjectRenderer::RenderToShadowMap(uint8_t viewId,
+                                       bgfx::ProgramHandle depthProgram,
+                                       const glm::mat4 &lightMtx) {
+  if (instances.empty())
+    return;
+
+  glm::vec4 frustum[6];
+  ExtractFrustum(lightMtx, frustum);
+
+  // The layer is kept until the light frustum shifts, so only what never
+  // changes goes in: no doors, no roofs (they fade out while the hero is
+  // indoors), no animated models
+  std::vector<bool> isDoor(instances.size(), false);
+  for (const auto &door : m_doors)
+    isDoor[door.instanceIdx] = true;
+
+  // No face culling: thin walls and fences cast from either side
+  uint64_t state = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
+                   BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS;
+
+  for (int ii = 0; ii < (int)instances.size(); ++ii) {
+    const auto &inst = instances[ii];
+    if (isDoor[ii] || IsTypeSkipped(inst.type) || IsTypeFiltered(inst.type) ||
+        typeAlphaMap.count(inst.type))
+      continue;
+    if (ii < (int)m_instanceBounds.size() &&
+        ClassifyBounds(frustum, m_instanceBounds[ii]) < 0)
+      continue;
+    auto it = modelCache.find(inst.type);
+    if (it == modelCache.end() || it->second.isAnimated ||
+        it->second.isGPUAnimated)
+      continue;
+
+    // Opaque meshes only: the depth shader has no alpha test
+    for (const auto &mb : it->second.meshBuffers) {
+      if (mb.indexCount == 0 || mb.hidden || mb.isDynamic)
+        continue;
+      if (mb.hasAlpha || mb.isWindowLight || mb.bright)
+        continue;
+      bgfx::setTransform(glm::value_ptr(inst.modelMatrix));
+      bgfx::setVertexBuffer(0, mb.vbo);
+      bgfx::setIndexBuffer(mb.ebo);
+      bgfx::setState(state);
+      SubmitDraw(viewId, depthProgram);
+    }
+  }
 }
 
 // ── Door animation (Main 5.2: ZzzObject.cpp:3871-3913) ──
@@ -1422,7 +1926,7 @@ void ObjectRenderer::RenderLightningSprites(const glm::mat4 &view,
                  | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_ONE,
                                          BGFX_STATE_BLEND_ONE);
   bgfx::setState(state);
-  bgfx::submit(0, m_spriteShader->program);
+  SubmitDraw(0, m_spriteShader->program);
 }
 
 void ObjectRenderer::Cleanup() {
@@ -1434,6 +1938,7 @@ void ObjectRenderer::Cleanup() {
       TexDestroy(mb.texture);
     }
   }
+  DestroyInstanceBatches();
   modelCache.clear();
   instances.clear();
   m_doors.clear();
@@ -1451,4 +1956,6 @@ void ObjectRenderer::Cleanup() {
   m_spriteShader.reset();
   shader.reset();
   skinnedShader.reset();
+  instancedShader.reset();
+  skinnedInstancedShader.reset();
 }
@@ -168,7 +168,7 @@ PathFinder::FindPath(GridPoint start, GridPoint end,
   // Lambda: check walkability for a terrain cell (caller ensures in-bounds)
   auto isWalkable = [&](uint8_t x, uint8_t y) -> bool {
     uint8_t attr = terrainAttribs[(int)y * TERRAIN_SIZE + (int)x];
-    if (attr & TW_NOMOVE)
+    if (attr & (TW_NOMOVE | TW_NOGROUND))
       return false;
     if (!canEnterSafeZone && (attr & TW_SAFEZONE))
       return false;
@@ -280,3 +280,34 @@ PathFinder::FindPath(GridPoint start, GridPoint end,
 
   return path;
 }
+
+// ── Multi-segment routes ────────────────────────────────────────────────────
+
+std::vector<GridPoint>
+PathFinder::FindRoute(GridPoint start, GridPoint end,
+                      const uint8_t *terrainAttribs, int maxSteps,
+                      bool canEnterSafeZone) const {
+  // Waypoints at most this far apart fit FindPath's largest scoped segment
+  static constexpr int SEGMENT_REACH = 15;
+
+  std::vector<GridPoint> route;
+  GridPoint cur = start;
+  while (cur != end && (int)route.size() < maxSteps) {
+    int dx = (int)end.x - (int)cur.x;
+    int dy = (int)end.y - (int)cur.y;
+    int span = std::max(std::abs(dx), std::abs(dy));
+    std::vector<GridPoint> segment;
+    for (int reach = std::min(span, SEGMENT_REACH); reach > 0 && segment.empty();
+         reach--) {
+      GridPoint waypoint{static_cast<uint8_t>(cur.x + dx * reach / span),
+                         static_cast<uint8_t>(cur.y + dy * reach / span)};
+      segment = FindPath(cur, waypoint, terrainAttribs,
+                         maxSteps - (int)route.size(), 500, canEnterSafeZone);
+    }
+    if (segment.empty())
+      break;
+    route.insert(route.end(), segment.begin(), segment.end());
+    cur = route.back();
+  }
+  return route;
+}
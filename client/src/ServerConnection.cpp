@@ -1,5 +1,7 @@
 #include "ServerConnection.hpp"
 #include "PacketDefs.hpp"
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 bool ServerConnection::Connect(const char *host, uint16_t port) {
@@ -9,6 +11,12 @@ bool ServerConnection::Connect(const char *host, uint16_t port) {
       if (onPacket)
         onPacket(pkt, size);
     };
+    // Bulk C2 packets (viewports, inventory, quest catalog) may come
+    // compressed from here on
+    PMSG_NET_OPTIONS opts{};
+    opts.h = MakeC1Header(sizeof(opts), Opcode::NET_OPTIONS);
+    opts.flags = NET_OPT_COMPRESS;
+    m_client.Send(&opts, sizeof(opts));
   }
   return ok;
 }
@@ -29,6 +37,12 @@ void ServerConnection::SendPrecisePosition(float worldX, float worldZ) {
   m_client.Send(&pkt, sizeof(pkt));
 }
 
+void ServerConnection::SendTownReturn() {
+  PMSG_TOWN_RETURN_RECV pkt{};
+  pkt.h = MakeC1Header(sizeof(pkt), Opcode::TOWN_RETURN);
+  m_client.Send(&pkt, sizeof(pkt));
+}
+
 void ServerConnection::SendAttack(uint16_t monsterIndex) {
   PMSG_ATTACK_RECV pkt{};
   pkt.h = MakeC1Header(sizeof(pkt), Opcode::ATTACK);
@@ -163,6 +177,21 @@ void ServerConnection::SendGridMove(uint8_t gridX, uint8_t gridY) {
   m_client.Send(&pkt, sizeof(pkt));
 }
 
+void ServerConnection::SendMovePath(uint8_t startX, uint8_t startY,
+                                    const uint8_t *pathXY, uint8_t count) {
+  PMSG_MOVE_PATH_RECV pkt{};
+  if (count > 32)
+    count = 32;
+  size_t size = offsetof(PMSG_MOVE_PATH_RECV, path) + count * 2;
+  pkt.h = MakeC1Header((uint8_t)size, Opcode::MOVE_PATH);
+  pkt.startX = startX;
+  pkt.startY = startY;
+  pkt.count = count;
+  if (count > 0)
+    std::memcpy(pkt.path, pathXY, count * 2);
+  m_client.Send(&pkt, size);
+}
+
 void ServerConnection::SendCharCreate(const char *name, uint8_t classCode) {
   PMSG_CHARCREATE_RECV pkt{};
   pkt.h = MakeC1SubHeader(sizeof(pkt), Opcode::CHARSELECT,
@@ -179,7 +179,7 @@ void Sky::Render(const glm::mat4 &view, const glm::mat4 &projection,
 
   bgfx::setVertexBuffer(0, vbo);
   bgfx::setIndexBuffer(ebo);
-  bgfx::submit(0, shader->program);
+  SubmitDraw(0, shader->program);
 
   // ─── Sun sprite ─────────────────────────────────────────────────
   if (bgfx::isValid(sunVbo) && TexValid(sunTexture)) {
@@ -215,7 +215,7 @@ void Sky::Render(const glm::mat4 &view, const glm::mat4 &projection,
 
     bgfx::setVertexBuffer(0, sunVbo);
     bgfx::setIndexBuffer(sunEbo);
-    bgfx::submit(0, shader->program);
+    SubmitDraw(0, shader->program);
   }
 }
 
@@ -1,5 +1,7 @@
 #include "Terrain.hpp"
 #include "TextureLoader.hpp"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
@@ -38,6 +40,9 @@ void Terrain::Cleanup() {
   if (bgfx::isValid(voidVbo)) { bgfx::destroy(voidVbo); voidVbo = BGFX_INVALID_HANDLE; }
   if (bgfx::isValid(voidEbo)) { bgfx::destroy(voidEbo); voidEbo = BGFX_INVALID_HANDLE; }
   voidIndexCount = 0;
+  indexCount = 0;
+  m_chunks.clear();
+  m_chunksPerSide = 0;
   TexDestroy(tileTextureArray);
   TexDestroy(layer1InfoMap);
   TexDestroy(layer2InfoMap);
@@ -434,8 +439,7 @@ void Terrain::Render(const glm::mat4 &view, const glm::mat4 &projection,
   bgfx::setState(state);
 
   bgfx::setVertexBuffer(0, vbo);
-  bgfx::setIndexBuffer(ebo);
-  bgfx::submit(0, shader->program);
+  submitChunks(0, projection * view, viewPos, shader->program);
 
   // Void mesh: cliff walls — no backface culling, vertex color gradient
   if (voidIndexCount > 0 && bgfx::isValid(voidVbo)) {
@@ -464,7 +468,7 @@ void Terrain::Render(const glm::mat4 &view, const glm::mat4 &projection,
     bgfx::setState(voidState);
     bgfx::setVertexBuffer(0, voidVbo);
     bgfx::setIndexBuffer(voidEbo);
-    bgfx::submit(0, shader->program);
+    SubmitDraw(0, shader->program);
   }
 }
 
@@ -504,8 +508,91 @@ void Terrain::RenderToView(bgfx::ViewId viewId, const glm::mat4 &view,
   bgfx::setState(state);
 
   bgfx::setVertexBuffer(0, vbo);
-  bgfx::setIndexBuffer(ebo);
-  bgfx::submit(viewId, shader->program);
+  submitChunks(viewId, proj * view, viewPos, shader->program);
+}
+
+// ─── Chunk culling / LOD ───
+
+// Horizontal distance from the viewer to a chunk's nearest edge at which
+// it drops to LOD 1 and LOD 2 (a chunk is 1600 units across)
+static const float LOD_DISTANCES[] = {1600.0f, 4000.0f};
+
+static void extractFrustum(const glm::mat4 &vp, glm::vec4 frustum[6]) {
+  for (int i = 0; i < 3; ++i) {
+    for (int sign = 0; sign < 2; ++sign) {
+      float s = sign ? -1.0f : 1.0f;
+      glm::vec4 &f = frustum[i * 2 + sign];
+      f = glm::vec4(vp[0][3] + s * vp[0][i], vp[1][3] + s * vp[1][i],
+                    vp[2][3] + s * vp[2][i], vp[3][3] + s * vp[3][i]);
+      f /= glm::length(glm::vec3(f));
+    }
+  }
+}
+
+static bool boxOutside(const glm::vec4 frustum[6], const glm::vec3 &bmin,
+                       const glm::vec3 &bmax) {
+  for (int p = 0; p < 6; ++p) {
+    const glm::vec4 &f = frustum[p];
+    glm::vec3 pv(f.x >= 0 ? bmax.x : bmin.x, f.y >= 0 ? bmax.y : bmin.y,
+                 f.z >= 0 ? bmax.z : bmin.z);
+    if (glm::dot(glm::vec3(f), pv) + f.w < 0.0f)
+      return true;
+  }
+  return false;
+}
+
+void Terrain::submitChunks(bgfx::ViewId viewId, const glm::mat4 &viewProj,
+                           const glm::vec3 &viewPos,
+                           bgfx::ProgramHandle program) {
+  glm::vec4 frustum[6];
+  extractFrustum(viewProj, frustum);
+
+  m_drawRanges.clear();
+  m_drawStats.calls++;
+  for (const Chunk &chunk : m_chunks) {
+    if (boxOutside(frustum, chunk.boundsMin, chunk.boundsMax))
+      continue;
+    int lod = 0;
+    if (!chunk.hasHoles) {
+      float dx = std::max({chunk.boundsMin.x - viewPos.x, 0.0f,
+                           viewPos.x - chunk.boundsMax.x});
+      float dz = std::max({chunk.boundsMin.z - viewPos.z, 0.0f,
+                           viewPos.z - chunk.boundsMax.z});
+      float dist = std::sqrt(dx * dx + dz * dz);
+      while (lod < LOD_COUNT - 1 && dist >= LOD_DISTANCES[lod])
+        ++lod;
+    }
+    if (chunk.count[lod] == 0)
+      continue;
+    m_drawStats.chunks++;
+    m_drawStats.triangles += chunk.count[lod] / 3;
+    m_drawRanges.push_back({chunk.first[lod], chunk.count[lod]});
+  }
+
+  // Back-to-back ranges in the index buffer go out as one draw
+  std::sort(m_drawRanges.begin(), m_drawRanges.end());
+  size_t merged = 0;
+  for (size_t i = 0; i < m_drawRanges.size(); ++i) {
+    if (merged > 0 && m_drawRanges[merged - 1].first +
+                              m_drawRanges[merged - 1].second ==
+                          m_drawRanges[i].first)
+      m_drawRanges[merged - 1].second += m_drawRanges[i].second;
+    else
+      m_drawRanges[merged++] = m_drawRanges[i];
+  }
+  m_drawRanges.resize(merged);
+
+  if (m_drawRanges.empty()) {
+    bgfx::discard(); // Drop the bindings the caller set up
+    return;
+  }
+  for (size_t i = 0; i < m_drawRanges.size(); ++i) {
+    bgfx::setIndexBuffer(ebo, m_drawRanges[i].first, m_drawRanges[i].second);
+    bool last = i + 1 == m_drawRanges.size();
+    SubmitDraw(viewId, program,
+               last ? BGFX_DISCARD_ALL : BGFX_DISCARD_INDEX_BUFFER);
+  }
+  m_drawStats.draws += m_drawRanges.size();
 }
 
 void Terrain::SetShadowMap(bgfx::TextureHandle tex, const glm::mat4 &lightMtx) {
@@ -542,37 +629,129 @@ void Terrain::setupMesh(const std::vector<float> &heightmap,
     }
   }
 
-  // Generate indices: skip void quads (normal terrain rendering)
-  for (int z = 0; z < size - 1; ++z) {
-    for (int x = 0; x < size - 1; ++x) {
-      int i00 = z * size + x;
-      int i01 = z * size + (x + 1);
-      int i10 = (z + 1) * size + x;
-      int i11 = (z + 1) * size + (x + 1);
-      // Skip void quads (top-left corner check only — matching original engine).
-      // Terrain quads at void edges intentionally extend one cell into void to
-      // fill gaps behind world objects (tentacles, cliff walls).
-      if (hasAttrs && (rawAttributes[i00] & 0x08) &&
-          !(hasBridgeMask && bridgeMask[i00]))
+  // Void quads are skipped (top-left corner check only — matching original
+  // engine). Terrain quads at void edges intentionally extend one cell into
+  // void to fill gaps behind world objects (tentacles, cliff walls).
+  auto cellVisible = [&](int x, int z) {
+    int i = z * size + x;
+    return !(hasAttrs && (rawAttributes[i] & 0x08) &&
+             !(hasBridgeMask && bridgeMask[i]));
+  };
+
+  // ── Skirt vertices ──
+  // One lowered copy of every vertex on a chunk border. A coarse edge segment
+  // spans at most maxStep cells, so dropping each end below the lowest
+  // border height within maxStep keeps the skirt under the full-detail edge.
+  const int maxStep = 1 << (LOD_COUNT - 1);
+  const float SKIRT_MARGIN = 20.0f;
+  auto onBorder = [&](int c) { return c % CHUNK_CELLS == 0 || c == size - 1; };
+  std::vector<int32_t> skirtOf(size * size, -1);
+  for (int z = 0; z < size; ++z) {
+    for (int x = 0; x < size; ++x) {
+      bool borderX = onBorder(x), borderZ = onBorder(z);
+      if (!borderX && !borderZ)
         continue;
-      int current = z * size + x;
-      int next = current + size;
-      indices.push_back(current);
-      indices.push_back(current + 1);
-      indices.push_back(next + 1);
-      indices.push_back(current);
-      indices.push_back(next + 1);
-      indices.push_back(next);
+      float lo = heightmap[z * size + x];
+      for (int d = -maxStep; d <= maxStep; ++d) {
+        if (borderX && z + d >= 0 && z + d < size)
+          lo = std::min(lo, heightmap[(z + d) * size + x]);
+        if (borderZ && x + d >= 0 && x + d < size)
+          lo = std::min(lo, heightmap[z * size + x + d]);
+      }
+      Vertex v = vertices[z * size + x];
+      v.position.y = lo - SKIRT_MARGIN;
+      skirtOf[z * size + x] = (int32_t)vertices.size();
+      vertices.push_back(v);
+    }
+  }
+
+  // ── Chunk index ranges ──
+  const int cells = size - 1;
+  m_chunksPerSide = (cells + CHUNK_CELLS - 1) / CHUNK_CELLS;
+  m_chunks.assign(m_chunksPerSide * m_chunksPerSide, Chunk{});
+  for (int cz = 0; cz < m_chunksPerSide; ++cz) {
+    for (int cx = 0; cx < m_chunksPerSide; ++cx) {
+      Chunk &chunk = m_chunks[cz * m_chunksPerSide + cx];
+      int x0 = cx * CHUNK_CELLS, x1 = std::min(x0 + CHUNK_CELLS, cells);
+      int z0 = cz * CHUNK_CELLS, z1 = std::min(z0 + CHUNK_CELLS, cells);
+      float lo = heightmap[z0 * size + x0], hi = lo;
+      for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+          float h = heightmap[z * size + x];
+          lo = std::min(lo, h);
+          hi = std::max(hi, h);
+          if (x < x1 && z < z1 && !cellVisible(x, z))
+            chunk.hasHoles = true;
+          int skirt = skirtOf[z * size + x];
+          if (skirt >= 0)
+            lo = std::min(lo, vertices[skirt].position.y);
+        }
+      }
+      // Grid z runs along world X, grid x along world Z (see vertices above)
+      chunk.boundsMin = glm::vec3(z0 * 100.0f, lo, x0 * 100.0f);
+      chunk.boundsMax = glm::vec3(z1 * 100.0f, hi, x1 * 100.0f);
+    }
+  }
+
+  auto quad = [&](int xa, int za, int xb, int zb) {
+    uint32_t i00 = za * size + xa, i01 = za * size + xb;
+    uint32_t i10 = zb * size + xa, i11 = zb * size + xb;
+    indices.insert(indices.end(), {i00, i01, i11, i00, i11, i10});
+  };
+  // (cellX, cellZ) = the chunk cell the segment borders; none under void
+  auto skirt = [&](int xa, int za, int xb, int zb, int cellX, int cellZ) {
+    if (!cellVisible(cellX, cellZ))
+      return;
+    uint32_t a = za * size + xa, b = zb * size + xb;
+    uint32_t sa = skirtOf[a], sb = skirtOf[b];
+    indices.insert(indices.end(), {a, b, sb, a, sb, sa});
+  };
+  size_t fullIndexCount = 0;
+  for (int lod = 0; lod < LOD_COUNT; ++lod) {
+    const int step = 1 << lod;
+    for (int cz = 0; cz < m_chunksPerSide; ++cz) {
+      for (int cx = 0; cx < m_chunksPerSide; ++cx) {
+        Chunk &chunk = m_chunks[cz * m_chunksPerSide + cx];
+        chunk.first[lod] = (uint32_t)indices.size();
+        if (lod > 0 && chunk.hasHoles)
+          continue; // Never drawn coarse
+        int x0 = cx * CHUNK_CELLS, x1 = std::min(x0 + CHUNK_CELLS, cells);
+        int z0 = cz * CHUNK_CELLS, z1 = std::min(z0 + CHUNK_CELLS, cells);
+        for (int z = z0; z < z1; z += step) {
+          for (int x = x0; x < x1; x += step) {
+            if (lod == 0 && !cellVisible(x, z))
+              continue;
+            quad(x, z, std::min(x + step, x1), std::min(z + step, z1));
+          }
+        }
+        // A chunk with holes stays at full detail at any distance, so a
+        // coarser neighbour can be on the viewer's side of the shared edge
+        // and the gap above that neighbour's skirt is open: skirt it too
+        if (lod > 0 || chunk.hasHoles) {
+          for (int x = x0; x < x1; x += step) {
+            skirt(x, z0, std::min(x + step, x1), z0, x, z0);
+            skirt(x, z1, std::min(x + step, x1), z1, x, z1 - 1);
+          }
+          for (int z = z0; z < z1; z += step) {
+            skirt(x0, z, x0, std::min(z + step, z1), x0, z);
+            skirt(x1, z, x1, std::min(z + step, z1), x1 - 1, z);
+          }
+        }
+        chunk.count[lod] = (uint32_t)indices.size() - chunk.first[lod];
+      }
     }
+    if (lod == 0)
+      fullIndexCount = indices.size();
   }
-  indexCount = indices.size();
+  indexCount = fullIndexCount;
 
   // Create BGFX vertex buffer
   const bgfx::Memory *vMem =
       bgfx::copy(vertices.data(), vertices.size() * sizeof(Vertex));
   vbo = bgfx::createVertexBuffer(vMem, s_terrainLayout);
 
-  // Create BGFX index buffer (32-bit: 256x256 = 65536 vertices exceeds uint16)
+  // Create BGFX index buffer (32-bit: 256x256 = 65536 vertices exceeds uint16,
+  // and the skirts come on top)
   const bgfx::Memory *iMem =
       bgfx::copy(indices.data(), indices.size() * sizeof(uint32_t));
   ebo = bgfx::createIndexBuffer(iMem, BGFX_BUFFER_INDEX32);
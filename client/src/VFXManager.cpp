@@ -1751,7 +1751,7 @@ void VFXManager::renderRibbons(const glm::mat4 &view,
       m_lineShader->setTexture(0, "s_ribbonTex", m_lightningTexture);
     bgfx::setVertexBuffer(0, &tvb);
     bgfx::setState(state);
-    bgfx::submit(0, m_lineShader->program);
+    SubmitDraw(0, m_lineShader->program);
   }
 }
 
@@ -1808,7 +1808,7 @@ void VFXManager::Render(const glm::mat4 &view, const glm::mat4 &projection) {
       state |= BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA,
                                        BGFX_STATE_BLEND_INV_SRC_ALPHA);
     bgfx::setState(state);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, m_shader->program);
   };
 
   // Normal alpha blend particles
@@ -2063,7 +2063,7 @@ void VFXManager::renderBuffAuras(const glm::mat4 &view, const glm::mat4 &project
       m_lineShader->setTexture(0, "s_ribbonTex", tex);
       bgfx::setVertexBuffer(0, &tvb);
       bgfx::setState(state);
-      bgfx::submit(0, m_lineShader->program);
+      SubmitDraw(0, m_lineShader->program);
     }
   }
 }
@@ -2207,7 +2207,7 @@ void VFXManager::renderLevelUpEffects(const glm::mat4 &view,
         m_lineShader->setTexture(0, "s_ribbonTex", flareTex);
         bgfx::setVertexBuffer(0, &tvb);
         bgfx::setState(state);
-        bgfx::submit(0, m_lineShader->program);
+        SubmitDraw(0, m_lineShader->program);
       }
     }
   }
@@ -2249,7 +2249,7 @@ void VFXManager::renderLevelUpEffects(const glm::mat4 &view,
         uint64_t bs = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_DEPTH_TEST_LESS
                     | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_ONE);
         bgfx::setState(bs);
-        bgfx::submit(0, m_shader->program);
+        SubmitDraw(0, m_shader->program);
       }
     }
   }
@@ -2292,7 +2292,7 @@ void VFXManager::renderGroundCircles(const glm::mat4 &view,
     m_lineShader->setTexture(0, "s_ribbonTex", m_magicGroundTexture);
     bgfx::setVertexBuffer(0, &tvb);
     bgfx::setState(state);
-    bgfx::submit(0, m_lineShader->program);
+    SubmitDraw(0, m_lineShader->program);
   }
 }
 
@@ -2323,7 +2323,7 @@ void VFXManager::renderSpellProjectiles(const glm::mat4 &view,
     bgfx::setInstanceDataBuffer(&idb);
     m_shader->setTexture(0, "s_fireTex", tex);
     bgfx::setState(blendState);
-    bgfx::submit(0, m_shader->program);
+    SubmitDraw(0, m_shader->program);
   };
 
   uint64_t addState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_DEPTH_TEST_LESS
@@ -2402,7 +2402,7 @@ void VFXManager::renderFireModel(const SpellProjectile &p,
     bgfx::setVertexBuffer(0, mb.vbo);
     bgfx::setIndexBuffer(mb.ebo);
     bgfx::setState(state);
-    bgfx::submit(0, m_modelShader->program);
+    SubmitDraw(0, m_modelShader->program);
   }
 }
 
@@ -212,7 +212,7 @@ void VFXManager::renderMeteorBolts(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -341,7 +341,7 @@ void VFXManager::renderIceCrystals(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -379,7 +379,7 @@ void VFXManager::renderIceShards(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -420,7 +420,7 @@ void VFXManager::renderLightningBolts(const glm::mat4 &view,
         bgfx::setVertexBuffer(0, mb.vbo);
         bgfx::setIndexBuffer(mb.ebo);
         bgfx::setState(mState);
-        bgfx::submit(0, m_modelShader->program);
+        SubmitDraw(0, m_modelShader->program);
       }
     }
   }
@@ -480,7 +480,7 @@ void VFXManager::renderLightningBolts(const glm::mat4 &view,
       m_lineShader->setTexture(0, "s_ribbonTex", m_energyTexture);
       bgfx::setVertexBuffer(0, &tvb);
       bgfx::setState(rState);
-      bgfx::submit(0, m_lineShader->program);
+      SubmitDraw(0, m_lineShader->program);
     }
   }
 }
@@ -573,7 +573,7 @@ void VFXManager::renderFlameGrounds(const glm::mat4 &view,
     m_lineShader->setTexture(0, "s_ribbonTex", m_flameTexture);
     bgfx::setVertexBuffer(0, &tvb);
     bgfx::setState(state);
-    bgfx::submit(0, m_lineShader->program);
+    SubmitDraw(0, m_lineShader->program);
   }
 }
 
@@ -633,7 +633,7 @@ void VFXManager::renderPoisonClouds(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -790,7 +790,7 @@ void VFXManager::renderTwisterStorms(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
   m_modelShader->setVec4("u_texCoordOffset", glm::vec4(0.0f));
@@ -99,7 +99,7 @@ void VFXManager::renderWeaponTrail(const glm::mat4 &view,
       if (hasTexture) m_lineShader->setTexture(0, "s_ribbonTex", blurTex);
       bgfx::setVertexBuffer(0, &tvb);
       bgfx::setState(state);
-      bgfx::submit(0, m_lineShader->program);
+      SubmitDraw(0, m_lineShader->program);
     }
   }
 }
@@ -475,7 +475,7 @@ void VFXManager::renderEarthQuakeCracks(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
   m_modelShader->setVec4("u_texCoordOffset", glm::vec4(0.0f));
@@ -549,7 +549,7 @@ void VFXManager::renderStoneDebris(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -928,7 +928,7 @@ void VFXManager::renderDeathStabShocks(const glm::mat4 &view,
       if (TexValid(m_lightningTexture)) m_lineShader->setTexture(0, "s_ribbonTex", m_lightningTexture);
       bgfx::setVertexBuffer(0, &tvb);
       bgfx::setState(state);
-      bgfx::submit(0, m_lineShader->program);
+      SubmitDraw(0, m_lineShader->program);
     }
   }
 }
@@ -983,7 +983,7 @@ void VFXManager::renderDeathStabSpirals(const glm::mat4 &view,
       if (TexValid(tex)) m_lineShader->setTexture(0, "s_ribbonTex", tex);
       bgfx::setVertexBuffer(0, &tvb);
       bgfx::setState(state);
-      bgfx::submit(0, m_lineShader->program);
+      SubmitDraw(0, m_lineShader->program);
     }
   }
 }
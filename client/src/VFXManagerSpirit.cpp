@@ -211,7 +211,7 @@ void VFXManager::renderSpiritBeams(const glm::mat4 &view,
       if (hasTexture) m_lineShader->setTexture(0, "s_ribbonTex", tex);
       bgfx::setVertexBuffer(0, &tvb);
       bgfx::setState(state);
-      bgfx::submit(0, m_lineShader->program);
+      SubmitDraw(0, m_lineShader->program);
     }
   }
 }
@@ -259,7 +259,7 @@ void VFXManager::renderLaserFlashes(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -510,7 +510,7 @@ void VFXManager::renderHellfireEffects(const glm::mat4 &view,
         bgfx::setVertexBuffer(0, mb.vbo);
         bgfx::setIndexBuffer(mb.ebo);
         bgfx::setState(state);
-        bgfx::submit(0, m_modelShader->program);
+        SubmitDraw(0, m_modelShader->program);
       }
     }
 
@@ -535,7 +535,7 @@ void VFXManager::renderHellfireEffects(const glm::mat4 &view,
           bgfx::setVertexBuffer(0, mb.vbo);
           bgfx::setIndexBuffer(mb.ebo);
           bgfx::setState(state);
-          bgfx::submit(0, m_modelShader->program);
+          SubmitDraw(0, m_modelShader->program);
         }
       }
     }
@@ -667,7 +667,7 @@ void VFXManager::renderInfernoEffects(const glm::mat4 &view,
       bgfx::setVertexBuffer(0, mb.vbo);
       bgfx::setIndexBuffer(mb.ebo);
       bgfx::setState(state);
-      bgfx::submit(0, m_modelShader->program);
+      SubmitDraw(0, m_modelShader->program);
     }
   }
 }
@@ -872,7 +872,7 @@ void VFXManager::renderAquaBeams(const glm::mat4 &view,
         m_lineShader->setVec4("u_lineColor", glm::vec4(pass.color, 1.0f));
         bgfx::setVertexBuffer(0, &tvb);
         bgfx::setState(state);
-        bgfx::submit(0, m_lineShader->program);
+        SubmitDraw(0, m_lineShader->program);
       }
     }
   }
@@ -1,5 +1,8 @@
 #include "ViewerCommon.hpp"
+#include <algorithm>
 #include <cmath>
+#include <iostream>
+#include <set>
 
 #include <bgfx/bgfx.h>
 #include <cstring>
@@ -23,6 +26,48 @@ const bgfx::VertexLayout &GetModelVertexLayout() {
 
 // ---------- BGFX Mesh upload ----------
 
+// Texture, script flags and BMD texture id shared by both upload paths
+static void ApplyMeshTexture(const Mesh_t &mesh, const std::string &textureDir,
+                             MeshBuffers &mb) {
+  // Load texture
+  auto texResult = TextureLoader::ResolveWithInfo(textureDir, mesh.TextureName);
+  mb.texture = texResult.textureID;
+  mb.hasAlpha = texResult.hasAlpha;
+
+  // Parse texture script flags
+  auto scriptFlags = TextureLoader::ParseScriptFlags(mesh.TextureName);
+  mb.noneBlend = scriptFlags.noneBlend;
+  mb.hidden = scriptFlags.hidden;
+  mb.bright = scriptFlags.bright;
+
+  // Main 5.2: BITMAP_HIDE — meshes with "hide" textures are never rendered.
+  {
+    std::string texLower = mesh.TextureName;
+    std::transform(texLower.begin(), texLower.end(), texLower.begin(),
+                   ::tolower);
+    auto slash = texLower.find_last_of("\\/");
+    if (slash != std::string::npos)
+      texLower = texLower.substr(slash + 1);
+    auto dot = texLower.find_last_of('.');
+    if (dot != std::string::npos)
+      texLower = texLower.substr(0, dot);
+
+    if (texLower == "hide" || texLower == "hide_m" || texLower == "hide22") {
+      mb.hidden = true;
+    }
+    if (texLower.find("flail00") != std::string::npos) {
+      mb.bright = true;
+    }
+    // NPC wings (e.g. ElfWizard): JPEG has no alpha, use additive blending
+    // so black areas become transparent (Main 5.2: BlendMesh on wing mesh)
+    if (texLower.find("wing") != std::string::npos) {
+      mb.bright = true;
+    }
+  }
+
+  mb.bmdTextureId = mesh.Texture;
+}
+
 void UploadMeshWithBones(const Mesh_t &mesh, const std::string &textureDir,
                          const std::vector<BoneWorldMatrix> &bones,
                          std::vector<MeshBuffers> &out, AABB &aabb,
@@ -109,44 +154,7 @@ void UploadMeshWithBones(const Mesh_t &mesh, const std::string &textureDir,
   }
 
   mb.ebo = bgfx::createIndexBuffer(bgfx::copy(indices.data(), ibSize));
-
-  // Load texture
-  auto texResult = TextureLoader::ResolveWithInfo(textureDir, mesh.TextureName);
-  mb.texture = texResult.textureID;
-  mb.hasAlpha = texResult.hasAlpha;
-
-  // Parse texture script flags
-  auto scriptFlags = TextureLoader::ParseScriptFlags(mesh.TextureName);
-  mb.noneBlend = scriptFlags.noneBlend;
-  mb.hidden = scriptFlags.hidden;
-  mb.bright = scriptFlags.bright;
-
-  // Main 5.2: BITMAP_HIDE — meshes with "hide" textures are never rendered.
-  {
-    std::string texLower = mesh.TextureName;
-    std::transform(texLower.begin(), texLower.end(), texLower.begin(),
-                   ::tolower);
-    auto slash = texLower.find_last_of("\\/");
-    if (slash != std::string::npos)
-      texLower = texLower.substr(slash + 1);
-    auto dot = texLower.find_last_of('.');
-    if (dot != std::string::npos)
-      texLower = texLower.substr(0, dot);
-
-    if (texLower == "hide" || texLower == "hide_m" || texLower == "hide22") {
-      mb.hidden = true;
-    }
-    if (texLower.find("flail00") != std::string::npos) {
-      mb.bright = true;
-    }
-    // NPC wings (e.g. ElfWizard): JPEG has no alpha, use additive blending
-    // so black areas become transparent (Main 5.2: BlendMesh on wing mesh)
-    if (texLower.find("wing") != std::string::npos) {
-      mb.bright = true;
-    }
-  }
-
-  mb.bmdTextureId = mesh.Texture;
+  ApplyMeshTexture(mesh, textureDir, mb);
   out.push_back(mb);
 }
 
@@ -155,6 +163,21 @@ void UploadMeshWithBones(const Mesh_t &mesh, const std::string &textureDir,
 void RetransformMeshWithBones(const Mesh_t &mesh,
                               const std::vector<BoneWorldMatrix> &bones,
                               MeshBuffers &mb) {
+  if (mb.isSkinned) {
+    // Only the palette changes; BindMesh uploads it with the draw
+    mb.bonePalette.resize(mb.boneCount * 12);
+    for (int b = 0; b < mb.boneCount; ++b) {
+      float *rows = &mb.bonePalette[b * 12];
+      if (b < (int)bones.size()) {
+        memcpy(rows, bones[b].data(), 12 * sizeof(float));
+      } else {
+        static const float identity[12] = {1, 0, 0, 0, 0, 1, 0, 0,
+                                           0, 0, 1, 0};
+        memcpy(rows, identity, sizeof(identity));
+      }
+    }
+    return;
+  }
   if (!mb.isDynamic || mb.vertexCount == 0 || !bgfx::isValid(mb.dynVbo))
     return;
 
@@ -211,6 +234,125 @@ void RetransformMeshWithBones(const Mesh_t &mesh,
   bgfx::update(mb.dynVbo, 0, bgfx::copy(vertices.data(), size));
 }
 
+// ---------- BGFX GPU skinning ----------
+
+struct SkinnedVertex {
+  glm::vec3 pos;    // Bind space
+  glm::vec3 normal; // Bind space
+  glm::vec2 tex;
+  float bone[4];    // x = bone index, -1 = unskinned
+};
+
+static bgfx::VertexLayout s_skinnedLayout;
+static bool s_skinnedLayoutInit = false;
+static bgfx::UniformHandle s_bonePaletteUniform = BGFX_INVALID_HANDLE;
+
+const bgfx::VertexLayout &GetSkinnedVertexLayout() {
+  if (!s_skinnedLayoutInit) {
+    s_skinnedLayout.begin()
+        .add(bgfx::Attrib::Position,  3, bgfx::AttribType::Float)
+        .add(bgfx::Attrib::Normal,    3, bgfx::AttribType::Float)
+        .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+        .add(bgfx::Attrib::TexCoord1, 4, bgfx::AttribType::Float)
+        .end();
+    s_skinnedLayoutInit = true;
+  }
+  return s_skinnedLayout;
+}
+
+static SkinFallbackStats s_skinFallback;
+static std::set<std::string> s_skinFallbackSeen;
+
+const SkinFallbackStats &GetSkinFallbackStats() { return s_skinFallback; }
+
+void UploadSkinnedMesh(const Mesh_t &mesh, const std::string &textureDir,
+                       const std::vector<BoneWorldMatrix> &bones,
+                       std::vector<MeshBuffers> &out, AABB &aabb) {
+  int boneCount = 0;
+  for (int i = 0; i < mesh.NumVertices; ++i)
+    boneCount = std::max(boneCount, (int)mesh.Vertices[i].Node + 1);
+  if (boneCount > MAX_SKIN_BONES) {
+    s_skinFallback.uploads++;
+    s_skinFallback.maxBones = std::max(s_skinFallback.maxBones, boneCount);
+    if (s_skinFallbackSeen.insert(textureDir + mesh.TextureName).second) {
+      s_skinFallback.meshes++;
+      std::cout << "[Skin] " << textureDir << mesh.TextureName << ": "
+                << boneCount << " bones > " << MAX_SKIN_BONES
+                << ", CPU skinning" << std::endl;
+    }
+    UploadMeshWithBones(mesh, textureDir, bones, out, aabb, true);
+    return;
+  }
+
+  MeshBuffers mb;
+  std::vector<SkinnedVertex> vertices;
+  std::vector<uint16_t> indices;
+
+  // Same corner order as UploadMeshWithBones: quads split into 0-1-2, 0-2-3
+  static const int triCorners[3] = {0, 1, 2};
+  static const int quadCorners[3] = {0, 2, 3};
+  for (int i = 0; i < mesh.NumTriangles; ++i) {
+    auto &tri = mesh.Triangles[i];
+    for (int pass = 0; pass < (tri.Polygon == 3 ? 1 : 2); ++pass) {
+      const int *corners = pass == 0 ? triCorners : quadCorners;
+      for (int c = 0; c < 3; ++c) {
+        int v = corners[c];
+        auto &srcVert = mesh.Vertices[tri.VertexIndex[v]];
+        SkinnedVertex vert;
+        vert.pos = srcVert.Position;
+        vert.normal = mesh.Normals[tri.NormalIndex[v]].Normal;
+        vert.tex = glm::vec2(mesh.TexCoords[tri.TexCoordIndex[v]].TexCoordU,
+                             mesh.TexCoords[tri.TexCoordIndex[v]].TexCoordV);
+        vert.bone[0] = srcVert.Node >= 0 ? (float)srcVert.Node : -1.0f;
+        vert.bone[1] = vert.bone[2] = vert.bone[3] = 0.0f;
+        vertices.push_back(vert);
+        indices.push_back((uint16_t)(vertices.size() - 1));
+
+        glm::vec3 posed = vert.pos;
+        int boneIdx = srcVert.Node;
+        if (boneIdx >= 0 && boneIdx < (int)bones.size())
+          posed = MuMath::TransformPoint(
+              (const float(*)[4])bones[boneIdx].data(), srcVert.Position);
+        aabb.min = glm::min(aabb.min, posed);
+        aabb.max = glm::max(aabb.max, posed);
+      }
+    }
+  }
+
+  mb.indexCount = (int)indices.size();
+  mb.vertexCount = (int)vertices.size();
+  mb.isSkinned = true;
+  mb.boneCount = boneCount;
+  if (mb.indexCount == 0) {
+    out.push_back(mb);
+    return;
+  }
+
+  uint32_t vbSize = (uint32_t)(vertices.size() * sizeof(SkinnedVertex));
+  uint32_t ibSize = (uint32_t)(indices.size() * sizeof(uint16_t));
+  mb.vbo = bgfx::createVertexBuffer(bgfx::copy(vertices.data(), vbSize),
+                                    GetSkinnedVertexLayout());
+  mb.ebo = bgfx::createIndexBuffer(bgfx::copy(indices.data(), ibSize));
+  ApplyMeshTexture(mesh, textureDir, mb);
+  RetransformMeshWithBones(mesh, bones, mb);
+  out.push_back(mb);
+}
+
+void BindMesh(const MeshBuffers &mb) {
+  if (mb.isDynamic)
+    bgfx::setVertexBuffer(0, mb.dynVbo);
+  else
+    bgfx::setVertexBuffer(0, mb.vbo);
+  bgfx::setIndexBuffer(mb.ebo);
+  if (!mb.isSkinned || mb.boneCount == 0)
+    return;
+  if (!bgfx::isValid(s_bonePaletteUniform))
+    s_bonePaletteUniform = bgfx::createUniform(
+        "u_bonePalette", bgfx::UniformType::Vec4, MAX_SKIN_BONES * 3);
+  bgfx::setUniform(s_bonePaletteUniform, mb.bonePalette.data(),
+                   (uint16_t)(mb.boneCount * 3));
+}
+
 // ---------- BGFX Mesh cleanup ----------
 
 void CleanupMeshBuffers(std::vector<MeshBuffers> &buffers) {
@@ -1,11 +1,19 @@
 // BGFX integration test — validates BGFX + GLFW + Metal + ImGui + Texture Loading + Sky + Terrain + Grass + Objects + Fire + Boids + ClickEffect + NPCs + HeroCharacter.
 // Phase 2-13 of the GL->BGFX migration. Captures screenshots for visual analysis.
+//
+// --headless-bench[=FRAMES] [--map N] [--monsters N]: no window, Noop renderer;
+// runs the same phases with an orbiting camera and prints per-phase CPU time
+// and draw calls (FrameProfiler) instead of taking a screenshot.
 
 #include <bgfx/bgfx.h>
 #include <bgfx/platform.h>
 #include <bx/math.h>
 #include <GLFW/glfw3.h>
+#ifdef __APPLE__
 #define GLFW_EXPOSE_NATIVE_COCOA
+#else
+#define GLFW_EXPOSE_NATIVE_X11
+#endif
 #include <GLFW/glfw3native.h>
 
 #include <glm/glm.hpp>
@@ -32,9 +40,13 @@
 #include "HeroCharacter.hpp"
 #include "MonsterManager.hpp"
 #include "ChromeGlow.hpp"
+#include "FrameProfiler.hpp"
 
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <string>
 #include <vector>
 #include <sys/stat.h>
 
@@ -112,20 +124,42 @@ struct ScreenshotCallback : public bgfx::CallbackI {
   void captureFrame(const void *, uint32_t) override {}
 };
 
-int main() {
-  if (!glfwInit()) {
-    fprintf(stderr, "Failed to initialize GLFW\n");
-    return 1;
+int main(int argc, char **argv) {
+  bool headless = false;
+  int benchFrames = 600;
+  int mapId = 0; // Lorencia
+  int benchMonsters = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--headless-bench", 16) == 0) {
+      headless = true;
+      if (argv[i][16] == '=')
+        benchFrames = atoi(argv[i] + 17);
+    } else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+      mapId = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--monsters") == 0 && i + 1 < argc) {
+      benchMonsters = atoi(argv[++i]);
+    }
   }
+  if (benchFrames < 1)
+    benchFrames = 600;
+  const int worldId = mapId + 1;
+
+  GLFWwindow *window = nullptr;
+  if (!headless) {
+    if (!glfwInit()) {
+      fprintf(stderr, "Failed to initialize GLFW\n");
+      return 1;
+    }
 
-  glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
-  GLFWwindow *window = glfwCreateWindow(1280, 720,
-      "BGFX Migration Test (Phase 11)", nullptr, nullptr);
-  if (!window) {
-    fprintf(stderr, "Failed to create GLFW window\n");
-    glfwTerminate();
-    return 1;
+    window = glfwCreateWindow(1280, 720,
+        "BGFX Migration Test (Phase 11)", nullptr, nullptr);
+    if (!window) {
+      fprintf(stderr, "Failed to create GLFW window\n");
+      glfwTerminate();
+      return 1;
+    }
   }
 
   bgfx::renderFrame();
@@ -136,20 +170,31 @@ int main() {
   ScreenshotCallback callback;
 
   bgfx::Init init;
-  init.type = bgfx::RendererType::Metal;
-  init.platformData.nwh = glfwGetCocoaWindow(window);
   init.callback = &callback;
 
-  int fbW, fbH;
-  glfwGetFramebufferSize(window, &fbW, &fbH);
+  int fbW = 1280, fbH = 720;
+  if (headless) {
+    init.type = bgfx::RendererType::Noop;
+  } else {
+#ifdef __APPLE__
+    init.type = bgfx::RendererType::Metal;
+    init.platformData.nwh = glfwGetCocoaWindow(window);
+#else
+    init.platformData.nwh = (void *)(uintptr_t)glfwGetX11Window(window);
+    init.platformData.ndt = glfwGetX11Display();
+#endif
+    glfwGetFramebufferSize(window, &fbW, &fbH);
+  }
   init.resolution.width = fbW;
   init.resolution.height = fbH;
-  init.resolution.reset = BGFX_RESET_VSYNC;
+  init.resolution.reset = headless ? BGFX_RESET_NONE : BGFX_RESET_VSYNC;
 
   if (!bgfx::init(init)) {
     fprintf(stderr, "Failed to initialize BGFX\n");
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (window) {
+      glfwDestroyWindow(window);
+      glfwTerminate();
+    }
     return 1;
   }
 
@@ -165,22 +210,24 @@ int main() {
   // View 255: ImGui overlay (no clear — renders on top)
   bgfx::setViewClear(255, BGFX_CLEAR_NONE);
 
-  // ImGui init
-  IMGUI_CHECKVERSION();
-  ImGui::CreateContext();
-  ImGuiIO &io = ImGui::GetIO();
-  io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-  ImGui::StyleColorsDark();
-
-  ImGui_ImplGlfw_InitForOther(window, true);
-  if (!ImGui_ImplBgfx_Init(255, "shaders")) {
-    fprintf(stderr, "[ImGui_BGFX] Failed to init ImGui BGFX backend\n");
-    bgfx::shutdown();
-    glfwDestroyWindow(window);
-    glfwTerminate();
-    return 1;
+  // ImGui init (windowed only — the headless bench has no UI)
+  if (!headless) {
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO &io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    ImGui::StyleColorsDark();
+
+    ImGui_ImplGlfw_InitForOther(window, true);
+    if (!ImGui_ImplBgfx_Init(255, "shaders")) {
+      fprintf(stderr, "[ImGui_BGFX] Failed to init ImGui BGFX backend\n");
+      bgfx::shutdown();
+      glfwDestroyWindow(window);
+      glfwTerminate();
+      return 1;
+    }
+    printf("[ImGui_BGFX] Backend initialized on view 255\n");
   }
-  printf("[ImGui_BGFX] Backend initialized on view 255\n");
 
   // Phase 3: Load test textures via BGFX
   printf("\n[Phase 3] Loading textures via BGFX...\n");
@@ -215,14 +262,14 @@ int main() {
   printf("[Phase 5] Sky renderer initialized\n\n");
 
   // ========== Phase 6: Terrain renderer ==========
-  printf("[Phase 6] Loading terrain (Lorencia, World 1)...\n");
+  printf("[Phase 6] Loading terrain (World %d)...\n", worldId);
   Terrain terrain;
   terrain.Init();
   bool terrainLoaded = false;
   // Load terrain data — kept alive for ObjectRenderer (SetTerrainMapping stores raw pointer)
-  TerrainData terrainData = TerrainParser::LoadWorld(1, "Data");
+  TerrainData terrainData = TerrainParser::LoadWorld(worldId, "Data");
   if (!terrainData.heightmap.empty()) {
-    terrain.Load(terrainData, 1, "Data");
+    terrain.Load(terrainData, worldId, "Data");
     terrainLoaded = true;
     printf("[Phase 6] Terrain loaded: 256x256 grid, %d lightmap entries\n",
            (int)terrainData.lightmap.size());
@@ -237,13 +284,13 @@ int main() {
   grass.Init();
   bool grassLoaded = false;
   if (terrainLoaded) {
-    grass.Load(terrainData, 1, "Data");
+    grass.Load(terrainData, worldId, "Data");
     grassLoaded = true;
   }
   printf("[Phase 7] Grass renderer: %s\n\n", grassLoaded ? "READY" : "FAILED");
 
   // ========== Phase 8: World objects (ObjectRenderer) ==========
-  printf("[Phase 8] Loading world objects (Lorencia)...\n");
+  printf("[Phase 8] Loading world objects (World %d)...\n", worldId);
   ObjectRenderer objectRenderer;
   objectRenderer.Init();
   bool objectsLoaded = false;
@@ -252,7 +299,13 @@ int main() {
     objectRenderer.SetTerrainMapping(&terrainData.mapping);
     objectRenderer.SetTerrainHeightmap(terrainData.heightmap);
     objectRenderer.SetLuminosity(0.7f);
-    objectRenderer.LoadObjects(terrainData.objects, "Data/Object1");
+    objectRenderer.SetMapId(mapId);
+    if (mapId == 0)
+      objectRenderer.LoadObjects(terrainData.objects, "Data/Object1");
+    else
+      objectRenderer.LoadObjectsGeneric(
+          terrainData.objects, "Data/Object" + std::to_string(worldId),
+          "Data/Object1");
     objectsLoaded = true;
     printf("[Phase 8] Objects loaded: %d instances, %d unique models\n",
            objectRenderer.GetInstanceCount(), objectRenderer.GetModelCount());
@@ -267,7 +320,6 @@ int main() {
   fireEffect.Init("Data/Effect");
   int fireEmitterCount = 0;
   if (objectsLoaded) {
-    const int mapId = 0; // Lorencia
     for (auto &inst : objectRenderer.GetInstances()) {
       // Fire emitters
       auto &offsets = GetFireOffsets(inst.type, mapId);
@@ -308,7 +360,7 @@ int main() {
     boidManager.SetTerrainLightmap(terrainData.lightmap);
   }
   boidManager.SetLuminosity(0.7f);
-  boidManager.SetMapId(0); // Lorencia — spawns birds + fish + leaves
+  boidManager.SetMapId(mapId); // Lorencia (0) spawns birds + fish + leaves
   printf("[Phase 10] Boid manager: READY\n\n");
 
   // ========== Phase 11: Click-to-move ground effect ==========
@@ -331,7 +383,7 @@ int main() {
     npcManager.SetTerrainLightmap(terrainData.lightmap);
   }
   npcManager.SetLuminosity(0.7f);
-  npcManager.SetMapId(0);
+  npcManager.SetMapId(mapId);
   // Spawn some Lorencia NPCs for visual test
   npcManager.AddNpcByType(253, 130, 128, 3); // Amy
   npcManager.AddNpcByType(250, 120, 113, 3); // Weapon Merchant
@@ -363,11 +415,19 @@ int main() {
     monsterManager.SetTerrainLightmap(terrainData.lightmap);
   }
   monsterManager.SetLuminosity(0.7f);
-  monsterManager.SetMapId(0);
+  monsterManager.SetMapId(mapId);
   // Spawn a few test monsters near Lorencia
   monsterManager.AddMonster(0, 135, 125, 3, 1001); // Bull Fighter
   monsterManager.AddMonster(2, 138, 130, 5, 1002); // Budge Dragon
   monsterManager.AddMonster(1, 132, 132, 1, 1003); // Hound
+  // Bench crowd: rings of Bull Fighters / Hounds / Budge Dragons around town
+  for (int i = 0; i < benchMonsters; ++i) {
+    float a = (float)i * 2.3999632f; // Golden angle: even spread
+    int r = 4 + i / 8;
+    monsterManager.AddMonster((uint16_t)(i % 3), (uint8_t)(130 + r * std::cos(a)),
+                              (uint8_t)(128 + r * std::sin(a)), (uint8_t)(i % 8),
+                              (uint16_t)(2000 + i));
+  }
   printf("[Phase 14] MonsterManager: READY (%d monsters)\n\n", monsterManager.GetMonsterCount());
 
   // Camera setup — terrain center
@@ -377,16 +437,23 @@ int main() {
   const int screenshotFrame = 30;
   bool screenshotRequested = false;
 
-  while (!glfwWindowShouldClose(window)) {
-    glfwPollEvents();
+  FrameProfiler profiler;
+  FrameProfiler *prof = headless ? &profiler : nullptr;
+
+  while (headless ? frameCount < benchFrames : !glfwWindowShouldClose(window)) {
+    if (!headless) {
+      glfwPollEvents();
 
-    int w, h;
-    glfwGetFramebufferSize(window, &w, &h);
-    if (w != fbW || h != fbH) {
-      fbW = w;
-      fbH = h;
-      bgfx::reset(fbW, fbH, BGFX_RESET_VSYNC);
+      int w, h;
+      glfwGetFramebufferSize(window, &w, &h);
+      if (w != fbW || h != fbH) {
+        fbW = w;
+        fbH = h;
+        bgfx::reset(fbW, fbH, BGFX_RESET_VSYNC);
+      }
     }
+    if (prof)
+      prof->BeginFrame();
 
     bgfx::setViewRect(0, 0, 0, uint16_t(fbW), uint16_t(fbH));
     bgfx::setViewRect(255, 0, 0, uint16_t(fbW), uint16_t(fbH));
@@ -394,9 +461,14 @@ int main() {
 
     // ========== View 0: 3D scene rendering ==========
     {
-      // Static camera — fixed position looking at terrain
+      // Static camera — fixed position looking at terrain (the bench orbits)
       glm::vec3 center = glm::vec3(12800.0f, 100.0f, 12800.0f);
       glm::vec3 eye = center + glm::vec3(1500.0f, 800.0f, 1500.0f);
+      if (headless) {
+        float a = (float)frameCount * 0.005f;
+        eye = center + glm::vec3(2121.0f * std::cos(a), 800.0f,
+                                 2121.0f * std::sin(a));
+      }
 
       glm::mat4 view = glm::lookAt(eye, center, glm::vec3(0.0f, 1.0f, 0.0f));
       glm::mat4 proj = glm::perspective(glm::radians(45.0f),
@@ -406,37 +478,44 @@ int main() {
       bgfx::setViewTransform(0, glm::value_ptr(view), glm::value_ptr(proj));
 
       // Sky renders first (behind everything)
+      FrameProfiler::Scope section(prof, "sky");
       sky.Render(view, proj, eye, 1.0f);
 
       // Terrain renders after sky, before models
       float time = (float)frameCount * 0.016f; // ~60fps timing
+      section.Next("terrain");
       if (terrainLoaded) {
         terrain.Render(view, proj, time, eye);
       }
 
       // Grass renders after terrain, before models
+      section.Next("grass");
       if (grassLoaded) {
         grass.Render(view, proj, time, eye);
       }
 
       // Phase 8: World objects (trees, buildings, fences, torches, etc.)
+      section.Next("objects");
       if (objectsLoaded) {
         objectRenderer.Render(view, proj, eye, time);
       }
 
       // Phase 9: Fire/smoke particle effects (rendered after objects, additive blend)
+      section.Next("fire");
       if (fireEmitterCount > 0) {
         fireEffect.Update(0.016f);
         fireEffect.Render(view, proj);
       }
 
       // Phase 10: Ambient wildlife (birds, fish, falling leaves)
+      section.Next("boids");
       boidManager.Update(0.016f, center, 0, time);
       boidManager.RenderShadows(view, proj);
       boidManager.Render(view, proj, eye);
       boidManager.RenderLeaves(view, proj);
 
       // Phase 11: Click-to-move ground effect
+      section.Next("click effect");
       if (clickShader) {
         clickEffect.Render(view, proj, 0.016f, clickShader.get());
         if (!clickEffect.IsVisible())
@@ -444,19 +523,32 @@ int main() {
       }
 
       // Phase 12: NPC rendering (shadows first, then models)
+      section.Next("npcs");
       npcManager.RenderShadows(view, proj);
       npcManager.Render(view, proj, eye, 0.016f);
 
       // Phase 13: HeroCharacter rendering (shadows first, then model)
+      section.Next("hero");
       hero.RenderShadow(view, proj);
       hero.Render(view, proj, eye, 0.016f);
 
       // Phase 14: Monster rendering (shadows first, then models)
+      section.Next("monsters");
       monsterManager.Update(0.016f);
       monsterManager.RenderShadows(view, proj);
       monsterManager.Render(view, proj, eye, 0.016f);
     } // end view 0 scope
 
+    if (headless) {
+      {
+        FrameProfiler::Scope section(prof, "bgfx frame");
+        bgfx::frame();
+      }
+      prof->EndFrame();
+      frameCount++;
+      continue;
+    }
+
     // Debug text overlay
     bgfx::dbgTextClear();
     bgfx::dbgTextPrintf(2, 1, 0x0f, "MU Remaster - BGFX Migration Test (Phase 14)");
@@ -557,7 +649,9 @@ int main() {
   }
 
   printf("[BGFX] Test completed: %d frames rendered\n", frameCount);
-  if (callback.hasCaptured)
+  if (headless)
+    profiler.Report("BgfxInitTest headless bench (Noop renderer, CPU only)");
+  else if (callback.hasCaptured)
     printf("[Screenshot] Output: screenshots/bgfx_phase13_test.png (%dx%d)\n",
            callback.capturedWidth, callback.capturedHeight);
   else
@@ -617,12 +711,16 @@ int main() {
   TexDestroy(texResolved);
   TexDestroy(texInfo.textureID);
 
-  ImGui_ImplBgfx_Shutdown();
-  ImGui_ImplGlfw_Shutdown();
-  ImGui::DestroyContext();
+  if (!headless) {
+    ImGui_ImplBgfx_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+  }
 
   bgfx::shutdown();
-  glfwDestroyWindow(window);
-  glfwTerminate();
+  if (window) {
+    glfwDestroyWindow(window);
+    glfwTerminate();
+  }
   return 0;
 }
@@ -1,3 +1,4 @@
+#include "AnimationTracks.hpp"
 #include "BMDParser.hpp"
 #include "BMDUtils.hpp"
 #include "BoidManager.hpp"
@@ -8,11 +9,13 @@
 #include "ClientPacketHandler.hpp"
 #include "ClientTypes.hpp"
 #include "FireEffect.hpp"
+#include "FrameProfiler.hpp"
 #include "GrassRenderer.hpp"
 #include "GroundItemRenderer.hpp"
 #include "HeroCharacter.hpp"
 #include "InputHandler.hpp"
 #include "InventoryUI.hpp"
+#include "JobSystem.hpp"
 #include "ItemDatabase.hpp"
 #include "ItemModelManager.hpp"
 #include "MockData.hpp"
@@ -38,7 +41,11 @@
 #include <bgfx/bgfx.h>
 #include <bgfx/platform.h>
 #include <bx/math.h>
+#ifdef __APPLE__
 #define GLFW_EXPOSE_NATIVE_COCOA
+#else
+#define GLFW_EXPOSE_NATIVE_X11
+#endif
 #include <GLFW/glfw3native.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
@@ -59,6 +66,7 @@ static constexpr uint16_t IMGUI_VIEW_MAIN    = 30;
 static constexpr uint16_t IMGUI_VIEW_OVERLAY = 200;
 static constexpr uint16_t IMGUI_VIEW_TRANSITION = 201;
 // BGFX view IDs for shadow mapping and post-processing bloom pipeline:
+static constexpr bgfx::ViewId SHADOW_STATIC_VIEW = 1; // Cached static layer
 static constexpr bgfx::ViewId SHADOW_VIEW      = 8;
 static constexpr bgfx::ViewId PP_VIEW_BRIGHT   = 2;
 static constexpr bgfx::ViewId PP_VIEW_BLUR0    = 3;
@@ -67,6 +75,11 @@ static constexpr bgfx::ViewId PP_VIEW_BLUR2    = 5;
 static constexpr bgfx::ViewId PP_VIEW_BLUR3    = 6;
 static constexpr bgfx::ViewId PP_VIEW_COMPOSITE = 9;
 static constexpr uint16_t SHADOW_MAP_SIZE = 2048;
+static constexpr float SHADOW_HALF_EXTENT = 1500.0f; // Light ortho half-width
+// Hero drift from the light frustum centre (in shadow texels, and along
+// the light) before the frustum recentres and the static layer is redrawn
+static constexpr float SHADOW_STATIC_SHIFT_TEXELS = 256.0f;
+static constexpr float SHADOW_STATIC_DEPTH_SLACK = 500.0f;
 
 #include <algorithm>
 #include <cmath>
@@ -77,6 +90,7 @@ static constexpr uint16_t SHADOW_MAP_SIZE = 2048;
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <streambuf>
 #include <turbojpeg.h>
 #include <unistd.h>
@@ -210,6 +224,7 @@ static ClickEffect g_clickEffect;
 static NpcManager g_npcManager;
 static MonsterManager g_monsterManager;
 static ServerConnection g_server;
+static JobSystem g_jobSystem; // Per-frame animation/skinning workers
 
 // NPC interaction state
 static int g_hoveredNpc = -1;        // Index of NPC under mouse cursor
@@ -831,9 +846,36 @@ struct ShadowMapState {
   bgfx::TextureHandle depthTex = BGFX_INVALID_HANDLE;
   bgfx::FrameBufferHandle fb = BGFX_INVALID_HANDLE;
   std::unique_ptr<Shader> depthShader;
+  std::unique_ptr<Shader> skinnedDepthShader; // GPU-skinned characters
+
+  // World objects cast shadows only with --object-shadows (off by default).
+  // Static layer: world objects, rendered only when the frustum recentres
+  // and blitted under the dynamic casters every frame. Without texture blit
+  // support the static casters are drawn into the shadow map every frame.
+  bool objectCasters = false;
+  bgfx::TextureHandle staticColorTex = BGFX_INVALID_HANDLE;
+  bgfx::TextureHandle staticDepthTex = BGFX_INVALID_HANDLE;
+  bgfx::FrameBufferHandle staticFb = BGFX_INVALID_HANDLE;
+  bool staticValid = false; // Cleared on world load
+  glm::vec3 centerLS{0.0f}; // Frustum centre in light space, texel-snapped
+  glm::mat4 lightView{1.0f};
+  int staticRedraws = 0;
 };
 static ShadowMapState g_shadowMap;
 
+static void DestroyShadowMap() {
+  if (g_shadowMap.depthShader) g_shadowMap.depthShader->destroy();
+  if (g_shadowMap.skinnedDepthShader) g_shadowMap.skinnedDepthShader->destroy();
+  if (bgfx::isValid(g_shadowMap.fb)) bgfx::destroy(g_shadowMap.fb);
+  if (bgfx::isValid(g_shadowMap.colorTex)) bgfx::destroy(g_shadowMap.colorTex);
+  if (bgfx::isValid(g_shadowMap.depthTex)) bgfx::destroy(g_shadowMap.depthTex);
+  if (bgfx::isValid(g_shadowMap.staticFb)) bgfx::destroy(g_shadowMap.staticFb);
+  if (bgfx::isValid(g_shadowMap.staticColorTex))
+    bgfx::destroy(g_shadowMap.staticColorTex);
+  if (bgfx::isValid(g_shadowMap.staticDepthTex))
+    bgfx::destroy(g_shadowMap.staticDepthTex);
+}
+
 // ── Minimap state (outline-style attribute map texture) ──
 static bgfx::TextureHandle g_minimapTex = BGFX_INVALID_HANDLE;
 static int g_minimapTexSize = 256; // matches terrain grid size
@@ -1109,7 +1151,7 @@ static void RenderPostProcess(int fbW, int fbH) {
   pp.brightExtract->setVec4("u_ppParams", glm::vec4(pp.bloomThreshold, 0, 0, 0));
   bgfx::setVertexBuffer(0, pp.screenTriVBO);
   bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
-  bgfx::submit(PP_VIEW_BRIGHT, pp.brightExtract->program);
+  SubmitDraw(PP_VIEW_BRIGHT, pp.brightExtract->program);
 
   // Pass 2: Horizontal blur — bloom[0] → bloom[1]
   bgfx::setViewName(PP_VIEW_BLUR0, "BlurH1");
@@ -1119,7 +1161,7 @@ static void RenderPostProcess(int fbW, int fbH) {
   pp.blur->setVec4("u_blurParams", glm::vec4(1.0f, 1.0f / pp.bloomW, 0, 0));
   bgfx::setVertexBuffer(0, pp.screenTriVBO);
   bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
-  bgfx::submit(PP_VIEW_BLUR0, pp.blur->program);
+  SubmitDraw(PP_VIEW_BLUR0, pp.blur->program);
 
   // Pass 3: Vertical blur — bloom[1] → bloom[0]
   bgfx::setViewName(PP_VIEW_BLUR1, "BlurV1");
@@ -1129,7 +1171,7 @@ static void RenderPostProcess(int fbW, int fbH) {
   pp.blur->setVec4("u_blurParams", glm::vec4(0.0f, 1.0f / pp.bloomH, 0, 0));
   bgfx::setVertexBuffer(0, pp.screenTriVBO);
   bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
-  bgfx::submit(PP_VIEW_BLUR1, pp.blur->program);
+  SubmitDraw(PP_VIEW_BLUR1, pp.blur->program);
 
   // Pass 4: Horizontal blur 2 — bloom[0] → bloom[1]
   bgfx::setViewName(PP_VIEW_BLUR2, "BlurH2");
@@ -1139,7 +1181,7 @@ static void RenderPostProcess(int fbW, int fbH) {
   pp.blur->setVec4("u_blurParams", glm::vec4(1.0f, 1.0f / pp.bloomW, 0, 0));
   bgfx::setVertexBuffer(0, pp.screenTriVBO);
   bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
-  bgfx::submit(PP_VIEW_BLUR2, pp.blur->program);
+  SubmitDraw(PP_VIEW_BLUR2, pp.blur->program);
 
   // Pass 5: Vertical blur 2 — bloom[1] → bloom[0]
   bgfx::setViewName(PP_VIEW_BLUR3, "BlurV2");
@@ -1149,7 +1191,7 @@ static void RenderPostProcess(int fbW, int fbH) {
   pp.blur->setVec4("u_blurParams", glm::vec4(0.0f, 1.0f / pp.bloomH, 0, 0));
   bgfx::setVertexBuffer(0, pp.screenTriVBO);
   bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
-  bgfx::submit(PP_VIEW_BLUR3, pp.blur->program);
+  SubmitDraw(PP_VIEW_BLUR3, pp.blur->program);
 
   // Pass 6: Composite — scene + bloom → backbuffer
   bgfx::setViewName(PP_VIEW_COMPOSITE, "Composite");
@@ -1161,7 +1203,7 @@ static void RenderPostProcess(int fbW, int fbH) {
   pp.composite->setVec4("u_ppTint", glm::vec4(pp.colorTint, 0.0f));
   bgfx::setVertexBuffer(0, pp.screenTriVBO);
   bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
-  bgfx::submit(PP_VIEW_COMPOSITE, pp.composite->program);
+  SubmitDraw(PP_VIEW_COMPOSITE, pp.composite->program);
 }
 
 struct LightTemplate {
@@ -1274,6 +1316,15 @@ static const LightTemplate *GetLightProperties(int type, int mapId = -1) {
 static void InitGameWorld(ServerData &serverData, LoadProgressFn onProgress = nullptr);
 static void ChangeMap(uint8_t mapId, uint8_t spawnX, uint8_t spawnY,
                       LoadProgressFn onProgress = nullptr);
+// Renderer/effect subsystems that outlive map changes (sky, shadow map, VFX...)
+static void InitRenderSubsystems();
+// In-game 3D scene: shadow pass through post-processing. `prof` may be null.
+static void RenderWorld(const glm::mat4 &view, const glm::mat4 &projection,
+                        const glm::vec3 &camPos, float deltaTime,
+                        float currentFrame, int fbW, int fbH,
+                        FrameProfiler *prof);
+// --headless-bench: Noop renderer, no window, no server (see definition)
+static int RunHeadlessBench(int argc, char **argv);
 
 // Input handling (mouse, keyboard, click-to-move, processInput) delegated
 // to InputHandler module (see src/InputHandler.cpp)
@@ -1282,6 +1333,10 @@ static void ChangeMap(uint8_t mapId, uint8_t spawnX, uint8_t spawnY,
 // all delegated to InventoryUI module (see src/InventoryUI.cpp)
 
 int main(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i)
+    if (strncmp(argv[i], "--headless-bench", 16) == 0)
+      return RunHeadlessBench(argc, argv);
+
   // Require launch via launch.sh (sets MU_LAUNCHED env var)
   if (!getenv("MU_LAUNCHED")) {
     fprintf(stderr, "ERROR: Please use launch.sh to start the game.\n"
@@ -1341,11 +1396,16 @@ int main(int argc, char **argv) {
   }
   g_window = window;
 
-  // Initialize BGFX with Metal backend on macOS
+  // Initialize BGFX with Metal backend on macOS (bgfx picks elsewhere)
   bgfx::renderFrame(); // Single-threaded mode: call before bgfx::init
   bgfx::Init bgfxInit;
+#ifdef __APPLE__
   bgfxInit.type = bgfx::RendererType::Metal;
   bgfxInit.platformData.nwh = glfwGetCocoaWindow(window);
+#else
+  bgfxInit.platformData.nwh = (void *)(uintptr_t)glfwGetX11Window(window);
+  bgfxInit.platformData.ndt = glfwGetX11Display();
+#endif
   bgfxInit.callback = &g_bgfxCallback;
   int initW, initH;
   glfwGetFramebufferSize(window, &initW, &initH);
@@ -1372,7 +1432,9 @@ int main(int argc, char **argv) {
     bgfx::touch(0);
     bgfx::frame();
   }
-  std::cout << "[BGFX] Initialized with Metal backend (" << initW << "x" << initH << ")" << std::endl;
+  std::cout << "[BGFX] Initialized with "
+            << bgfx::getRendererName(bgfx::getRendererType()) << " backend ("
+            << initW << "x" << initH << ")" << std::endl;
   g_terrain.Init(); // Load BGFX terrain shader
 
   ItemDatabase::Init();
@@ -1472,39 +1534,10 @@ int main(int argc, char **argv) {
   std::string data_path = g_dataPath;
 
   // ── One-time subsystem initialization (before first world load) ──
-  g_sky.Init(data_path + "/");
-  InitPostProcess();
-  {
-    g_shadowMap.colorTex = bgfx::createTexture2D(
-        SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, false, 1,
-        bgfx::TextureFormat::BGRA8,
-        BGFX_TEXTURE_RT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
-    g_shadowMap.depthTex = bgfx::createTexture2D(
-        SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, false, 1,
-        bgfx::TextureFormat::D16, BGFX_TEXTURE_RT_WRITE_ONLY);
-    bgfx::TextureHandle atts[] = { g_shadowMap.colorTex, g_shadowMap.depthTex };
-    g_shadowMap.fb = bgfx::createFrameBuffer(2, atts, false);
-    g_shadowMap.depthShader = Shader::Load("vs_depth.bin", "fs_depth.bin");
-    if (g_shadowMap.depthShader && bgfx::isValid(g_shadowMap.fb)) {
-      std::cout << "[ShadowMap] Initialized " << SHADOW_MAP_SIZE << "x"
-                << SHADOW_MAP_SIZE << " depth FBO\n";
-    } else {
-      std::cerr << "[ShadowMap] Failed to initialize shadow mapping\n";
-    }
-  }
-  // Minimap texture will be generated after each terrain load
-  g_fireEffect.Init(data_path + "/Effect");
-  g_vfxManager.Init(data_path);
-  g_vfxManager.SetTerrainHeightFunc(
-      [](float x, float z) -> float { return g_terrain.GetHeight(x, z); });
-  g_vfxManager.SetPlaySoundFunc(
-      [](int soundId) { SoundManager::Play(soundId); });
-  g_boidManager.Init(data_path);
-  g_hero.Init(data_path);
-  g_hero.SetVFXManager(&g_vfxManager);
-  g_hero.LoadStats(1, 28, 20, 25, 10, 0, 0, 110, 110, 20, 20, 50, 50, 16);
-  ChromeGlow::LoadTextures(g_dataPath);
-  ItemModelManager::Init(g_hero.GetShader(), g_dataPath);
+  InitRenderSubsystems();
+  g_jobSystem.Start();
+  g_monsterManager.SetJobSystem(&g_jobSystem);
+  g_npcManager.SetJobSystem(&g_jobSystem);
 
   // ── Load initial world (terrain, objects, fire, lights, grass) ──
   LoadWorld(g_currentMapId, [](float p, const char *s) {
@@ -1747,6 +1780,8 @@ int main(int argc, char **argv) {
       objectDebugIdx = std::atoi(argv[i + 1]);
       ++i;
     }
+    if (std::string(argv[i]) == "--object-shadows")
+      g_shadowMap.objectCasters = true;
   }
 
   // Initialize CharacterSelect scene
@@ -2134,22 +2169,64 @@ int main(int argc, char **argv) {
         g_hero.SetBuffDamage(g_clientState->activeBuffs[1].active);
       }
 
+      // Movement sync: the hero walks a grid route and the server simulates
+      // the same cells from MOVE_PATH, sent in chunks of up to 16 cells as the
+      // hero advances. Without a route (no terrain attributes) only the
+      // destination is sent and the server paths to it. PRECISE_POS is only a
+      // low-rate correction while walking and a final fix when the hero stops.
+      static constexpr size_t MOVE_PATH_CHUNK = 16;
+      static bool wasMoving = false;
+      static uint32_t sentRoute = 0;
+      static size_t sentEnd = 0; // Route index after the last cell sent
+      static int lastDestX = -1, lastDestY = -1;
       static float posTimer = 0.0f;
-      static int lastGridX = -1, lastGridY = -1;
-      posTimer += deltaTime;
-      if (posTimer >= 0.10f && !g_mapTransitionActive) {
-        posTimer = 0.0f;
+      if (!g_mapTransitionActive) {
         glm::vec3 hp = g_hero.GetPosition();
-        g_server.SendPrecisePosition(hp.x, hp.z);
-
-        // Also send grid move when grid cell changes (for DB persistence)
-        int gx = (int)(hp.z / 100.0f);
-        int gy = (int)(hp.x / 100.0f);
-        if (gx != lastGridX || gy != lastGridY) {
-          g_server.SendGridMove((uint8_t)gx, (uint8_t)gy);
-          lastGridX = gx;
-          lastGridY = gy;
+        uint8_t gx = (uint8_t)(hp.z / 100.0f);
+        uint8_t gy = (uint8_t)(hp.x / 100.0f);
+        bool moving = g_hero.IsMoving();
+        if (moving) {
+          const auto &route = g_hero.GetRoute();
+          size_t step = g_hero.GetRouteStep();
+          bool newRoute = !wasMoving || g_hero.GetRouteVersion() != sentRoute;
+          if (!route.empty()) {
+            // Next chunk goes out two cells before the server runs out
+            if (newRoute || (sentEnd < route.size() && step + 2 >= sentEnd)) {
+              size_t count = std::min(MOVE_PATH_CHUNK, route.size() - step);
+              uint8_t cells[MOVE_PATH_CHUNK][2];
+              for (size_t i = 0; i < count; i++) {
+                cells[i][0] = route[step + i].x;
+                cells[i][1] = route[step + i].y;
+              }
+              g_server.SendMovePath(gx, gy, &cells[0][0], (uint8_t)count);
+              sentRoute = g_hero.GetRouteVersion();
+              sentEnd = step + count;
+              posTimer = 0.0f;
+            }
+          } else {
+            glm::vec3 target = g_hero.GetMoveTarget();
+            int destX = (int)(target.z / 100.0f);
+            int destY = (int)(target.x / 100.0f);
+            if (newRoute || destX != lastDestX || destY != lastDestY) {
+              uint8_t dest[2] = {(uint8_t)destX, (uint8_t)destY};
+              g_server.SendMovePath(gx, gy, dest, 1);
+              sentRoute = g_hero.GetRouteVersion();
+              lastDestX = destX;
+              lastDestY = destY;
+              posTimer = 0.0f;
+            }
+          }
+          posTimer += deltaTime;
+          if (posTimer >= 1.0f) {
+            posTimer = 0.0f;
+            g_server.SendPrecisePosition(hp.x, hp.z);
+          }
+        } else if (wasMoving) {
+          g_server.SendMovePath(gx, gy, nullptr, 0);
+          g_server.SendPrecisePosition(hp.x, hp.z);
+          lastDestX = lastDestY = -1;
         }
+        wasMoving = moving;
       }
     }
 
@@ -2551,7 +2628,8 @@ int main(int argc, char **argv) {
           g_hero.SnapToTerrain();
           g_hero.SetAction(1);
           g_camera.SetPosition(g_hero.GetPosition());
-          g_server.SendPrecisePosition(spawnPos.x, spawnPos.z);
+          // The server moves us to the same cell (GameWorld::FindTownSpot)
+          g_server.SendTownReturn();
           g_objectRenderer.ResetDoorStates();
           InventoryUI::ShowRegionName(GetMapConfig(g_currentMapId)->regionName);
           g_hero.SetTeleportCooldown();
@@ -2776,27 +2854,6 @@ int main(int argc, char **argv) {
     // Use framebuffer size for viewport (Retina displays are 2x window size)
     int fbW, fbH;
     glfwGetFramebufferSize(window, &fbW, &fbH);
-    // BGFX view ordering: shadow pass (view 8) renders before scene (view 0)
-    // and post-processing (views 1-6). Views 9+ (ImGui 30, 200, 201) use default order.
-    {
-      bgfx::ViewId order[] = { SHADOW_VIEW, 0, PP_VIEW_BRIGHT, PP_VIEW_BLUR0,
-                                PP_VIEW_BLUR1, PP_VIEW_BLUR2, PP_VIEW_BLUR3,
-                                PP_VIEW_COMPOSITE, 7 };
-      bgfx::setViewOrder(0, 9, order);
-    }
-    // BGFX view 0 setup: clear, viewport, and post-process FBO
-    bgfx::setViewClear(0, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL,
-                        0x000000FF, 1.0f, 0);
-    bgfx::setViewRect(0, 0, 0, uint16_t(fbW), uint16_t(fbH));
-    if (g_postProcess.enabled) {
-      ResizePostProcessFBOs(fbW, fbH);
-      if (bgfx::isValid(g_postProcess.sceneFB))
-        bgfx::setViewFrameBuffer(0, g_postProcess.sceneFB);
-    } else {
-      bgfx::setViewFrameBuffer(0, BGFX_INVALID_HANDLE);
-    }
-    bgfx::touch(0);
-
     int winW, winH;
     glfwGetWindowSize(window, &winW, &winH);
     glm::mat4 projection =
@@ -2811,276 +2868,8 @@ int main(int argc, char **argv) {
       view = glm::translate(view, shakeOffset);
     }
 
-    // ── Shadow map pass: render depth from directional light ──
-    if (g_shadowMap.depthShader && bgfx::isValid(g_shadowMap.fb)) {
-      glm::vec3 heroPos = g_hero.GetPosition();
-      // Directional light: nearly overhead sun with subtle side tilt
-      glm::vec3 lightDir = glm::normalize(glm::vec3(-0.2f, -1.0f, -0.1f));
-      glm::vec3 lightPos = heroPos - lightDir * 2000.0f;
-      glm::vec3 up = glm::vec3(0.0f, 0.0f, 1.0f);
-      // Avoid degenerate up vector
-      if (std::abs(glm::dot(lightDir, up)) > 0.99f)
-        up = glm::vec3(1.0f, 0.0f, 0.0f);
-      glm::mat4 lightView = glm::lookAt(lightPos, heroPos, up);
-      // Metal uses [0,1] Z clip range; OpenGL uses [-1,1]
-      glm::mat4 lightProj = bgfx::getCaps()->homogeneousDepth
-        ? glm::ortho(-1500.0f, 1500.0f, -1500.0f, 1500.0f, 100.0f, 5000.0f)
-        : glm::orthoRH_ZO(-1500.0f, 1500.0f, -1500.0f, 1500.0f, 100.0f, 5000.0f);
-      glm::mat4 lightMtx = lightProj * lightView;
-
-      // Setup shadow view
-      bgfx::setViewName(SHADOW_VIEW, "ShadowMap");
-      bgfx::setViewRect(SHADOW_VIEW, 0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
-      bgfx::setViewClear(SHADOW_VIEW, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0xFFFFFFFF, 1.0f, 0);
-      bgfx::setViewFrameBuffer(SHADOW_VIEW, g_shadowMap.fb);
-      bgfx::setViewTransform(SHADOW_VIEW, glm::value_ptr(lightView),
-                              glm::value_ptr(lightProj));
-      bgfx::touch(SHADOW_VIEW);
-
-      // View 8 renders before view 0 via setViewOrder (set above).
-
-      // Submit shadow casters
-      g_hero.RenderToShadowMap(SHADOW_VIEW, g_shadowMap.depthShader->program);
-      g_monsterManager.RenderToShadowMap(SHADOW_VIEW, g_shadowMap.depthShader->program);
-      g_npcManager.RenderToShadowMap(SHADOW_VIEW, g_shadowMap.depthShader->program);
-
-      // Pass shadow map texture + light matrix to all receivers
-      g_hero.SetShadowMap(g_shadowMap.colorTex, lightMtx);
-      g_monsterManager.SetShadowMap(g_shadowMap.colorTex, lightMtx);
-      g_npcManager.SetShadowMap(g_shadowMap.colorTex, lightMtx);
-      g_terrain.SetShadowMap(g_shadowMap.colorTex, lightMtx);
-    }
-
-    // Sky renders first (behind everything, no depth write)
-    if (g_mapCfg->hasSky) {
-      g_sky.Render(view, projection, camPos, g_luminosity);
-    }
-
-    // Main 5.2: AddTerrainLight — merge world point lights + spell projectile
-    // lights Spell lights are transient (per-frame), so rebuild the full list
-    // each frame. Static vectors reuse capacity across frames (zero heap allocs
-    // after warmup).
-    {
-      static std::vector<glm::vec3> lightPos, lightCol;
-      static std::vector<float> lightRange;
-      static std::vector<int> lightObjTypes;
-      lightPos.clear();
-      lightCol.clear();
-      lightRange.clear();
-      lightObjTypes.clear();
-      // Static world lights (fires, streetlights, candles, etc.)
-      for (auto &pl : g_pointLights) {
-        lightPos.push_back(pl.position);
-        lightCol.push_back(pl.color);
-        lightRange.push_back(pl.range);
-        lightObjTypes.push_back(pl.objectType);
-      }
-      // Dynamic spell lights from active projectiles
-      g_vfxManager.GetActiveSpellLights(lightPos, lightCol, lightRange,
-                                        lightObjTypes);
-      // Update terrain (CPU lightmap) and object renderer (shader uniforms)
-      g_terrain.SetPointLights(lightPos, lightCol, lightRange, lightObjTypes);
-      g_objectRenderer.SetPointLights(lightPos, lightCol, lightRange);
-      // Update character renderers with merged PointLight list
-      static std::vector<PointLight> mergedLights;
-      mergedLights.clear();
-      mergedLights.reserve(lightPos.size());
-      for (size_t i = 0; i < lightPos.size(); ++i) {
-        mergedLights.push_back(
-            {lightPos[i], lightCol[i], lightRange[i],
-             i < lightObjTypes.size() ? lightObjTypes[i] : 0});
-      }
-      g_hero.SetPointLights(mergedLights);
-      g_npcManager.SetPointLights(mergedLights);
-      g_monsterManager.SetPointLights(mergedLights);
-      g_boidManager.SetPointLights(mergedLights);
-    }
-
-    g_terrain.Render(view, projection, currentFrame, camPos);
-
-    // Lightmap texture is destroyed+recreated each frame by Terrain, so refresh handle
-    g_objectRenderer.SetLightmapTexture(g_terrain.GetLightmapTexture());
-    g_objectRenderer.Render(view, projection, g_camera.GetPosition(),
-                            currentFrame);
-
-    // Render grass billboards (config-driven)
-    if (g_mapCfg->hasGrass) {
-      std::vector<GrassRenderer::PushSource> pushSources;
-      pushSources.push_back({g_hero.GetPosition(), 100.0f});
-      g_grass.Render(view, projection, currentFrame, camPos, pushSources);
-    }
-
-    // Main 5.2 level-up VFX: 15 BITMAP_FLARE joints in a ring
-    if (g_hero.LeveledUpThisFrame()) {
-      g_vfxManager.SpawnLevelUpEffect(g_hero.GetPosition());
-      SoundManager::Play(SOUND_LEVEL_UP);
-      g_hero.ClearLevelUpFlag();
-    }
-
-    // Update effects (VFX rendered after characters for correct layering)
-    g_fireEffect.Update(deltaTime);
-    g_vfxManager.UpdateLevelUpCenter(g_hero.GetPosition());
-
-    // Dungeon trap VFX (Main 5.2: types 39=lance, 40=blade, 51=fire)
-    // HiddenMesh=-2, VFX-only — spawned continuously in CharacterAnimation
-    if (g_mapCfg->hasDungeonTraps) {
-      static float trapVfxTimer = 0.0f;
-      trapVfxTimer += deltaTime;
-      if (trapVfxTimer >= 0.15f) { // ~7 bursts/sec
-        trapVfxTimer -= 0.15f;
-        for (auto &inst : g_objectRenderer.GetInstances()) {
-          glm::vec3 pos = glm::vec3(inst.modelMatrix[3]);
-          if (inst.type == 39) {
-            // Lance Trap: lightning sprites (Main 5.2: MODEL_SAW +
-            // SOUND_TRAP01)
-            pos.y += 30.0f + (float)(rand() % 40);
-            g_vfxManager.SpawnBurst(ParticleType::SPELL_LIGHTNING, pos, 2);
-          }
-          // Note: type 51 (Fire Trap) fire particles now handled by ambient
-          // fire emitter system in VFXManager
-        }
-      }
-    }
-
-
-    g_vfxManager.Update(deltaTime);
-
-    // Twister proximity: apply StormTime spin when tornado VFX reaches a
-    // monster
-    if (g_vfxManager.HasActiveTwisters()) {
-      int monCount = g_monsterManager.GetMonsterCount();
-      for (int mi = 0; mi < monCount; ++mi) {
-        MonsterInfo info = g_monsterManager.GetMonsterInfo(mi);
-        if (info.hp <= 0)
-          continue;
-        if (g_vfxManager.CheckTwisterHit(info.serverIndex, info.position))
-          g_monsterManager.ApplyStormTime(info.serverIndex, 10);
-      }
-    }
-
-    // Evil Spirit: StormTime spin on nearby monsters (Main 5.2: same as
-    // Twister)
-    if (g_vfxManager.HasActiveSpiritBeams()) {
-      int monCount = g_monsterManager.GetMonsterCount();
-      for (int mi = 0; mi < monCount; ++mi) {
-        MonsterInfo info = g_monsterManager.GetMonsterInfo(mi);
-        if (info.hp <= 0)
-          continue;
-        if (g_vfxManager.CheckSpiritBeamHit(info.serverIndex, info.position))
-          g_monsterManager.ApplyStormTime(info.serverIndex, 10);
-      }
-    }
-
-    // Boids — birds in Lorencia, bats in Dungeon (BoidManager handles map
-    // logic)
-    g_boidManager.Update(deltaTime, g_hero.GetPosition(), 0, currentFrame);
-    g_fireEffect.Render(view, projection);
-    g_objectRenderer.RenderLightningSprites(view, projection, currentFrame);
-
-    // Render ambient creatures (birds/fish/bats/leaves)
-    g_boidManager.RenderShadows(view, projection);
-    g_boidManager.Render(view, projection, camPos);
-    if (g_mapCfg->hasLeaves)
-      g_boidManager.RenderLeaves(view, projection);
-
-    // Update NPC interaction state (guard faces player only when quest dialog
-    // is open)
-    g_npcManager.SetPlayerPosition(g_hero.GetPosition());
-    g_npcManager.SetInteractingNpc(g_questDialogOpen ? g_questDialogNpcIndex
-                                                     : -1);
-    // Precompute quest markers per guard NPC type
-    {
-      // Collect unique guard types from quest defs
-      std::vector<NpcManager::GuardMarker> markers;
-      uint16_t seenGuards[20];
-      int seenCount = 0;
-      for (int qi = 0; qi < (int)g_questCatalog.size(); qi++) {
-        uint16_t gt = g_questCatalog[qi].guardType;
-        bool found = false;
-        for (int s = 0; s < seenCount; s++)
-          if (seenGuards[s] == gt) { found = true; break; }
-        if (found) continue;
-        seenGuards[seenCount++] = gt;
-
-        // Determine best marker for this guard
-        // Priority: completable '?' gold > available '!' gold > in-progress '?' grey
-        char bestMarker = '\0';
-        bool bestGold = false;
-        for (int qi2 = 0; qi2 < (int)g_questCatalog.size(); qi2++) {
-          if (g_questCatalog[qi2].guardType != gt) continue;
-          int st = GetQuestStatus(qi2);
-          if (st == 2) { // completable — highest priority
-            bestMarker = '?'; bestGold = true; break;
-          } else if (st == 0 && bestMarker != '?') { // available
-            bestMarker = '!'; bestGold = true;
-          } else if (st == 1 && bestMarker == '\0') { // in-progress
-            bestMarker = '?'; bestGold = false;
-          }
-        }
-        if (bestMarker != '\0')
-          markers.push_back({gt, bestMarker, bestGold});
-      }
-      g_npcManager.SetQuestMarkers(markers);
-    }
-
-    // Render NPC stencil shadows + models (skip stencil when shadow map active)
-    bool hasShadowMap = g_shadowMap.depthShader && bgfx::isValid(g_shadowMap.fb);
-    if (!hasShadowMap) g_npcManager.RenderShadows(view, projection);
-    g_npcManager.Render(view, projection, camPos, deltaTime);
-
-    // Render monster stencil shadows + models
-    if (!hasShadowMap) g_monsterManager.RenderShadows(view, projection);
-    g_monsterManager.Render(view, projection, camPos, deltaTime);
-
-    // Silhouette outline on hovered NPC/monster (stencil-based)
-    if (g_hoveredMonster >= 0)
-      g_monsterManager.RenderSilhouetteOutline(g_hoveredMonster, view,
-                                               projection);
-
-    // Render ground item shadows (before hero so items don't shadow-over hero)
-    GroundItemRenderer::RenderShadows(g_groundItems, MAX_GROUND_ITEMS, view,
-                                      projection);
-
-    // Render hero stencil shadow + model (skip stencil when shadow map active)
-    g_clickEffect.Render(view, projection, deltaTime, g_hero.GetShader());
-    if (!hasShadowMap) g_hero.RenderShadow(view, projection);
-    g_hero.Render(view, projection, camPos, deltaTime);
-
-    // Compute hero bone world positions for VFX bone-attached particles
-    {
-      const auto &bones = g_hero.GetCachedBones();
-      float facing = g_hero.GetFacing();
-      glm::vec3 heroPos = g_hero.GetPosition();
-      float cosF = cosf(facing), sinF = sinf(facing);
-      std::vector<glm::vec3> boneWorldPos(bones.size());
-      for (int i = 0; i < (int)bones.size(); ++i) {
-        // Translation column of 3x4 bone matrix (model-local space)
-        float bx = bones[i][0][3];
-        float by = bones[i][1][3];
-        float bz = bones[i][2][3];
-        // Apply facing rotation in MU space (same as shadow
-        // HeroCharacter.cpp:994)
-        float rx = bx * cosF - by * sinF;
-        float ry = bx * sinF + by * cosF;
-        // Full model transform: translate * rotZ(-90) * rotY(-90) *
-        // rotZ(facing) After facing rotation in MU space: (rx, ry, bz) After
-        // rotY(-90): (-bz, ry, rx) After rotZ(-90): (ry, bz, rx)
-        boneWorldPos[i] = heroPos + glm::vec3(ry, bz, rx);
-      }
-      g_vfxManager.SetHeroBonePositions(boneWorldPos);
-    }
-
-    // Feed weapon blur trail points to VFX (Main 5.2: per-frame capture)
-    if (g_hero.IsWeaponTrailActive() && g_hero.HasValidTrailPoints()) {
-      g_vfxManager.AddWeaponTrailPoint(g_hero.GetWeaponTrailTip(),
-                                       g_hero.GetWeaponTrailBase());
-    }
-
-    // Render VFX (after all characters so particles layer on top)
-    g_vfxManager.Render(view, projection);
-
-    // Post-processing: bloom + vignette + composite (reads scene FBO → backbuffer)
-    RenderPostProcess(fbW, fbH);
+    RenderWorld(view, projection, camPos, deltaTime, currentFrame, fbW, fbH,
+                nullptr);
 
     // Auto-GIF: capture with warmup for fire particle buildup
     // Capture BEFORE ImGui rendering so debug overlay is not in the output
@@ -4544,6 +4333,7 @@ int main(int argc, char **argv) {
   // Disconnect from server
   g_server.Disconnect();
   // Cleanup
+  g_jobSystem.Stop();
   SoundManager::Shutdown();
   CharacterSelect::Shutdown();
   ChromeGlow::DeleteTextures();
@@ -4559,10 +4349,7 @@ int main(int argc, char **argv) {
   g_vfxManager.Cleanup();
   g_terrain.Cleanup();
   // Cleanup shadow map
-  if (g_shadowMap.depthShader) g_shadowMap.depthShader->destroy();
-  if (bgfx::isValid(g_shadowMap.fb)) bgfx::destroy(g_shadowMap.fb);
-  if (bgfx::isValid(g_shadowMap.colorTex)) bgfx::destroy(g_shadowMap.colorTex);
-  if (bgfx::isValid(g_shadowMap.depthTex)) bgfx::destroy(g_shadowMap.depthTex);
+  DestroyShadowMap();
   // Cleanup minimap
   if (bgfx::isValid(g_minimapTex)) bgfx::destroy(g_minimapTex);
 
@@ -4985,6 +4772,7 @@ static void LoadWorld(int mapId, LoadProgressFn onProgress) {
   }
   if (cfg.hasDoors)
     g_objectRenderer.InitDoors();
+  g_shadowMap.staticValid = false; // New static casters
 
   if (onProgress) onProgress(0.70f, "Setting up lighting...");
 
@@ -5147,3 +4935,716 @@ static void ChangeMap(uint8_t mapId, uint8_t spawnX, uint8_t spawnY,
   }
 
 }
+
+// ═══════════════════════════════════════════════════════════════════
+// InitRenderSubsystems — one-time setup before the first LoadWorld
+// ═══════════════════════════════════════════════════════════════════
+
+static void InitRenderSubsystems() {
+  std::string data_path = g_dataPath;
+  g_sky.Init(data_path + "/");
+  InitPostProcess();
+  {
+    bool canBlit = g_shadowMap.objectCasters &&
+                   (bgfx::getCaps()->supported & BGFX_CAPS_TEXTURE_BLIT) != 0;
+    g_shadowMap.colorTex = bgfx::createTexture2D(
+        SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, false, 1,
+        bgfx::TextureFormat::BGRA8,
+        BGFX_TEXTURE_RT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP |
+            (canBlit ? BGFX_TEXTURE_BLIT_DST : 0));
+    g_shadowMap.depthTex = bgfx::createTexture2D(
+        SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, false, 1,
+        bgfx::TextureFormat::D16, BGFX_TEXTURE_RT_WRITE_ONLY);
+    bgfx::TextureHandle atts[] = { g_shadowMap.colorTex, g_shadowMap.depthTex };
+    g_shadowMap.fb = bgfx::createFrameBuffer(2, atts, false);
+    if (canBlit) {
+      g_shadowMap.staticColorTex = bgfx::createTexture2D(
+          SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, false, 1,
+          bgfx::TextureFormat::BGRA8,
+          BGFX_TEXTURE_RT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
+      g_shadowMap.staticDepthTex = bgfx::createTexture2D(
+          SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, false, 1,
+          bgfx::TextureFormat::D16, BGFX_TEXTURE_RT_WRITE_ONLY);
+      bgfx::TextureHandle staticAtts[] = { g_shadowMap.staticColorTex,
+                                           g_shadowMap.staticDepthTex };
+      g_shadowMap.staticFb = bgfx::createFrameBuffer(2, staticAtts, false);
+    }
+    g_shadowMap.depthShader = Shader::Load("vs_depth.bin", "fs_depth.bin");
+    g_shadowMap.skinnedDepthShader =
+        Shader::Load("vs_depth_skinned.bin", "fs_depth.bin");
+    if (g_shadowMap.depthShader && bgfx::isValid(g_shadowMap.fb)) {
+      std::cout << "[ShadowMap] Initialized " << SHADOW_MAP_SIZE << "x"
+                << SHADOW_MAP_SIZE << " depth FBO"
+                << (!g_shadowMap.objectCasters ? "\n"
+                    : bgfx::isValid(g_shadowMap.staticFb)
+                        ? " + cached static layer\n"
+                        : " (no blit: static casters every frame)\n");
+    } else {
+      std::cerr << "[ShadowMap] Failed to initialize shadow mapping\n";
+    }
+  }
+  // Minimap texture will be generated after each terrain load
+  g_fireEffect.Init(data_path + "/Effect");
+  g_vfxManager.Init(data_path);
+  g_vfxManager.SetTerrainHeightFunc(
+      [](float x, float z) -> float { return g_terrain.GetHeight(x, z); });
+  g_vfxManager.SetPlaySoundFunc(
+      [](int soundId) { SoundManager::Play(soundId); });
+  g_boidManager.Init(data_path);
+  g_hero.Init(data_path);
+  g_hero.SetVFXManager(&g_vfxManager);
+  g_hero.LoadStats(1, 28, 20, 25, 10, 0, 0, 110, 110, 20, 20, 50, 50, 16);
+  ChromeGlow::LoadTextures(g_dataPath);
+  ItemModelManager::Init(g_hero.GetShader(), g_dataPath);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// RenderWorld — in-game 3D scene, one frame
+// ═══════════════════════════════════════════════════════════════════
+
+static void RenderWorld(const glm::mat4 &view, const glm::mat4 &projection,
+                        const glm::vec3 &camPos, float deltaTime,
+                        float currentFrame, int fbW, int fbH,
+                        FrameProfiler *prof) {
+  // BGFX view ordering: static shadow layer (view 1), then the shadow pass
+  // (view 8), before scene (view 0) and post-processing (views 2-6, 9).
+  // Views 10+ (ImGui 30, 200, 201) use default order.
+  {
+    bgfx::ViewId order[] = { SHADOW_STATIC_VIEW, SHADOW_VIEW, 0,
+                              PP_VIEW_BRIGHT, PP_VIEW_BLUR0, PP_VIEW_BLUR1,
+                              PP_VIEW_BLUR2, PP_VIEW_BLUR3, PP_VIEW_COMPOSITE,
+                              7 };
+    bgfx::setViewOrder(0, 10, order);
+  }
+  // BGFX view 0 setup: clear, viewport, and post-process FBO
+  bgfx::setViewClear(0, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL,
+                      0x000000FF, 1.0f, 0);
+  bgfx::setViewRect(0, 0, 0, uint16_t(fbW), uint16_t(fbH));
+  if (g_postProcess.enabled) {
+    ResizePostProcessFBOs(fbW, fbH);
+    if (bgfx::isValid(g_postProcess.sceneFB))
+      bgfx::setViewFrameBuffer(0, g_postProcess.sceneFB);
+  } else {
+    bgfx::setViewFrameBuffer(0, BGFX_INVALID_HANDLE);
+  }
+  bgfx::touch(0);
+
+  FrameProfiler::Scope section(prof, "shadows");
+  // ── Shadow map pass: render depth from directional light ──
+  // Two layers: world objects go into a cached static layer, redrawn only
+  // when the light frustum recentres; characters are drawn over a copy of
+  // it every frame (min blend keeps the nearer depth of the two).
+  if (g_shadowMap.depthShader && bgfx::isValid(g_shadowMap.fb)) {
+    glm::vec3 heroPos = g_hero.GetPosition();
+    // Directional light: nearly overhead sun with subtle side tilt
+    glm::vec3 lightDir = glm::normalize(glm::vec3(-0.2f, -1.0f, -0.1f));
+    glm::vec3 up = glm::vec3(0.0f, 0.0f, 1.0f);
+    // Avoid degenerate up vector
+    if (std::abs(glm::dot(lightDir, up)) > 0.99f)
+      up = glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::mat4 lightRot = glm::lookAt(glm::vec3(0.0f), lightDir, up);
+
+    // Recentre on the hero once it drifts far enough, snapped to whole
+    // texels so shadow edges don't crawl when the layer is redrawn (static
+    // and dynamic casters share lightView, hence the grid, in between)
+    glm::vec3 heroLS = glm::vec3(lightRot * glm::vec4(heroPos, 1.0f));
+    const float texel = 2.0f * SHADOW_HALF_EXTENT / SHADOW_MAP_SIZE;
+    glm::vec3 drift = heroLS - g_shadowMap.centerLS;
+    bool recentre =
+        !g_shadowMap.staticValid ||
+        std::max(std::abs(drift.x), std::abs(drift.y)) >
+            SHADOW_STATIC_SHIFT_TEXELS * texel ||
+        std::abs(drift.z) > SHADOW_STATIC_DEPTH_SLACK;
+    if (recentre) {
+      g_shadowMap.centerLS =
+          glm::vec3(std::floor(heroLS.x / texel) * texel,
+                    std::floor(heroLS.y / texel) * texel, heroLS.z);
+      // Eye 2000 units back along the light from the centre
+      g_shadowMap.lightView =
+          glm::translate(glm::mat4(1.0f),
+                         glm::vec3(0.0f, 0.0f, -2000.0f) -
+                             g_shadowMap.centerLS) *
+          lightRot;
+    }
+    const glm::mat4 &lightView = g_shadowMap.lightView;
+    const float E = SHADOW_HALF_EXTENT;
+    // Metal uses [0,1] Z clip range; OpenGL uses [-1,1]
+    glm::mat4 lightProj = bgfx::getCaps()->homogeneousDepth
+      ? glm::ortho(-E, E, -E, E, 100.0f, 5000.0f)
+      : glm::orthoRH_ZO(-E, E, -E, E, 100.0f, 5000.0f);
+    glm::mat4 lightMtx = lightProj * lightView;
+
+    bool cached = bgfx::isValid(g_shadowMap.staticFb);
+    if (cached) {
+      if (recentre) {
+        bgfx::setViewName(SHADOW_STATIC_VIEW, "ShadowMapStatic");
+        bgfx::setViewRect(SHADOW_STATIC_VIEW, 0, 0, SHADOW_MAP_SIZE,
+                          SHADOW_MAP_SIZE);
+        bgfx::setViewClear(SHADOW_STATIC_VIEW,
+                           BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0xFFFFFFFF,
+                           1.0f, 0);
+        bgfx::setViewFrameBuffer(SHADOW_STATIC_VIEW, g_shadowMap.staticFb);
+        bgfx::setViewTransform(SHADOW_STATIC_VIEW, glm::value_ptr(lightView),
+                               glm::value_ptr(lightProj));
+        bgfx::touch(SHADOW_STATIC_VIEW);
+        g_objectRenderer.RenderToShadowMap(SHADOW_STATIC_VIEW,
+                                           g_shadowMap.depthShader->program,
+                                           lightMtx);
+        g_shadowMap.staticRedraws++;
+      } else {
+        // Untouched: the layer keeps last redraw's contents
+        bgfx::setViewClear(SHADOW_STATIC_VIEW, BGFX_CLEAR_NONE);
+      }
+    }
+    g_shadowMap.staticValid = true;
+
+    // Setup shadow view
+    bgfx::setViewName(SHADOW_VIEW, "ShadowMap");
+    bgfx::setViewRect(SHADOW_VIEW, 0, 0, SHADOW_MAP_SIZE, SHADOW_MAP_SIZE);
+    if (cached) {
+      // Color comes whole from the static layer (blits run before draws)
+      bgfx::setViewClear(SHADOW_VIEW, BGFX_CLEAR_DEPTH, 0, 1.0f, 0);
+      bgfx::blit(SHADOW_VIEW, g_shadowMap.colorTex, 0, 0,
+                 g_shadowMap.staticColorTex);
+    } else {
+      bgfx::setViewClear(SHADOW_VIEW, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH,
+                         0xFFFFFFFF, 1.0f, 0);
+    }
+    bgfx::setViewFrameBuffer(SHADOW_VIEW, g_shadowMap.fb);
+    bgfx::setViewTransform(SHADOW_VIEW, glm::value_ptr(lightView),
+                            glm::value_ptr(lightProj));
+    bgfx::touch(SHADOW_VIEW);
+
+    // Views 1 and 8 render before view 0 via setViewOrder (set above).
+
+    // Submit shadow casters
+    if (!cached && g_shadowMap.objectCasters)
+      g_objectRenderer.RenderToShadowMap(SHADOW_VIEW,
+                                         g_shadowMap.depthShader->program,
+                                         lightMtx);
+    // Without the skinned depth program characters just cast no shadow
+    bgfx::ProgramHandle skinnedDepth = BGFX_INVALID_HANDLE;
+    if (g_shadowMap.skinnedDepthShader)
+      skinnedDepth = g_shadowMap.skinnedDepthShader->program;
+    g_hero.RenderToShadowMap(SHADOW_VIEW, g_shadowMap.depthShader->program,
+                             skinnedDepth);
+    g_monsterManager.RenderToShadowMap(SHADOW_VIEW,
+                                       g_shadowMap.depthShader->program,
+                                       skinnedDepth);
+    g_npcManager.RenderToShadowMap(SHADOW_VIEW, g_shadowMap.depthShader->program,
+                                   skinnedDepth);
+
+    // Pass shadow map texture + light matrix to all receivers
+    g_hero.SetShadowMap(g_shadowMap.colorTex, lightMtx);
+    g_monsterManager.SetShadowMap(g_shadowMap.colorTex, lightMtx);
+    g_npcManager.SetShadowMap(g_shadowMap.colorTex, lightMtx);
+    g_terrain.SetShadowMap(g_shadowMap.colorTex, lightMtx);
+  }
+
+  section.Next("sky");
+  // Sky renders first (behind everything, no depth write)
+  if (g_mapCfg->hasSky) {
+    g_sky.Render(view, projection, camPos, g_luminosity);
+  }
+
+  section.Next("lights");
+  // Main 5.2: AddTerrainLight — merge world point lights + spell projectile
+  // lights Spell lights are transient (per-frame), so rebuild the full list
+  // each frame. Static vectors reuse capacity across frames (zero heap allocs
+  // after warmup).
+  {
+    static std::vector<glm::vec3> lightPos, lightCol;
+    static std::vector<float> lightRange;
+    static std::vector<int> lightObjTypes;
+    lightPos.clear();
+    lightCol.clear();
+    lightRange.clear();
+    lightObjTypes.clear();
+    // Static world lights (fires, streetlights, candles, etc.)
+    for (auto &pl : g_pointLights) {
+      lightPos.push_back(pl.position);
+      lightCol.push_back(pl.color);
+      lightRange.push_back(pl.range);
+      lightObjTypes.push_back(pl.objectType);
+    }
+    // Dynamic spell lights from active projectiles
+    g_vfxManager.GetActiveSpellLights(lightPos, lightCol, lightRange,
+                                      lightObjTypes);
+    // Update terrain (CPU lightmap) and object renderer (shader uniforms)
+    g_terrain.SetPointLights(lightPos, lightCol, lightRange, lightObjTypes);
+    g_objectRenderer.SetPointLights(lightPos, lightCol, lightRange);
+    // Update character renderers with merged PointLight list
+    static std::vector<PointLight> mergedLights;
+    mergedLights.clear();
+    mergedLights.reserve(lightPos.size());
+    for (size_t i = 0; i < lightPos.size(); ++i) {
+      mergedLights.push_back(
+          {lightPos[i], lightCol[i], lightRange[i],
+           i < lightObjTypes.size() ? lightObjTypes[i] : 0});
+    }
+    g_hero.SetPointLights(mergedLights);
+    g_npcManager.SetPointLights(mergedLights);
+    g_monsterManager.SetPointLights(mergedLights);
+    g_boidManager.SetPointLights(mergedLights);
+  }
+
+  section.Next("terrain");
+  g_terrain.Render(view, projection, currentFrame, camPos);
+
+  section.Next("objects");
+  // Lightmap texture is destroyed+recreated each frame by Terrain, so refresh handle
+  g_objectRenderer.SetLightmapTexture(g_terrain.GetLightmapTexture());
+  g_objectRenderer.Render(view, projection, g_camera.GetPosition(),
+                          currentFrame);
+
+  section.Next("grass");
+  // Render grass billboards (config-driven)
+  if (g_mapCfg->hasGrass) {
+    std::vector<GrassRenderer::PushSource> pushSources;
+    pushSources.push_back({g_hero.GetPosition(), 100.0f});
+    g_grass.Render(view, projection, currentFrame, camPos, pushSources);
+  }
+
+  section.Next("vfx update");
+  // Main 5.2 level-up VFX: 15 BITMAP_FLARE joints in a ring
+  if (g_hero.LeveledUpThisFrame()) {
+    g_vfxManager.SpawnLevelUpEffect(g_hero.GetPosition());
+    SoundManager::Play(SOUND_LEVEL_UP);
+    g_hero.ClearLevelUpFlag();
+  }
+
+  // Update effects (VFX rendered after characters for correct layering)
+  g_fireEffect.Update(deltaTime);
+  g_vfxManager.UpdateLevelUpCenter(g_hero.GetPosition());
+
+  // Dungeon trap VFX (Main 5.2: types 39=lance, 40=blade, 51=fire)
+  // HiddenMesh=-2, VFX-only — spawned continuously in CharacterAnimation
+  if (g_mapCfg->hasDungeonTraps) {
+    static float trapVfxTimer = 0.0f;
+    trapVfxTimer += deltaTime;
+    if (trapVfxTimer >= 0.15f) { // ~7 bursts/sec
+      trapVfxTimer -= 0.15f;
+      for (auto &inst : g_objectRenderer.GetInstances()) {
+        glm::vec3 pos = glm::vec3(inst.modelMatrix[3]);
+        if (inst.type == 39) {
+          // Lance Trap: lightning sprites (Main 5.2: MODEL_SAW +
+          // SOUND_TRAP01)
+          pos.y += 30.0f + (float)(rand() % 40);
+          g_vfxManager.SpawnBurst(ParticleType::SPELL_LIGHTNING, pos, 2);
+        }
+        // Note: type 51 (Fire Trap) fire particles now handled by ambient
+        // fire emitter system in VFXManager
+      }
+    }
+  }
+
+
+  g_vfxManager.Update(deltaTime);
+
+  // Twister proximity: apply StormTime spin when tornado VFX reaches a
+  // monster
+  if (g_vfxManager.HasActiveTwisters()) {
+    int monCount = g_monsterManager.GetMonsterCount();
+    for (int mi = 0; mi < monCount; ++mi) {
+      MonsterInfo info = g_monsterManager.GetMonsterInfo(mi);
+      if (info.hp <= 0)
+        continue;
+      if (g_vfxManager.CheckTwisterHit(info.serverIndex, info.position))
+        g_monsterManager.ApplyStormTime(info.serverIndex, 10);
+    }
+  }
+
+  // Evil Spirit: StormTime spin on nearby monsters (Main 5.2: same as
+  // Twister)
+  if (g_vfxManager.HasActiveSpiritBeams()) {
+    int monCount = g_monsterManager.GetMonsterCount();
+    for (int mi = 0; mi < monCount; ++mi) {
+      MonsterInfo info = g_monsterManager.GetMonsterInfo(mi);
+      if (info.hp <= 0)
+        continue;
+      if (g_vfxManager.CheckSpiritBeamHit(info.serverIndex, info.position))
+        g_monsterManager.ApplyStormTime(info.serverIndex, 10);
+    }
+  }
+
+  section.Next("ambient");
+  // Boids — birds in Lorencia, bats in Dungeon (BoidManager handles map
+  // logic)
+  g_boidManager.Update(deltaTime, g_hero.GetPosition(), 0, currentFrame);
+  g_fireEffect.Render(view, projection);
+  g_objectRenderer.RenderLightningSprites(view, projection, currentFrame);
+
+  // Render ambient creatures (birds/fish/bats/leaves)
+  g_boidManager.RenderShadows(view, projection);
+  g_boidManager.Render(view, projection, camPos);
+  if (g_mapCfg->hasLeaves)
+    g_boidManager.RenderLeaves(view, projection);
+
+  section.Next("npcs");
+  // Update NPC interaction state (guard faces player only when quest dialog
+  // is open)
+  g_npcManager.SetPlayerPosition(g_hero.GetPosition());
+  g_npcManager.SetInteractingNpc(g_questDialogOpen ? g_questDialogNpcIndex
+                                                   : -1);
+  // Precompute quest markers per guard NPC type
+  {
+    // Collect unique guard types from quest defs
+    std::vector<NpcManager::GuardMarker> markers;
+    uint16_t seenGuards[20];
+    int seenCount = 0;
+    for (int qi = 0; qi < (int)g_questCatalog.size(); qi++) {
+      uint16_t gt = g_questCatalog[qi].guardType;
+      bool found = false;
+      for (int s = 0; s < seenCount; s++)
+        if (seenGuards[s] == gt) { found = true; break; }
+      if (found) continue;
+      seenGuards[seenCount++] = gt;
+
+      // Determine best marker for this guard
+      // Priority: completable '?' gold > available '!' gold > in-progress '?' grey
+      char bestMarker = '\0';
+      bool bestGold = false;
+      for (int qi2 = 0; qi2 < (int)g_questCatalog.size(); qi2++) {
+        if (g_questCatalog[qi2].guardType != gt) continue;
+        int st = GetQuestStatus(qi2);
+        if (st == 2) { // completable — highest priority
+          bestMarker = '?'; bestGold = true; break;
+        } else if (st == 0 && bestMarker != '?') { // available
+          bestMarker = '!'; bestGold = true;
+        } else if (st == 1 && bestMarker == '\0') { // in-progress
+          bestMarker = '?'; bestGold = false;
+        }
+      }
+      if (bestMarker != '\0')
+        markers.push_back({gt, bestMarker, bestGold});
+    }
+    g_npcManager.SetQuestMarkers(markers);
+  }
+
+  // Render NPC stencil shadows + models (skip stencil when shadow map active)
+  bool hasShadowMap = g_shadowMap.depthShader && bgfx::isValid(g_shadowMap.fb);
+  if (!hasShadowMap) g_npcManager.RenderShadows(view, projection);
+  g_npcManager.Render(view, projection, camPos, deltaTime);
+
+  section.Next("monsters");
+  // Render monster stencil shadows + models
+  if (!hasShadowMap) g_monsterManager.RenderShadows(view, projection);
+  g_monsterManager.Render(view, projection, camPos, deltaTime);
+
+  // Silhouette outline on hovered NPC/monster (stencil-based)
+  if (g_hoveredMonster >= 0)
+    g_monsterManager.RenderSilhouetteOutline(g_hoveredMonster, view,
+                                             projection);
+
+  section.Next("hero");
+  // Render ground item shadows (before hero so items don't shadow-over hero)
+  GroundItemRenderer::RenderShadows(g_groundItems, MAX_GROUND_ITEMS, view,
+                                    projection);
+
+  // Render hero stencil shadow + model (skip stencil when shadow map active)
+  g_clickEffect.Render(view, projection, deltaTime, g_hero.GetShader());
+  if (!hasShadowMap) g_hero.RenderShadow(view, projection);
+  g_hero.Render(view, projection, camPos, deltaTime);
+
+  // Compute hero bone world positions for VFX bone-attached particles
+  {
+    const auto &bones = g_hero.GetCachedBones();
+    float facing = g_hero.GetFacing();
+    glm::vec3 heroPos = g_hero.GetPosition();
+    float cosF = cosf(facing), sinF = sinf(facing);
+    std::vector<glm::vec3> boneWorldPos(bones.size());
+    for (int i = 0; i < (int)bones.size(); ++i) {
+      // Translation column of 3x4 bone matrix (model-local space)
+      float bx = bones[i][0][3];
+      float by = bones[i][1][3];
+      float bz = bones[i][2][3];
+      // Apply facing rotation in MU space (same as shadow
+      // HeroCharacter.cpp:994)
+      float rx = bx * cosF - by * sinF;
+      float ry = bx * sinF + by * cosF;
+      // Full model transform: translate * rotZ(-90) * rotY(-90) *
+      // rotZ(facing) After facing rotation in MU space: (rx, ry, bz) After
+      // rotY(-90): (-bz, ry, rx) After rotZ(-90): (ry, bz, rx)
+      boneWorldPos[i] = heroPos + glm::vec3(ry, bz, rx);
+    }
+    g_vfxManager.SetHeroBonePositions(boneWorldPos);
+  }
+
+  // Feed weapon blur trail points to VFX (Main 5.2: per-frame capture)
+  if (g_hero.IsWeaponTrailActive() && g_hero.HasValidTrailPoints()) {
+    g_vfxManager.AddWeaponTrailPoint(g_hero.GetWeaponTrailTip(),
+                                     g_hero.GetWeaponTrailBase());
+  }
+
+  section.Next("vfx render");
+  // Render VFX (after all characters so particles layer on top)
+  g_vfxManager.Render(view, projection);
+
+  section.Next("postprocess");
+  // Post-processing: bloom + vignette + composite (reads scene FBO → backbuffer)
+  RenderPostProcess(fbW, fbH);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// RunHeadlessBench — client CPU benchmark without a GPU, window or server
+//   MuRemaster --headless-bench[=FRAMES] [--map N] [--monsters N] [--npcs N]
+//                                [--no-crowd] [--no-instancing] [--jobs N]
+// BGFX runs the Noop renderer, so every subsystem does its full CPU work
+// (culling, animation, uniform/transient buffer setup, submits) and nothing
+// is drawn. The hero walks a fixed circle with the camera orbiting, among
+// seeded monsters/NPCs and periodic VFX; the timestep is a fixed 60 Hz so
+// runs are comparable across machines and builds. --jobs sets the animation
+// worker count (0 = all on the main thread; default one per spare core);
+// --object-shadows adds the world-object shadow casters; --no-crowd and
+// --no-instancing fall back to per-instance monster/object draws.
+// ═══════════════════════════════════════════════════════════════════
+
+static int RunHeadlessBench(int argc, char **argv) {
+  int frames = 600, mapId = 0, monsterCount = 60, npcCount = 8;
+  bool crowd = true;
+  int jobs = -1;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.rfind("--headless-bench=", 0) == 0)
+      frames = std::atoi(argv[i] + 17);
+    else if (arg == "--map" && i + 1 < argc)
+      mapId = std::atoi(argv[++i]);
+    else if (arg == "--monsters" && i + 1 < argc)
+      monsterCount = std::atoi(argv[++i]);
+    else if (arg == "--npcs" && i + 1 < argc)
+      npcCount = std::atoi(argv[++i]);
+    else if (arg == "--no-crowd")
+      crowd = false; // Per-instance monster draws, for comparison
+    else if (arg == "--no-instancing")
+      g_objectRenderer.SetInstancing(false); // Per-instance object draws
+    else if (arg == "--jobs" && i + 1 < argc)
+      jobs = std::atoi(argv[++i]);
+    else if (arg == "--object-shadows")
+      g_shadowMap.objectCasters = true;
+  }
+  if (frames < 1)
+    frames = 600;
+  if (mapId < 0 || mapId > 255 || GetMapConfig(mapId)->mapId != mapId) {
+    std::cerr << "[Bench] Unknown map " << mapId << std::endl;
+    return 1;
+  }
+
+  static constexpr int BENCH_W = 1366, BENCH_H = 768;
+  static constexpr float BENCH_DT = 1.0f / 60.0f;
+  static constexpr int WARMUP_FRAMES = 60; // Fill particle pools first
+  static constexpr float PATH_RADIUS = 800.0f;
+  static constexpr float PATH_LAP_SECONDS = 20.0f;
+
+  bgfx::renderFrame(); // Single-threaded: bgfx::frame() includes backend work
+  bgfx::Init bgfxInit;
+  bgfxInit.type = bgfx::RendererType::Noop;
+  bgfxInit.resolution.width = BENCH_W;
+  bgfxInit.resolution.height = BENCH_H;
+  bgfxInit.resolution.reset = BGFX_RESET_NONE;
+  if (!bgfx::init(bgfxInit)) {
+    std::cerr << "[Bench] Failed to initialize BGFX (Noop)" << std::endl;
+    return 1;
+  }
+
+  g_terrain.Init();
+  ItemDatabase::Init();
+  InitRenderSubsystems();
+  LoadWorld(mapId);
+
+  std::string data_path = g_dataPath;
+  g_npcManager.InitModels(data_path);
+  g_monsterManager.InitModels(data_path);
+  g_hero.SetTerrainData(g_terrainDataPtr);
+  g_hero.SetTerrainLightmap(g_terrainDataPtr->lightmap);
+  g_hero.SetPointLights(g_pointLights);
+  g_npcManager.SetTerrainData(g_terrainDataPtr);
+  g_npcManager.SetTerrainLightmap(g_terrainDataPtr->lightmap);
+  g_npcManager.SetPointLights(g_pointLights);
+  g_npcManager.SetVFXManager(&g_vfxManager);
+  g_monsterManager.SetTerrainData(g_terrainDataPtr);
+  g_monsterManager.SetTerrainLightmap(g_terrainDataPtr->lightmap);
+  g_monsterManager.SetPointLights(g_pointLights);
+  g_monsterManager.SetVFXManager(&g_vfxManager);
+  g_monsterManager.SetCrowdRendering(crowd);
+  g_jobSystem.Start(jobs);
+  g_monsterManager.SetJobSystem(&g_jobSystem);
+  g_npcManager.SetJobSystem(&g_jobSystem);
+  g_boidManager.SetTerrainData(g_terrainDataPtr);
+  g_boidManager.SetTerrainLightmap(g_terrainDataPtr->lightmap);
+  g_boidManager.SetPointLights(g_pointLights);
+  g_clickEffect.Init();
+  g_clickEffect.LoadAssets(data_path);
+  g_clickEffect.SetTerrainData(g_terrainDataPtr);
+
+  // Centre the scene on the walkable cell nearest the middle of the map
+  const int S = TerrainParser::TERRAIN_SIZE;
+  const auto &attrs = g_terrainDataPtr->mapping.attributes;
+  auto walkable = [&](int gx, int gy) {
+    return gx >= 0 && gy >= 0 && gx < S && gy < S &&
+           (attrs[gy * S + gx] & 0x0C) == 0; // Not TW_NOMOVE / TW_NOGROUND
+  };
+  int centerX = S / 2, centerY = S / 2;
+  for (int r = 0; r < S / 2 && !walkable(centerX, centerY); ++r)
+    for (int dy = -r; dy <= r && !walkable(centerX, centerY); ++dy)
+      for (int dx = -r; dx <= r; ++dx)
+        if (walkable(S / 2 + dx, S / 2 + dy)) {
+          centerX = S / 2 + dx;
+          centerY = S / 2 + dy;
+          break;
+        }
+  // Grid (x, y) → world (y * 100, x * 100), as for server positions
+  const glm::vec3 center((float)centerY * 100.0f, 0.0f, (float)centerX * 100.0f);
+
+  // Seeded so every run and machine sees the same scene
+  std::mt19937 rng(20240601);
+  auto scatter = [&](uint8_t &gx, uint8_t &gy) {
+    std::uniform_int_distribution<int> off(-15, 15);
+    for (int attempt = 0; attempt < 32; ++attempt) {
+      int x = centerX + off(rng), y = centerY + off(rng);
+      if (walkable(x, y)) {
+        gx = (uint8_t)x;
+        gy = (uint8_t)y;
+        return;
+      }
+    }
+    gx = (uint8_t)centerX;
+    gy = (uint8_t)centerY;
+  };
+  static const uint16_t MONSTER_TYPES[] = {0, 1, 2, 3, 4, 6, 7, 8, 9, 10, 11};
+  static const uint16_t NPC_TYPES[] = {253, 250, 251, 249, 254, 255, 248, 240};
+  for (int i = 0; i < monsterCount; ++i) {
+    uint8_t gx, gy;
+    scatter(gx, gy);
+    uint16_t type = MONSTER_TYPES[i % (sizeof(MONSTER_TYPES) / sizeof(MONSTER_TYPES[0]))];
+    g_monsterManager.AddMonster(type, gx, gy, (uint8_t)(rng() % 8),
+                                (uint16_t)(1000 + i), 100, 100);
+  }
+  for (int i = 0; i < npcCount; ++i) {
+    uint8_t gx, gy;
+    scatter(gx, gy);
+    uint16_t type = NPC_TYPES[i % (sizeof(NPC_TYPES) / sizeof(NPC_TYPES[0]))];
+    g_npcManager.AddNpcByType(type, gx, gy, (uint8_t)(rng() % 8),
+                              (uint16_t)(2000 + i));
+  }
+
+  std::cout << "[Bench] Map " << mapId << " (" << g_mapCfg->regionName
+            << ") around grid (" << centerX << "," << centerY << "): "
+            << g_monsterManager.GetMonsterCount() << " monsters, "
+            << g_npcManager.GetNpcCount() << " NPCs, " << frames
+            << " frames after " << WARMUP_FRAMES << " warm-up" << std::endl;
+
+  static const ParticleType BURST_TYPES[] = {
+      ParticleType::HIT_SPARK, ParticleType::BLOOD, ParticleType::SPELL_FIRE,
+      ParticleType::SPELL_LIGHTNING, ParticleType::SPELL_ICE};
+  const float startYaw = g_camera.GetYaw(), pitch = g_camera.GetPitch();
+  FrameProfiler profiler;
+  for (int f = -WARMUP_FRAMES; f < frames; ++f) {
+    FrameProfiler *prof = f >= 0 ? &profiler : nullptr;
+    if (f == 0) {
+      AnimationTracks::ResetStats(); // Warm-up bakes the first samples
+      AnimationTracks::SetTiming(true);
+      g_terrain.ResetDrawStats();
+      g_objectRenderer.ResetCullStats();
+    }
+    if (prof)
+      prof->BeginFrame();
+    float currentFrame = (float)(f + WARMUP_FRAMES) * BENCH_DT;
+
+    {
+      FrameProfiler::Scope section(prof, "simulation");
+      // Scripted path: hero circles the centre, camera turns with it
+      float lap = currentFrame / PATH_LAP_SECONDS;
+      float ang = lap * 6.2831853f;
+      g_hero.SetPosition(center + glm::vec3(std::cos(ang) * PATH_RADIUS, 0.0f,
+                                            std::sin(ang) * PATH_RADIUS));
+      g_hero.SnapToTerrain();
+      g_camera.SetPosition(g_hero.GetPosition());
+      g_camera.SetAngles(startYaw + lap * 360.0f, pitch);
+      g_camera.Update(BENCH_DT);
+
+      // Synthetic combat: a burst on some monster every 0.25s, a level-up
+      // ring every 3s
+      int step = f + WARMUP_FRAMES;
+      if (step % 15 == 0 && g_monsterManager.GetMonsterCount() > 0) {
+        int target = (int)(rng() % g_monsterManager.GetMonsterCount());
+        glm::vec3 pos = g_monsterManager.GetMonsterInfo(target).position;
+        pos.y += 80.0f;
+        g_vfxManager.SpawnBurst(
+            BURST_TYPES[(step / 15) % (sizeof(BURST_TYPES) / sizeof(BURST_TYPES[0]))],
+            pos, 12);
+      }
+      if (step % 180 == 0)
+        g_vfxManager.SpawnLevelUpEffect(g_hero.GetPosition());
+
+      g_monsterManager.SetPlayerPosition(g_hero.GetPosition());
+      g_monsterManager.SetPlayerFacing(g_hero.GetFacing());
+      g_monsterManager.Update(BENCH_DT);
+      g_hero.UpdateState(BENCH_DT);
+    }
+
+    glm::mat4 projection =
+        g_camera.GetProjectionMatrix((float)BENCH_W, (float)BENCH_H);
+    glm::mat4 view = g_camera.GetViewMatrix();
+    RenderWorld(view, projection, g_camera.GetPosition(), BENCH_DT,
+                currentFrame, BENCH_W, BENCH_H, prof);
+
+    {
+      FrameProfiler::Scope section(prof, "bgfx frame");
+      bgfx::frame();
+    }
+    if (prof)
+      prof->EndFrame();
+  }
+  profiler.Report("Headless bench (Noop renderer, CPU only)");
+  printf("[Bench] Animation workers: %d\n", g_jobSystem.GetWorkerCount());
+  if (g_shadowMap.objectCasters)
+    printf("[Bench] Static shadow layer: %d redraws in %d frames%s\n",
+           g_shadowMap.staticRedraws, frames + WARMUP_FRAMES,
+           bgfx::isValid(g_shadowMap.staticFb) ? "" : " (not cached, no blit)");
+  const Terrain::DrawStats &terrainStats = g_terrain.GetDrawStats();
+  if (terrainStats.calls > 0)
+    printf("[Bench] Terrain: %.0f of %zu triangles/pass, %.1f chunks, %.1f "
+           "draws\n",
+           (double)terrainStats.triangles / terrainStats.calls,
+           g_terrain.GetFullTriangleCount(),
+           (double)terrainStats.chunks / terrainStats.calls,
+           (double)terrainStats.draws / terrainStats.calls);
+  const ObjectRenderer::CullStats &cull = g_objectRenderer.GetCullStats();
+  if (cull.calls > 0)
+    printf("[Bench] Objects: %.1f of %d instances in %.1f visible leaves "
+           "(%.1f drawn), cull %.3f ms/pass\n",
+           (double)cull.instances / cull.calls,
+           g_objectRenderer.GetInstanceCount(),
+           (double)cull.leaves / cull.calls,
+           (double)cull.visible / cull.calls,
+           cull.cullNs / 1e6 / cull.calls);
+  const SkinFallbackStats &skin = GetSkinFallbackStats();
+  printf("[Bench] Skinning: %d meshes over %d bones on CPU (%d uploads, "
+         "max %d bones)\n",
+         skin.meshes, MAX_SKIN_BONES, skin.uploads, skin.maxBones);
+  AnimationTracks::Stats poses = AnimationTracks::GetStats();
+  if (frames > 0 && poses.lookups > 0)
+    printf("[Bench] Pose cache: %.1f lookups/frame, %.1f%% hits, %llu "
+           "samples baked, %.3f ms/frame\n",
+           (double)poses.lookups / frames,
+           100.0 * (double)poses.hits / (double)poses.lookups,
+           (unsigned long long)poses.baked, poses.cpuNs / 1e6 / frames);
+
+  g_jobSystem.Stop();
+  ChromeGlow::DeleteTextures();
+  g_monsterManager.Cleanup();
+  g_boidManager.Cleanup();
+  g_npcManager.Cleanup();
+  g_hero.Cleanup();
+  g_clickEffect.Cleanup();
+  g_sky.Cleanup();
+  g_fireEffect.Cleanup();
+  g_objectRenderer.Cleanup();
+  g_grass.Cleanup();
+  g_vfxManager.Cleanup();
+  g_terrain.Cleanup();
+  DestroyShadowMap();
+  if (bgfx::isValid(g_minimapTex)) bgfx::destroy(g_minimapTex);
+  bgfx::shutdown();
+  return 0;
+}
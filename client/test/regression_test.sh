@@ -37,7 +37,7 @@ usage() {
     echo "  baseline   - Capture reference screenshots (run with GL build before migration)"
     echo "  test       - Capture current screenshots and compare against baselines"
     echo "  compare    - Compare existing current/ against baselines/ (no capture)"
-    echo "  benchmark  - Run performance benchmark at fixed camera position"
+    echo "  benchmark  - Run the headless CPU benchmark (Noop renderer, no window)"
     exit 1
 }
 
@@ -46,6 +46,10 @@ check_deps() {
         echo "ERROR: ImageMagick not found. Install with: brew install imagemagick"
         exit 1
     fi
+    check_executable
+}
+
+check_executable() {
     if [ ! -f "$EXECUTABLE" ]; then
         echo "ERROR: Game executable not found at $EXECUTABLE"
         echo "Build first: cd build && cmake -DCMAKE_BUILD_TYPE=Release .. && ninja"
@@ -142,13 +146,27 @@ compare_screenshots() {
     return 0
 }
 
+# Headless bench: scripted camera lap over Lorencia with synthetic monsters,
+# NPCs and VFX; prints per-section CPU times and draw calls
+BENCH_FRAMES="${BENCH_FRAMES:-600}"
+
+run_bench() {
+    local label="$1"
+    shift
+    echo ""
+    echo "--- $label ---"
+    "$EXECUTABLE" --headless-bench="$BENCH_FRAMES" --map 0 "$@" 2>&1 | grep '^\[Bench\]\|^  '
+}
+
 run_benchmark() {
-    echo "=== Performance Benchmark ==="
-    echo "  Running 300 frames at fixed camera position..."
-    "$EXECUTABLE" --benchmark --pos 13500 200 13500 2>&1 || {
-        echo "  NOTE: --benchmark flag not yet implemented"
-        echo "  This will be added during the BGFX migration."
-    }
+    echo "=== Performance Benchmark (Noop renderer, $BENCH_FRAMES frames) ==="
+    run_bench "default"
+    run_bench "objects without instancing" --no-instancing
+    run_bench "animation on the main thread" --jobs 0
+    for n in 200 500; do
+        run_bench "$n monsters, crowd" --monsters "$n"
+        run_bench "$n monsters, per-instance" --monsters "$n" --no-crowd
+    done
 }
 
 # Main
@@ -169,7 +187,7 @@ case "${1:-}" in
         compare_screenshots
         ;;
     benchmark)
-        check_deps
+        check_executable
         run_benchmark
         ;;
     *)
@@ -0,0 +1,26 @@
+#ifndef MU_BENCH_HPP
+#define MU_BENCH_HPP
+
+// Offline micro-benchmarks, run from the command line (see main.cpp).
+// Each benchmark works on a scratch database next to the server binary and
+// never touches mu_server.db.
+namespace Bench {
+
+// Save N fully-populated characters (stats, 8x8 bag, equipment, quests) and
+// report saves/sec, once per DB tuning profile and once per commit strategy
+// (one transaction per character vs. one per autosave tick).
+int RunSaveBenchmark(int characters);
+
+// Run the monster tick (Update + ProcessMonsterAI) for N monsters and a few
+// dozen players on an open synthetic map; report per-tick time and, where the
+// kernel allows perf counters, cache misses per tick.
+int RunMonsterBenchmark(int monsters);
+
+// Log in N times against a populated database (5 characters per account with
+// equipment, bag, skills, quests and chat history) and report the time from
+// login to in-world: ValidateLogin + character list + character select.
+int RunLoginBenchmark(int logins);
+
+} // namespace Bench
+
+#endif // MU_BENCH_HPP
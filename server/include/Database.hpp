@@ -1,9 +1,16 @@
 #ifndef MU_DATABASE_HPP
 #define MU_DATABASE_HPP
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <sqlite3.h>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 struct NpcSpawnData {
@@ -123,11 +130,66 @@ struct ItemDropInfo {
   uint16_t level;
 };
 
+// SQLite durability/performance profile, applied by Database::Open
+struct DatabaseTuning {
+  bool walJournal = true;           // journal_mode=WAL (else rollback journal)
+  bool synchronousNormal = true;    // synchronous=NORMAL (else FULL)
+  int64_t mmapSize = 256ll << 20;   // mmap_size in bytes (0 = disabled)
+  int cacheSizeKiB = 16 * 1024;     // Page cache size (cache_size=-N)
+
+  // Default: WAL + NORMAL. A crash may lose the last few commits, but the
+  // database is never corrupted.
+  static DatabaseTuning Fast() { return {}; }
+  // SQLite defaults: rollback journal, fsync on every commit, no mmap.
+  static DatabaseTuning Safe() { return {false, false, 0, 2000}; }
+};
+
 class Database {
 public:
-  bool Open(const std::string &dbPath);
+  ~Database() { Close(); }
+  bool Open(const std::string &dbPath,
+            const DatabaseTuning &tuning = DatabaseTuning::Fast());
   void Close();
 
+  // Scoped transaction: BEGIN on construction, COMMIT only through Commit().
+  // A scope left without Commit() (early return, exception) rolls back, as
+  // does Commit() after a write statement failed inside it. Nested scopes
+  // join the outermost transaction: an inner rollback dooms the whole
+  // transaction, and only the outermost Commit() reaches the database.
+  class Transaction {
+  public:
+    explicit Transaction(Database &db) : m_db(db) { m_db.BeginTransaction(); }
+    ~Transaction() { Rollback(); }
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+
+    // False if the transaction was rolled back instead
+    bool Commit() {
+      if (m_done)
+        return false;
+      m_done = true;
+      return m_db.EndTransaction(true);
+    }
+    void Rollback() {
+      if (!m_done) {
+        m_done = true;
+        m_db.EndTransaction(false);
+      }
+    }
+
+  private:
+    Database &m_db;
+    bool m_done = false;
+  };
+  void BeginTransaction();
+  // commit=false marks the transaction failed. The outermost end issues
+  // COMMIT if nothing failed, ROLLBACK otherwise; returns whether it (or,
+  // when nested, the transaction so far) is still good.
+  bool EndTransaction(bool commit);
+
+  // Returns new accountId, 0 on failure (e.g. username taken)
+  int CreateAccount(const std::string &username, const std::string &password);
+
   // Returns accountId on success, 0 on failure
   int ValidateLogin(const std::string &username, const std::string &password);
 
@@ -169,12 +231,26 @@ public:
   std::vector<MonsterSpawnData> GetMonsterSpawns(uint8_t mapId);
   void SeedMonsterSpawns();
 
+  // Write counter of the spawn and item tables, kept by triggers on every
+  // INSERT/UPDATE/DELETE (world.snapshot key); -1 if it can't be read
+  int64_t GetWorldTablesRevision();
+
   // Items and equipment
+  // Bump when the item seed data in SeedItemDefinitions changes; the table is
+  // only re-seeded (and the world snapshot rebuilt) when this differs from the
+  // revision stored in the database (PRAGMA user_version).
+  static constexpr int ITEM_SEED_REVISION = 1;
   void SeedItemDefinitions();
+  std::vector<ItemDefinition> GetAllItemDefinitions();
+  // Serve GetItemDefinition / GetItemsByLevelRange from memory instead of SQL
+  void SetItemDefinitionCache(const std::vector<ItemDefinition> &items);
   ItemDefinition GetItemDefinition(uint8_t category, uint8_t itemIndex);
   ItemDefinition GetItemDefinition(int id);
   std::vector<ItemDropInfo> GetItemsByLevelRange(int minLevel, int maxLevel);
   std::vector<EquipmentSlot> GetCharacterEquipment(int characterId);
+  // Equipment of every character on the account in one query, by character id
+  std::unordered_map<int, std::vector<EquipmentSlot>>
+  GetAccountEquipment(int accountId);
   void SeedDefaultEquipment(int characterId);
 
   void UpdateEquipment(int characterId, uint8_t slot, uint8_t category,
@@ -218,19 +294,91 @@ public:
   void SaveQuestProgress(int characterId, int questId, int kc0, int kc1, int kc2, bool completed);
   void DeleteQuestProgress(int characterId, int questId);
 
-  // Chat log persistence
+  // Chat log. Each character's most recent CHAT_HISTORY_LIMIT messages live
+  // in an in-memory ring (loaded from chat_log on first use, at most
+  // CHAT_CACHE_CHARACTERS rings, least recently used dropped first). New
+  // messages go to the ring and a pending list that FlushChatLog writes in one
+  // transaction. A background thread trims flushed characters to
+  // CHAT_RETAIN_ROWS rows on its own connection.
+  static constexpr size_t CHAT_HISTORY_LIMIT = 200;
+  static constexpr size_t CHAT_CACHE_CHARACTERS = 1024;
+  static constexpr int CHAT_RETAIN_ROWS = 500;
   struct ChatLogEntry {
     uint8_t category;
     uint32_t color;
     std::string message;
   };
   void SaveChatMessage(int characterId, uint8_t category, uint32_t color,
-                       const std::string &message);
-  std::vector<ChatLogEntry> GetChatHistory(int characterId, int limit = 200);
+                       const std::string &message); // No SQL until the flush
+  std::vector<ChatLogEntry> GetChatHistory(int characterId); // Oldest first
+  void FlushChatLog();
+  // Flush, then forget the ring: another process may write this character's
+  // log next (gateway backends), so reload it from chat_log if it comes back
+  void EvictChatHistory(int characterId);
+
+  // Everything character select needs except chat history (GetChatHistory),
+  // one query per table inside a single read transaction. False if no
+  // character has that name.
+  struct CharacterLoad {
+    CharacterData character;
+    std::vector<EquipmentSlot> equipment;
+    std::vector<InventorySlotData> inventory;
+    std::vector<uint8_t> skills;
+    std::vector<QuestProgress> quests;
+  };
+  bool LoadCharacter(const std::string &name, CharacterLoad &out);
 
 private:
   void CreateTables();
+  void ApplyTuning(const DatabaseTuning &tuning);
+  // Prepared once, reset after each use. Keyed by the SQL text, so any
+  // buffer holding the same statement finds the same entry. Used by the
+  // per-character save and load paths.
+  sqlite3_stmt *CachedStatement(std::string_view sql);
+  // Run a write statement; a failure is logged and fails the open
+  // transaction, if any
+  bool StepWrite(sqlite3_stmt *stmt);
+  bool ExecWrite(const char *sql);
   sqlite3 *m_db = nullptr;
+  int m_txDepth = 0;
+  bool m_txFailed = false; // A write or a nested scope failed
+  struct SqlHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view sql) const {
+      return std::hash<std::string_view>{}(sql);
+    }
+  };
+  std::unordered_map<std::string, sqlite3_stmt *, SqlHash, std::equal_to<>>
+      m_stmtCache;
+  // Indexed by category * 32 + itemIndex; empty = not loaded (query SQL)
+  std::vector<ItemDefinition> m_itemCache;
+
+  struct ChatRing {
+    std::deque<ChatLogEntry> entries;
+    uint64_t lastUse = 0;
+  };
+  struct PendingChat {
+    int characterId;
+    ChatLogEntry entry;
+  };
+  ChatRing &LoadChatRing(int characterId); // Cached, else from chat_log
+  std::unordered_map<int, ChatRing> m_chatCache;
+  uint64_t m_chatUseClock = 0;
+  std::vector<PendingChat> m_chatPending; // Oldest first, not yet in chat_log
+  // A failed flush keeps its rows for the next one; after this many failures
+  // in a row they are dropped so one bad row can't block the log forever
+  static constexpr int CHAT_FLUSH_RETRIES = 3;
+  int m_chatFlushFailures = 0;
+
+  // Retention thread: trims the characters in m_chatPruneIds every
+  // CHAT_PRUNE_INTERVAL (and everyone over the limit at startup)
+  static constexpr int CHAT_PRUNE_INTERVAL = 30; // Seconds
+  void ChatRetentionMain(std::string dbPath);
+  std::thread m_chatPruneThread;
+  std::mutex m_chatPruneMutex;
+  std::condition_variable m_chatPruneCv;
+  std::unordered_set<int> m_chatPruneIds; // Flushed since the last pass
+  bool m_chatPruneStop = false;
 };
 
 #endif // MU_DATABASE_HPP
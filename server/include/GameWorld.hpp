@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // GridPoint: also defined in PathFinder.hpp — must stay identical (ODR)
@@ -20,6 +21,10 @@ struct GridPoint {
 #endif
 
 class PathFinder; // Forward declaration — included by .cpp
+namespace Handoff {
+class Writer;
+class Reader;
+} // namespace Handoff
 
 // ─── Server Config (tunable rates) ─────────────────────────────────────
 namespace ServerConfig {
@@ -27,6 +32,11 @@ static constexpr int XP_MULTIPLIER =
     100;                            // XP gain multiplier (1=normal, 100=100x)
 static constexpr int DROP_RATE = 1; // Drop rate multiplier
 static constexpr float RESPAWN_MULTIPLIER = 1.0f; // Respawn speed (0.5=fast, 1.0=normal, 2.0=slow)
+static constexpr float PLAYER_MOVE_SPEED = 334.0f; // World units/s (client hero walk speed)
+// Client PRECISE_POS may move the simulated position by at most this much per
+// second (accumulating up to POSITION_CORRECTION_MAX), on top of the simulation
+static constexpr float POSITION_CORRECTION_RATE = PLAYER_MOVE_SPEED * 0.5f;
+static constexpr float POSITION_CORRECTION_MAX = 300.0f;
 
 // WoW-style progressive/degressive XP calculation
 // All monsters give at least 1 XP, with smooth reduction for lower-level mobs
@@ -105,23 +115,33 @@ struct MonsterTypeDef {
   float respawnDelay;  // Seconds before respawn (OpenMU per-type)
 };
 
-// Live monster state (server-authoritative)
-struct MonsterInstance {
-  uint16_t index;                 // Unique ID (2001+)
-  uint16_t type;                  // Monster type (3=Spider)
-  uint8_t gridX, gridY;           // Authoritative grid position
-  uint8_t spawnGridX, spawnGridY; // Spawn position for leash/respawn
-  uint8_t dir;
-  float worldX, worldZ; // Derived from grid: worldX=gridY*100, worldZ=gridX*100
-  float spawnX, spawnZ; // Derived from spawn grid
-
-  int hp, maxHp;
-  int defense, defenseRate;
-  int attackMin, attackMax;
-  int attackRate;
-  int level;
+// Fixed-capacity monster path (PathFinder maxSteps is 16 for every caller).
+// Lives inline in MonsterInstance, so path updates never touch the heap.
+struct MonsterPath {
+  static constexpr int CAPACITY = 16;
+  GridPoint points[CAPACITY];
+  uint8_t count = 0;
+
+  bool empty() const { return count == 0; }
+  size_t size() const { return count; }
+  void clear() { count = 0; }
+  const GridPoint &operator[](size_t i) const { return points[i]; }
+  const GridPoint &back() const { return points[count - 1]; }
+  // Takes the first CAPACITY steps of a PathFinder result
+  MonsterPath &operator=(const std::vector<GridPoint> &path) {
+    count = static_cast<uint8_t>(std::min<size_t>(path.size(), CAPACITY));
+    std::copy(path.begin(), path.begin() + count, points);
+    return *this;
+  }
+};
 
-  // ── Proper AI state machine (replaces boolean flag soup) ──
+// Live monster state (server-authoritative).
+// Laid out hot-first: the fields the per-tick Update/ProcessMonsterAI loops
+// read for every monster share the leading cache lines; combat stats, debuffs,
+// summon ownership and broadcast dedup follow. Per-type constants are read
+// through `def` instead of being copied into every instance.
+struct MonsterInstance {
+  // ── Hot: touched every tick ──
   enum class AIState : uint8_t {
     IDLE,        // Standing, decrementing idle timer
     WANDERING,   // Following A* path to random wander point
@@ -133,59 +153,61 @@ struct MonsterInstance {
     DEAD         // Respawn wait (10s)
   };
   AIState aiState = AIState::IDLE;
+  uint8_t gridX, gridY;           // Authoritative grid position
+  uint8_t dir;
+  uint16_t index;                 // Unique ID (2001+)
+  uint16_t type;                  // Monster type (3=Spider)
+  float worldX, worldZ; // Derived from grid: worldX=gridY*100, worldZ=gridX*100
+  int hp, maxHp;
   float stateTimer = 0.0f;     // Time in current state / idle timer
   float attackCooldown = 0.0f; // Cooldown between attacks
-  bool justRespawned = false;  // Set true on respawn, cleared after broadcast
+  float moveTimer = 0.0f;      // Accumulator for moveDelay timing
+  float moveDelay = 0.4f;      // Seconds per grid step (summons move faster)
+  float repathTimer = 0.0f;    // Timer for re-pathfinding during chase
+  int aggroTargetFd = -1;      // FD of player who attacked us
+  float aggroTimer = 0.0f; // Duration to keep aggro (negative = respawn immune)
+  int stormTime = 0;       // Main 5.2: StormTime — Twister stun (AI ticks)
+  int ownerFd = -1;        // FD of summoner (-1 = wild monster)
+  bool aggressive = false; // true=red (auto-aggro); false for summons
+  bool justRespawned = false; // Set true on respawn, cleared after broadcast
+  bool evading = false;       // True during RETURNING (invulnerable)
+  bool poisoned = false;      // Currently has poison debuff
+  const MonsterTypeDef *def = nullptr; // Per-type constants (never null once spawned)
+  bool isSummon() const { return ownerFd >= 0; }
 
   // A* path following (grid-step movement)
-  std::vector<GridPoint> currentPath; // A* result, consumed one step at a time
-  int pathStep = 0;                   // Current step index in path
-  float moveTimer = 0.0f;             // Accumulator for moveDelay timing
-
-  // Per-type AI parameters (from MonsterTypeDef)
-  float atkCooldownTime = 1.8f; // Seconds between attacks
-  float moveDelay = 0.4f;       // Seconds per grid step
-  uint8_t moveRange = 3;        // Grid cells for wandering
-  uint8_t viewRange = 5;        // Grid cells for aggro detection
-  uint8_t attackRange = 1;      // Grid cells for attack range
-  bool aggressive = false;      // true=red (auto-aggro)
-  float respawnDelay = 10.0f;   // Seconds before respawn (per-type from OpenMU)
-
-  // Passive HP regen timer (1% maxHP per second when idle + out of combat)
-  float regenTimer = 0.0f;
-
-  // Main 5.2: StormTime — Twister stun (pauses AI for N ticks)
-  int stormTime = 0;
-  float stormTickTimer = 0.0f;
+  int pathStep = 0;         // Current step index in path
+  MonsterPath currentPath;  // A* result, consumed one step at a time
 
-  // Aggro memory
-  int aggroTargetFd = -1;  // FD of player who attacked us
-  float aggroTimer = 0.0f; // Duration to keep aggro (negative = respawn immune)
-  float repathTimer = 0.0f; // Timer for re-pathfinding during chase
-  int chaseFailCount = 0;   // Consecutive pathfinding failures
+  // ── Warm: AI decisions ──
+  uint8_t spawnGridX, spawnGridY; // Spawn position for leash/respawn
+  float spawnX, spawnZ;           // Derived from spawn grid
+  int chaseFailCount = 0;         // Consecutive pathfinding failures
+  float approachTimer = 0.0f;     // Time spent in APPROACHING state
+  float staggerDelay = 0.0f;      // Per-monster random offset for attack timing
+  float regenTimer = 0.0f; // Passive HP regen (1% maxHP/s, idle + out of combat)
+  float stormTickTimer = 0.0f;
 
   // Threat tracking (summon aggro system)
   float playerThreat = 0.0f;  // Accumulated damage from player
   float summonThreat = 0.0f;  // Accumulated damage from summon
   int aggroSummonIdx = 0;     // If non-zero, monster targets this summon instead of player
 
-  // WoW-style approach + evade
-  float approachTimer = 0.0f;   // Time spent in APPROACHING state
-  float staggerDelay = 0.0f;    // Per-monster random offset for attack timing
-  bool evading = false;          // True during RETURNING (invulnerable)
+  // ── Cold: combat resolution, debuffs, ownership, broadcast ──
+  int defense, defenseRate;
+  int attackMin, attackMax;
+  int attackRate;
+  int level;
 
   // Poison DoT debuff (Main 5.2: AT_SKILL_POISON, OpenMU PoisonMagicEffect)
-  bool poisoned = false;        // Currently has poison debuff
   float poisonTickTimer = 0.0f; // Accumulator for 3-second tick interval
   float poisonDuration = 0.0f;  // Remaining poison duration
   int poisonDamage = 0;         // Flat damage per tick
   int poisonAttackerFd = -1;    // FD of player who applied poison (for XP/aggro)
 
   // Summon ownership (Elf summon pets)
-  int ownerFd = -1;          // FD of summoner (-1 = wild monster)
   int ownerCharId = -1;       // Character ID of summoner
   int lastAttackedMonIdx = -1; // Track last attack target for approach delay
-  bool isSummon() const { return ownerFd >= 0; }
 
   // Broadcast dedup (event-driven: only emit when something changes)
   uint8_t lastBroadcastTargetX = 0;
@@ -204,14 +226,22 @@ struct GroundDrop {
   float age = 0.0f; // Seconds since spawn (despawn after 30s)
 };
 
+class WorldSnapshot;
+
 class GameWorld {
 public:
   GameWorld();
   ~GameWorld(); // Defined in .cpp where PathFinder is complete
 
-  // Load NPCs and monsters from database
+  // Load NPCs and monsters from database (or the attached world snapshot)
   void LoadNpcsFromDB(Database &db, uint8_t mapId = 0);
   void LoadMonstersFromDB(Database &db, uint8_t mapId = 0);
+  void LoadMonsters(const std::vector<MonsterSpawnData> &spawns, uint8_t mapId);
+
+  // Use a mapped world snapshot for terrain, region labels and spawns instead
+  // of decrypting .att files and querying spawn tables. Snapshot must outlive
+  // the world.
+  void AttachSnapshot(const WorldSnapshot *snapshot);
 
   // Player info for server-side monster AI
   struct PlayerTarget {
@@ -310,6 +340,23 @@ public:
   // Find monster by unique index (returns nullptr if not found)
   MonsterInstance *FindMonster(uint16_t index);
 
+  // Spatial queries over monster world positions (includes DYING/DEAD and
+  // summons — callers filter). Results go into the caller's buffer; returns
+  // the number written (at most `capacity`, never writing past it). With
+  // `dropped`, the scan continues past a full buffer and reports how many
+  // further matches didn't fit; without it, it stops at `capacity`. Backed
+  // by a bucket grid rebuilt lazily after monsters move, spawn or despawn, so
+  // cost is proportional to the monsters near the query rather than the map
+  // population.
+  size_t QueryCircle(float x, float z, float radius, MonsterInstance **out,
+                     size_t capacity, size_t *dropped = nullptr);
+  // Monsters within `radius` of the segment (x0,z0)-(x1,z1)
+  size_t QueryCapsule(float x0, float z0, float x1, float z1, float radius,
+                      MonsterInstance **out, size_t capacity,
+                      size_t *dropped = nullptr);
+  // Call after moving a monster outside Update/ProcessMonsterAI
+  void InvalidateSpatialIndex() { m_spatialDirty = true; }
+
   // Summon management
   MonsterInstance *SpawnSummon(uint16_t type, uint8_t gridX, uint8_t gridY,
                                int ownerFd, int ownerCharId,
@@ -318,6 +365,16 @@ public:
   void DespawnSummonsForOwner(int ownerFd);
   void RescaleSummon(uint16_t summonIndex, uint16_t newOwnerLevel);
 
+  // Hot restart (see Handoff.hpp): dynamic state only — monsters, guards,
+  // drops and index counters. Terrain and spawn tables come from the snapshot.
+  void SaveState(Handoff::Writer &out) const;
+  bool LoadState(Handoff::Reader &in);
+  // Count and total size of the fields SaveState writes per monster and drop
+  static void StateLayout(size_t &fields, size_t &bytes);
+  // Rewrite player fds held by monsters and guards after sockets changed
+  // numbers; fds missing from the map are forgotten (summons are despawned).
+  void RemapPlayerFds(const std::unordered_map<int, int> &fdMap);
+
   // Build viewport packets
   std::vector<uint8_t> BuildNpcViewportPacket() const;
   std::vector<uint8_t> BuildMonsterViewportPacket() const; // Legacy 0x1F
@@ -345,12 +402,18 @@ public:
   // Load terrain attributes (.att file) for walkability checks
   bool LoadTerrainAttributes(const std::string &attFilePath);
   bool LoadTerrainAttributesForMap(uint8_t mapId, const std::string &attFilePath);
+  void SetTerrainAttributesForMap(uint8_t mapId, const uint8_t *attributes);
+  static bool ParseTerrainAttributeFile(const std::string &attFilePath,
+                                        std::vector<uint8_t> &outAttributes);
   void SetActiveMap(uint8_t mapId);
   void ClearWorldData(); // Clear NPCs, monsters, drops for map transition
   bool IsWalkable(float worldX, float worldZ) const;
   bool IsSafeZone(float worldX, float worldZ) const;
   bool IsWalkableGrid(uint8_t gx, uint8_t gy) const;
   bool IsSafeZoneGrid(uint8_t gx, uint8_t gy) const;
+  // False only when both cells are walkable and in different regions (no path
+  // can exist). True when no region labels are loaded.
+  bool IsConnectedGrid(GridPoint a, GridPoint b) const;
 
   static constexpr int TERRAIN_SIZE = 256;
   static constexpr uint8_t TW_NOMOVE = 0x04;
@@ -363,6 +426,18 @@ public:
   // Monster type definition lookup
   static const MonsterTypeDef *FindMonsterTypeDef(uint16_t type);
 
+  // A* for player movement (may enter safe zones), start exclusive, end
+  // inclusive. Routes longer than one 16-cell A* segment are chained; the
+  // result stops early (possibly empty) where no segment can be found.
+  std::vector<GridPoint> FindPlayerPath(GridPoint start, GridPoint end,
+                                        int maxSteps) const;
+
+  // Cell a return-to-town (respawn = false) or respawn puts a player on
+  // `mapId`: the map's town point moved to the nearest walkable cell, searched
+  // the same way the client does. False for maps without a town (Dungeon),
+  // whose players are warped to Lorencia instead.
+  bool FindTownSpot(uint8_t mapId, bool respawn, GridPoint &out) const;
+
   // Terrain attributes accessor (for pathfinder)
   const std::vector<uint8_t> &GetTerrainAttributes() const {
     return m_terrainAttributes;
@@ -374,6 +449,21 @@ private:
   std::vector<GroundDrop> m_drops;
   std::vector<uint8_t> m_terrainAttributes; // 256x256 attribute grid (active map)
   std::unordered_map<uint8_t, std::vector<uint8_t>> m_mapTerrainAttributes; // Per-map
+  const uint16_t *m_regionLabels = nullptr; // 256x256 (active map, snapshot)
+
+  // Monster spatial index: slots into m_monsterInstances bucketed by world
+  // position (counting sort, CSR layout). Marked dirty by anything that moves
+  // or adds/removes monsters; rebuilt on the next query.
+  static constexpr float SPATIAL_BUCKET_SIZE = 400.0f; // 4x4 grid cells
+  static constexpr int SPATIAL_DIM = 64;               // 25600 / 400
+  std::vector<uint32_t> m_spatialStart; // SPATIAL_DIM^2 + 1 bucket offsets
+  std::vector<uint32_t> m_spatialSlots;
+  bool m_spatialDirty = true;
+  void rebuildSpatialIndex();
+  template <typename Fn>
+  void forEachSpatialBucket(float minX, float minZ, float maxX, float maxZ,
+                            Fn &&fn);
+  const WorldSnapshot *m_snapshot = nullptr;
   uint8_t m_activeMapId = 0;
   uint16_t m_nextMonsterIndex = 2001;
   uint16_t m_nextSummonIndex = 5001;
@@ -0,0 +1,85 @@
+#ifndef MU_GATEWAY_HPP
+#define MU_GATEWAY_HPP
+
+// MuGateway: connect-server tier in front of several MuServer backends.
+//
+// Clients connect to the gateway and speak the normal C1-C4 protocol. Every
+// client gets its own TCP connection to exactly one backend at a time, and the
+// gateway relays whole packets both ways. Each backend is a MuServer started
+// with --map=N and hosts only that map; all of them share one SQLite file, of
+// which exactly one backend (--db-owner) is the persistence owner that seeds
+// it and builds world.snapshot. Start the owner first.
+//
+// New clients land on the first backend listed (the lobby) for login and
+// character select. When a backend needs a map it doesn't host (character
+// select or a map change), it saves the character and sends a GATEWAY MIGRATE
+// packet carrying the session state instead of changing maps. The gateway
+// then closes that backend connection, connects to the backend hosting the
+// target map and sends it the same packet as RESUME. Backend output up to its
+// RESUMED reply (welcome, character list) is dropped; after it, the client
+// sees the usual MAP_CHANGE flow. GATEWAY packets from clients are dropped, so
+// only the gateway can resume a session. Backends listen on loopback only, so
+// the gateway runs on their host, and every RESUME carries the shared
+// MU_GATEWAY_SECRET; a backend drops RESUMEs with any other key and reloads
+// the character from the database rather than trusting the blob's stats.
+
+#include "PacketDefs.hpp"
+#include "SendQueue.hpp"
+#include <cstdint>
+#include <netinet/in.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Gateway {
+public:
+  struct Backend {
+    uint8_t mapId = 0;
+    std::string host;
+    uint16_t port = 0;
+    struct sockaddr_in addr{}; // Resolved by Start
+  };
+
+  // Shared with the backends (16-32 bytes, false otherwise); set before Start
+  bool SetSecret(const std::string &secret);
+  // backends[0] is the lobby every new client starts on
+  bool Start(uint16_t port, std::vector<Backend> backends);
+  void Run(); // Main loop (blocks until SIGINT)
+  void Stop();
+
+private:
+  struct Link {
+    int fd = -1;
+    bool connecting = false; // Non-blocking connect still in progress
+    std::vector<uint8_t> recvBuf;
+    SendQueue out;
+  };
+  struct Client {
+    Link client;
+    Link backend;
+    int backendIndex = -1;
+    bool resuming = false; // Dropping backend output until RESUMED
+  };
+
+  void AcceptClients();
+  bool ConnectBackend(Client &c, int backendIndex);
+  void OnClientPacket(Client &c, const std::vector<uint8_t> &packet);
+  // False when the backend link was replaced (ignore the rest of its input)
+  bool OnBackendPacket(Client &c, const std::vector<uint8_t> &packet);
+  void Migrate(Client &c, std::vector<uint8_t> packet);
+  bool ReadLink(Link &link, std::vector<std::vector<uint8_t>> &packets);
+  bool Forward(Link &link, const std::vector<uint8_t> &packet);
+  void CloseBackend(Client &c);
+  void CloseClient(int clientFd);
+  int BackendForMap(uint8_t mapId) const;
+
+  int m_listenFd = -1;
+  bool m_running = false;
+  std::vector<Backend> m_backends;
+  std::unordered_map<int, Client> m_clients; // Keyed by client fd
+  std::unordered_map<int, int> m_backendFds; // Backend fd -> client fd
+  uint64_t m_migrations = 0;
+  uint8_t m_key[GATEWAY_KEY_SIZE] = {};
+};
+
+#endif // MU_GATEWAY_HPP
@@ -0,0 +1,169 @@
+#ifndef MU_HANDOFF_HPP
+#define MU_HANDOFF_HPP
+
+// Hot restart: a new MuServer process takes over from a running one without
+// dropping clients.
+//
+// A server started with --handoff=PATH listens on a Unix domain socket at
+// PATH. A new process started with the same flag finds it there, connects and
+// asks for a takeover. The old process then:
+//   1. saves every character (the database stays the source of truth),
+//   2. stops its I/O threads, collecting each connection's unhandled input and
+//      unsent output,
+//   3. sends the listen socket and every client socket (SCM_RIGHTS), followed
+//      by a state blob: per-connection buffers, Session state and the dynamic
+//      GameWorld state (monsters, guards, drops),
+//   4. waits for the new process to acknowledge, then exits without closing
+//      any connection.
+// If the takeover fails before the acknowledgement, the old process re-adopts
+// its connections and keeps serving. Static data (terrain, spawn tables, item
+// definitions) is not sent; the new process maps it from world.snapshot.
+//
+// The blob is native-endian (both processes share a host) and only valid
+// between builds with the same VERSION and LayoutKey(); otherwise the takeover
+// is refused and the server has to be restarted normally.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class Session;
+
+namespace Handoff {
+
+static constexpr uint32_t MAGIC = 0x4F48554D; // "MUHO"
+static constexpr uint32_t VERSION = 2;
+
+// Hash of record sizes and per-field counts/bytes of everything serialized
+uint64_t LayoutKey();
+
+// ─── State blob ────────────────────────────────────────────────────────
+
+class Writer {
+public:
+  template <typename T> void Put(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    PutBytes(&value, sizeof(T));
+  }
+  void PutBytes(const void *data, size_t len) {
+    const auto *p = static_cast<const uint8_t *>(data);
+    m_buf.insert(m_buf.end(), p, p + len);
+  }
+  void PutBlob(const std::vector<uint8_t> &data) {
+    Put<uint32_t>(static_cast<uint32_t>(data.size()));
+    PutBytes(data.data(), data.size());
+  }
+  void PutString(const std::string &s) {
+    Put<uint32_t>(static_cast<uint32_t>(s.size()));
+    PutBytes(s.data(), s.size());
+  }
+  template <typename T> void PutVector(const std::vector<T> &v) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Put<uint32_t>(static_cast<uint32_t>(v.size()));
+    PutBytes(v.data(), v.size() * sizeof(T));
+  }
+
+  const std::vector<uint8_t> &Data() const { return m_buf; }
+
+private:
+  std::vector<uint8_t> m_buf;
+};
+
+// Reads fail sticky: once anything is out of bounds every later read fails
+// too, so callers can check Ok() once after a group of reads.
+class Reader {
+public:
+  Reader(const uint8_t *data, size_t len) : m_data(data), m_len(len) {}
+
+  template <typename T> bool Get(T &out) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return GetBytes(&out, sizeof(T));
+  }
+  bool GetBytes(void *out, size_t len) {
+    if (!m_ok || m_len - m_pos < len)
+      return m_ok = false;
+    memcpy(out, m_data + m_pos, len);
+    m_pos += len;
+    return true;
+  }
+  bool GetBlob(std::vector<uint8_t> &out) {
+    uint32_t len = 0;
+    if (!Get(len) || m_len - m_pos < len)
+      return m_ok = false;
+    out.assign(m_data + m_pos, m_data + m_pos + len);
+    m_pos += len;
+    return true;
+  }
+  bool GetString(std::string &out) {
+    uint32_t len = 0;
+    if (!Get(len) || m_len - m_pos < len)
+      return m_ok = false;
+    out.assign(reinterpret_cast<const char *>(m_data + m_pos), len);
+    m_pos += len;
+    return true;
+  }
+  template <typename T> bool GetVector(std::vector<T> &out) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    uint32_t count = 0;
+    if (!Get(count) || (m_len - m_pos) / sizeof(T) < count)
+      return m_ok = false;
+    out.resize(count);
+    return GetBytes(out.data(), count * sizeof(T));
+  }
+
+  bool Ok() const { return m_ok; }
+  bool AtEnd() const { return m_pos == m_len; }
+
+private:
+  const uint8_t *m_data;
+  size_t m_len;
+  size_t m_pos = 0;
+  bool m_ok = true;
+};
+
+// Session game state (not its fd / reactor, which the receiver assigns)
+void WriteSession(Writer &out, const Session &session);
+bool ReadSession(Reader &in, Session &session);
+
+// ─── Control socket ────────────────────────────────────────────────────
+
+// Messages, in order: new -> old Hello; old -> new Offer (accepted = 0 means
+// refused, nothing follows), fdCount descriptors, blobSize bytes; new -> old
+// Ack.
+struct Hello {
+  uint32_t magic = MAGIC;
+  uint32_t version = VERSION;
+  uint64_t layoutKey = 0;
+};
+struct Offer {
+  uint32_t magic = MAGIC;
+  uint32_t accepted = 0;
+  uint32_t fdCount = 0;
+  uint32_t reserved = 0;
+  uint64_t blobSize = 0;
+};
+struct Ack {
+  uint32_t magic = MAGIC;
+  uint32_t ok = 0;
+};
+
+// Bind PATH (replacing a stale socket file) and listen, non-blocking. -1 on
+// error.
+int Listen(const std::string &path);
+// Connect to a running server's handoff socket. -1 if nobody is listening.
+int Connect(const std::string &path);
+
+// Blocking transfers on the control socket. False on error, peer close or
+// once the SetTimeout limit passes without progress.
+void SetTimeout(int sock, int seconds);
+bool SendAll(int sock, const void *data, size_t len);
+bool RecvAll(int sock, void *data, size_t len);
+bool SendFds(int sock, const std::vector<int> &fds);
+bool RecvFds(int sock, size_t count, std::vector<int> &out);
+
+} // namespace Handoff
+
+#endif // MU_HANDOFF_HPP
@@ -0,0 +1,119 @@
+#ifndef MU_IO_REACTOR_HPP
+#define MU_IO_REACTOR_HPP
+
+// Network I/O thread.
+//
+// Each reactor owns a subset of the client sockets: it accepts from the shared
+// listen socket, reads and frames C1-C4 packets, and writes queued output. It
+// never touches game state. Framed packets and connection events go to the game
+// thread through an inbound SPSC queue; the game thread sends output and close
+// requests back through an outbound SPSC queue.
+//
+// A socket is only closed when the game thread asks for it (IoCommand::CLOSE),
+// so an fd number can't be reused while a Session still refers to it.
+
+#include "SendQueue.hpp"
+#include "SpscQueue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Reactor -> game thread
+struct IoEvent {
+  enum Type : uint8_t { CONNECTED, PACKET, DISCONNECTED };
+  Type type = PACKET;
+  int fd = -1;
+  std::vector<uint8_t> data; // PACKET: one complete MU packet
+};
+
+// A live connection detached from its reactor, to be adopted by another one
+// (possibly in another process, see Handoff.hpp)
+struct IoHandoffConn {
+  int fd = -1;
+  bool open = true; // false = peer gone; reported as DISCONNECTED on adoption
+  std::vector<uint8_t> input;  // Received but not yet handled, in order
+  std::vector<uint8_t> output; // Queued but not yet written
+};
+
+// Game thread -> reactor
+struct IoCommand {
+  enum Type : uint8_t { SEND, CLOSE };
+  Type type = SEND;
+  int fd = -1;
+  std::vector<uint8_t> data; // SEND: bytes to append to the socket's output
+};
+
+class IoReactor {
+public:
+  static constexpr size_t QUEUE_CAPACITY = 4096;
+
+  // listenFd is shared by all reactors; gameWakeFd is the write end of the
+  // game thread's wake pipe, signalled whenever new events are queued.
+  IoReactor(int index, int listenFd, int gameWakeFd);
+  ~IoReactor();
+  IoReactor(const IoReactor &) = delete;
+  IoReactor &operator=(const IoReactor &) = delete;
+
+  bool Start();
+  void Stop(); // Joins the thread and closes every socket it still owns
+
+  // Hot restart. Adopt (before Start) takes over a detached connection;
+  // Detach joins the thread and hands back every connection it still owns
+  // instead of closing it. Unprocessed events, queued commands and the game thread's
+  // `pending` commands are folded into the connections' buffers first.
+  void Adopt(IoHandoffConn &&conn);
+  std::vector<IoHandoffConn> Detach(std::vector<IoCommand> &pending);
+
+  int GetIndex() const { return m_index; }
+
+  // ─── Game thread side ───
+  bool PopEvent(IoEvent &out) { return m_inbound.TryPop(out); }
+  bool PushCommand(IoCommand &cmd) { return m_outbound.TryPush(cmd); }
+  void Wake(); // Interrupt the reactor's poll after pushing commands
+
+private:
+  struct Connection {
+    int fd = -1;
+    bool open = true; // false = peer gone, waiting for the game's CLOSE
+    std::vector<uint8_t> recvBuf;
+    SendQueue sendQueue; // Bounded, supersedes stale updates when backed up
+  };
+
+  void Join();
+  void ThreadMain();
+  void AcceptClients();
+  void ReadConnection(Connection &conn);
+  void ExtractPackets(Connection &conn);
+  void FlushConnection(Connection &conn);
+  void DropConnection(Connection &conn);
+  void ApplyCommands();
+  void ApplyCommand(IoCommand &cmd);
+  void CloseConnection(Connection &conn);
+  void ReportQueueMetrics();
+  void Emit(IoEvent &ev);
+  void FlushEventBacklog();
+
+  int m_index;
+  int m_listenFd;
+  int m_gameWakeFd;
+  int m_wakePipe[2] = {-1, -1};
+  std::thread m_thread;
+  std::atomic<bool> m_running{false};
+
+  SpscQueue<IoEvent> m_inbound{QUEUE_CAPACITY};
+  SpscQueue<IoCommand> m_outbound{QUEUE_CAPACITY};
+
+  // Reactor thread only
+  std::unordered_map<int, Connection> m_conns;
+  std::vector<IoEvent> m_eventBacklog; // Events that didn't fit in m_inbound
+  bool m_eventsPushed = false;         // Wake the game thread after this pass
+
+  // Send queue metrics, logged periodically while anything is backed up
+  uint64_t m_slowDisconnects = 0;
+  uint64_t m_lastReportSuperseded = 0;
+  int64_t m_lastReportMs = 0;
+};
+
+#endif // MU_IO_REACTOR_HPP
@@ -0,0 +1,51 @@
+#ifndef MU_PACKET_COMPRESSION_HPP
+#define MU_PACKET_COMPRESSION_HPP
+
+// Optional compression of bulk C2 packets (viewports, inventory, char list,
+// quest catalog...).
+//
+// A client opts in with NET_OPTIONS (NET_OPT_COMPRESS). From then on a C2
+// packet of at least MIN_PACKET_SIZE bytes is replaced by a COMPRESSED packet
+// (C2:0xF9, see PMSG_COMPRESSED_HEAD) when that makes it smaller; the payload
+// decodes back to the complete original packet, header included. Small
+// packets and C1 packets are never touched.
+//
+// The codec is a byte-oriented LZ77 in the LZ4 block layout: sequences of
+// [token: literal count << 4 | match length - 4] [literal count extension]
+// [literals] [offset, 2 bytes LE] [match length extension], where a nibble of
+// 15 continues in extension bytes (255 = keep adding). The last sequence is
+// literals only. server/ and client/ carry identical copies of this file.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PacketCompression {
+
+static constexpr size_t MIN_PACKET_SIZE = 256;
+
+// Raw codec. LzCompress returns the encoded size, or 0 if it would need more
+// than `cap` bytes. LzDecompress fails unless `in` decodes to exactly
+// `outLen` bytes.
+size_t LzCompress(const uint8_t *in, size_t len, uint8_t *out, size_t cap);
+bool LzDecompress(const uint8_t *in, size_t len, uint8_t *out, size_t outLen);
+
+// Append one complete C2 packet to `out` as a COMPRESSED packet. Returns false
+// (out unchanged) if compression wouldn't make it smaller.
+bool Compress(const uint8_t *packet, size_t len, std::vector<uint8_t> &out);
+// Replace `out` with the original packet carried by a COMPRESSED packet
+bool Decompress(const uint8_t *packet, size_t len, std::vector<uint8_t> &out);
+
+// Compress() totals for this process (single-threaded use)
+struct Stats {
+  uint64_t packets = 0;        // Sent compressed
+  uint64_t incompressible = 0; // Tried, sent as-is
+  uint64_t rawBytes = 0;       // Original size of the compressed packets
+  uint64_t wireBytes = 0;      // What they cost on the wire instead
+  int64_t cpuUs = 0;           // Time spent in Compress, both outcomes
+};
+const Stats &GetStats();
+
+} // namespace PacketCompression
+
+#endif // MU_PACKET_COMPRESSION_HPP
@@ -0,0 +1,32 @@
+#ifndef MU_RATE_LIMIT_HPP
+#define MU_RATE_LIMIT_HPP
+
+// Inbound flood protection, applied by Server before PacketHandler::Handle.
+//
+// Each rate-limited opcode has a token bucket per session (refilled every
+// tick; one packet = one token). On top of that, a session may spend at most
+// TICK_BUDGET_US of handler time per tick. A packet that is over either limit
+// is deferred to a later tick (keeping the session's packet order); a session
+// whose deferred backlog grows past the kick threshold is disconnected.
+
+#include <cstdint>
+
+namespace RateLimit {
+
+struct Rule {
+  uint8_t opcode;
+  float perSecond; // Sustained rate
+  float burst;     // Bucket size
+};
+
+static constexpr int RULE_COUNT = 20;
+static constexpr int64_t TICK_BUDGET_US = 2000; // Handler time per session/tick
+static constexpr int DEFAULT_KICK_BACKLOG = 256; // Deferred packets
+
+// Rule index for an opcode, -1 if the opcode is not rate-limited
+int RuleFor(uint8_t opcode);
+const Rule &GetRule(int index);
+
+} // namespace RateLimit
+
+#endif // MU_RATE_LIMIT_HPP
@@ -0,0 +1,77 @@
+#ifndef MU_SEND_QUEUE_HPP
+#define MU_SEND_QUEUE_HPP
+
+// Bounded per-connection output queue (owned by the connection's IoReactor).
+//
+// Packets are stored back to back in a growable byte ring, with one entry per
+// packet. There are two priority classes:
+//   - reliable: everything by default (inventory, stats, death, chat...),
+//     always delivered in order;
+//   - supersedable: pure position/target updates for one entity (monster and
+//     guard moves). While the queue is over SOFT_LIMIT, a new update for an
+//     entity drops the older unsent update for the same entity.
+// Dropping only older updates keeps ordering against reliable packets intact
+// (a respawn queued between two moves still arrives before the latest move).
+// A client whose queue of live bytes would exceed CAPACITY is too slow to
+// serve and gets disconnected by the reactor.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+class SendQueue {
+public:
+  static constexpr size_t SOFT_LIMIT = 64 * 1024; // Start superseding updates
+  static constexpr size_t CAPACITY = 512 * 1024;  // Disconnect threshold
+
+  // Non-zero = supersedable update, unique per (opcode, entity)
+  static uint32_t SupersedeKey(const uint8_t *packet, size_t len);
+
+  // Append a run of complete packets. Returns false if the queue would exceed
+  // CAPACITY (nothing is appended in that case).
+  bool Push(const uint8_t *data, size_t len);
+
+  // Write as much as the socket accepts. Returns false on a socket error.
+  bool Flush(int fd);
+
+  // Copy out every byte still to be sent (in order, superseded updates
+  // skipped) and empty the queue. Used to move a connection between processes.
+  std::vector<uint8_t> TakePending();
+
+  bool Empty() const { return m_entries.empty(); }
+  size_t Depth() const { return m_liveBytes; } // Queued bytes still to send
+
+  // Metrics
+  size_t PeakDepth() const { return m_peakDepth; }
+  uint64_t Superseded() const { return m_superseded; }
+  uint64_t SupersededBytes() const { return m_supersededBytes; }
+
+private:
+  struct Entry {
+    uint64_t start; // Absolute ring offset of the first byte
+    uint32_t len;
+    uint32_t key; // 0 = reliable
+    bool dropped = false;
+  };
+
+  void PushPacket(const uint8_t *packet, size_t len);
+  void Reserve(size_t bytes); // Grow and/or compact so `bytes` more fit
+  void Consume(size_t bytes);
+  void PopFront();
+
+  std::vector<uint8_t> m_ring; // Power-of-two size, indexed by offset & mask
+  uint64_t m_head = 0;         // Next byte to send (inside the front entry)
+  uint64_t m_tail = 0;         // One past the last queued byte
+  std::deque<Entry> m_entries;
+  uint64_t m_firstSeq = 0; // Sequence number of m_entries.front()
+  std::unordered_map<uint32_t, uint64_t> m_latest; // Update key -> seq
+  size_t m_liveBytes = 0;
+
+  size_t m_peakDepth = 0;
+  uint64_t m_superseded = 0;
+  uint64_t m_supersededBytes = 0;
+};
+
+#endif // MU_SEND_QUEUE_HPP
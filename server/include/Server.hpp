@@ -4,16 +4,60 @@
 #include "Session.hpp"
 #include "Database.hpp"
 #include "GameWorld.hpp"
+#include "IoReactor.hpp"
+#include "PacketDefs.hpp"
+#include "WorldSnapshot.hpp"
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class Server {
 public:
-    bool Start(uint16_t port);
+    static constexpr int DEFAULT_IO_THREADS = 2;
+
+    // ioThreads: number of network reactor threads (sockets are spread
+    // across them; game logic stays on the thread that calls Run).
+    // handoffPath: Unix socket for hot restarts (see Handoff.hpp). If a server
+    // is already listening there, take over its sockets and state instead of
+    // binding the port; either way, accept takeovers on it afterwards.
+    bool Start(uint16_t port,
+               const DatabaseTuning &dbTuning = DatabaseTuning::Fast(),
+               int ioThreads = DEFAULT_IO_THREADS,
+               const std::string &handoffPath = "");
     void Run(); // Main loop (blocks)
     void Stop();
 
+    // Disconnect a session once this many of its packets are waiting on the
+    // rate limiter / tick budget
+    void SetKickBacklog(int packets) { m_kickBacklog = packets; }
+
+    // Gateway backend mode (see Gateway.hpp), set before Start: host only
+    // `mapId`; map changes and character selects for any other map migrate
+    // the session through the gateway. Default -1 = standalone, all maps.
+    void SetHostedMap(int mapId) { m_hostedMap = mapId; }
+    bool IsBackend() const { return m_hostedMap >= 0; }
+    bool HostsMap(uint8_t mapId) const {
+        return m_hostedMap < 0 || m_hostedMap == mapId;
+    }
+    // Backends share one database file; only the persistence owner seeds it
+    // and rebuilds world.snapshot (the others just read them)
+    void SetPersistenceOwner(bool owner) { m_persistenceOwner = owner; }
+    // Secret the gateway puts in every RESUME (16-32 bytes, false otherwise);
+    // a backend refuses to start without one and drops RESUMEs carrying
+    // anything else
+    bool SetGatewaySecret(const std::string &secret);
+
+    // Hand a session to the backend hosting `mapId` (via the gateway)
+    void MigrateSession(Session &session, uint8_t mapId, uint8_t spawnX,
+                        uint8_t spawnY);
+    void MigrateCharSelect(Session &session, uint8_t mapId,
+                           const std::vector<uint8_t> &selectPacket);
+    // Gateway RESUME: continue a session migrated from another backend
+    void ResumeSession(Session &session, const std::vector<uint8_t> &packet);
+
     Database &GetDB() { return m_db; }
     GameWorld &GetWorld() { return m_world; }
 
@@ -28,17 +72,81 @@ public:
     void TransitionMap(Session &session, uint8_t newMapId, uint8_t spawnX, uint8_t spawnY);
     void CheckGateZones(Session &session);
 
+    // Kill resolution: player-credited monster deaths are queued during the tick
+    // and resolved together once per tick (XP, level-ups, drops, quests, chat)
+    void QueueKill(Session &killer, const MonsterInstance &mon);
+
 private:
-    void AcceptNewClients();
-    void ProcessSessions();
+    struct KillEvent {
+        int killerFd;
+        uint16_t monsterIndex;
+        uint16_t monsterType;
+        int monsterLevel;
+        float worldX, worldZ;
+        bool isSummon;
+    };
+    void ResolveKills();
+
+    // Network I/O: reactors own the sockets, the game thread exchanges
+    // framed packets and output with them through SPSC queues
+    bool StartIo();
+    void StopIo();
+    void DrainIoEvents();      // Connect/packet/disconnect events -> handlers
+    void FlushSessionOutput(); // Session send buffers -> reactors
+    void SubmitIo(int reactor, IoCommand &cmd);
+    void ReleaseSession(Session &session); // Forget fd, let its reactor close it
+
+    // Inbound rate limiting: DispatchPacket returns false (without running
+    // the handler) when the session is out of tokens or tick budget
+    bool DispatchPacket(Session &session, const std::vector<uint8_t> &packet);
+    void DeferPacket(Session &session, std::vector<uint8_t> &&packet);
+    void ProcessDeferredPackets(float dt); // Refill buckets, retry backlogs
+
     void HandlePacket(Session &session, const std::vector<uint8_t> &packet);
     void OnClientConnected(Session &session);
 
+    bool OpenListenSocket(uint16_t port);
+
+    // Hot restart (see Handoff.hpp)
+    bool TakeOver(int sock); // New process: receive sockets + state
+    bool ImportState(const std::vector<int> &fds,
+                     const std::vector<uint8_t> &blob);
+    void ServeHandoff(); // Old process: a successor connected
+    std::vector<IoHandoffConn> DetachIo(); // Stop reactors, keep sockets open
+    // Give every connection a Session, then queue them for StartIo
+    void AdoptConnections(std::vector<IoHandoffConn> &&conns);
+
     int m_listenFd = -1;
     bool m_running = false;
 
+    std::string m_handoffPath;
+    int m_handoffFd = -1;     // Listening Unix socket, -1 = hot restart off
+    bool m_handedOff = false; // Sockets now belong to the successor
+    std::vector<IoHandoffConn> m_adoptConns; // Picked up by StartIo
+
+    int m_ioThreadCount = DEFAULT_IO_THREADS;
+    std::vector<std::unique_ptr<IoReactor>> m_reactors;
+    std::vector<std::vector<IoCommand>> m_ioBacklog; // Per reactor, queue full
+    std::vector<bool> m_ioWake;                      // Per reactor, wake pending
+    int m_wakePipe[2] = {-1, -1}; // Reactors -> game thread "events queued"
+
+    int m_hostedMap = -1;
+    bool m_persistenceOwner = true;
+    std::array<uint8_t, GATEWAY_KEY_SIZE> m_gatewayKey{};
+    bool m_hasGatewaySecret = false;
+    int m_kickBacklog = RateLimit::DEFAULT_KICK_BACKLOG;
+    struct RateLimitStats {
+        uint64_t rateDeferred = 0;   // Out of tokens for the opcode
+        uint64_t budgetDeferred = 0; // Session used up its tick budget
+        uint64_t kicked = 0;
+    } m_rateStats, m_rateStatsReported;
+    float m_rateReportTimer = 0.0f;
+
     std::vector<std::unique_ptr<Session>> m_sessions;
+    std::unordered_map<int, Session *> m_sessionsByFd;
+    std::vector<KillEvent> m_pendingKills;
     Database m_db;
+    WorldSnapshot m_snapshot; // Declared before m_world, which points into it
     GameWorld m_world;
 };
 
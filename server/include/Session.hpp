@@ -1,29 +1,30 @@
 #ifndef MU_SESSION_HPP
 #define MU_SESSION_HPP
 
+#include "RateLimit.hpp"
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <string>
 #include <vector>
 
 class Session {
 public:
-  explicit Session(int fd);
-  ~Session();
+  // The socket itself is owned (read, written and closed) by I/O reactor
+  // `reactor`; the session only buffers output for it.
+  explicit Session(int fd, int reactor = 0);
 
   int GetFd() const { return m_fd; }
+  int GetReactor() const { return m_reactor; }
   bool IsAlive() const { return m_alive; }
 
-  // Returns complete packets extracted from recv buffer
-  // Each vector<uint8_t> is one complete MU packet
-  std::vector<std::vector<uint8_t>> ReadPackets();
-
-  // Queue data to send
+  // Queue data to send; handed to the I/O thread once per server loop
   void Send(const void *data, size_t len);
 
-  // Flush send buffer to socket. Returns false if connection lost.
-  bool FlushSend();
+  bool HasPendingSend() const { return !m_sendBuf.empty(); }
+  // Move the queued output out (leaves the buffer empty)
+  std::vector<uint8_t> TakeSendBuffer();
 
   // Mark session for removal
   void Kill() { m_alive = false; }
@@ -70,6 +71,15 @@ public:
   int maxAg = 0;
   bool dead = false;
 
+  // Coalesced stats sync: StatsField bits changed this tick, and the values
+  // the client last received (delta packets only carry what differs)
+  uint16_t statsDirty = 0;
+  struct SentStats {
+    bool valid = false; // false until a full CHARSTATS went out
+    int hp = 0, maxHp = 0, mana = 0, maxMana = 0, ag = 0, maxAg = 0;
+    uint64_t experience = 0;
+  } statsSent;
+
   // Full character stats (for stat allocation validation)
   uint16_t dexterity = 0;
   uint16_t vitality = 0;
@@ -101,9 +111,22 @@ public:
   std::array<InventoryItem, 64> bag{};
   uint32_t zen = 0;
 
-  // World position (updated from move packets, used for server AI aggro)
+  // World position (simulated from MOVE_PATH, corrected by PRECISE_POS; used
+  // for server AI aggro)
   float worldX = 0.0f;
   float worldZ = 0.0f;
+
+  // Server-side movement: grid cells left to walk (advanced every tick at
+  // ServerConfig::PLAYER_MOVE_SPEED) and how far client position reports may
+  // still pull the simulated position (refills over time).
+  static constexpr int MAX_MOVE_PATH = 32;
+  uint8_t movePathX[MAX_MOVE_PATH] = {};
+  uint8_t movePathY[MAX_MOVE_PATH] = {};
+  uint8_t movePathLen = 0;
+  uint8_t movePathStep = 0;
+  float correctionAllowance = 0.0f;
+  bool IsMoving() const { return movePathStep < movePathLen; }
+  void StopMoving() { movePathLen = movePathStep = 0; }
   uint8_t mapId = 0; // 0=Lorencia, 1=Dungeon
   float gateTransitionCooldown = 0.0f; // Seconds until gate detection re-enables
   float pendingViewportDelay = 0.0f;   // Seconds until deferred viewport send after map change
@@ -126,6 +149,18 @@ public:
   // Server-side attack rate limiter (prevents speed hack / GCD bypass)
   float attackCooldown = 0.0f; // Seconds until next attack is allowed
 
+  // Inbound flood protection (see RateLimit.hpp): one token bucket per
+  // rate-limited opcode, handler time used this tick, and packets held back
+  // for a later tick (dispatched in arrival order)
+  std::array<float, RateLimit::RULE_COUNT> rateTokens{};
+  int64_t tickHandlerUs = 0;
+  std::deque<std::vector<uint8_t>> deferredPackets;
+  uint64_t packetsDeferred = 0; // Lifetime count, logged on disconnect
+  int64_t handlerUsTotal = 0;   // Lifetime handler time
+
+  // Client opted into COMPRESSED packets (NET_OPTIONS); applied by Send
+  bool compressC2 = false;
+
   // Monster→player poison debuff (OpenMU: Poison Bull type 8, Larva type 12)
   // DoT: 3% of current HP every 3 seconds for ~20 seconds
   bool poisoned = false;
@@ -161,11 +196,9 @@ public:
 
 private:
   int m_fd;
+  int m_reactor;
   bool m_alive = true;
 
-  // Recv buffer — accumulates partial packets
-  std::vector<uint8_t> m_recvBuf;
-
   // Send buffer — queued outgoing data
   std::vector<uint8_t> m_sendBuf;
 };
@@ -0,0 +1,65 @@
+#ifndef MU_SPSC_QUEUE_HPP
+#define MU_SPSC_QUEUE_HPP
+
+// Bounded lock-free single-producer / single-consumer ring.
+//
+// Exactly one thread may call TryPush and exactly one (other) thread may call
+// TryPop. Capacity is rounded up to a power of two. Each side keeps a cached
+// copy of the other side's index so the shared cache line is only touched when
+// the ring looks full (producer) or empty (consumer).
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template <typename T> class SpscQueue {
+public:
+  explicit SpscQueue(size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity)
+      cap <<= 1;
+    m_slots.resize(cap);
+    m_mask = cap - 1;
+  }
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  // Producer. Moves from item only on success.
+  bool TryPush(T &item) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_headCache > m_mask) {
+      m_headCache = m_head.load(std::memory_order_acquire);
+      if (tail - m_headCache > m_mask)
+        return false; // Full
+    }
+    m_slots[tail & m_mask] = std::move(item);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer
+  bool TryPop(T &out) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tailCache) {
+      m_tailCache = m_tail.load(std::memory_order_acquire);
+      if (head == m_tailCache)
+        return false; // Empty
+    }
+    out = std::move(m_slots[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t Capacity() const { return m_mask + 1; }
+
+private:
+  std::vector<T> m_slots;
+  size_t m_mask = 0;
+  alignas(64) std::atomic<size_t> m_head{0}; // Next slot to pop
+  size_t m_tailCache = 0;                    // Consumer's view of m_tail
+  alignas(64) std::atomic<size_t> m_tail{0}; // Next slot to push
+  size_t m_headCache = 0;                    // Producer's view of m_head
+};
+
+#endif // MU_SPSC_QUEUE_HPP
@@ -0,0 +1,112 @@
+#ifndef MU_WORLD_SNAPSHOT_HPP
+#define MU_WORLD_SNAPSHOT_HPP
+
+// Prebuilt binary world snapshot ("world.snapshot").
+//
+// Holds everything Server::Start used to derive from static game data on every
+// boot: item definitions, NPC/monster spawns, decrypted terrain attributes and
+// a walkable-region label per cell. The file is memory-mapped read-only and
+// validated against a source key; when the key changes (seed data revision,
+// spawn tables, .att files) it is rebuilt from the sources and re-mapped.
+//
+// Layout: Header, Section[sectionCount], then section payloads (8-byte aligned).
+
+#include "Database.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class WorldSnapshot {
+public:
+  static constexpr uint32_t MAGIC = 0x5357554D; // "MUWS"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr int MAX_MAPS = 4;
+  static constexpr int CELLS = 256 * 256;
+
+  // .att source file per map (index = mapId, empty = map has no terrain)
+  using TerrainSources = std::vector<std::string>;
+
+  WorldSnapshot() = default;
+  ~WorldSnapshot();
+  WorldSnapshot(const WorldSnapshot &) = delete;
+  WorldSnapshot &operator=(const WorldSnapshot &) = delete;
+
+  // Cheap fingerprint of every input the snapshot is derived from: format
+  // and seed versions, the database's world table revision, .att size/mtime.
+  // Reads no table rows.
+  static uint64_t ComputeSourceKey(Database &db, const TerrainSources &terrain);
+
+  // Regenerate the snapshot file from the database and .att files. Refuses
+  // (logs, returns false) if a name doesn't fit its record or a map has more
+  // walkable regions than a uint16_t label holds.
+  static bool Build(const std::string &path, uint64_t sourceKey, Database &db,
+                    const TerrainSources &terrain);
+
+  // Map an existing snapshot. Fails (without logging an error) if the file is
+  // missing, truncated, or was built from different sources.
+  bool Open(const std::string &path, uint64_t sourceKey);
+  void Close();
+  bool IsOpen() const { return m_base != nullptr; }
+
+  std::vector<ItemDefinition> GetItemDefinitions() const;
+  std::vector<NpcSpawnData> GetNpcSpawns(uint8_t mapId) const;
+  std::vector<MonsterSpawnData> GetMonsterSpawns(uint8_t mapId) const;
+  // 256x256 attribute grid / region labels, nullptr if the map has no terrain.
+  // Region 0 = not walkable; equal non-zero labels = 8-connected walkable cells.
+  const uint8_t *GetTerrainAttributes(uint8_t mapId) const;
+  const uint16_t *GetRegionLabels(uint8_t mapId) const;
+
+private:
+  enum SectionId : uint32_t {
+    SECTION_ITEMS = 1,
+    SECTION_NPC_SPAWNS = 2,
+    SECTION_MONSTER_SPAWNS = 3,
+    SECTION_TERRAIN = 4, // One per map
+    SECTION_REGIONS = 5, // One per map
+  };
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceKey;
+    uint32_t sectionCount;
+    uint32_t reserved;
+  };
+  struct Section {
+    uint32_t id;
+    uint32_t mapId;
+    uint64_t offset;
+    uint64_t size;
+  };
+  struct ItemRecord {
+    int32_t id;
+    uint8_t category, itemIndex, attackSpeed, twoHanded, width, height;
+    uint16_t level, damageMin, damageMax, defense;
+    uint16_t reqStrength, reqDexterity, reqVitality, reqEnergy, magicPower;
+    uint32_t classFlags, buyPrice;
+    char name[32];
+    char modelFile[32];
+  };
+  struct NpcRecord {
+    int32_t id;
+    uint16_t type;
+    uint8_t mapId, posX, posY, direction;
+    char name[32];
+  };
+  struct MonsterRecord {
+    int32_t id;
+    uint16_t type;
+    uint8_t mapId, posX, posY, direction;
+  };
+
+  static bool LabelRegions(const uint8_t *attributes, uint16_t *outLabels);
+  const Section *FindSection(uint32_t id, uint32_t mapId) const;
+  template <typename T>
+  const T *SectionData(uint32_t id, uint32_t mapId, size_t &count) const;
+
+  const uint8_t *m_base = nullptr;
+  size_t m_size = 0;
+};
+
+#endif // MU_WORLD_SNAPSHOT_HPP
@@ -2,6 +2,7 @@
 #define MU_CHARACTER_HANDLER_HPP
 
 #include "../Database.hpp"
+#include "../GameWorld.hpp"
 #include "../Session.hpp"
 #include <cstdint>
 #include <vector>
@@ -10,23 +11,38 @@ namespace CharacterHandler {
 
 // Send full character stats packet (loads from DB, syncs session)
 void SendCharStats(Session &session, Database &db, int characterId);
+// Same, from rows the caller already loaded
+void SendCharStats(Session &session, Database &db, const CharacterData &c,
+                   const std::vector<EquipmentSlot> &equip);
 
 // Send character stats from current session state (no DB reload)
 void SendCharStats(Session &session);
 
+// High-frequency stat changes (regen, poison, AG gain, XP): mark the touched
+// StatsField bits; FlushStatsDelta sends one delta packet per tick with only
+// the fields whose value the client doesn't have yet.
+inline void MarkStatsDirty(Session &session, uint16_t fields) {
+  session.statsDirty |= fields;
+}
+void FlushStatsDelta(Session &session);
+
 // Send equipment list to client
 void SendEquipment(Session &session, Database &db, int characterId);
+void SendEquipment(Session &session, Database &db,
+                   const std::vector<EquipmentSlot> &equip);
 
 // Recalculate weapon damage and defense from equipment DB
 // Used by HandleCharSelect, HandleEquip, and OnClientConnected
 void RefreshCombatStats(Session &session, Database &db, int characterId);
+void RefreshCombatStats(Session &session, Database &db,
+                        const std::vector<EquipmentSlot> &equip);
 
 // Send learned skill list to client
 void SendSkillList(Session &session);
 
 // Packet handlers
 void HandleCharSave(Session &session, const std::vector<uint8_t> &packet,
-                    Database &db);
+                    Database &db, const GameWorld &world);
 void HandleEquip(Session &session, const std::vector<uint8_t> &packet,
                  Database &db);
 void HandleStatAlloc(Session &session, const std::vector<uint8_t> &packet,
@@ -22,6 +22,11 @@ void HandleCharCreate(Session &session, const std::vector<uint8_t> &packet,
 void HandleCharDelete(Session &session, const std::vector<uint8_t> &packet,
                       Database &db);
 
+// Load a stored character's identity, stats, equipment, inventory, skills,
+// quests and buffs into the session (no packets sent; position untouched)
+void ApplyStoredCharacter(Session &session, Database &db,
+                          const Database::CharacterLoad &load);
+
 // Handle character select and enter world (F3:03)
 // Loads character, sends world data, transitions to inWorld
 void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
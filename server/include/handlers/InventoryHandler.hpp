@@ -16,6 +16,9 @@ void SendInventorySync(Session &session);
 
 // Load inventory from DB into session bag
 void LoadInventory(Session &session, Database &db, int characterId);
+// Same, from rows the caller already loaded
+void LoadInventory(Session &session, Database &db, int characterId,
+                   const std::vector<Database::InventorySlotData> &invItems);
 
 // Find empty space in inventory grid for an item of given dimensions
 bool FindEmptySpace(Session &session, uint8_t w, uint8_t h, uint8_t &outSlot);
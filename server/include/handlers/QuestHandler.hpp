@@ -28,8 +28,10 @@ void HandleQuestComplete(Session &session, const std::vector<uint8_t> &packet,
 void HandleQuestAbandon(Session &session, const std::vector<uint8_t> &packet,
                         Database &db);
 
-// Called by CombatHandler when a monster is killed
-void OnMonsterKill(Session &session, uint16_t monsterType, bool isSummon, Database &db);
+// Called by the server's kill resolution stage when a monster is killed.
+// Updates kill counts in the session only; returns true if any quest
+// progressed (caller persists progress and sends quest state once per tick).
+bool OnMonsterKill(Session &session, uint16_t monsterType, bool isSummon);
 
 } // namespace QuestHandler
 
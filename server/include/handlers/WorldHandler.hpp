@@ -15,12 +15,22 @@ void SendNpcViewport(Session &session, const GameWorld &world);
 void SendMonsterViewport(Session &session, const GameWorld &world);
 
 // Packet handlers
-void HandleMove(Session &session, const std::vector<uint8_t> &packet,
-                Database &db);
+void HandleMove(Session &session, const std::vector<uint8_t> &packet);
+void HandleMovePath(Session &session, const std::vector<uint8_t> &packet,
+                    const GameWorld &world);
 void HandlePrecisePosition(Session &session,
                            const std::vector<uint8_t> &packet,
                            GameWorld &world);
 
+void HandleTownReturn(Session &session, const GameWorld &world);
+
+// Advance server-simulated movement along the session's path (every tick)
+void UpdateMovement(Session &session, float dt);
+
+// Put the player on the map's town (or respawn) spot. The server owns these
+// teleports: the client lands on the same cell but never reports it.
+bool MoveToTownSpot(Session &session, const GameWorld &world, bool respawn);
+
 // Auth handlers (simple auto-login flow)
 void HandleLogin(Session &session, const std::vector<uint8_t> &packet,
                  Database &db);
@@ -0,0 +1,433 @@
+#include "Bench.hpp"
+#include "PacketDefs.hpp"
+#include "Server.hpp"
+#include "handlers/CharacterSelectHandler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include <unistd.h>
+
+namespace Bench {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point t0) {
+  return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+void RemoveDatabaseFiles(const std::string &path) {
+  std::remove(path.c_str());
+  std::remove((path + "-wal").c_str());
+  std::remove((path + "-shm").c_str());
+  std::remove((path + "-journal").c_str());
+}
+
+// Create `count` characters (4 per account) and matching in-memory sessions
+// with a realistic amount of state to persist.
+std::vector<std::unique_ptr<Session>> CreateSessions(Database &db, int count) {
+  std::vector<std::unique_ptr<Session>> sessions;
+  sessions.reserve(count);
+  Database::Transaction tx(db);
+  int accountId = 0;
+  for (int i = 0; i < count; i++) {
+    if (i % 4 == 0) {
+      std::string user = "bench" + std::to_string(i / 4);
+      accountId = db.CreateAccount(user, user);
+    }
+    static const uint8_t kClasses[] = {0, 16, 32, 48};
+    std::string name = "Bench" + std::to_string(i);
+    int charId = db.CreateCharacter(accountId, name, kClasses[i % 4]);
+    if (charId <= 0)
+      continue;
+
+    auto s = std::make_unique<Session>(-1);
+    s->characterId = charId;
+    s->level = 50;
+    s->experience = Database::GetXPForLevel(50);
+    s->zen = 100000;
+    s->worldX = 13000.0f;
+    s->worldZ = 13000.0f;
+    // Half the bag filled with 1x1 items, every equipment slot used
+    for (int slot = 0; slot < 32; slot++) {
+      auto &item = s->bag[slot];
+      item.defIndex = static_cast<int16_t>(slot % 20);
+      item.quantity = 1;
+      item.itemLevel = static_cast<uint8_t>(slot % 4);
+      item.occupied = true;
+      item.primary = true;
+    }
+    for (auto &eq : s->equipment) {
+      eq.category = 0;
+      eq.itemIndex = 1;
+      eq.itemLevel = 3;
+    }
+    for (int q = 1; q <= 3; q++)
+      s->activeQuests.push_back({q, {q, 0, 0}});
+    sessions.push_back(std::move(s));
+  }
+  tx.Commit();
+  return sessions;
+}
+
+void RunProfile(const char *label, const DatabaseTuning &tuning,
+                int characters) {
+  const std::string path = "bench_saves.db";
+  RemoveDatabaseFiles(path);
+
+  auto server = std::make_unique<Server>();
+  Database &db = server->GetDB();
+  if (!db.Open(path, tuning)) {
+    printf("[Bench] %s: failed to open %s\n", label, path.c_str());
+    return;
+  }
+  db.SeedItemDefinitions();
+  auto sessions = CreateSessions(db, characters);
+  int n = static_cast<int>(sessions.size());
+
+  // One transaction per character (logout / map change saves)
+  auto t0 = Clock::now();
+  for (auto &s : sessions)
+    server->SaveSession(*s);
+  double perChar = SecondsSince(t0);
+
+  // One transaction for the whole tick (autosave path)
+  t0 = Clock::now();
+  {
+    Database::Transaction tx(db);
+    for (auto &s : sessions)
+      server->SaveSession(*s);
+    tx.Commit();
+  }
+  double perTick = SecondsSince(t0);
+
+  printf("[Bench] %-5s %d chars: per-character tx %.0f saves/sec (%.1f ms), "
+         "batched tx %.0f saves/sec (%.1f ms)\n",
+         label, n, n / perChar, perChar * 1000.0, n / perTick,
+         perTick * 1000.0);
+
+  sessions.clear();
+  db.Close();
+  RemoveDatabaseFiles(path);
+}
+
+// Hardware cache-miss counter for the calling thread (Linux perf events).
+// Valid() is false when perf is unavailable (container, paranoid level, macOS).
+class CacheMissCounter {
+public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (m_fd >= 0)
+      close(m_fd);
+#endif
+  }
+  bool Valid() const { return m_fd >= 0; }
+  void Start() {
+#ifdef __linux__
+    if (m_fd >= 0) {
+      ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+  uint64_t Stop() {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (m_fd >= 0) {
+      ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+        count = 0;
+    }
+#endif
+    return count;
+  }
+
+private:
+  int m_fd = -1;
+};
+
+// Send stdout to /dev/null while in scope (handlers log every step)
+class QuietStdout {
+public:
+  QuietStdout() {
+    fflush(stdout);
+    m_saved = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+      dup2(devNull, STDOUT_FILENO);
+      close(devNull);
+    }
+  }
+  ~QuietStdout() {
+    fflush(stdout);
+    if (m_saved >= 0) {
+      dup2(m_saved, STDOUT_FILENO);
+      close(m_saved);
+    }
+  }
+
+private:
+  int m_saved = -1;
+};
+
+// `accounts` accounts ("login<N>") with 5 characters each, saved through the
+// normal SaveSession path. The first character of each account ("Login<N>")
+// also gets chat history; it's the one the benchmark selects.
+void CreateLoginAccounts(Server &server, int accounts) {
+  static constexpr int CHARS_PER_ACCOUNT = 5;
+  static constexpr int CHAT_MESSAGES = 30;
+  static const uint8_t kClasses[] = {0, 16, 32, 48};
+  Database &db = server.GetDB();
+  Database::Transaction tx(db);
+  for (int a = 0; a < accounts; a++) {
+    std::string user = "login" + std::to_string(a);
+    int accountId = db.CreateAccount(user, user);
+    for (int c = 0; c < CHARS_PER_ACCOUNT; c++) {
+      std::string name = (c == 0 ? "Login" : "Alt" + std::to_string(c) + "_") +
+                         std::to_string(a);
+      int charId = db.CreateCharacter(accountId, name, kClasses[c % 4]);
+      if (charId <= 0)
+        continue;
+
+      Session s(-1);
+      s.characterId = charId;
+      s.classCode = kClasses[c % 4];
+      s.level = 80;
+      s.experience = Database::GetXPForLevel(80);
+      s.zen = 250000;
+      s.worldX = 13000.0f;
+      s.worldZ = 13000.0f;
+      for (int slot = 0; slot < 32; slot++) {
+        auto &item = s.bag[slot];
+        item.defIndex = static_cast<int16_t>(slot % 20);
+        item.quantity = 1;
+        item.itemLevel = static_cast<uint8_t>(slot % 4);
+        item.occupied = true;
+        item.primary = true;
+      }
+      for (int e = 0; e < 7; e++) {
+        s.equipment[e].category = e < 2 ? 0 : 7 + e;
+        s.equipment[e].itemIndex = 1;
+        s.equipment[e].itemLevel = 5;
+      }
+      for (int q = 0; q < 10; q++)
+        s.activeQuests.push_back({q, {q, 1, 0}});
+      server.SaveSession(s);
+      for (uint8_t skill = 1; skill <= 8; skill++)
+        db.LearnSkill(charId, skill);
+      if (c == 0) {
+        for (int m = 0; m < CHAT_MESSAGES; m++)
+          db.SaveChatMessage(charId, 0, 0xFFFFFFFF,
+                             "bench message " + std::to_string(m));
+        // Written out and dropped from memory: the benchmark's logins are
+        // first logins, history comes from chat_log
+        db.EvictChatHistory(charId);
+      }
+    }
+  }
+  tx.Commit();
+}
+
+} // namespace
+
+int RunMonsterBenchmark(int monsters) {
+  static constexpr int TICKS = 600; // 10s of simulated time at 60Hz
+  static constexpr int PLAYERS = 40;
+  static constexpr float DT = 1.0f / 60.0f;
+  const int size = GameWorld::TERRAIN_SIZE;
+  monsters = std::min(monsters, size * size / 2);
+  srand(1234);
+
+  // Open map with a few walls so some chases need real A* detours
+  std::vector<uint8_t> terrain(size * size, 0);
+  for (int y = 0; y < size; y++)
+    for (int x = 16; x < size; x += 32)
+      if (y % 64 > 8)
+        terrain[y * size + x] = GameWorld::TW_NOMOVE;
+
+  std::vector<uint16_t> types;
+  for (uint16_t t = 0; t < 150; t++)
+    if (GameWorld::FindMonsterTypeDef(t))
+      types.push_back(t);
+
+  std::vector<MonsterSpawnData> spawns;
+  spawns.reserve(monsters);
+  while ((int)spawns.size() < monsters) {
+    MonsterSpawnData s;
+    s.posX = static_cast<uint8_t>(rand() % size);
+    s.posY = static_cast<uint8_t>(rand() % size);
+    if (terrain[s.posY * size + s.posX])
+      continue;
+    s.id = static_cast<int>(spawns.size()) + 1;
+    s.type = types[spawns.size() % types.size()];
+    s.direction = static_cast<uint8_t>(rand() % 8);
+    spawns.push_back(s);
+  }
+
+  auto world = std::make_unique<GameWorld>();
+  world->SetTerrainAttributesForMap(0, terrain.data());
+  world->SetActiveMap(0);
+  world->LoadMonsters(spawns, 0);
+
+  std::vector<GameWorld::PlayerTarget> players(PLAYERS);
+  for (int i = 0; i < PLAYERS; i++) {
+    auto &p = players[i];
+    p.fd = 100 + i;
+    p.gridX = static_cast<uint8_t>(rand() % size);
+    p.gridY = static_cast<uint8_t>(rand() % size);
+    p.worldX = p.gridY * 100.0f;
+    p.worldZ = p.gridX * 100.0f;
+    p.defense = 50;
+    p.defenseRate = 30;
+    p.life = 1000000; // Never dies, keeps the whole pack engaged
+    p.dead = false;
+    p.level = 50;
+  }
+
+  CacheMissCounter misses;
+  std::vector<double> tickMs;
+  tickMs.reserve(TICKS);
+  uint64_t totalMisses = 0;
+  size_t attacks = 0, moves = 0;
+  for (int t = 0; t < TICKS; t++) {
+    std::vector<GameWorld::MonsterMoveUpdate> wanderMoves, aiMoves;
+    auto t0 = Clock::now();
+    misses.Start();
+    world->Update(DT, nullptr, &wanderMoves);
+    auto result = world->ProcessMonsterAI(DT, players, aiMoves);
+    totalMisses += misses.Stop();
+    tickMs.push_back(SecondsSince(t0) * 1000.0);
+    attacks += result.size();
+    moves += wanderMoves.size() + aiMoves.size();
+  }
+
+  double sum = 0;
+  for (double ms : tickMs)
+    sum += ms;
+  std::sort(tickMs.begin(), tickMs.end());
+  printf("[Bench] Monster tick: %d monsters, %d players, %d ticks, "
+         "sizeof(MonsterInstance)=%zu\n",
+         monsters, PLAYERS, TICKS, sizeof(MonsterInstance));
+  printf("[Bench]   avg %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms "
+         "(%zu attacks, %zu moves)\n",
+         sum / TICKS, tickMs[TICKS / 2], tickMs[TICKS * 99 / 100],
+         tickMs.back(), attacks, moves);
+  if (misses.Valid())
+    printf("[Bench]   %.0f cache misses/tick (%.2f per monster)\n",
+           (double)totalMisses / TICKS, (double)totalMisses / TICKS / monsters);
+  else
+    printf("[Bench]   cache-miss counter unavailable (perf events disabled)\n");
+  return 0;
+}
+
+int RunLoginBenchmark(int logins) {
+  const std::string path = "bench_logins.db";
+  RemoveDatabaseFiles(path);
+  auto server = std::make_unique<Server>();
+  Database &db = server->GetDB();
+  if (!db.Open(path)) {
+    printf("[Bench] Failed to open %s\n", path.c_str());
+    return 1;
+  }
+  db.SeedItemDefinitions();
+  db.SetItemDefinitionCache(db.GetAllItemDefinitions()); // As at startup
+  server->GetWorld().SetActiveMap(0);
+  printf("[Bench] Login benchmark (%d logins, 5 characters per account)\n",
+         logins);
+  {
+    QuietStdout quiet;
+    CreateLoginAccounts(*server, logins);
+  }
+
+  std::vector<double> listMs, selectMs, totalMs;
+  listMs.reserve(logins);
+  selectMs.reserve(logins);
+  totalMs.reserve(logins);
+  size_t bytesSent = 0;
+  {
+    QuietStdout quiet;
+    for (int i = 0; i < logins; i++) {
+      std::string user = "login" + std::to_string(i);
+      std::string name = "Login" + std::to_string(i);
+      PMSG_CHARSELECT_RECV sel{};
+      sel.h = MakeC1SubHeader(sizeof(sel), Opcode::CHARSELECT,
+                              Opcode::SUB_CHARSELECT);
+      size_t nameLen = std::min(name.size(), sizeof(sel.name) - 1);
+      memcpy(sel.name, name.data(), nameLen);
+      sel.name[nameLen] = '\0';
+      std::vector<uint8_t> packet(sizeof(sel));
+      memcpy(packet.data(), &sel, sizeof(sel));
+
+      Session s(-1);
+      auto t0 = Clock::now();
+      s.accountId = db.ValidateLogin(user, user);
+      CharacterSelectHandler::SendCharList(s, db);
+      auto t1 = Clock::now();
+      CharacterSelectHandler::HandleCharSelect(s, packet, db,
+                                               server->GetWorld(), *server);
+      auto t2 = Clock::now();
+      if (!s.inWorld)
+        continue;
+      listMs.push_back(std::chrono::duration<double>(t1 - t0).count() * 1e3);
+      selectMs.push_back(std::chrono::duration<double>(t2 - t1).count() * 1e3);
+      totalMs.push_back(std::chrono::duration<double>(t2 - t0).count() * 1e3);
+      bytesSent += s.TakeSendBuffer().size();
+    }
+  }
+
+  if (totalMs.empty()) {
+    printf("[Bench] No login reached the world\n");
+    return 1;
+  }
+  auto avg = [](const std::vector<double> &v) {
+    double sum = 0;
+    for (double x : v)
+      sum += x;
+    return sum / v.size();
+  };
+  size_t n = totalMs.size();
+  double avgList = avg(listMs), avgSelect = avg(selectMs);
+  std::sort(totalMs.begin(), totalMs.end());
+  printf("[Bench]   %zu logins: login->in-world avg %.3f ms, p50 %.3f ms, "
+         "p99 %.3f ms\n",
+         n, avg(totalMs), totalMs[n / 2], totalMs[n * 99 / 100]);
+  printf("[Bench]   char list avg %.3f ms, char select avg %.3f ms, "
+         "%zu bytes sent per login\n",
+         avgList, avgSelect, bytesSent / n);
+
+  db.Close();
+  RemoveDatabaseFiles(path);
+  return 0;
+}
+
+int RunSaveBenchmark(int characters) {
+  printf("[Bench] Character save benchmark (%d characters)\n", characters);
+  RunProfile("safe", DatabaseTuning::Safe(), characters);
+  RunProfile("fast", DatabaseTuning::Fast(), characters);
+  return 0;
+}
+
+} // namespace Bench
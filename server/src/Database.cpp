@@ -1,24 +1,139 @@
 #include "Database.hpp"
 #include "Session.hpp"
+#include <chrono>
 #include <cstdio>
 
-bool Database::Open(const std::string &dbPath) {
+bool Database::Open(const std::string &dbPath, const DatabaseTuning &tuning) {
   if (sqlite3_open(dbPath.c_str(), &m_db) != SQLITE_OK) {
     printf("[DB] Failed to open: %s\n", sqlite3_errmsg(m_db));
     return false;
   }
+  // Gateway backends share one database file; wait out each other's writes
+  // instead of failing with SQLITE_BUSY
+  sqlite3_busy_timeout(m_db, 5000);
+  ApplyTuning(tuning);
   CreateTables();
+  if (dbPath != ":memory:") {
+    m_chatPruneStop = false;
+    m_chatPruneThread = std::thread(&Database::ChatRetentionMain, this, dbPath);
+  }
   printf("[DB] Opened %s\n", dbPath.c_str());
   return true;
 }
 
 void Database::Close() {
+  if (m_db)
+    FlushChatLog();
+  if (m_chatPruneThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_chatPruneMutex);
+      m_chatPruneStop = true;
+    }
+    m_chatPruneCv.notify_one();
+    m_chatPruneThread.join();
+  }
+  m_chatCache.clear();
+  for (auto &[sql, stmt] : m_stmtCache)
+    sqlite3_finalize(stmt);
+  m_stmtCache.clear();
   if (m_db) {
     sqlite3_close(m_db);
     m_db = nullptr;
   }
 }
 
+void Database::ApplyTuning(const DatabaseTuning &tuning) {
+  char sql[256];
+  snprintf(sql, sizeof(sql),
+           "PRAGMA journal_mode=%s;"
+           "PRAGMA synchronous=%s;"
+           "PRAGMA mmap_size=%lld;"
+           "PRAGMA cache_size=-%d;"
+           "PRAGMA temp_store=MEMORY;",
+           tuning.walJournal ? "WAL" : "DELETE",
+           tuning.synchronousNormal ? "NORMAL" : "FULL",
+           (long long)tuning.mmapSize, tuning.cacheSizeKiB);
+  char *err = nullptr;
+  if (sqlite3_exec(m_db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+    printf("[DB] PRAGMA error: %s\n", err);
+    sqlite3_free(err);
+    return;
+  }
+  printf("[DB] Tuning: journal=%s synchronous=%s mmap=%lldMB cache=%dKB\n",
+         tuning.walJournal ? "WAL" : "DELETE",
+         tuning.synchronousNormal ? "NORMAL" : "FULL",
+         (long long)(tuning.mmapSize >> 20), tuning.cacheSizeKiB);
+}
+
+sqlite3_stmt *Database::CachedStatement(std::string_view sql) {
+  auto it = m_stmtCache.find(sql);
+  if (it != m_stmtCache.end()) {
+    sqlite3_clear_bindings(it->second);
+    return it->second;
+  }
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v3(m_db, sql.data(), (int)sql.size(),
+                         SQLITE_PREPARE_PERSISTENT, &stmt,
+                         nullptr) != SQLITE_OK) {
+    printf("[DB] Prepare failed: %s\n", sqlite3_errmsg(m_db));
+    if (m_txDepth > 0)
+      m_txFailed = true;
+    return nullptr;
+  }
+  m_stmtCache.emplace(sql, stmt);
+  return stmt;
+}
+
+void Database::BeginTransaction() {
+  if (m_txDepth++ == 0)
+    sqlite3_exec(m_db, "BEGIN", nullptr, nullptr, nullptr);
+}
+
+bool Database::EndTransaction(bool commit) {
+  if (m_txDepth == 0)
+    return false;
+  if (!commit)
+    m_txFailed = true;
+  if (--m_txDepth > 0)
+    return !m_txFailed;
+
+  bool failed = m_txFailed;
+  m_txFailed = false;
+  if (!failed) {
+    char *err = nullptr;
+    if (sqlite3_exec(m_db, "COMMIT", nullptr, nullptr, &err) == SQLITE_OK)
+      return true;
+    printf("[DB] Commit error: %s\n", err);
+    sqlite3_free(err);
+  }
+  // A failed COMMIT can leave the transaction open (e.g. SQLITE_BUSY)
+  if (!sqlite3_get_autocommit(m_db))
+    sqlite3_exec(m_db, "ROLLBACK", nullptr, nullptr, nullptr);
+  printf("[DB] Transaction rolled back\n");
+  return false;
+}
+
+bool Database::StepWrite(sqlite3_stmt *stmt) {
+  int rc = sqlite3_step(stmt);
+  if (rc == SQLITE_DONE || rc == SQLITE_ROW)
+    return true;
+  printf("[DB] Write failed: %s\n", sqlite3_errmsg(m_db));
+  if (m_txDepth > 0)
+    m_txFailed = true;
+  return false;
+}
+
+bool Database::ExecWrite(const char *sql) {
+  char *err = nullptr;
+  if (sqlite3_exec(m_db, sql, nullptr, nullptr, &err) == SQLITE_OK)
+    return true;
+  printf("[DB] Write failed: %s\n", err ? err : sqlite3_errmsg(m_db));
+  sqlite3_free(err);
+  if (m_txDepth > 0)
+    m_txFailed = true;
+  return false;
+}
+
 void Database::CreateTables() {
   const char *sql = R"(
         CREATE TABLE IF NOT EXISTS accounts (
@@ -197,6 +312,12 @@ void Database::CreateTables() {
   sqlite3_exec(m_db, "ALTER TABLE characters ADD COLUMN potion_bar BLOB",
                nullptr, nullptr, nullptr);
 
+  // Character list / account-wide equipment lookups
+  sqlite3_exec(m_db,
+               "CREATE INDEX IF NOT EXISTS idx_characters_account "
+               "ON characters(account_id, slot)",
+               nullptr, nullptr, nullptr);
+
   // Migration: camera zoom per character (default 800.0 stored as 8000)
   sqlite3_exec(m_db,
                "ALTER TABLE characters ADD COLUMN camera_zoom INTEGER DEFAULT 8000",
@@ -235,6 +356,38 @@ void Database::CreateTables() {
     printf("[DB] chat_log create error: %s\n", chatErr);
     sqlite3_free(chatErr);
   }
+  // History loads and retention trims: newest rows of one character
+  sqlite3_exec(m_db,
+               "CREATE INDEX IF NOT EXISTS idx_chat_log_character "
+               "ON chat_log(character_id, id)",
+               nullptr, nullptr, nullptr);
+
+  // World data revision (world.snapshot key): every write to the spawn and
+  // item tables bumps it, so a boot reads one row instead of hashing them
+  sqlite3_exec(m_db,
+               "CREATE TABLE IF NOT EXISTS world_revision ("
+               "id INTEGER PRIMARY KEY CHECK (id = 0), "
+               "revision INTEGER NOT NULL);"
+               "INSERT OR IGNORE INTO world_revision VALUES (0, 0);",
+               nullptr, nullptr, nullptr);
+  static const char *kWorldTables[] = {"npc_spawns", "monster_spawns",
+                                       "item_definitions"};
+  static const char *kWriteOps[] = {"INSERT", "UPDATE", "DELETE"};
+  for (const char *table : kWorldTables) {
+    for (const char *op : kWriteOps) {
+      char trigger[256];
+      snprintf(trigger, sizeof(trigger),
+               "CREATE TRIGGER IF NOT EXISTS %s_%s_revision AFTER %s ON %s "
+               "BEGIN UPDATE world_revision SET revision = revision + 1; END",
+               table, op, op, table);
+      char *triggerErr = nullptr;
+      if (sqlite3_exec(m_db, trigger, nullptr, nullptr, &triggerErr) !=
+          SQLITE_OK) {
+        printf("[DB] world_revision trigger error: %s\n", triggerErr);
+        sqlite3_free(triggerErr);
+      }
+    }
+  }
 
   // Quest progress table (per-quest tracking, replaces old chain system)
   const char *questSql = R"(
@@ -281,6 +434,21 @@ void Database::CreateTables() {
       nullptr, nullptr, nullptr);
 }
 
+int Database::CreateAccount(const std::string &username,
+                            const std::string &password) {
+  sqlite3_stmt *stmt = nullptr;
+  sqlite3_prepare_v2(m_db,
+                     "INSERT INTO accounts (username, password) VALUES (?, ?)",
+                     -1, &stmt, nullptr);
+  sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, password.c_str(), -1, SQLITE_TRANSIENT);
+  int accountId = 0;
+  if (sqlite3_step(stmt) == SQLITE_DONE)
+    accountId = static_cast<int>(sqlite3_last_insert_rowid(m_db));
+  sqlite3_finalize(stmt);
+  return accountId;
+}
+
 void Database::CreateDefaultAccount() {
   // Check if test account exists
   int accountId = 0;
@@ -511,171 +679,210 @@ bool Database::DeleteCharacter(int accountId, int charId) {
     return false;
 
   // Delete associated data
+  Transaction tx(*this);
   char sql[256];
   snprintf(sql, sizeof(sql),
            "DELETE FROM character_equipment WHERE character_id=%d", charId);
-  sqlite3_exec(m_db, sql, nullptr, nullptr, nullptr);
+  ExecWrite(sql);
 
   snprintf(sql, sizeof(sql),
            "DELETE FROM character_inventory WHERE character_id=%d", charId);
-  sqlite3_exec(m_db, sql, nullptr, nullptr, nullptr);
+  ExecWrite(sql);
 
   snprintf(sql, sizeof(sql),
            "DELETE FROM character_skills WHERE character_id=%d", charId);
-  sqlite3_exec(m_db, sql, nullptr, nullptr, nullptr);
+  ExecWrite(sql);
+
+  FlushChatLog();
+  m_chatCache.erase(charId);
+  snprintf(sql, sizeof(sql), "DELETE FROM chat_log WHERE character_id=%d",
+           charId);
+  ExecWrite(sql);
 
   snprintf(sql, sizeof(sql), "DELETE FROM characters WHERE id=%d", charId);
-  sqlite3_exec(m_db, sql, nullptr, nullptr, nullptr);
+  ExecWrite(sql);
 
+  if (!tx.Commit())
+    return false;
   printf("[DB] Deleted character id=%d\n", charId);
   return true;
 }
 
+// Every column of CharacterData, in readCharacterRow order
+#define CHARACTER_COLUMNS                                                      \
+  "c.id, c.account_id, c.slot, c.name, c.class, c.level, c.map_id, "          \
+  "c.pos_x, c.pos_y, c.direction, c.strength, c.dexterity, c.vitality, "      \
+  "c.energy, c.life, c.max_life, c.mana, c.max_mana, c.ag, c.max_ag, "        \
+  "c.money, c.experience, c.level_up_points, c.skill_bar, c.potion_bar, "     \
+  "c.rmc_skill_id, c.summon_type, c.camera_zoom, "                            \
+  "c.buff_def_type, c.buff_def_remaining, c.buff_def_value, "                 \
+  "c.buff_dmg_type, c.buff_dmg_remaining, c.buff_dmg_value"
+
+static void readCharacterRow(sqlite3_stmt *stmt, CharacterData &c) {
+  c.id = sqlite3_column_int(stmt, 0);
+  c.accountId = sqlite3_column_int(stmt, 1);
+  c.slot = sqlite3_column_int(stmt, 2);
+  c.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
+  c.charClass = static_cast<uint8_t>(sqlite3_column_int(stmt, 4));
+  c.level = static_cast<uint16_t>(sqlite3_column_int(stmt, 5));
+  c.mapId = static_cast<uint8_t>(sqlite3_column_int(stmt, 6));
+  c.posX = static_cast<uint8_t>(sqlite3_column_int(stmt, 7));
+  c.posY = static_cast<uint8_t>(sqlite3_column_int(stmt, 8));
+  c.direction = static_cast<uint8_t>(sqlite3_column_int(stmt, 9));
+  c.strength = static_cast<uint16_t>(sqlite3_column_int(stmt, 10));
+  c.dexterity = static_cast<uint16_t>(sqlite3_column_int(stmt, 11));
+  c.vitality = static_cast<uint16_t>(sqlite3_column_int(stmt, 12));
+  c.energy = static_cast<uint16_t>(sqlite3_column_int(stmt, 13));
+  c.life = static_cast<uint16_t>(sqlite3_column_int(stmt, 14));
+  c.maxLife = static_cast<uint16_t>(sqlite3_column_int(stmt, 15));
+  c.mana = static_cast<uint16_t>(sqlite3_column_int(stmt, 16));
+  c.maxMana = static_cast<uint16_t>(sqlite3_column_int(stmt, 17));
+  c.ag = static_cast<uint16_t>(sqlite3_column_int(stmt, 18));
+  c.maxAg = static_cast<uint16_t>(sqlite3_column_int(stmt, 19));
+  c.money = static_cast<uint32_t>(sqlite3_column_int(stmt, 20));
+  c.experience = static_cast<uint64_t>(sqlite3_column_int64(stmt, 21));
+  c.levelUpPoints = static_cast<uint16_t>(sqlite3_column_int(stmt, 22));
+
+  const void *skillBlob = sqlite3_column_blob(stmt, 23);
+  if (skillBlob && sqlite3_column_bytes(stmt, 23) == 10) {
+    memcpy(c.skillBar, skillBlob, 10);
+  } else {
+    memset(c.skillBar, -1, 10);
+  }
+  const void *potionBlob = sqlite3_column_blob(stmt, 24);
+  int potionBytes = sqlite3_column_bytes(stmt, 24);
+  memset(c.potionBar, -1, 8); // 4 × int16_t, default all empty
+  if (potionBlob && potionBytes >= 6) {
+    memcpy(c.potionBar, potionBlob, std::min(potionBytes, 8));
+  }
+
+  c.rmcSkillId = static_cast<int8_t>(sqlite3_column_int(stmt, 25));
+  c.summonType = static_cast<int16_t>(sqlite3_column_int(stmt, 26));
+  c.cameraZoom = static_cast<uint16_t>(sqlite3_column_int(stmt, 27));
+  c.buffDefType = static_cast<uint8_t>(sqlite3_column_int(stmt, 28));
+  c.buffDefRemaining = static_cast<float>(sqlite3_column_double(stmt, 29));
+  c.buffDefValue = sqlite3_column_int(stmt, 30);
+  c.buffDmgType = static_cast<uint8_t>(sqlite3_column_int(stmt, 31));
+  c.buffDmgRemaining = static_cast<float>(sqlite3_column_double(stmt, 32));
+  c.buffDmgValue = sqlite3_column_int(stmt, 33);
+}
+
 CharacterData Database::GetCharacter(const std::string &name) {
   CharacterData c;
-  sqlite3_stmt *stmt = nullptr;
-  const char *sql =
-      "SELECT id, account_id, slot, name, class, level, map_id, "
-      "pos_x, pos_y, direction, strength, dexterity, vitality, "
-      "energy, life, max_life, mana, max_mana, ag, max_ag, money, "
-      "experience, level_up_points, skill_bar, potion_bar, "
-      "rmc_skill_id, summon_type, camera_zoom, "
-      "buff_def_type, buff_def_remaining, buff_def_value, "
-      "buff_dmg_type, buff_dmg_remaining, buff_dmg_value "
-      "FROM characters WHERE name=?";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(
+      "SELECT " CHARACTER_COLUMNS " FROM characters c WHERE c.name=?");
+  if (!stmt)
     return c;
-
   sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
-  if (sqlite3_step(stmt) == SQLITE_ROW) {
-    c.id = sqlite3_column_int(stmt, 0);
-    c.accountId = sqlite3_column_int(stmt, 1);
-    c.slot = sqlite3_column_int(stmt, 2);
-    c.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-    c.charClass = static_cast<uint8_t>(sqlite3_column_int(stmt, 4));
-    c.level = static_cast<uint16_t>(sqlite3_column_int(stmt, 5));
-    c.mapId = static_cast<uint8_t>(sqlite3_column_int(stmt, 6));
-    c.posX = static_cast<uint8_t>(sqlite3_column_int(stmt, 7));
-    c.posY = static_cast<uint8_t>(sqlite3_column_int(stmt, 8));
-    c.direction = static_cast<uint8_t>(sqlite3_column_int(stmt, 9));
-    c.strength = static_cast<uint16_t>(sqlite3_column_int(stmt, 10));
-    c.dexterity = static_cast<uint16_t>(sqlite3_column_int(stmt, 11));
-    c.vitality = static_cast<uint16_t>(sqlite3_column_int(stmt, 12));
-    c.energy = static_cast<uint16_t>(sqlite3_column_int(stmt, 13));
-    c.life = static_cast<uint16_t>(sqlite3_column_int(stmt, 14));
-    c.maxLife = static_cast<uint16_t>(sqlite3_column_int(stmt, 15));
-    c.mana = static_cast<uint16_t>(sqlite3_column_int(stmt, 16));
-    c.maxMana = static_cast<uint16_t>(sqlite3_column_int(stmt, 17));
-    c.ag = static_cast<uint16_t>(sqlite3_column_int(stmt, 18));
-    c.maxAg = static_cast<uint16_t>(sqlite3_column_int(stmt, 19));
-    c.money = static_cast<uint32_t>(sqlite3_column_int(stmt, 20));
-    c.experience = static_cast<uint64_t>(sqlite3_column_int64(stmt, 21));
-    c.levelUpPoints = static_cast<uint16_t>(sqlite3_column_int(stmt, 22));
-
-    const void *skillBlob = sqlite3_column_blob(stmt, 23);
-    if (skillBlob && sqlite3_column_bytes(stmt, 23) == 10) {
-      memcpy(c.skillBar, skillBlob, 10);
-    } else {
-      memset(c.skillBar, -1, 10);
-    }
-    const void *potionBlob = sqlite3_column_blob(stmt, 24);
-    int potionBytes = sqlite3_column_bytes(stmt, 24);
-    memset(c.potionBar, -1, 8); // 4 × int16_t, default all empty
-    if (potionBlob && potionBytes >= 6) {
-      memcpy(c.potionBar, potionBlob, std::min(potionBytes, 8));
-    }
-
-    c.rmcSkillId = static_cast<int8_t>(sqlite3_column_int(stmt, 25));
-    c.summonType = static_cast<int16_t>(sqlite3_column_int(stmt, 26));
-    c.cameraZoom = static_cast<uint16_t>(sqlite3_column_int(stmt, 27));
-    c.buffDefType = static_cast<uint8_t>(sqlite3_column_int(stmt, 28));
-    c.buffDefRemaining = static_cast<float>(sqlite3_column_double(stmt, 29));
-    c.buffDefValue = sqlite3_column_int(stmt, 30);
-    c.buffDmgType = static_cast<uint8_t>(sqlite3_column_int(stmt, 31));
-    c.buffDmgRemaining = static_cast<float>(sqlite3_column_double(stmt, 32));
-    c.buffDmgValue = sqlite3_column_int(stmt, 33);
-  }
-  sqlite3_finalize(stmt);
+  if (sqlite3_step(stmt) == SQLITE_ROW)
+    readCharacterRow(stmt, c);
+  sqlite3_reset(stmt);
   return c;
 }
 
 CharacterData Database::GetCharacterById(int id) {
   CharacterData c;
-  sqlite3_stmt *stmt = nullptr;
-  const char *sql =
-      "SELECT id, account_id, slot, name, class, level, map_id, "
-      "pos_x, pos_y, direction, strength, dexterity, vitality, "
-      "energy, life, max_life, mana, max_mana, ag, max_ag, money, "
-      "experience, level_up_points, skill_bar, potion_bar, "
-      "rmc_skill_id, summon_type, camera_zoom, "
-      "buff_def_type, buff_def_remaining, buff_def_value, "
-      "buff_dmg_type, buff_dmg_remaining, buff_dmg_value "
-      "FROM characters WHERE id=?";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(
+      "SELECT " CHARACTER_COLUMNS " FROM characters c WHERE c.id=?");
+  if (!stmt)
     return c;
-
   sqlite3_bind_int(stmt, 1, id);
-  if (sqlite3_step(stmt) == SQLITE_ROW) {
-    c.id = sqlite3_column_int(stmt, 0);
-    c.accountId = sqlite3_column_int(stmt, 1);
-    c.slot = sqlite3_column_int(stmt, 2);
-    c.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-    c.charClass = static_cast<uint8_t>(sqlite3_column_int(stmt, 4));
-    c.level = static_cast<uint16_t>(sqlite3_column_int(stmt, 5));
-    c.mapId = static_cast<uint8_t>(sqlite3_column_int(stmt, 6));
-    c.posX = static_cast<uint8_t>(sqlite3_column_int(stmt, 7));
-    c.posY = static_cast<uint8_t>(sqlite3_column_int(stmt, 8));
-    c.direction = static_cast<uint8_t>(sqlite3_column_int(stmt, 9));
-    c.strength = static_cast<uint16_t>(sqlite3_column_int(stmt, 10));
-    c.dexterity = static_cast<uint16_t>(sqlite3_column_int(stmt, 11));
-    c.vitality = static_cast<uint16_t>(sqlite3_column_int(stmt, 12));
-    c.energy = static_cast<uint16_t>(sqlite3_column_int(stmt, 13));
-    c.life = static_cast<uint16_t>(sqlite3_column_int(stmt, 14));
-    c.maxLife = static_cast<uint16_t>(sqlite3_column_int(stmt, 15));
-    c.mana = static_cast<uint16_t>(sqlite3_column_int(stmt, 16));
-    c.maxMana = static_cast<uint16_t>(sqlite3_column_int(stmt, 17));
-    c.ag = static_cast<uint16_t>(sqlite3_column_int(stmt, 18));
-    c.maxAg = static_cast<uint16_t>(sqlite3_column_int(stmt, 19));
-    c.money = static_cast<uint32_t>(sqlite3_column_int(stmt, 20));
-    c.experience = static_cast<uint64_t>(sqlite3_column_int64(stmt, 21));
-    c.levelUpPoints = static_cast<uint16_t>(sqlite3_column_int(stmt, 22));
+  if (sqlite3_step(stmt) == SQLITE_ROW)
+    readCharacterRow(stmt, c);
+  sqlite3_reset(stmt);
+  return c;
+}
 
-    const void *skillBlob = sqlite3_column_blob(stmt, 23);
-    if (skillBlob && sqlite3_column_bytes(stmt, 23) == 10) {
-      memcpy(c.skillBar, skillBlob, 10);
-    } else {
-      memset(c.skillBar, -1, 10);
+bool Database::LoadCharacter(const std::string &name, CharacterLoad &out) {
+  // One read transaction: a consistent snapshot, one lock acquisition
+  Transaction tx(*this);
+  out = {};
+
+  sqlite3_stmt *stmt = CachedStatement(
+      "SELECT " CHARACTER_COLUMNS " FROM characters c WHERE c.name=?");
+  if (!stmt)
+    return false;
+  sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
+  if (sqlite3_step(stmt) == SQLITE_ROW)
+    readCharacterRow(stmt, out.character);
+  sqlite3_reset(stmt);
+  int id = out.character.id;
+  if (id == 0)
+    return false;
+
+  stmt = CachedStatement(
+      "SELECT slot, item_category, item_index, item_level, quantity "
+      "FROM character_equipment WHERE character_id=? ORDER BY slot");
+  if (stmt) {
+    out.equipment.reserve(9);
+    sqlite3_bind_int(stmt, 1, id);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      EquipmentSlot e;
+      e.slot = static_cast<uint8_t>(sqlite3_column_int(stmt, 0));
+      e.category = static_cast<uint8_t>(sqlite3_column_int(stmt, 1));
+      e.itemIndex = static_cast<uint8_t>(sqlite3_column_int(stmt, 2));
+      e.itemLevel = static_cast<uint8_t>(sqlite3_column_int(stmt, 3));
+      e.quantity = static_cast<uint8_t>(sqlite3_column_int(stmt, 4));
+      out.equipment.push_back(e);
     }
-    const void *potionBlob = sqlite3_column_blob(stmt, 24);
-    int potionBytes = sqlite3_column_bytes(stmt, 24);
-    memset(c.potionBar, -1, 8); // 4 × int16_t, default all empty
-    if (potionBlob && potionBytes >= 6) {
-      memcpy(c.potionBar, potionBlob, std::min(potionBytes, 8));
+    sqlite3_reset(stmt);
+  }
+
+  stmt = CachedStatement(
+      "SELECT slot, def_index, quantity, item_level "
+      "FROM character_inventory WHERE character_id=? ORDER BY slot");
+  if (stmt) {
+    out.inventory.reserve(64);
+    sqlite3_bind_int(stmt, 1, id);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      InventorySlotData d;
+      d.slot = static_cast<uint8_t>(sqlite3_column_int(stmt, 0));
+      d.defIndex = static_cast<int16_t>(sqlite3_column_int(stmt, 1));
+      d.quantity = static_cast<uint8_t>(sqlite3_column_int(stmt, 2));
+      d.itemLevel = static_cast<uint8_t>(sqlite3_column_int(stmt, 3));
+      out.inventory.push_back(d);
     }
+    sqlite3_reset(stmt);
+  }
 
-    c.rmcSkillId = static_cast<int8_t>(sqlite3_column_int(stmt, 25));
-    c.summonType = static_cast<int16_t>(sqlite3_column_int(stmt, 26));
-    c.cameraZoom = static_cast<uint16_t>(sqlite3_column_int(stmt, 27));
-    c.buffDefType = static_cast<uint8_t>(sqlite3_column_int(stmt, 28));
-    c.buffDefRemaining = static_cast<float>(sqlite3_column_double(stmt, 29));
-    c.buffDefValue = sqlite3_column_int(stmt, 30);
-    c.buffDmgType = static_cast<uint8_t>(sqlite3_column_int(stmt, 31));
-    c.buffDmgRemaining = static_cast<float>(sqlite3_column_double(stmt, 32));
-    c.buffDmgValue = sqlite3_column_int(stmt, 33);
+  stmt = CachedStatement(
+      "SELECT skill_id FROM character_skills WHERE character_id=?");
+  if (stmt) {
+    sqlite3_bind_int(stmt, 1, id);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+      out.skills.push_back(static_cast<uint8_t>(sqlite3_column_int(stmt, 0)));
+    sqlite3_reset(stmt);
   }
-  sqlite3_finalize(stmt);
-  return c;
+
+  stmt = CachedStatement(
+      "SELECT quest_id, kill_count_0, kill_count_1, kill_count_2, completed "
+      "FROM character_quest_progress WHERE character_id=?");
+  if (stmt) {
+    sqlite3_bind_int(stmt, 1, id);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      QuestProgress qp;
+      qp.questId = sqlite3_column_int(stmt, 0);
+      qp.kc[0] = sqlite3_column_int(stmt, 1);
+      qp.kc[1] = sqlite3_column_int(stmt, 2);
+      qp.kc[2] = sqlite3_column_int(stmt, 3);
+      qp.completed = sqlite3_column_int(stmt, 4) != 0;
+      out.quests.push_back(qp);
+    }
+    sqlite3_reset(stmt);
+  }
+  tx.Commit();
+  return true;
 }
 
 void Database::UpdateCameraZoom(int charId, uint16_t zoom) {
-  sqlite3_stmt *stmt = nullptr;
   const char *sql = "UPDATE characters SET camera_zoom=? WHERE id=?";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(sql);
+  if (!stmt)
     return;
   sqlite3_bind_int(stmt, 1, zoom);
   sqlite3_bind_int(stmt, 2, charId);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  StepWrite(stmt);
+  sqlite3_reset(stmt);
 }
 
 void Database::UpdateCharacterStats(
@@ -710,7 +917,7 @@ void Database::UpdateCharacterStats(
   sqlite3_bind_int(stmt, 16, rmcSkillId);
   sqlite3_bind_int(stmt, 17, charId);
 
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
   printf("[DB] Saved character %d stats: Lv%d STR=%d DEX=%d VIT=%d ENE=%d "
          "HP=%d/%d MP=%d/%d AG=%d/%d XP=%llu pts=%d RMC=%d\n",
@@ -729,7 +936,6 @@ void Database::SaveCharacterFull(int charId, uint16_t level, uint16_t strength,
                                  uint8_t mapId, const int8_t *skillBar,
                                  const int16_t *potionBar, int8_t rmcSkillId,
                                  int16_t summonType, const Session *session) {
-  sqlite3_stmt *stmt = nullptr;
   const char *sql =
       "UPDATE characters SET level=?, strength=?, dexterity=?, vitality=?, "
       "energy=?, life=?, max_life=?, mana=?, max_mana=?, ag=?, max_ag=?, "
@@ -737,7 +943,8 @@ void Database::SaveCharacterFull(int charId, uint16_t level, uint16_t strength,
       "map_id=?, skill_bar=?, potion_bar=?, rmc_skill_id=?, summon_type=?, "
       "buff_def_type=?, buff_def_remaining=?, buff_def_value=?, "
       "buff_dmg_type=?, buff_dmg_remaining=?, buff_dmg_value=? WHERE id=?";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(sql);
+  if (!stmt)
     return;
   sqlite3_bind_int(stmt, 1, level);
   sqlite3_bind_int(stmt, 2, strength);
@@ -778,8 +985,8 @@ void Database::SaveCharacterFull(int charId, uint16_t level, uint16_t strength,
   }
   sqlite3_bind_int(stmt, 28, charId);
 
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  StepWrite(stmt);
+  sqlite3_reset(stmt);
 }
 
 void Database::UpdatePosition(int charId, uint8_t x, uint8_t y, int mapId) {
@@ -800,11 +1007,12 @@ void Database::UpdatePosition(int charId, uint8_t x, uint8_t y, int mapId) {
     sqlite3_bind_int(stmt, 2, y);
     sqlite3_bind_int(stmt, 3, charId);
   }
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
 }
 
 void Database::SeedNpcSpawns() {
+  Transaction tx(*this);
   // Check if NPCs already seeded
   sqlite3_stmt *stmt = nullptr;
   sqlite3_prepare_v2(m_db, "SELECT COUNT(*) FROM npc_spawns WHERE map_id=0", -1,
@@ -815,6 +1023,7 @@ void Database::SeedNpcSpawns() {
   sqlite3_finalize(stmt);
   if (count > 0) {
     printf("[DB] NPC spawns already seeded (%d entries)\n", count);
+    tx.Commit();
     return;
   }
 
@@ -855,6 +1064,7 @@ void Database::SeedNpcSpawns() {
   sqlite3_finalize(stmt);
   if (deviasNpcCount > 0) {
     printf("[DB] Devias NPC spawns already seeded (%d entries)\n", deviasNpcCount);
+    tx.Commit();
     return;
   }
 
@@ -886,6 +1096,7 @@ void Database::SeedNpcSpawns() {
   sqlite3_finalize(stmt);
   if (noriaNpcCount > 0) {
     printf("[DB] Noria NPC spawns already seeded (%d entries)\n", noriaNpcCount);
+    tx.Commit();
     return;
   }
 
@@ -906,6 +1117,7 @@ void Database::SeedNpcSpawns() {
   } else {
     printf("[DB] Seeded 7 Noria NPC spawns (3 vendors + vault + chaos goblin + quest guard)\n");
   }
+  tx.Commit();
 }
 
 std::vector<NpcSpawnData> Database::GetNpcSpawns(uint8_t mapId) {
@@ -933,8 +1145,30 @@ std::vector<NpcSpawnData> Database::GetNpcSpawns(uint8_t mapId) {
 }
 
 void Database::SeedItemDefinitions() {
-  // Force re-seeding to apply model filename fixes
-  sqlite3_exec(m_db, "DELETE FROM item_definitions", nullptr, nullptr, nullptr);
+  Transaction tx(*this);
+  // Re-seed only when the seed data revision changed (model filename fixes,
+  // price tweaks, ...) — the DELETE + insert of every item is the slowest step
+  // of a cold start.
+  sqlite3_stmt *stmt = nullptr;
+  int storedRevision = 0, storedCount = 0;
+  sqlite3_prepare_v2(m_db, "PRAGMA user_version", -1, &stmt, nullptr);
+  if (sqlite3_step(stmt) == SQLITE_ROW)
+    storedRevision = sqlite3_column_int(stmt, 0);
+  sqlite3_finalize(stmt);
+  sqlite3_prepare_v2(m_db, "SELECT COUNT(*) FROM item_definitions", -1, &stmt,
+                     nullptr);
+  if (sqlite3_step(stmt) == SQLITE_ROW)
+    storedCount = sqlite3_column_int(stmt, 0);
+  sqlite3_finalize(stmt);
+  if (storedRevision == ITEM_SEED_REVISION && storedCount > 0) {
+    printf("[DB] Item definitions up to date (revision %d, %d entries)\n",
+           storedRevision, storedCount);
+    tx.Commit();
+    return;
+  }
+
+  // DELETE + reseed as one unit: a failed insert keeps the old rows
+  ExecWrite("DELETE FROM item_definitions");
 
   // Seed all item definitions (MU 0.97d complete database — OpenMU
   // authoritative) Format: (category, item_index, name, model_file, level_req,
@@ -1314,10 +1548,8 @@ void Database::SeedItemDefinitions() {
             (14, 20, 'Remedy of Love', 'Drink00.bmd', 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 15),
             (14, 31, 'Guardian Angel Scroll', 'Suho.bmd', 0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 15)
      )";
-  char *err = nullptr;
-  if (sqlite3_exec(m_db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
-    printf("[DB] SeedItemDefinitions error: %s\n", err);
-    sqlite3_free(err);
+  if (!ExecWrite(sql)) {
+    printf("[DB] SeedItemDefinitions failed, keeping the previous items\n");
   } else {
     // Count actual items seeded
     sqlite3_stmt *countStmt = nullptr;
@@ -1412,7 +1644,38 @@ void Database::SeedItemDefinitions() {
     )";
     sqlite3_exec(m_db, staffMagicPower, nullptr, nullptr, nullptr);
     printf("[DB] Set staff magicPower values\n");
+
+    char pragma[64];
+    snprintf(pragma, sizeof(pragma), "PRAGMA user_version=%d",
+             ITEM_SEED_REVISION);
+    sqlite3_exec(m_db, pragma, nullptr, nullptr, nullptr);
+  }
+  tx.Commit();
+}
+
+std::vector<ItemDefinition> Database::GetAllItemDefinitions() {
+  std::vector<ItemDefinition> items;
+  sqlite3_stmt *stmt = nullptr;
+  const char *sql = "SELECT category, item_index FROM item_definitions "
+                    "ORDER BY category, item_index";
+  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    return items;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    items.push_back(GetItemDefinition(
+        static_cast<uint8_t>(sqlite3_column_int(stmt, 0)),
+        static_cast<uint8_t>(sqlite3_column_int(stmt, 1))));
+  }
+  sqlite3_finalize(stmt);
+  return items;
+}
+
+void Database::SetItemDefinitionCache(const std::vector<ItemDefinition> &items) {
+  m_itemCache.assign(16 * 32, ItemDefinition{});
+  for (auto &item : items) {
+    if (item.category < 16 && item.itemIndex < 32)
+      m_itemCache[item.category * 32 + item.itemIndex] = item;
   }
+  printf("[DB] Item definition cache: %zu entries\n", items.size());
 }
 
 ItemDefinition Database::GetItemDefinition(int id) {
@@ -1422,6 +1685,9 @@ ItemDefinition Database::GetItemDefinition(int id) {
 
 ItemDefinition Database::GetItemDefinition(uint8_t category,
                                            uint8_t itemIndex) {
+  if (!m_itemCache.empty() && category < 16 && itemIndex < 32)
+    return m_itemCache[category * 32 + itemIndex];
+
   ItemDefinition item;
   sqlite3_stmt *stmt = nullptr;
   const char *sql =
@@ -1465,6 +1731,15 @@ ItemDefinition Database::GetItemDefinition(uint8_t category,
 std::vector<ItemDropInfo> Database::GetItemsByLevelRange(int minLevel,
                                                          int maxLevel) {
   std::vector<ItemDropInfo> items;
+  if (!m_itemCache.empty()) {
+    for (auto &def : m_itemCache) {
+      if (!def.name.empty() && def.category <= 11 && def.level >= minLevel &&
+          def.level <= maxLevel)
+        items.push_back({def.category, def.itemIndex, def.name, def.level});
+    }
+    return items;
+  }
+
   sqlite3_stmt *stmt = nullptr;
   // Exclude Wings (12+), Orbs, Quest Items, etc. Only allow Categories 0-11
   // (Gear)
@@ -1513,7 +1788,32 @@ std::vector<EquipmentSlot> Database::GetCharacterEquipment(int characterId) {
   return equip;
 }
 
+std::unordered_map<int, std::vector<EquipmentSlot>>
+Database::GetAccountEquipment(int accountId) {
+  std::unordered_map<int, std::vector<EquipmentSlot>> equip;
+  sqlite3_stmt *stmt = CachedStatement(
+      "SELECT e.character_id, e.slot, e.item_category, e.item_index, "
+      "e.item_level, e.quantity FROM character_equipment e "
+      "JOIN characters c ON c.id = e.character_id "
+      "WHERE c.account_id=? ORDER BY e.character_id, e.slot");
+  if (!stmt)
+    return equip;
+  sqlite3_bind_int(stmt, 1, accountId);
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    EquipmentSlot e;
+    e.slot = static_cast<uint8_t>(sqlite3_column_int(stmt, 1));
+    e.category = static_cast<uint8_t>(sqlite3_column_int(stmt, 2));
+    e.itemIndex = static_cast<uint8_t>(sqlite3_column_int(stmt, 3));
+    e.itemLevel = static_cast<uint8_t>(sqlite3_column_int(stmt, 4));
+    e.quantity = static_cast<uint8_t>(sqlite3_column_int(stmt, 5));
+    equip[sqlite3_column_int(stmt, 0)].push_back(e);
+  }
+  sqlite3_reset(stmt);
+  return equip;
+}
+
 void Database::SeedMonsterSpawns() {
+  Transaction tx(*this);
   sqlite3_stmt *stmt = nullptr;
   char *err = nullptr;
 
@@ -1914,6 +2214,18 @@ void Database::SeedMonsterSpawns() {
            "Noria.cs)\n");
   }
   } // end Noria else
+  tx.Commit();
+}
+
+int64_t Database::GetWorldTablesRevision() {
+  sqlite3_stmt *stmt = nullptr;
+  int64_t revision = -1;
+  if (sqlite3_prepare_v2(m_db, "SELECT revision FROM world_revision", -1,
+                         &stmt, nullptr) == SQLITE_OK &&
+      sqlite3_step(stmt) == SQLITE_ROW)
+    revision = sqlite3_column_int64(stmt, 0);
+  sqlite3_finalize(stmt);
+  return revision;
 }
 
 std::vector<MonsterSpawnData> Database::GetMonsterSpawns(uint8_t mapId) {
@@ -1968,7 +2280,6 @@ void Database::SeedDefaultEquipment(int characterId) {
 void Database::UpdateEquipment(int characterId, uint8_t slot, uint8_t category,
                                uint8_t itemIndex, uint8_t itemLevel,
                                uint8_t quantity) {
-  sqlite3_stmt *stmt = nullptr;
   // UPSERT: insert or replace on (character_id, slot) unique constraint
   const char *sql =
       "INSERT INTO character_equipment (character_id, slot, item_category, "
@@ -1977,7 +2288,8 @@ void Database::UpdateEquipment(int characterId, uint8_t slot, uint8_t category,
       "ON CONFLICT(character_id, slot) DO UPDATE SET "
       "item_category=excluded.item_category, item_index=excluded.item_index, "
       "item_level=excluded.item_level, quantity=excluded.quantity";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(sql);
+  if (!stmt)
     return;
   sqlite3_bind_int(stmt, 1, characterId);
   sqlite3_bind_int(stmt, 2, slot);
@@ -1985,8 +2297,8 @@ void Database::UpdateEquipment(int characterId, uint8_t slot, uint8_t category,
   sqlite3_bind_int(stmt, 4, itemIndex);
   sqlite3_bind_int(stmt, 5, itemLevel);
   sqlite3_bind_int(stmt, 6, quantity);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  StepWrite(stmt);
+  sqlite3_reset(stmt);
   printf("[DB] Equipment updated: char=%d slot=%d cat=%d idx=%d +%d qty=%d\n",
          characterId, slot, category, itemIndex, itemLevel, quantity);
 }
@@ -2016,22 +2328,22 @@ Database::GetCharacterInventory(int characterId) {
 void Database::SaveCharacterInventory(int characterId, int16_t defIndex,
                                       uint8_t quantity, uint8_t itemLevel,
                                       uint8_t slot) {
-  sqlite3_stmt *stmt = nullptr;
   const char *sql = "INSERT INTO character_inventory (character_id, slot, "
                     "def_index, quantity, item_level) "
                     "VALUES (?, ?, ?, ?, ?) "
                     "ON CONFLICT(character_id, slot) DO UPDATE SET "
                     "def_index=excluded.def_index, quantity=excluded.quantity, "
                     "item_level=excluded.item_level";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(sql);
+  if (!stmt)
     return;
   sqlite3_bind_int(stmt, 1, characterId);
   sqlite3_bind_int(stmt, 2, slot);
   sqlite3_bind_int(stmt, 3, defIndex);
   sqlite3_bind_int(stmt, 4, quantity);
   sqlite3_bind_int(stmt, 5, itemLevel);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  StepWrite(stmt);
+  sqlite3_reset(stmt);
 }
 
 void Database::DeleteCharacterInventoryItem(int characterId, uint8_t slot) {
@@ -2042,18 +2354,18 @@ void Database::DeleteCharacterInventoryItem(int characterId, uint8_t slot) {
     return;
   sqlite3_bind_int(stmt, 1, characterId);
   sqlite3_bind_int(stmt, 2, slot);
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
 }
 
 void Database::DeleteCharacterInventoryAll(int characterId) {
-  sqlite3_stmt *stmt = nullptr;
   const char *sql = "DELETE FROM character_inventory WHERE character_id=?";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+  sqlite3_stmt *stmt = CachedStatement(sql);
+  if (!stmt)
     return;
   sqlite3_bind_int(stmt, 1, characterId);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  StepWrite(stmt);
+  sqlite3_reset(stmt);
 }
 
 void Database::UpdateCharacterMoney(int characterId, uint32_t money) {
@@ -2063,7 +2375,7 @@ void Database::UpdateCharacterMoney(int characterId, uint32_t money) {
     return;
   sqlite3_bind_int(stmt, 1, static_cast<int>(money));
   sqlite3_bind_int(stmt, 2, characterId);
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
 }
 
@@ -2097,7 +2409,7 @@ void Database::LearnSkill(int characterId, uint8_t skillId) {
     return;
   sqlite3_bind_int(stmt, 1, characterId);
   sqlite3_bind_int(stmt, 2, skillId);
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
   printf("[DB] Character %d learned skill %d\n", characterId, skillId);
 }
@@ -2123,7 +2435,7 @@ void Database::SetRmcSkillId(int characterId, int8_t skillId) {
     return;
   sqlite3_bind_int(stmt, 1, skillId);
   sqlite3_bind_int(stmt, 2, characterId);
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
 }
 
@@ -2131,56 +2443,167 @@ void Database::SetRmcSkillId(int characterId, int8_t skillId) {
 
 void Database::SaveChatMessage(int characterId, uint8_t category,
                                uint32_t color, const std::string &message) {
-  sqlite3_stmt *stmt = nullptr;
-  const char *sql =
-      "INSERT INTO chat_log (character_id, category, color, message) "
-      "VALUES (?, ?, ?, ?)";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-    return;
-  sqlite3_bind_int(stmt, 1, characterId);
-  sqlite3_bind_int(stmt, 2, category);
-  sqlite3_bind_int64(stmt, 3, (int64_t)color);
-  sqlite3_bind_text(stmt, 4, message.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  ChatRing &ring = LoadChatRing(characterId);
+  ring.entries.push_back({category, color, message});
+  if (ring.entries.size() > CHAT_HISTORY_LIMIT)
+    ring.entries.pop_front();
+  m_chatPending.push_back({characterId, {category, color, message}});
+}
+
+std::vector<Database::ChatLogEntry>
+Database::GetChatHistory(int characterId) {
+  const ChatRing &ring = LoadChatRing(characterId);
+  return {ring.entries.begin(), ring.entries.end()};
+}
 
-  // Trim: keep only last 500 messages per character
-  sqlite3_stmt *trimStmt = nullptr;
-  const char *trimSql =
-      "DELETE FROM chat_log WHERE character_id=? AND id NOT IN "
-      "(SELECT id FROM chat_log WHERE character_id=? ORDER BY id DESC LIMIT 500)";
-  if (sqlite3_prepare_v2(m_db, trimSql, -1, &trimStmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_int(trimStmt, 1, characterId);
-    sqlite3_bind_int(trimStmt, 2, characterId);
-    sqlite3_step(trimStmt);
-    sqlite3_finalize(trimStmt);
+Database::ChatRing &Database::LoadChatRing(int characterId) {
+  auto it = m_chatCache.find(characterId);
+  if (it == m_chatCache.end()) {
+    if (m_chatCache.size() >= CHAT_CACHE_CHARACTERS) {
+      // Drop the least recently used ring; its pending rows go out first
+      FlushChatLog();
+      auto oldest = m_chatCache.begin();
+      for (auto i = m_chatCache.begin(); i != m_chatCache.end(); ++i) {
+        if (i->second.lastUse < oldest->second.lastUse)
+          oldest = i;
+      }
+      m_chatCache.erase(oldest);
+    }
+    it = m_chatCache.emplace(characterId, ChatRing{}).first;
+
+    // Most recent N messages, oldest first for display
+    sqlite3_stmt *stmt = CachedStatement(
+        "SELECT category, color, message FROM "
+        "(SELECT id, category, color, message FROM chat_log "
+        "WHERE character_id=? ORDER BY id DESC LIMIT ?) ORDER BY id ASC");
+    if (stmt) {
+      sqlite3_bind_int(stmt, 1, characterId);
+      sqlite3_bind_int(stmt, 2, (int)CHAT_HISTORY_LIMIT);
+      while (sqlite3_step(stmt) == SQLITE_ROW) {
+        ChatLogEntry e;
+        e.category = (uint8_t)sqlite3_column_int(stmt, 0);
+        e.color = (uint32_t)sqlite3_column_int64(stmt, 1);
+        const char *msg = (const char *)sqlite3_column_text(stmt, 2);
+        e.message = msg ? msg : "";
+        it->second.entries.push_back(std::move(e));
+      }
+      sqlite3_reset(stmt);
+    }
   }
+  it->second.lastUse = ++m_chatUseClock;
+  return it->second;
 }
 
-std::vector<Database::ChatLogEntry>
-Database::GetChatHistory(int characterId, int limit) {
-  std::vector<ChatLogEntry> entries;
-  sqlite3_stmt *stmt = nullptr;
-  // Get most recent N messages, ordered oldest-first for display
-  const char *sql =
-      "SELECT category, color, message FROM "
-      "(SELECT category, color, message FROM chat_log "
-      "WHERE character_id=? ORDER BY id DESC LIMIT ?) "
-      "ORDER BY rowid ASC";
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-    return entries;
-  sqlite3_bind_int(stmt, 1, characterId);
-  sqlite3_bind_int(stmt, 2, limit);
-  while (sqlite3_step(stmt) == SQLITE_ROW) {
-    ChatLogEntry e;
-    e.category = (uint8_t)sqlite3_column_int(stmt, 0);
-    e.color = (uint32_t)sqlite3_column_int64(stmt, 1);
-    const char *msg = (const char *)sqlite3_column_text(stmt, 2);
-    e.message = msg ? msg : "";
-    entries.push_back(std::move(e));
+void Database::FlushChatLog() {
+  if (m_chatPending.empty())
+    return;
+  bool written = false;
+  {
+    Transaction tx(*this);
+    sqlite3_stmt *stmt = CachedStatement(
+        "INSERT INTO chat_log (character_id, category, color, message) "
+        "VALUES (?, ?, ?, ?)");
+    if (stmt) {
+      for (auto &p : m_chatPending) {
+        sqlite3_bind_int(stmt, 1, p.characterId);
+        sqlite3_bind_int(stmt, 2, p.entry.category);
+        sqlite3_bind_int64(stmt, 3, (int64_t)p.entry.color);
+        sqlite3_bind_text(stmt, 4, p.entry.message.c_str(), -1,
+                          SQLITE_STATIC);
+        StepWrite(stmt);
+        sqlite3_reset(stmt);
+      }
+      written = tx.Commit();
+    }
   }
-  sqlite3_finalize(stmt);
-  return entries;
+  if (!written) {
+    if (++m_chatFlushFailures < CHAT_FLUSH_RETRIES) {
+      printf("[DB] Chat log flush failed (%d/%d), keeping %zu rows\n",
+             m_chatFlushFailures, CHAT_FLUSH_RETRIES, m_chatPending.size());
+      return;
+    }
+    printf("[DB] Chat log flush failed %d times, dropped %zu rows\n",
+           m_chatFlushFailures, m_chatPending.size());
+    m_chatFlushFailures = 0;
+    m_chatPending.clear();
+    return;
+  }
+  m_chatFlushFailures = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_chatPruneMutex);
+    for (auto &p : m_chatPending)
+      m_chatPruneIds.insert(p.characterId);
+  }
+  m_chatPending.clear();
+}
+
+void Database::EvictChatHistory(int characterId) {
+  FlushChatLog();
+  m_chatCache.erase(characterId);
+}
+
+void Database::ChatRetentionMain(std::string dbPath) {
+  sqlite3 *db = nullptr;
+  if (sqlite3_open(dbPath.c_str(), &db) != SQLITE_OK) {
+    printf("[ChatLog] Retention disabled, can't open %s: %s\n",
+           dbPath.c_str(), sqlite3_errmsg(db));
+    sqlite3_close(db);
+    return;
+  }
+  sqlite3_busy_timeout(db, 5000);
+
+  // Everything at or below the CHAT_RETAIN_ROWS-th newest row goes. Each
+  // character is its own autocommit statement, so the game thread never
+  // waits on more than one short delete.
+  sqlite3_stmt *trim = nullptr;
+  sqlite3_prepare_v2(db,
+                     "DELETE FROM chat_log WHERE character_id=?1 AND id <= "
+                     "(SELECT id FROM chat_log WHERE character_id=?1 "
+                     "ORDER BY id DESC LIMIT 1 OFFSET ?2)",
+                     -1, &trim, nullptr);
+
+  // First pass: whoever is over the limit already (older servers never
+  // trimmed in the background)
+  std::vector<int> ids;
+  sqlite3_stmt *over = nullptr;
+  if (sqlite3_prepare_v2(db,
+                         "SELECT character_id FROM chat_log "
+                         "GROUP BY character_id HAVING COUNT(*) > ?",
+                         -1, &over, nullptr) == SQLITE_OK) {
+    sqlite3_bind_int(over, 1, CHAT_RETAIN_ROWS);
+    while (sqlite3_step(over) == SQLITE_ROW)
+      ids.push_back(sqlite3_column_int(over, 0));
+    sqlite3_finalize(over);
+  }
+
+  while (trim) {
+    int trimmed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int id : ids) {
+      sqlite3_bind_int(trim, 1, id);
+      sqlite3_bind_int(trim, 2, CHAT_RETAIN_ROWS);
+      if (sqlite3_step(trim) == SQLITE_DONE)
+        trimmed += sqlite3_changes(db);
+      sqlite3_reset(trim);
+    }
+    if (trimmed > 0)
+      printf("[ChatLog] Retention: trimmed %d row(s) of %zu character(s) in "
+             "%.1f ms\n",
+             trimmed, ids.size(),
+             std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - start)
+                 .count());
+
+    std::unique_lock<std::mutex> lock(m_chatPruneMutex);
+    m_chatPruneCv.wait_for(lock, std::chrono::seconds(CHAT_PRUNE_INTERVAL),
+                           [this] { return m_chatPruneStop; });
+    if (m_chatPruneStop)
+      break;
+    ids.assign(m_chatPruneIds.begin(), m_chatPruneIds.end());
+    m_chatPruneIds.clear();
+  }
+  sqlite3_finalize(trim);
+  sqlite3_close(db);
 }
 
 std::vector<Database::QuestProgress> Database::LoadAllQuestProgress(int characterId) {
@@ -2207,8 +2630,7 @@ std::vector<Database::QuestProgress> Database::LoadAllQuestProgress(int characte
 
 void Database::SaveQuestProgress(int characterId, int questId,
                                  int kc0, int kc1, int kc2, bool completed) {
-  sqlite3_stmt *stmt = nullptr;
-  if (sqlite3_prepare_v2(m_db,
+  const char *sql =
           "INSERT INTO character_quest_progress "
           "(character_id, quest_id, kill_count_0, kill_count_1, kill_count_2, completed) "
           "VALUES (?,?,?,?,?,?) "
@@ -2216,8 +2638,9 @@ void Database::SaveQuestProgress(int characterId, int questId,
           "kill_count_0=excluded.kill_count_0, "
           "kill_count_1=excluded.kill_count_1, "
           "kill_count_2=excluded.kill_count_2, "
-          "completed=excluded.completed",
-          -1, &stmt, nullptr) != SQLITE_OK)
+          "completed=excluded.completed";
+  sqlite3_stmt *stmt = CachedStatement(sql);
+  if (!stmt)
     return;
   sqlite3_bind_int(stmt, 1, characterId);
   sqlite3_bind_int(stmt, 2, questId);
@@ -2225,8 +2648,8 @@ void Database::SaveQuestProgress(int characterId, int questId,
   sqlite3_bind_int(stmt, 4, kc1);
   sqlite3_bind_int(stmt, 5, kc2);
   sqlite3_bind_int(stmt, 6, completed ? 1 : 0);
-  sqlite3_step(stmt);
-  sqlite3_finalize(stmt);
+  StepWrite(stmt);
+  sqlite3_reset(stmt);
 }
 
 void Database::DeleteQuestProgress(int characterId, int questId) {
@@ -2237,6 +2660,6 @@ void Database::DeleteQuestProgress(int characterId, int questId) {
     return;
   sqlite3_bind_int(stmt, 1, characterId);
   sqlite3_bind_int(stmt, 2, questId);
-  sqlite3_step(stmt);
+  StepWrite(stmt);
   sqlite3_finalize(stmt);
 }
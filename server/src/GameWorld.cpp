@@ -1,6 +1,8 @@
 #include "GameWorld.hpp"
+#include "Handoff.hpp"
 #include "PacketDefs.hpp"
 #include "PathFinder.hpp"
+#include "WorldSnapshot.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
@@ -67,6 +69,10 @@ static const MonsterTypeDef s_monsterDefs[] = {
 static constexpr int NUM_MONSTER_DEFS =
     sizeof(s_monsterDefs) / sizeof(s_monsterDefs[0]);
 
+// AI parameters for types missing from the table (stats are set per instance)
+static const MonsterTypeDef s_fallbackMonsterDef = {
+    0, 30, 3, 3, 4, 7, 8, 4, 1.8f, 0.4f, 3, 5, 1, false, 10.0f};
+
 // World-space melee range threshold (squared) — must be adjacent.
 // Adjacent diagonal = ~141 units, so 150 allows adjacent but not 2-cell hits.
 // Max world distance for melee attacks. Grid cells are 100 units wide, and
@@ -107,8 +113,8 @@ static std::vector<uint8_t> DecryptMapFile(const std::vector<uint8_t> &data) {
   return out;
 }
 
-static bool ParseTerrainAttributeFile(const std::string &attFilePath,
-                                      std::vector<uint8_t> &outAttributes) {
+bool GameWorld::ParseTerrainAttributeFile(const std::string &attFilePath,
+                                          std::vector<uint8_t> &outAttributes) {
   std::ifstream file(attFilePath, std::ios::binary);
   if (!file) {
     printf("[World] Cannot open terrain attribute file: %s\n",
@@ -172,10 +178,31 @@ bool GameWorld::LoadTerrainAttributesForMap(uint8_t mapId,
   return ok;
 }
 
+void GameWorld::SetTerrainAttributesForMap(uint8_t mapId,
+                                           const uint8_t *attributes) {
+  m_mapTerrainAttributes[mapId].assign(
+      attributes, attributes + TERRAIN_SIZE * TERRAIN_SIZE);
+}
+
+void GameWorld::AttachSnapshot(const WorldSnapshot *snapshot) {
+  m_snapshot = snapshot;
+  int maps = 0;
+  for (uint8_t mapId = 0; snapshot && mapId < WorldSnapshot::MAX_MAPS;
+       mapId++) {
+    const uint8_t *attrs = snapshot->GetTerrainAttributes(mapId);
+    if (!attrs)
+      continue;
+    SetTerrainAttributesForMap(mapId, attrs);
+    maps++;
+  }
+  printf("[World] Using world snapshot (%d terrain maps)\n", maps);
+}
+
 void GameWorld::SetActiveMap(uint8_t mapId) {
   auto it = m_mapTerrainAttributes.find(mapId);
   if (it != m_mapTerrainAttributes.end()) {
     m_terrainAttributes = it->second;
+    m_regionLabels = m_snapshot ? m_snapshot->GetRegionLabels(mapId) : nullptr;
     m_activeMapId = mapId;
     // Rebuild pathfinder with new terrain
     m_pathFinder = std::make_unique<PathFinder>();
@@ -189,6 +216,7 @@ void GameWorld::SetActiveMap(uint8_t mapId) {
 void GameWorld::ClearWorldData() {
   m_npcs.clear();
   m_monsterInstances.clear();
+  m_spatialDirty = true;
   m_drops.clear();
   m_nextMonsterIndex = 2001;
   m_nextDropIndex = 1;
@@ -196,6 +224,247 @@ void GameWorld::ClearWorldData() {
   printf("[World] Cleared all NPCs, monsters, and drops\n");
 }
 
+// ─── Hot restart state ──────────────────────────────────────────────────────
+
+// Every persisted monster/drop field, in blob order. Save and load both walk
+// these lists (like Handoff's Session fields), so the blob never depends on
+// struct layout. `def` is re-resolved on load; paths are sent as cell lists.
+template <typename M, typename Fn>
+static void forEachMonsterField(M &mon, Fn &&f) {
+  f(mon.aiState);
+  f(mon.gridX);
+  f(mon.gridY);
+  f(mon.dir);
+  f(mon.index);
+  f(mon.type);
+  f(mon.worldX);
+  f(mon.worldZ);
+  f(mon.hp);
+  f(mon.maxHp);
+  f(mon.level);
+  f(mon.stateTimer);
+  f(mon.attackCooldown);
+  f(mon.moveTimer);
+  f(mon.moveDelay);
+  f(mon.repathTimer);
+  f(mon.aggroTargetFd);
+  f(mon.aggroTimer);
+  f(mon.stormTime);
+  f(mon.ownerFd);
+  f(mon.aggressive);
+  f(mon.justRespawned);
+  f(mon.evading);
+  f(mon.poisoned);
+  f(mon.pathStep);
+  f(mon.spawnGridX);
+  f(mon.spawnGridY);
+  f(mon.spawnX);
+  f(mon.spawnZ);
+  f(mon.chaseFailCount);
+  f(mon.approachTimer);
+  f(mon.staggerDelay);
+  f(mon.regenTimer);
+  f(mon.stormTickTimer);
+  f(mon.playerThreat);
+  f(mon.summonThreat);
+  f(mon.aggroSummonIdx);
+  f(mon.defense);
+  f(mon.defenseRate);
+  f(mon.attackMin);
+  f(mon.attackMax);
+  f(mon.attackRate);
+  f(mon.poisonTickTimer);
+  f(mon.poisonDuration);
+  f(mon.poisonDamage);
+  f(mon.poisonAttackerFd);
+  f(mon.ownerCharId);
+  f(mon.lastAttackedMonIdx);
+  f(mon.lastBroadcastTargetX);
+  f(mon.lastBroadcastTargetY);
+  f(mon.lastBroadcastChasing);
+  f(mon.lastBroadcastIsMoving);
+}
+
+template <typename D, typename Fn>
+static void forEachDropField(D &drop, Fn &&f) {
+  f(drop.index);
+  f(drop.defIndex);
+  f(drop.quantity);
+  f(drop.itemLevel);
+  f(drop.worldX);
+  f(drop.worldZ);
+  f(drop.age);
+}
+
+void GameWorld::StateLayout(size_t &fields, size_t &bytes) {
+  auto count = [&](const auto &field) {
+    fields++;
+    bytes += sizeof(field);
+  };
+  MonsterInstance mon{};
+  GroundDrop drop{};
+  forEachMonsterField(mon, count);
+  forEachDropField(drop, count);
+}
+
+void GameWorld::SaveState(Handoff::Writer &out) const {
+  auto put = [&out](const auto &field) { out.Put(field); };
+  out.Put(m_activeMapId);
+  out.Put(m_nextMonsterIndex);
+  out.Put(m_nextSummonIndex);
+  out.Put(m_nextDropIndex);
+
+  out.Put<uint32_t>(static_cast<uint32_t>(m_monsterInstances.size()));
+  for (const auto &mon : m_monsterInstances) {
+    forEachMonsterField(mon, put);
+    const MonsterPath &path = mon.currentPath;
+    out.PutVector(std::vector<GridPoint>(path.points, path.points + path.count));
+  }
+
+  out.Put<uint32_t>(static_cast<uint32_t>(m_drops.size()));
+  for (const auto &drop : m_drops)
+    forEachDropField(drop, put);
+
+  out.Put<uint32_t>(static_cast<uint32_t>(m_npcs.size()));
+  for (const auto &npc : m_npcs) {
+    out.Put(npc.index);
+    out.Put(npc.type);
+    out.Put(npc.x);
+    out.Put(npc.y);
+    out.Put(npc.dir);
+    out.PutString(npc.name);
+    out.Put(npc.isGuard);
+    out.Put(npc.worldX);
+    out.Put(npc.worldZ);
+    out.Put(npc.spawnX);
+    out.Put(npc.spawnZ);
+    out.Put(npc.wanderTimer);
+    out.Put(npc.wanderTargetX);
+    out.Put(npc.wanderTargetZ);
+    out.Put(npc.isWandering);
+    out.Put(npc.lastBroadcastX);
+    out.Put(npc.lastBroadcastY);
+    out.PutVector(npc.patrolWaypoints);
+    out.Put(npc.patrolIndex);
+    out.PutVector(npc.guardPath);
+    out.Put(npc.guardPathStep);
+    out.Put(npc.guardMoveTimer);
+    out.Put(npc.interactingFd);
+  }
+}
+
+bool GameWorld::LoadState(Handoff::Reader &in) {
+  auto get = [&in](auto &field) { in.Get(field); };
+  uint8_t mapId = 0;
+  in.Get(mapId);
+  in.Get(m_nextMonsterIndex);
+  in.Get(m_nextSummonIndex);
+  in.Get(m_nextDropIndex);
+
+  uint32_t monsterCount = 0;
+  std::vector<MonsterInstance> monsters;
+  in.Get(monsterCount);
+  for (uint32_t i = 0; i < monsterCount && in.Ok(); i++) {
+    MonsterInstance mon{};
+    std::vector<GridPoint> path;
+    forEachMonsterField(mon, get);
+    in.GetVector(path);
+    mon.currentPath = path;
+    monsters.push_back(mon);
+  }
+
+  uint32_t dropCount = 0;
+  std::vector<GroundDrop> drops;
+  in.Get(dropCount);
+  for (uint32_t i = 0; i < dropCount && in.Ok(); i++) {
+    GroundDrop drop{};
+    forEachDropField(drop, get);
+    drops.push_back(drop);
+  }
+
+  uint32_t npcCount = 0;
+  std::vector<NpcSpawn> npcs;
+  in.Get(npcCount);
+  for (uint32_t i = 0; i < npcCount && in.Ok(); i++) {
+    NpcSpawn npc;
+    in.Get(npc.index);
+    in.Get(npc.type);
+    in.Get(npc.x);
+    in.Get(npc.y);
+    in.Get(npc.dir);
+    in.GetString(npc.name);
+    in.Get(npc.isGuard);
+    in.Get(npc.worldX);
+    in.Get(npc.worldZ);
+    in.Get(npc.spawnX);
+    in.Get(npc.spawnZ);
+    in.Get(npc.wanderTimer);
+    in.Get(npc.wanderTargetX);
+    in.Get(npc.wanderTargetZ);
+    in.Get(npc.isWandering);
+    in.Get(npc.lastBroadcastX);
+    in.Get(npc.lastBroadcastY);
+    in.GetVector(npc.patrolWaypoints);
+    in.Get(npc.patrolIndex);
+    in.GetVector(npc.guardPath);
+    in.Get(npc.guardPathStep);
+    in.Get(npc.guardMoveTimer);
+    in.Get(npc.interactingFd);
+    npcs.push_back(std::move(npc));
+  }
+  if (!in.Ok())
+    return false;
+
+  // Pointers from the old process mean nothing here
+  for (auto &mon : monsters) {
+    const MonsterTypeDef *def = FindMonsterTypeDef(mon.type);
+    mon.def = def ? def : &s_fallbackMonsterDef;
+  }
+
+  if (mapId != m_activeMapId)
+    SetActiveMap(mapId);
+  m_monsterInstances = std::move(monsters);
+  m_drops = std::move(drops);
+  m_npcs = std::move(npcs);
+  m_spatialDirty = true;
+  rebuildOccupancyGrid();
+  printf("[World] Restored %zu monsters, %zu NPCs, %zu drops from handoff\n",
+         m_monsterInstances.size(), m_npcs.size(), m_drops.size());
+  return true;
+}
+
+void GameWorld::RemapPlayerFds(const std::unordered_map<int, int> &fdMap) {
+  auto remap = [&fdMap](int fd) {
+    auto it = fdMap.find(fd);
+    return it != fdMap.end() ? it->second : -1;
+  };
+  for (auto &npc : m_npcs) {
+    if (npc.interactingFd >= 0)
+      npc.interactingFd = remap(npc.interactingFd);
+  }
+  size_t kept = 0;
+  for (size_t i = 0; i < m_monsterInstances.size(); i++) {
+    MonsterInstance &mon = m_monsterInstances[i];
+    if (mon.isSummon()) {
+      // Summon aggroTargetFd is only a "chasing" flag, not a player fd
+      mon.ownerFd = remap(mon.ownerFd);
+      if (mon.ownerFd < 0)
+        continue; // Owner left during the handoff
+    } else {
+      if (mon.aggroTargetFd >= 0)
+        mon.aggroTargetFd = remap(mon.aggroTargetFd);
+      if (mon.poisonAttackerFd >= 0)
+        mon.poisonAttackerFd = remap(mon.poisonAttackerFd);
+    }
+    if (kept != i)
+      m_monsterInstances[kept] = mon;
+    kept++;
+  }
+  m_monsterInstances.resize(kept);
+  m_spatialDirty = true;
+  rebuildOccupancyGrid();
+}
+
 bool GameWorld::IsWalkable(float worldX, float worldZ) const {
   if (m_terrainAttributes.empty())
     return true;
@@ -230,6 +499,63 @@ bool GameWorld::IsSafeZoneGrid(uint8_t gx, uint8_t gy) const {
   return (attr & TW_SAFEZONE) != 0;
 }
 
+std::vector<GridPoint> GameWorld::FindPlayerPath(GridPoint start, GridPoint end,
+                                                 int maxSteps) const {
+  if (m_terrainAttributes.empty()) {
+    // No terrain loaded: everything is walkable, step straight at the target
+    std::vector<GridPoint> path;
+    GridPoint p = start;
+    while (p != end && (int)path.size() < maxSteps) {
+      p.x = static_cast<uint8_t>(p.x + (end.x > p.x) - (end.x < p.x));
+      p.y = static_cast<uint8_t>(p.y + (end.y > p.y) - (end.y < p.y));
+      path.push_back(p);
+    }
+    return path;
+  }
+  if (!IsWalkableGrid(end.x, end.y) || !IsConnectedGrid(start, end))
+    return {};
+  return m_pathFinder->FindRoute(start, end, m_terrainAttributes.data(),
+                                 maxSteps, /*canEnterSafeZone=*/true);
+}
+
+bool GameWorld::FindTownSpot(uint8_t mapId, bool respawn, GridPoint &out) const {
+  // Town points (grid x, y) per map, matching the client's tables
+  GridPoint town;
+  if (mapId == 0)
+    town = {137, 126}; // Lorencia
+  else if (mapId == 2)
+    town = respawn ? GridPoint{215, 47} : GridPoint{210, 40}; // Devias
+  else if (mapId == 3)
+    town = {174, 110}; // Noria
+  else
+    return false;
+  out = town;
+  for (int radius = 0; radius < 30; radius++) {
+    for (int dy = -radius; dy <= radius; dy++) {
+      for (int dx = -radius; dx <= radius; dx++) {
+        if (radius > 0 && std::abs(dx) != radius && std::abs(dy) != radius)
+          continue;
+        int cx = town.x + dx, cy = town.y + dy;
+        if (cx < 1 || cy < 1 || cx >= TERRAIN_SIZE - 1 || cy >= TERRAIN_SIZE - 1)
+          continue;
+        if (IsWalkableGrid((uint8_t)cx, (uint8_t)cy)) {
+          out = {(uint8_t)cx, (uint8_t)cy};
+          return true;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool GameWorld::IsConnectedGrid(GridPoint a, GridPoint b) const {
+  if (!m_regionLabels)
+    return true;
+  uint16_t ra = m_regionLabels[a.y * TERRAIN_SIZE + a.x];
+  uint16_t rb = m_regionLabels[b.y * TERRAIN_SIZE + b.x];
+  return ra == 0 || rb == 0 || ra == rb;
+}
+
 // Guard patrol still uses tryMove (will be refactored separately)
 bool GameWorld::tryMove(float &x, float &z, float sX, float sZ) const {
   if (std::abs(sX) < 0.001f && std::abs(sZ) < 0.001f)
@@ -322,7 +648,8 @@ void GameWorld::emitMoveIfChanged(MonsterInstance &mon, uint8_t targetX,
 // ─── NPC Loading ─────────────────────────────────────────────────────────────
 
 void GameWorld::LoadNpcsFromDB(Database &db, uint8_t mapId) {
-  auto spawns = db.GetNpcSpawns(mapId);
+  auto spawns =
+      m_snapshot ? m_snapshot->GetNpcSpawns(mapId) : db.GetNpcSpawns(mapId);
 
   uint16_t nextIndex = 1001;
   for (auto &s : spawns) {
@@ -386,8 +713,13 @@ std::vector<uint8_t> GameWorld::BuildNpcViewportPacket() const {
 // ─── Monster Loading (uses MonsterTypeDef lookup table) ──────────────────────
 
 void GameWorld::LoadMonstersFromDB(Database &db, uint8_t mapId) {
-  auto spawns = db.GetMonsterSpawns(mapId);
+  LoadMonsters(m_snapshot ? m_snapshot->GetMonsterSpawns(mapId)
+                          : db.GetMonsterSpawns(mapId),
+               mapId);
+}
 
+void GameWorld::LoadMonsters(const std::vector<MonsterSpawnData> &spawns,
+                             uint8_t mapId) {
   for (auto &s : spawns) {
     MonsterInstance mon{};
     mon.index = m_nextMonsterIndex++;
@@ -404,6 +736,7 @@ void GameWorld::LoadMonstersFromDB(Database &db, uint8_t mapId) {
     mon.aiState = MonsterInstance::AIState::IDLE;
 
     const MonsterTypeDef *def = FindMonsterTypeDef(mon.type);
+    mon.def = def ? def : &s_fallbackMonsterDef;
     if (def) {
       mon.hp = def->hp;
       mon.maxHp = def->hp;
@@ -413,13 +746,8 @@ void GameWorld::LoadMonstersFromDB(Database &db, uint8_t mapId) {
       mon.attackMax = def->attackMax;
       mon.attackRate = def->attackRate;
       mon.level = def->level;
-      mon.atkCooldownTime = def->atkCooldown;
       mon.moveDelay = def->moveDelay;
-      mon.moveRange = def->moveRange;
-      mon.viewRange = def->viewRange;
-      mon.attackRange = def->attackRange;
       mon.aggressive = def->aggressive;
-      mon.respawnDelay = def->respawnDelay;
     } else {
       // Fallback for unknown types
       mon.hp = 30;
@@ -476,6 +804,7 @@ void GameWorld::LoadMonstersFromDB(Database &db, uint8_t mapId) {
 
   // Build initial occupancy grid
   rebuildOccupancyGrid();
+  m_spatialDirty = true;
 
   printf("[World] Loaded %zu monsters for map %d (indices %d-%d)\n",
          m_monsterInstances.size(), mapId,
@@ -602,7 +931,7 @@ GameWorld::findBestTarget(const MonsterInstance &mon,
         continue;
       int dist =
           PathFinder::ChebyshevDist(mon.gridX, mon.gridY, p.gridX, p.gridY);
-      if (dist <= mon.viewRange && dist < bestDist) {
+      if (dist <= mon.def->viewRange && dist < bestDist) {
         bestDist = dist;
         best = &p;
       }
@@ -644,10 +973,10 @@ void GameWorld::processIdle(MonsterInstance &mon, float dt,
     int numCandidates = 0;
 
     for (int tries = 0; tries < 10 && numCandidates < 5; tries++) {
-      int rx = (int)mon.spawnGridX + (rand() % (2 * mon.moveRange + 1)) -
-               mon.moveRange;
-      int ry = (int)mon.spawnGridY + (rand() % (2 * mon.moveRange + 1)) -
-               mon.moveRange;
+      int rx = (int)mon.spawnGridX + (rand() % (2 * mon.def->moveRange + 1)) -
+               mon.def->moveRange;
+      int ry = (int)mon.spawnGridY + (rand() % (2 * mon.def->moveRange + 1)) -
+               mon.def->moveRange;
       if (rx < 0 || ry < 0 || rx >= TERRAIN_SIZE || ry >= TERRAIN_SIZE)
         continue;
       uint8_t gx = (uint8_t)rx, gy = (uint8_t)ry;
@@ -765,7 +1094,7 @@ void GameWorld::processChasing(MonsterInstance &mon, float dt,
 
   // Leash check — chase limit from spawn point
   // Damage-aggro'd monsters get a much larger leash to chase attackers
-  int leashDist = std::max(25, mon.viewRange * 3);
+  int leashDist = std::max(25, mon.def->viewRange * 3);
   int distFromSpawn = PathFinder::ChebyshevDist(mon.gridX, mon.gridY,
                                                 mon.spawnGridX, mon.spawnGridY);
   if (distFromSpawn > leashDist) {
@@ -777,8 +1106,8 @@ void GameWorld::processChasing(MonsterInstance &mon, float dt,
                                                target->gridX, target->gridY);
 
   // In attack range → APPROACHING (brief delay for client walk anim to finish)
-  if (distToTarget <= mon.attackRange &&
-      (mon.attackRange > 1 ||
+  if (distToTarget <= mon.def->attackRange &&
+      (mon.def->attackRange > 1 ||
        WorldDistSq(mon, *target) <= MELEE_ATTACK_DIST_SQ)) {
     mon.aiState = MonsterInstance::AIState::APPROACHING;
     mon.approachTimer = 0.0f;
@@ -789,7 +1118,7 @@ void GameWorld::processChasing(MonsterInstance &mon, float dt,
 
   // Already in attack range? Don't re-path — the check above will handle it
   // (only for ranged monsters where attackRange > 1; melee needs to keep pathing)
-  if (mon.attackRange > 1 && distToTarget <= mon.attackRange) {
+  if (mon.def->attackRange > 1 && distToTarget <= mon.def->attackRange) {
     mon.chaseFailCount = 0;
     mon.currentPath.clear();
     mon.pathStep = 0;
@@ -821,7 +1150,7 @@ void GameWorld::processChasing(MonsterInstance &mon, float dt,
     // using monster index as a rotational offset to prevent all converging
     // on the same cell. Prefer cardinal cells (100 units) over diagonal
     // (141 units) for visually tighter attacks.
-    if (mon.attackRange <= 1) {
+    if (mon.def->attackRange <= 1) {
       // Cardinals first (indices 0-3), then diagonals (4-7)
       static const int dx8[] = {0, 0, -1, 1, -1, -1, 1, 1};
       static const int dy8[] = {-1, 1, 0, 0, -1, 1, -1, 1};
@@ -876,9 +1205,12 @@ void GameWorld::processChasing(MonsterInstance &mon, float dt,
     } else {
       // Allow safe zone traversal during chase (monsters walk through, just
       // don't aggro there). Original MU behavior — prevents stuck monsters
-      // near town borders.
-      auto path = m_pathFinder->FindPath(start, end, m_terrainAttributes.data(),
-                                         16, 500, true, nullptr);
+      // near town borders. Targets in another walkable region (across a wall
+      // or on an island) fail immediately instead of exhausting the A* budget.
+      std::vector<GridPoint> path;
+      if (IsConnectedGrid(start, end))
+        path = m_pathFinder->FindPath(start, end, m_terrainAttributes.data(),
+                                      16, 500, true, nullptr);
       if (!path.empty()) {
         mon.currentPath = std::move(path);
         mon.pathStep = 0;
@@ -969,9 +1301,9 @@ void GameWorld::processApproaching(MonsterInstance &mon, float dt,
   // Target moved out of range → resume chasing (with +1 tolerance)
   int dist = PathFinder::ChebyshevDist(mon.gridX, mon.gridY, target->gridX,
                                        target->gridY);
-  int rechaseRange = mon.attackRange + 1;
+  int rechaseRange = mon.def->attackRange + 1;
   if (dist > rechaseRange ||
-      (mon.attackRange <= 1 && WorldDistSq(mon, *target) > MELEE_ATTACK_DIST_SQ * 1.5f)) {
+      (mon.def->attackRange <= 1 && WorldDistSq(mon, *target) > MELEE_ATTACK_DIST_SQ * 1.5f)) {
     mon.aiState = MonsterInstance::AIState::CHASING;
     mon.currentPath.clear();
     mon.pathStep = 0;
@@ -1018,9 +1350,9 @@ void GameWorld::processAttacking(MonsterInstance &mon, float dt,
   // constant re-chase when player shifts 1 cell — reduces jostling)
   int dist = PathFinder::ChebyshevDist(mon.gridX, mon.gridY, target->gridX,
                                        target->gridY);
-  int rechaseRange = mon.attackRange + 1;
+  int rechaseRange = mon.def->attackRange + 1;
   if (dist > rechaseRange ||
-      (mon.attackRange <= 1 && WorldDistSq(mon, *target) > MELEE_ATTACK_DIST_SQ * 1.5f)) {
+      (mon.def->attackRange <= 1 && WorldDistSq(mon, *target) > MELEE_ATTACK_DIST_SQ * 1.5f)) {
     mon.aiState = MonsterInstance::AIState::CHASING;
     mon.currentPath.clear();
     mon.pathStep = 0;
@@ -1095,7 +1427,7 @@ void GameWorld::processAttacking(MonsterInstance &mon, float dt,
   result.remainingHp = static_cast<uint16_t>(std::max(0, target->life));
   attacks.push_back(result);
 
-  mon.attackCooldown = mon.atkCooldownTime;
+  mon.attackCooldown = mon.def->atkCooldown;
   mon.aggroTimer = 10.0f;
 }
 
@@ -1182,6 +1514,7 @@ void GameWorld::Update(float dt,
                        std::vector<MonsterMoveUpdate> *outWanderMoves,
                        std::vector<NpcMoveUpdate> *outNpcMoves,
                        std::function<void(uint16_t)> guardKillCallback) {
+  m_spatialDirty = true; // Respawns, summon sweep
   // Update monster DYING/DEAD timers and respawn
   for (auto &mon : m_monsterInstances) {
     if (mon.attackCooldown > 0) {
@@ -1203,7 +1536,7 @@ void GameWorld::Update(float dt,
       if (mon.isSummon())
         break; // Summons don't respawn — removed in sweep below
       mon.stateTimer += dt;
-      if (mon.stateTimer >= mon.respawnDelay * ServerConfig::RESPAWN_MULTIPLIER) {
+      if (mon.stateTimer >= mon.def->respawnDelay * ServerConfig::RESPAWN_MULTIPLIER) {
         // Respawn at original position
         setOccupied(mon.gridX, mon.gridY, false);
         mon.aiState = MonsterInstance::AIState::IDLE;
@@ -1328,6 +1661,7 @@ GameWorld::ProcessMonsterAI(float dt, std::vector<PlayerTarget> &players,
                             std::vector<SummonHitResult> *outSummonHits,
                             std::vector<MonsterHitSummonResult> *outMonsterHitSummon) {
   std::vector<MonsterAttackResult> attacks;
+  m_spatialDirty = true; // Monsters step along their paths below
 
   for (auto &mon : m_monsterInstances) {
     // Only process alive states
@@ -1598,7 +1932,7 @@ void GameWorld::processSummonAI(MonsterInstance &mon, float dt,
         damage = 1;
 
       bestTarget->hp -= damage;
-      mon.attackCooldown = mon.atkCooldownTime;
+      mon.attackCooldown = mon.def->atkCooldown;
       bool killed = bestTarget->hp <= 0;
 
       // Track summon threat for aggro system
@@ -1793,8 +2127,8 @@ void GameWorld::processSummonTargeting(
                                        summon.gridY);
 
   // In attack range — face and attack the summon
-  if (dist <= mon.attackRange &&
-      (mon.attackRange > 1 || WorldDistSqMon(mon, summon) <= MELEE_ATTACK_DIST_SQ)) {
+  if (dist <= mon.def->attackRange &&
+      (mon.def->attackRange > 1 || WorldDistSqMon(mon, summon) <= MELEE_ATTACK_DIST_SQ)) {
     // Face the summon
     int dx = (int)summon.gridX - (int)mon.gridX;
     int dy = (int)summon.gridY - (int)mon.gridY;
@@ -1815,7 +2149,7 @@ void GameWorld::processSummonTargeting(
       dmg = 1;
 
     summon.hp -= dmg;
-    mon.attackCooldown = mon.atkCooldownTime;
+    mon.attackCooldown = mon.def->atkCooldown;
     bool killed = summon.hp <= 0;
 
     if (killed) {
@@ -1846,7 +2180,7 @@ void GameWorld::processSummonTargeting(
     GridPoint end{summon.gridX, summon.gridY};
 
     // Target adjacent cell to the summon (for melee)
-    if (mon.attackRange <= 1) {
+    if (mon.def->attackRange <= 1) {
       int bestAdjDist = 999;
       for (int dy = -1; dy <= 1; dy++) {
         for (int dx = -1; dx <= 1; dx++) {
@@ -1894,6 +2228,105 @@ MonsterInstance *GameWorld::FindMonster(uint16_t index) {
   return nullptr;
 }
 
+// ─── Spatial queries ─────────────────────────────────────────────────────────
+
+static int SpatialBucketCoord(float v, float bucketSize, int dim) {
+  int b = static_cast<int>(v / bucketSize);
+  return std::max(0, std::min(b, dim - 1));
+}
+
+void GameWorld::rebuildSpatialIndex() {
+  const int buckets = SPATIAL_DIM * SPATIAL_DIM;
+  m_spatialStart.assign(buckets + 1, 0);
+  m_spatialSlots.resize(m_monsterInstances.size());
+
+  auto bucketOf = [](const MonsterInstance &mon) {
+    int bx = SpatialBucketCoord(mon.worldX, SPATIAL_BUCKET_SIZE, SPATIAL_DIM);
+    int bz = SpatialBucketCoord(mon.worldZ, SPATIAL_BUCKET_SIZE, SPATIAL_DIM);
+    return bz * SPATIAL_DIM + bx;
+  };
+  for (auto &mon : m_monsterInstances)
+    m_spatialStart[bucketOf(mon) + 1]++;
+  for (int b = 0; b < buckets; b++)
+    m_spatialStart[b + 1] += m_spatialStart[b];
+  std::vector<uint32_t> cursor(m_spatialStart.begin(), m_spatialStart.end() - 1);
+  for (size_t i = 0; i < m_monsterInstances.size(); i++)
+    m_spatialSlots[cursor[bucketOf(m_monsterInstances[i])]++] =
+        static_cast<uint32_t>(i);
+  m_spatialDirty = false;
+}
+
+template <typename Fn>
+void GameWorld::forEachSpatialBucket(float minX, float minZ, float maxX,
+                                     float maxZ, Fn &&fn) {
+  if (m_spatialDirty)
+    rebuildSpatialIndex();
+  int bx0 = SpatialBucketCoord(minX, SPATIAL_BUCKET_SIZE, SPATIAL_DIM);
+  int bx1 = SpatialBucketCoord(maxX, SPATIAL_BUCKET_SIZE, SPATIAL_DIM);
+  int bz0 = SpatialBucketCoord(minZ, SPATIAL_BUCKET_SIZE, SPATIAL_DIM);
+  int bz1 = SpatialBucketCoord(maxZ, SPATIAL_BUCKET_SIZE, SPATIAL_DIM);
+  for (int bz = bz0; bz <= bz1; bz++) {
+    for (int bx = bx0; bx <= bx1; bx++) {
+      int b = bz * SPATIAL_DIM + bx;
+      for (uint32_t i = m_spatialStart[b]; i < m_spatialStart[b + 1]; i++) {
+        if (!fn(m_monsterInstances[m_spatialSlots[i]]))
+          return;
+      }
+    }
+  }
+}
+
+size_t GameWorld::QueryCircle(float x, float z, float radius,
+                              MonsterInstance **out, size_t capacity,
+                              size_t *dropped) {
+  size_t count = 0, over = 0;
+  float r2 = radius * radius;
+  forEachSpatialBucket(x - radius, z - radius, x + radius, z + radius,
+                       [&](MonsterInstance &mon) {
+                         float dx = mon.worldX - x;
+                         float dz = mon.worldZ - z;
+                         if (dx * dx + dz * dz > r2)
+                           return true;
+                         if (count < capacity)
+                           out[count++] = &mon;
+                         else
+                           over++;
+                         return count < capacity || dropped;
+                       });
+  if (dropped)
+    *dropped = over;
+  return count;
+}
+
+size_t GameWorld::QueryCapsule(float x0, float z0, float x1, float z1,
+                               float radius, MonsterInstance **out,
+                               size_t capacity, size_t *dropped) {
+  size_t count = 0, over = 0;
+  float r2 = radius * radius;
+  float sx = x1 - x0, sz = z1 - z0;
+  float lenSq = sx * sx + sz * sz;
+  forEachSpatialBucket(
+      std::min(x0, x1) - radius, std::min(z0, z1) - radius,
+      std::max(x0, x1) + radius, std::max(z0, z1) + radius,
+      [&](MonsterInstance &mon) {
+        float mx = mon.worldX - x0, mz = mon.worldZ - z0;
+        float t = lenSq > 0.0f ? (mx * sx + mz * sz) / lenSq : 0.0f;
+        t = std::max(0.0f, std::min(t, 1.0f));
+        float nx = x0 + sx * t - mon.worldX;
+        float nz = z0 + sz * t - mon.worldZ;
+        if (nx * nx + nz * nz > r2)
+          return true;
+        if (count < capacity)
+          out[count++] = &mon;
+        else
+          over++;
+        return count < capacity || dropped;
+      });
+  if (dropped)
+    *dropped = over;
+  return count;
+}
+
 // ─── Summon Spawn / Despawn ──────────────────────────────────────────────────
 
 MonsterInstance *GameWorld::SpawnSummon(uint16_t type, uint8_t gridX,
@@ -1918,6 +2351,7 @@ MonsterInstance *GameWorld::SpawnSummon(uint16_t type, uint8_t gridX,
   mon.aggressive = false; // Summons don't self-aggro, AI handles targeting
 
   const MonsterTypeDef *def = FindMonsterTypeDef(type);
+  mon.def = def ? def : &s_fallbackMonsterDef;
   if (def) {
     mon.hp = def->hp;
     mon.maxHp = def->hp;
@@ -1927,11 +2361,7 @@ MonsterInstance *GameWorld::SpawnSummon(uint16_t type, uint8_t gridX,
     mon.attackMax = def->attackMax;
     mon.attackRate = def->attackRate;
     mon.level = def->level;
-    mon.atkCooldownTime = def->atkCooldown;
     mon.moveDelay = def->moveDelay;
-    mon.moveRange = def->moveRange;
-    mon.viewRange = def->viewRange;
-    mon.attackRange = def->attackRange;
   } else {
     // Fallback — use the type's known HP from summon table
     mon.hp = 100;
@@ -1963,6 +2393,7 @@ MonsterInstance *GameWorld::SpawnSummon(uint16_t type, uint8_t gridX,
 
   setOccupied(gridX, gridY, true);
   m_monsterInstances.push_back(mon);
+  m_spatialDirty = true;
 
 
   return &m_monsterInstances.back();
@@ -1974,6 +2405,7 @@ void GameWorld::DespawnSummon(uint16_t summonIndex) {
     if (it->index == summonIndex && it->isSummon()) {
       setOccupied(it->gridX, it->gridY, false);
       m_monsterInstances.erase(it);
+      m_spatialDirty = true;
       return;
     }
   }
@@ -1984,6 +2416,7 @@ void GameWorld::DespawnSummonsForOwner(int ownerFd) {
     if (it->isSummon() && it->ownerFd == ownerFd) {
       setOccupied(it->gridX, it->gridY, false);
       it = m_monsterInstances.erase(it);
+      m_spatialDirty = true;
     } else {
       ++it;
     }
@@ -0,0 +1,390 @@
+#include "Gateway.hpp"
+#include "PacketDefs.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static volatile bool g_sigint = false;
+static void sigHandler(int) { g_sigint = true; }
+
+static void setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static void setNoDelay(int fd) {
+  int tcpNoDelay = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &tcpNoDelay, sizeof(tcpNoDelay));
+}
+
+static uint8_t headcodeOf(const std::vector<uint8_t> &packet) {
+  size_t at = (packet[0] == 0xC2 || packet[0] == 0xC4) ? 3 : 2;
+  return packet.size() > at ? packet[at] : 0;
+}
+
+bool Gateway::SetSecret(const std::string &secret) {
+  if (secret.size() < 16 || secret.size() > sizeof(m_key))
+    return false;
+  memset(m_key, 0, sizeof(m_key));
+  memcpy(m_key, secret.data(), secret.size());
+  return true;
+}
+
+bool Gateway::Start(uint16_t port, std::vector<Backend> backends) {
+  if (backends.empty()) {
+    printf("[Gateway] No backends configured\n");
+    return false;
+  }
+  for (auto &b : backends) {
+    struct addrinfo hints{}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    std::string service = std::to_string(b.port);
+    if (getaddrinfo(b.host.c_str(), service.c_str(), &hints, &res) != 0 ||
+        !res) {
+      printf("[Gateway] Can't resolve backend %s\n", b.host.c_str());
+      return false;
+    }
+    memcpy(&b.addr, res->ai_addr, sizeof(b.addr));
+    freeaddrinfo(res);
+    printf("[Gateway] Map %d -> %s:%d%s\n", b.mapId, b.host.c_str(), b.port,
+           &b == &backends[0] ? " (lobby)" : "");
+  }
+  m_backends = std::move(backends);
+
+  m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (m_listenFd < 0) {
+    perror("[Gateway] socket");
+    return false;
+  }
+  int opt = 1;
+  setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+  setNonBlocking(m_listenFd);
+
+  struct sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_port = htons(port);
+  if (bind(m_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(m_listenFd, 64) < 0) {
+    perror("[Gateway] bind/listen");
+    close(m_listenFd);
+    m_listenFd = -1;
+    return false;
+  }
+
+  printf("[Gateway] Listening on port %d, %zu backend(s)\n", port,
+         m_backends.size());
+  m_running = true;
+  return true;
+}
+
+void Gateway::Stop() {
+  m_running = false;
+  while (!m_clients.empty())
+    CloseClient(m_clients.begin()->first);
+  if (m_listenFd >= 0) {
+    close(m_listenFd);
+    m_listenFd = -1;
+  }
+}
+
+void Gateway::Run() {
+  signal(SIGINT, sigHandler);
+  signal(SIGPIPE, SIG_IGN);
+
+  // pollfd index -> (client fd, is backend side)
+  std::vector<struct pollfd> fds;
+  std::vector<std::pair<int, bool>> owners;
+  std::vector<std::vector<uint8_t>> packets;
+
+  while (m_running && !g_sigint) {
+    fds.clear();
+    owners.clear();
+    fds.push_back({m_listenFd, POLLIN, 0});
+    owners.push_back({-1, false});
+    for (auto &entry : m_clients) {
+      Client &c = entry.second;
+      fds.push_back(
+          {c.client.fd,
+           static_cast<short>(POLLIN | (c.client.out.Empty() ? 0 : POLLOUT)),
+           0});
+      owners.push_back({entry.first, false});
+      if (c.backend.fd >= 0) {
+        bool wantOut = c.backend.connecting || !c.backend.out.Empty();
+        fds.push_back({c.backend.fd,
+                       static_cast<short>(POLLIN | (wantOut ? POLLOUT : 0)),
+                       0});
+        owners.push_back({entry.first, true});
+      }
+    }
+
+    int ret = poll(fds.data(), static_cast<nfds_t>(fds.size()), 100);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("[Gateway] poll");
+      break;
+    }
+
+    for (size_t i = 1; i < fds.size(); i++) {
+      if (!fds[i].revents)
+        continue;
+      auto it = m_clients.find(owners[i].first);
+      if (it == m_clients.end())
+        continue; // Closed earlier in this pass
+      Client &c = it->second;
+      bool backendSide = owners[i].second;
+      Link &link = backendSide ? c.backend : c.client;
+      if (link.fd != fds[i].fd)
+        continue; // Backend link replaced by a migration in this pass
+
+      if (backendSide && link.connecting &&
+          (fds[i].revents & (POLLOUT | POLLERR | POLLHUP))) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(link.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err != 0) {
+          printf("[Gateway] Backend for map %d unreachable: %s\n",
+                 m_backends[c.backendIndex].mapId, strerror(err));
+          CloseClient(owners[i].first);
+          continue;
+        }
+        link.connecting = false;
+      }
+
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+        packets.clear();
+        bool open = ReadLink(link, packets);
+        for (const auto &packet : packets) {
+          if (!backendSide) {
+            OnClientPacket(c, packet);
+          } else if (!OnBackendPacket(c, packet)) {
+            break;
+          }
+        }
+        if (!open && link.fd == fds[i].fd) {
+          CloseClient(owners[i].first);
+          continue;
+        }
+      }
+    }
+
+    if (fds[0].revents & POLLIN)
+      AcceptClients();
+
+    // Flush everything that was queued this pass
+    std::vector<int> dead;
+    for (auto &entry : m_clients) {
+      Client &c = entry.second;
+      bool ok = c.client.out.Empty() || c.client.out.Flush(c.client.fd);
+      if (ok && c.backend.fd >= 0 && !c.backend.connecting &&
+          !c.backend.out.Empty())
+        ok = c.backend.out.Flush(c.backend.fd);
+      if (!ok)
+        dead.push_back(entry.first);
+    }
+    for (int fd : dead)
+      CloseClient(fd);
+  }
+  printf("[Gateway] Shutting down (%zu client(s), %llu migration(s))\n",
+         m_clients.size(), (unsigned long long)m_migrations);
+}
+
+void Gateway::AcceptClients() {
+  while (true) {
+    struct sockaddr_in clientAddr{};
+    socklen_t addrLen = sizeof(clientAddr);
+    int fd =
+        accept(m_listenFd, reinterpret_cast<sockaddr *>(&clientAddr), &addrLen);
+    if (fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        perror("[Gateway] accept");
+      return;
+    }
+    setNonBlocking(fd);
+    setNoDelay(fd);
+
+    char ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &clientAddr.sin_addr, ip, sizeof(ip));
+    printf("[Gateway] New client from %s:%d (fd=%d)\n", ip,
+           ntohs(clientAddr.sin_port), fd);
+
+    Client &c = m_clients[fd];
+    c.client.fd = fd;
+    if (!ConnectBackend(c, 0))
+      CloseClient(fd);
+  }
+}
+
+bool Gateway::ConnectBackend(Client &c, int backendIndex) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    perror("[Gateway] socket");
+    return false;
+  }
+  setNonBlocking(fd);
+  setNoDelay(fd);
+  const Backend &b = m_backends[backendIndex];
+  if (connect(fd, reinterpret_cast<const sockaddr *>(&b.addr),
+              sizeof(b.addr)) < 0 &&
+      errno != EINPROGRESS) {
+    printf("[Gateway] Connect to map %d backend failed: %s\n", b.mapId,
+           strerror(errno));
+    close(fd);
+    return false;
+  }
+  c.backend = Link{};
+  c.backend.fd = fd;
+  c.backend.connecting = true; // Output is queued until it completes
+  c.backendIndex = backendIndex;
+  m_backendFds[fd] = c.client.fd;
+  return true;
+}
+
+void Gateway::OnClientPacket(Client &c, const std::vector<uint8_t> &packet) {
+  // Only the gateway may speak for a session
+  if (headcodeOf(packet) == Opcode::GATEWAY)
+    return;
+  if (!Forward(c.backend, packet))
+    CloseClient(c.client.fd);
+}
+
+bool Gateway::OnBackendPacket(Client &c, const std::vector<uint8_t> &packet) {
+  if (headcodeOf(packet) == Opcode::GATEWAY) {
+    size_t subAt = (packet[0] == 0xC2 || packet[0] == 0xC4) ? 4 : 3;
+    uint8_t subcode = packet.size() > subAt ? packet[subAt] : 0xFF;
+    if (subcode == Opcode::SUB_GATEWAY_RESUMED) {
+      c.resuming = false;
+    } else if (subcode == Opcode::SUB_GATEWAY_MIGRATE &&
+               packet.size() >= sizeof(PMSG_GATEWAY_MIGRATE_HEAD)) {
+      Migrate(c, packet);
+      return false;
+    }
+    return true;
+  }
+  if (c.resuming)
+    return true; // Fresh-connection greeting from the new backend
+  if (!Forward(c.client, packet)) {
+    printf("[Gateway] Client fd=%d not reading, disconnecting\n", c.client.fd);
+    CloseClient(c.client.fd);
+    return false;
+  }
+  return true;
+}
+
+void Gateway::Migrate(Client &c, std::vector<uint8_t> packet) {
+  PMSG_GATEWAY_MIGRATE_HEAD head;
+  memcpy(&head, packet.data(), sizeof(head));
+  int target = BackendForMap(head.mapId);
+  int clientFd = c.client.fd;
+  if (target < 0) {
+    printf("[Gateway] No backend hosts map %d, disconnecting fd=%d\n",
+           head.mapId, clientFd);
+    CloseClient(clientFd);
+    return;
+  }
+
+  // The old backend already saved the character and let go of it
+  int from = c.backendIndex;
+  CloseBackend(c);
+  if (!ConnectBackend(c, target)) {
+    CloseClient(clientFd);
+    return;
+  }
+  packet[offsetof(PMSG_GATEWAY_MIGRATE_HEAD, subcode)] =
+      Opcode::SUB_GATEWAY_RESUME;
+  memcpy(packet.data() + offsetof(PMSG_GATEWAY_MIGRATE_HEAD, key), m_key,
+         sizeof(m_key));
+  c.resuming = true;
+  Forward(c.backend, packet);
+  m_migrations++;
+  printf("[Gateway] fd=%d migrating map %d backend -> map %d backend\n",
+         clientFd, m_backends[from].mapId, head.mapId);
+}
+
+bool Gateway::ReadLink(Link &link, std::vector<std::vector<uint8_t>> &packets) {
+  bool open = true;
+  uint8_t tmp[16384];
+  for (int i = 0; i < 4; i++) {
+    ssize_t n = recv(link.fd, tmp, sizeof(tmp), 0);
+    if (n > 0) {
+      link.recvBuf.insert(link.recvBuf.end(), tmp, tmp + n);
+      if (static_cast<size_t>(n) < sizeof(tmp))
+        break;
+      continue;
+    }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+      open = false;
+    break;
+  }
+
+  // Same framing as IoReactor::ExtractPackets
+  auto &buf = link.recvBuf;
+  size_t pos = 0;
+  while (buf.size() - pos >= 2) {
+    uint8_t type = buf[pos];
+    size_t packetSize = 0;
+    if (type == 0xC1 || type == 0xC3) {
+      packetSize = buf[pos + 1];
+    } else if (type == 0xC2 || type == 0xC4) {
+      if (buf.size() - pos < 3)
+        break;
+      packetSize = (static_cast<size_t>(buf[pos + 1]) << 8) | buf[pos + 2];
+    } else {
+      pos++; // Invalid packet type, skip byte
+      continue;
+    }
+    if (packetSize < 3) {
+      open = false;
+      break;
+    }
+    if (buf.size() - pos < packetSize)
+      break;
+    packets.emplace_back(buf.begin() + pos, buf.begin() + pos + packetSize);
+    pos += packetSize;
+  }
+  if (pos > 0)
+    buf.erase(buf.begin(), buf.begin() + pos);
+  return open;
+}
+
+bool Gateway::Forward(Link &link, const std::vector<uint8_t> &packet) {
+  return link.fd >= 0 && link.out.Push(packet.data(), packet.size());
+}
+
+void Gateway::CloseBackend(Client &c) {
+  if (c.backend.fd < 0)
+    return;
+  m_backendFds.erase(c.backend.fd);
+  close(c.backend.fd);
+  c.backend = Link{};
+  c.backendIndex = -1;
+}
+
+void Gateway::CloseClient(int clientFd) {
+  auto it = m_clients.find(clientFd);
+  if (it == m_clients.end())
+    return;
+  CloseBackend(it->second);
+  close(clientFd);
+  m_clients.erase(it);
+  printf("[Gateway] Client fd=%d disconnected\n", clientFd);
+}
+
+int Gateway::BackendForMap(uint8_t mapId) const {
+  for (size_t i = 0; i < m_backends.size(); i++) {
+    if (m_backends[i].mapId == mapId)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
@@ -0,0 +1,295 @@
+#include "Handoff.hpp"
+#include "GameWorld.hpp"
+#include "Session.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Handoff {
+
+// ─── Session state ─────────────────────────────────────────────────────
+
+// Every trivially copyable Session field, in blob order. Read and write both
+// walk this list, so a field added here can't get out of sync between them.
+template <typename S, typename Fn> static void forEachPodField(S &s, Fn &&f) {
+  f(s.accountId);
+  f(s.characterId);
+  f(s.charClass);
+  f(s.inWorld);
+  f(s.inCharSelect);
+  f(s.strength);
+  f(s.energy);
+  f(s.classCode);
+  f(s.weaponDamageMin);
+  f(s.weaponDamageMax);
+  f(s.minMagicDamage);
+  f(s.maxMagicDamage);
+  f(s.staffRisePercent);
+  f(s.attackSpeed);
+  f(s.attackRate);
+  f(s.defenseRate);
+  f(s.totalDefense);
+  f(s.hasBow);
+  f(s.hasTwoHandedWeapon);
+  f(s.petBonusMaxHp);
+  f(s.petDamageReduction);
+  f(s.petAttackMultiplier);
+  f(s.hp);
+  f(s.maxHp);
+  f(s.mana);
+  f(s.maxMana);
+  f(s.ag);
+  f(s.maxAg);
+  f(s.dead);
+  f(s.statsDirty);
+  f(s.statsSent);
+  f(s.dexterity);
+  f(s.vitality);
+  f(s.level);
+  f(s.levelUpPoints);
+  f(s.experience);
+  f(s.equipment);
+  f(s.bag);
+  f(s.zen);
+  f(s.worldX);
+  f(s.worldZ);
+  f(s.movePathX);
+  f(s.movePathY);
+  f(s.movePathLen);
+  f(s.movePathStep);
+  f(s.correctionAllowance);
+  f(s.mapId);
+  f(s.gateTransitionCooldown);
+  f(s.pendingViewportDelay);
+  f(s.potionCooldown);
+  f(s.hpRemainder);
+  f(s.idleHpRemainder);
+  f(s.idleTimer);
+  f(s.manaRemainder);
+  f(s.skillBar);
+  f(s.potionBar);
+  f(s.rmcSkillId);
+  f(s.shopNpcType);
+  f(s.agRegenTimer);
+  f(s.lastAgUseTime); // steady_clock ms: shared by processes on one host
+  f(s.attackCooldown);
+  f(s.poisoned);
+  f(s.poisonTickTimer);
+  f(s.poisonDuration);
+  f(s.activeSummonIndex);
+  f(s.activeSummonType);
+  f(s.cameraZoom);
+  f(s.attackTargetMonsterIdx);
+  f(s.wasInSafeZone);
+  f(s.buffs);
+  f(s.completedQuestMask);
+  f(s.rateTokens);
+  f(s.packetsDeferred);
+  f(s.handlerUsTotal);
+  f(s.compressC2);
+}
+
+void WriteSession(Writer &out, const Session &session) {
+  forEachPodField(session, [&out](const auto &field) { out.Put(field); });
+  out.PutString(session.characterName);
+  out.PutVector(session.learnedSkills);
+  out.PutVector(session.activeQuests);
+  out.Put<uint32_t>(static_cast<uint32_t>(session.deferredPackets.size()));
+  for (const auto &packet : session.deferredPackets)
+    out.PutBlob(packet);
+}
+
+bool ReadSession(Reader &in, Session &session) {
+  forEachPodField(session, [&in](auto &field) { in.Get(field); });
+  in.GetString(session.characterName);
+  in.GetVector(session.learnedSkills);
+  in.GetVector(session.activeQuests);
+  uint32_t deferred = 0;
+  in.Get(deferred);
+  for (uint32_t i = 0; i < deferred && in.Ok(); i++) {
+    std::vector<uint8_t> packet;
+    if (in.GetBlob(packet))
+      session.deferredPackets.push_back(std::move(packet));
+  }
+  return in.Ok();
+}
+
+uint64_t LayoutKey() {
+  // FNV-1a over record sizes: catches most layout changes between builds
+  uint64_t key = 14695981039346656037ull;
+  auto mix = [&key](uint64_t v) {
+    key ^= v;
+    key *= 1099511628211ull;
+  };
+  mix(sizeof(GridPoint));
+  mix(sizeof(Session::ActiveQuest));
+  Session probe(-1);
+  size_t podFields = 0, podBytes = 0;
+  forEachPodField(probe, [&](const auto &field) {
+    podFields++;
+    podBytes += sizeof(field);
+  });
+  mix(podFields);
+  mix(podBytes);
+  size_t worldFields = 0, worldBytes = 0;
+  GameWorld::StateLayout(worldFields, worldBytes);
+  mix(worldFields);
+  mix(worldBytes);
+  return key;
+}
+
+// ─── Control socket ────────────────────────────────────────────────────
+
+static bool makeAddress(const std::string &path, sockaddr_un &addr) {
+  addr = {};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    printf("[Handoff] Socket path too long: %s\n", path.c_str());
+    return false;
+  }
+  memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  return true;
+}
+
+int Listen(const std::string &path) {
+  sockaddr_un addr;
+  if (!makeAddress(path, addr))
+    return -1;
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    perror("[Handoff] socket");
+    return -1;
+  }
+  unlink(path.c_str()); // Stale file from a previous process
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(fd, 1) < 0) {
+    perror("[Handoff] bind/listen");
+    close(fd);
+    return -1;
+  }
+  int flags = fcntl(fd, F_GETFL, 0);
+  fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  return fd;
+}
+
+int Connect(const std::string &path) {
+  sockaddr_un addr;
+  if (!makeAddress(path, addr))
+    return -1;
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return -1;
+  if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+    close(fd); // ENOENT / ECONNREFUSED: no server running
+    return -1;
+  }
+  return fd;
+}
+
+void SetTimeout(int sock, int seconds) {
+  struct timeval tv{};
+  tv.tv_sec = seconds;
+  setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool SendAll(int sock, const void *data, size_t len) {
+  const auto *p = static_cast<const uint8_t *>(data);
+  while (len > 0) {
+    ssize_t n = send(sock, p, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    p += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+bool RecvAll(int sock, void *data, size_t len) {
+  auto *p = static_cast<uint8_t *>(data);
+  while (len > 0) {
+    ssize_t n = recv(sock, p, len, 0);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    p += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+// Descriptors go in batches (the kernel caps SCM_RIGHTS at 253 per message),
+// each carried by a one-word payload holding the batch size
+static constexpr size_t FD_BATCH = 128;
+
+bool SendFds(int sock, const std::vector<int> &fds) {
+  for (size_t pos = 0; pos < fds.size(); pos += FD_BATCH) {
+    uint32_t count = static_cast<uint32_t>(std::min(FD_BATCH, fds.size() - pos));
+    std::vector<uint8_t> control(CMSG_SPACE(count * sizeof(int)));
+    struct iovec iov = {&count, sizeof(count)};
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = control.size();
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(count * sizeof(int));
+    memcpy(CMSG_DATA(cmsg), fds.data() + pos, count * sizeof(int));
+
+    ssize_t n;
+    do {
+      n = sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    if (n != static_cast<ssize_t>(sizeof(count)))
+      return false;
+  }
+  return true;
+}
+
+bool RecvFds(int sock, size_t count, std::vector<int> &out) {
+  while (out.size() < count) {
+    uint32_t batch = 0;
+    std::vector<uint8_t> control(CMSG_SPACE(FD_BATCH * sizeof(int)));
+    struct iovec iov = {&batch, sizeof(batch)};
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = control.size();
+
+    ssize_t n;
+    do {
+      n = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+    if (n != static_cast<ssize_t>(sizeof(batch)))
+      return false;
+
+    size_t received = 0;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+        continue;
+      size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      for (size_t i = 0; i < n; i++) {
+        int fd;
+        memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+        out.push_back(fd);
+      }
+      received += n;
+    }
+    if (received != batch || (msg.msg_flags & MSG_CTRUNC))
+      return false;
+  }
+  return out.size() == count;
+}
+
+} // namespace Handoff
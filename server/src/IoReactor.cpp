@@ -0,0 +1,419 @@
+#include "IoReactor.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static void setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static void drainPipe(int fd) {
+  uint8_t tmp[64];
+  while (read(fd, tmp, sizeof(tmp)) > 0) {
+  }
+}
+
+IoReactor::IoReactor(int index, int listenFd, int gameWakeFd)
+    : m_index(index), m_listenFd(listenFd), m_gameWakeFd(gameWakeFd) {}
+
+IoReactor::~IoReactor() { Stop(); }
+
+bool IoReactor::Start() {
+  if (pipe(m_wakePipe) < 0) {
+    perror("[Io] pipe");
+    return false;
+  }
+  setNonBlocking(m_wakePipe[0]);
+  setNonBlocking(m_wakePipe[1]);
+
+  m_running.store(true, std::memory_order_release);
+  m_thread = std::thread(&IoReactor::ThreadMain, this);
+  return true;
+}
+
+void IoReactor::Join() {
+  if (m_thread.joinable()) {
+    m_running.store(false, std::memory_order_release);
+    Wake();
+    m_thread.join();
+  }
+}
+
+void IoReactor::Stop() {
+  Join();
+  for (auto &entry : m_conns)
+    CloseConnection(entry.second);
+  m_conns.clear();
+  for (int &fd : m_wakePipe) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+}
+
+void IoReactor::Adopt(IoHandoffConn &&handoff) {
+  setNonBlocking(handoff.fd);
+  Connection &conn = m_conns[handoff.fd];
+  conn = Connection{};
+  conn.fd = handoff.fd;
+  conn.open = handoff.open;
+  conn.recvBuf = std::move(handoff.input); // Framed when the thread starts
+  if (!handoff.output.empty())
+    conn.sendQueue.Push(handoff.output.data(), handoff.output.size());
+}
+
+std::vector<IoHandoffConn> IoReactor::Detach(std::vector<IoCommand> &pending) {
+  Join(); // Everything below is now owned by this (the game) thread
+
+  // Packets the game never saw go back in front of the partial input
+  std::unordered_map<int, std::vector<uint8_t>> unhandled;
+  auto takeEvent = [&](IoEvent &ev) {
+    if (ev.type == IoEvent::PACKET) {
+      auto &buf = unhandled[ev.fd];
+      buf.insert(buf.end(), ev.data.begin(), ev.data.end());
+    }
+  };
+  IoEvent ev;
+  while (m_inbound.TryPop(ev))
+    takeEvent(ev);
+  for (auto &backlogged : m_eventBacklog)
+    takeEvent(backlogged);
+  m_eventBacklog.clear();
+
+  IoCommand cmd;
+  while (m_outbound.TryPop(cmd))
+    ApplyCommand(cmd);
+  for (auto &p : pending)
+    ApplyCommand(p);
+  pending.clear();
+
+  std::vector<IoHandoffConn> out;
+  // Closed connections go along too: their fd stays reserved until the game
+  // releases the session, wherever that ends up happening
+  for (auto &entry : m_conns) {
+    Connection &conn = entry.second;
+    IoHandoffConn handoff;
+    handoff.fd = conn.fd;
+    handoff.open = conn.open;
+    handoff.input = std::move(unhandled[conn.fd]);
+    handoff.input.insert(handoff.input.end(), conn.recvBuf.begin(),
+                         conn.recvBuf.end());
+    handoff.output = conn.sendQueue.TakePending();
+    out.push_back(std::move(handoff));
+  }
+  m_conns.clear();
+  for (int &fd : m_wakePipe) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+  return out;
+}
+
+void IoReactor::Wake() {
+  uint8_t b = 1;
+  if (m_wakePipe[1] >= 0)
+    (void)write(m_wakePipe[1], &b, 1); // Full pipe = already woken
+}
+
+void IoReactor::ThreadMain() {
+  // Adopted connections may arrive with whole packets already buffered, or
+  // already closed by the peer
+  for (auto &entry : m_conns) {
+    Connection &conn = entry.second;
+    if (conn.open) {
+      ExtractPackets(conn);
+      continue;
+    }
+    IoEvent ev;
+    ev.type = IoEvent::DISCONNECTED;
+    ev.fd = conn.fd;
+    Emit(ev);
+  }
+  FlushEventBacklog();
+
+  std::vector<struct pollfd> fds;
+  while (m_running.load(std::memory_order_acquire)) {
+    // Stop reading (and accepting) while the game thread is behind, so a
+    // flood backs up into the kernel's socket buffers instead of our memory
+    bool backlogged = !m_eventBacklog.empty();
+
+    fds.clear();
+    fds.push_back({m_wakePipe[0], POLLIN, 0});
+    fds.push_back({backlogged ? -1 : m_listenFd, POLLIN, 0});
+    for (auto &entry : m_conns) {
+      Connection &conn = entry.second;
+      if (!conn.open)
+        continue;
+      short events = backlogged ? 0 : POLLIN;
+      if (!conn.sendQueue.Empty())
+        events |= POLLOUT;
+      fds.push_back({conn.fd, events, 0});
+    }
+
+    int ret = poll(fds.data(), static_cast<nfds_t>(fds.size()),
+                   backlogged ? 1 : 100);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("[Io] poll");
+      break;
+    }
+
+    if (fds[0].revents & POLLIN)
+      drainPipe(m_wakePipe[0]);
+
+    // Socket I/O first: revents refer to the fds as they were when polled,
+    // before CLOSE commands or accept() below can recycle an fd number
+    for (size_t i = 2; i < fds.size(); i++) {
+      auto &pfd = fds[i];
+      if (!pfd.revents)
+        continue;
+      auto it = m_conns.find(pfd.fd);
+      if (it == m_conns.end() || !it->second.open)
+        continue;
+      Connection &conn = it->second;
+      if (pfd.revents & (POLLIN | POLLHUP))
+        ReadConnection(conn);
+      if (conn.open && (pfd.revents & (POLLERR | POLLNVAL)))
+        DropConnection(conn);
+      if (conn.open && (pfd.revents & POLLOUT))
+        FlushConnection(conn);
+    }
+
+    ApplyCommands();
+    FlushEventBacklog();
+
+    if (fds[1].revents & POLLIN)
+      AcceptClients();
+
+    ReportQueueMetrics();
+
+    if (m_eventsPushed) {
+      m_eventsPushed = false;
+      uint8_t b = 1;
+      (void)write(m_gameWakeFd, &b, 1);
+    }
+  }
+}
+
+void IoReactor::AcceptClients() {
+  // The listen socket is shared: other reactors may win the race (EAGAIN)
+  while (true) {
+    struct sockaddr_in clientAddr{};
+    socklen_t addrLen = sizeof(clientAddr);
+    int clientFd =
+        accept(m_listenFd, reinterpret_cast<sockaddr *>(&clientAddr), &addrLen);
+    if (clientFd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        perror("[Io] accept");
+      break;
+    }
+
+    setNonBlocking(clientFd);
+
+    // Disable Nagle's algorithm for low latency
+    int tcpNoDelay = 1;
+    setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &tcpNoDelay,
+               sizeof(tcpNoDelay));
+
+    char ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &clientAddr.sin_addr, ip, sizeof(ip));
+    printf("[Io %d] New client from %s:%d (fd=%d)\n", m_index, ip,
+           ntohs(clientAddr.sin_port), clientFd);
+
+    Connection &conn = m_conns[clientFd];
+    conn = Connection{};
+    conn.fd = clientFd;
+    conn.recvBuf.reserve(4096);
+
+    IoEvent ev;
+    ev.type = IoEvent::CONNECTED;
+    ev.fd = clientFd;
+    Emit(ev);
+  }
+}
+
+void IoReactor::ReadConnection(Connection &conn) {
+  // A few reads per wakeup, so one busy client can't starve the others
+  uint8_t tmp[16384];
+  for (int i = 0; i < 4; i++) {
+    ssize_t n = recv(conn.fd, tmp, sizeof(tmp), 0);
+    if (n > 0) {
+      conn.recvBuf.insert(conn.recvBuf.end(), tmp, tmp + n);
+      if (static_cast<size_t>(n) < sizeof(tmp))
+        break;
+      continue;
+    }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      ExtractPackets(conn); // Deliver whatever arrived before the close
+      DropConnection(conn);
+      return;
+    }
+    break;
+  }
+  ExtractPackets(conn);
+}
+
+void IoReactor::ExtractPackets(Connection &conn) {
+  auto &buf = conn.recvBuf;
+  size_t pos = 0;
+  while (buf.size() - pos >= 2) {
+    uint8_t type = buf[pos];
+    size_t packetSize = 0;
+
+    if (type == 0xC1 || type == 0xC3) {
+      // C1/C3: size in byte 1
+      packetSize = buf[pos + 1];
+    } else if (type == 0xC2 || type == 0xC4) {
+      // C2/C4: size in bytes 1-2 (big-endian)
+      if (buf.size() - pos < 3)
+        break;
+      packetSize = (static_cast<size_t>(buf[pos + 1]) << 8) | buf[pos + 2];
+    } else {
+      // Invalid packet type — skip byte
+      printf("[Io %d] Invalid packet type 0x%02X, skipping\n", m_index, type);
+      pos++;
+      continue;
+    }
+
+    if (packetSize < 2) {
+      printf("[Io %d] Invalid packet size %zu, disconnecting fd=%d\n", m_index,
+             packetSize, conn.fd);
+      DropConnection(conn);
+      return;
+    }
+
+    if (buf.size() - pos < packetSize)
+      break; // Incomplete packet
+
+    IoEvent ev;
+    ev.type = IoEvent::PACKET;
+    ev.fd = conn.fd;
+    ev.data.assign(buf.begin() + pos, buf.begin() + pos + packetSize);
+    Emit(ev);
+    pos += packetSize;
+  }
+  if (pos > 0)
+    buf.erase(buf.begin(), buf.begin() + pos);
+}
+
+void IoReactor::FlushConnection(Connection &conn) {
+  if (!conn.sendQueue.Flush(conn.fd))
+    DropConnection(conn);
+}
+
+void IoReactor::CloseConnection(Connection &conn) {
+  const SendQueue &q = conn.sendQueue;
+  if (q.PeakDepth() > SendQueue::SOFT_LIMIT || q.Superseded() > 0)
+    printf("[Io %d] fd=%d send queue: peak %.1f KiB, %llu update(s) "
+           "superseded (%.1f KiB)\n",
+           m_index, conn.fd, q.PeakDepth() / 1024.0,
+           (unsigned long long)q.Superseded(), q.SupersededBytes() / 1024.0);
+  close(conn.fd);
+}
+
+void IoReactor::ReportQueueMetrics() {
+  static constexpr int64_t REPORT_INTERVAL_MS = 10000;
+  int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+  if (nowMs - m_lastReportMs < REPORT_INTERVAL_MS)
+    return;
+  m_lastReportMs = nowMs;
+
+  size_t queued = 0, maxDepth = 0;
+  int maxFd = -1;
+  uint64_t superseded = 0;
+  for (auto &entry : m_conns) {
+    const SendQueue &q = entry.second.sendQueue;
+    queued += q.Depth();
+    superseded += q.Superseded();
+    if (q.Depth() > maxDepth) {
+      maxDepth = q.Depth();
+      maxFd = entry.first;
+    }
+  }
+  // Quiet unless some client is actually falling behind
+  if (maxDepth <= SendQueue::SOFT_LIMIT && superseded == m_lastReportSuperseded)
+    return;
+  printf("[Io %d] Send queues: %zu conn(s), %.1f KiB queued, max %.1f KiB "
+         "(fd=%d), %llu superseded, %llu slow disconnect(s)\n",
+         m_index, m_conns.size(), queued / 1024.0, maxDepth / 1024.0, maxFd,
+         (unsigned long long)superseded, (unsigned long long)m_slowDisconnects);
+  m_lastReportSuperseded = superseded;
+}
+
+void IoReactor::DropConnection(Connection &conn) {
+  if (!conn.open)
+    return;
+  conn.open = false;
+  conn.recvBuf = {};
+
+  IoEvent ev;
+  ev.type = IoEvent::DISCONNECTED;
+  ev.fd = conn.fd;
+  Emit(ev);
+}
+
+void IoReactor::ApplyCommands() {
+  IoCommand cmd;
+  while (m_outbound.TryPop(cmd))
+    ApplyCommand(cmd);
+}
+
+void IoReactor::ApplyCommand(IoCommand &cmd) {
+  auto it = m_conns.find(cmd.fd);
+  if (it == m_conns.end())
+    return;
+  Connection &conn = it->second;
+
+  if (cmd.type == IoCommand::CLOSE) {
+    CloseConnection(conn);
+    m_conns.erase(it);
+    return;
+  }
+
+  if (!conn.open)
+    return; // Peer already gone, drop the output
+  if (!conn.sendQueue.Push(cmd.data.data(), cmd.data.size())) {
+    printf("[Io %d] fd=%d not reading, %.1f KiB queued (limit %zu KiB), "
+           "disconnecting\n",
+           m_index, conn.fd, conn.sendQueue.Depth() / 1024.0,
+           SendQueue::CAPACITY / 1024);
+    m_slowDisconnects++;
+    DropConnection(conn);
+    return;
+  }
+  FlushConnection(conn);
+}
+
+void IoReactor::Emit(IoEvent &ev) {
+  // Keep ordering: once anything is backlogged, everything queues behind it
+  if (!m_eventBacklog.empty() || !m_inbound.TryPush(ev))
+    m_eventBacklog.push_back(std::move(ev));
+  else
+    m_eventsPushed = true;
+}
+
+void IoReactor::FlushEventBacklog() {
+  size_t pushed = 0;
+  while (pushed < m_eventBacklog.size() &&
+         m_inbound.TryPush(m_eventBacklog[pushed]))
+    pushed++;
+  if (pushed > 0) {
+    m_eventBacklog.erase(m_eventBacklog.begin(),
+                         m_eventBacklog.begin() + pushed);
+    m_eventsPushed = true;
+  }
+}
@@ -0,0 +1,182 @@
+#include "PacketCompression.hpp"
+#include "PacketDefs.hpp"
+#include <chrono>
+#include <cstring>
+
+namespace PacketCompression {
+
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t MAX_OFFSET = 0xFFFF;
+static constexpr int HASH_BITS = 12;
+
+static Stats s_stats;
+
+static uint32_t read32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint32_t hash4(uint32_t v) {
+  return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Extension bytes for a length whose token nibble is 15
+static bool putLength(size_t len, uint8_t *&op, const uint8_t *end) {
+  len -= 15;
+  while (len >= 255) {
+    if (op >= end)
+      return false;
+    *op++ = 255;
+    len -= 255;
+  }
+  if (op >= end)
+    return false;
+  *op++ = static_cast<uint8_t>(len);
+  return true;
+}
+
+static bool getLength(const uint8_t *in, size_t len, size_t &ip,
+                      size_t &value) {
+  uint8_t b;
+  do {
+    if (ip >= len)
+      return false;
+    b = in[ip++];
+    value += b;
+  } while (b == 255);
+  return true;
+}
+
+// One sequence; matchLen 0 = the final literals-only sequence
+static bool emitSequence(const uint8_t *lit, size_t litLen, size_t offset,
+                         size_t matchLen, uint8_t *&op, const uint8_t *end) {
+  if (op >= end)
+    return false;
+  uint8_t *token = op++;
+  *token = static_cast<uint8_t>((litLen < 15 ? litLen : 15) << 4);
+  if (litLen >= 15 && !putLength(litLen, op, end))
+    return false;
+  if (static_cast<size_t>(end - op) < litLen)
+    return false;
+  memcpy(op, lit, litLen);
+  op += litLen;
+  if (matchLen == 0)
+    return true;
+
+  if (end - op < 2)
+    return false;
+  *op++ = static_cast<uint8_t>(offset);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  size_t ml = matchLen - MIN_MATCH;
+  *token |= static_cast<uint8_t>(ml < 15 ? ml : 15);
+  return ml < 15 || putLength(ml, op, end);
+}
+
+size_t LzCompress(const uint8_t *in, size_t len, uint8_t *out, size_t cap) {
+  uint32_t table[1 << HASH_BITS] = {}; // Position + 1, 0 = empty
+  uint8_t *op = out;
+  const uint8_t *end = out + cap;
+  size_t anchor = 0, ip = 0;
+
+  while (ip + MIN_MATCH <= len) {
+    uint32_t seq = read32(in + ip);
+    uint32_t h = hash4(seq);
+    size_t cand = table[h];
+    table[h] = static_cast<uint32_t>(ip + 1);
+    if (cand == 0 || ip - (cand - 1) > MAX_OFFSET ||
+        read32(in + cand - 1) != seq) {
+      ip++;
+      continue;
+    }
+    size_t ref = cand - 1;
+    size_t matchLen = MIN_MATCH;
+    while (ip + matchLen < len && in[ref + matchLen] == in[ip + matchLen])
+      matchLen++;
+    if (!emitSequence(in + anchor, ip - anchor, ip - ref, matchLen, op, end))
+      return 0;
+    ip += matchLen;
+    anchor = ip;
+  }
+  if (!emitSequence(in + anchor, len - anchor, 0, 0, op, end))
+    return 0;
+  return static_cast<size_t>(op - out);
+}
+
+bool LzDecompress(const uint8_t *in, size_t len, uint8_t *out, size_t outLen) {
+  size_t ip = 0, op = 0;
+  while (ip < len) {
+    uint8_t token = in[ip++];
+    size_t litLen = token >> 4;
+    if (litLen == 15 && !getLength(in, len, ip, litLen))
+      return false;
+    if (litLen > len - ip || litLen > outLen - op)
+      return false;
+    memcpy(out + op, in + ip, litLen);
+    ip += litLen;
+    op += litLen;
+    if (ip == len)
+      break; // Final sequence
+
+    if (len - ip < 2)
+      return false;
+    size_t offset = in[ip] | static_cast<size_t>(in[ip + 1]) << 8;
+    ip += 2;
+    size_t matchLen = token & 15;
+    if (matchLen == 15 && !getLength(in, len, ip, matchLen))
+      return false;
+    matchLen += MIN_MATCH;
+    if (offset == 0 || offset > op || matchLen > outLen - op)
+      return false;
+    // Byte by byte: the source may overlap what is being written
+    for (size_t k = 0; k < matchLen; k++, op++)
+      out[op] = out[op - offset];
+  }
+  return op == outLen;
+}
+
+bool Compress(const uint8_t *packet, size_t len, std::vector<uint8_t> &out) {
+  if (len <= sizeof(PMSG_COMPRESSED_HEAD) + 1)
+    return false;
+  auto start = std::chrono::steady_clock::now();
+  size_t base = out.size();
+  // Only worth sending if it saves at least the wrapper
+  size_t cap = len - sizeof(PMSG_COMPRESSED_HEAD) - 1;
+  out.resize(base + sizeof(PMSG_COMPRESSED_HEAD) + cap);
+  size_t encoded = LzCompress(packet, len,
+                              out.data() + base + sizeof(PMSG_COMPRESSED_HEAD),
+                              cap);
+  if (encoded == 0) {
+    out.resize(base);
+    s_stats.incompressible++;
+  } else {
+    size_t total = sizeof(PMSG_COMPRESSED_HEAD) + encoded;
+    PMSG_COMPRESSED_HEAD head{};
+    head.h = MakeC2Header(static_cast<uint16_t>(total), Opcode::COMPRESSED);
+    head.rawSize = static_cast<uint16_t>(len);
+    memcpy(out.data() + base, &head, sizeof(head));
+    out.resize(base + total);
+    s_stats.packets++;
+    s_stats.rawBytes += len;
+    s_stats.wireBytes += total;
+  }
+  s_stats.cpuUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return encoded != 0;
+}
+
+bool Decompress(const uint8_t *packet, size_t len, std::vector<uint8_t> &out) {
+  if (len < sizeof(PMSG_COMPRESSED_HEAD))
+    return false;
+  PMSG_COMPRESSED_HEAD head;
+  memcpy(&head, packet, sizeof(head));
+  out.resize(head.rawSize);
+  return head.rawSize >= 3 &&
+         LzDecompress(packet + sizeof(head), len - sizeof(head), out.data(),
+                      out.size());
+}
+
+const Stats &GetStats() { return s_stats; }
+
+} // namespace PacketCompression
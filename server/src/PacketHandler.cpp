@@ -53,15 +53,21 @@ void Handle(Session &session, const std::vector<uint8_t> &packet, Database &db,
 
   // Movement
   case Opcode::MOVE:
-    WorldHandler::HandleMove(session, packet, db);
+    WorldHandler::HandleMove(session, packet);
+    break;
+  case Opcode::MOVE_PATH:
+    WorldHandler::HandleMovePath(session, packet, world);
     break;
   case Opcode::PRECISE_POS:
     WorldHandler::HandlePrecisePosition(session, packet, world);
     break;
+  case Opcode::TOWN_RETURN:
+    WorldHandler::HandleTownReturn(session, world);
+    break;
 
   // Character
   case Opcode::CHARSAVE:
-    CharacterHandler::HandleCharSave(session, packet, db);
+    CharacterHandler::HandleCharSave(session, packet, db, world);
     break;
   case Opcode::EQUIP:
     CharacterHandler::HandleEquip(session, packet, db);
@@ -148,6 +154,12 @@ void Handle(Session &session, const std::vector<uint8_t> &packet, Database &db,
       QuestHandler::HandleQuestAbandon(session, packet, db);
     break;
 
+  // Gateway (the gateway never forwards these from a client)
+  case Opcode::GATEWAY:
+    if (subcode == Opcode::SUB_GATEWAY_RESUME)
+      server.ResumeSession(session, packet);
+    break;
+
   // Client settings (camera zoom)
   case Opcode::CLIENT_SETTINGS:
     if (packet.size() >= sizeof(PMSG_CLIENT_SETTINGS)) {
@@ -157,6 +169,14 @@ void Handle(Session &session, const std::vector<uint8_t> &packet, Database &db,
     }
     break;
 
+  // Transport options
+  case Opcode::NET_OPTIONS:
+    if (packet.size() >= sizeof(PMSG_NET_OPTIONS)) {
+      auto *opts = reinterpret_cast<const PMSG_NET_OPTIONS *>(packet.data());
+      session.compressC2 = (opts->flags & NET_OPT_COMPRESS) != 0;
+    }
+    break;
+
   default:
     break;
   }
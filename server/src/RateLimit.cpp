@@ -0,0 +1,51 @@
+#include "RateLimit.hpp"
+#include "PacketDefs.hpp"
+
+namespace RateLimit {
+
+// Legit clients stay well below these; DB-backed actions get the tightest
+// limits since each one costs a transaction.
+static constexpr Rule RULES[RULE_COUNT] = {
+    // Movement
+    {Opcode::MOVE, 20.0f, 20.0f},
+    {Opcode::MOVE_PATH, 10.0f, 10.0f},
+    {Opcode::PRECISE_POS, 25.0f, 25.0f},
+    {Opcode::TOWN_RETURN, 1.0f, 1.0f},
+    // Combat
+    {Opcode::ATTACK, 10.0f, 10.0f},
+    {Opcode::SKILL_USE, 10.0f, 5.0f},
+    {Opcode::SKILL_TELEPORT, 2.0f, 2.0f},
+    // Character (DB)
+    {Opcode::CHARSELECT, 2.0f, 4.0f},
+    {Opcode::CHARSAVE, 2.0f, 4.0f},
+    {Opcode::EQUIP, 5.0f, 10.0f},
+    {Opcode::STAT_ALLOC, 10.0f, 20.0f},
+    // Inventory / shop (DB)
+    {Opcode::PICKUP, 10.0f, 10.0f},
+    {Opcode::INV_MOVE, 8.0f, 8.0f},
+    {Opcode::ITEM_USE, 5.0f, 5.0f},
+    {Opcode::ITEM_DROP, 5.0f, 5.0f},
+    {Opcode::SHOP_BUY, 5.0f, 5.0f},
+    {Opcode::SHOP_SELL, 5.0f, 5.0f},
+    // Quests / map / chat
+    {Opcode::QUEST, 2.0f, 4.0f},
+    {Opcode::WARP_COMMAND, 1.0f, 2.0f},
+    {Opcode::CHAT_LOG_SAVE, 5.0f, 10.0f},
+};
+
+int RuleFor(uint8_t opcode) {
+  // Opcode -> rule index, built once (0 = not limited, else index + 1)
+  static const auto table = [] {
+    struct {
+      uint8_t slot[256] = {};
+    } t;
+    for (int i = 0; i < RULE_COUNT; i++)
+      t.slot[RULES[i].opcode] = static_cast<uint8_t>(i + 1);
+    return t;
+  }();
+  return table.slot[opcode] - 1;
+}
+
+const Rule &GetRule(int index) { return RULES[index]; }
+
+} // namespace RateLimit
@@ -0,0 +1,213 @@
+#include "SendQueue.hpp"
+#include "PacketDefs.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <sys/uio.h>
+
+uint32_t SendQueue::SupersedeKey(const uint8_t *packet, size_t len) {
+  if (len < sizeof(PBMSG_HEAD) || packet[0] != 0xC1)
+    return 0;
+  uint8_t opcode = packet[2];
+  uint16_t entity = 0;
+  switch (opcode) {
+  case Opcode::MON_MOVE:
+    if (len < sizeof(PMSG_MONSTER_MOVE_SEND))
+      return 0;
+    memcpy(&entity, packet + offsetof(PMSG_MONSTER_MOVE_SEND, monsterIndex),
+           sizeof(entity));
+    break;
+  case Opcode::NPC_MOVE:
+    if (len < sizeof(PMSG_NPC_MOVE_SEND))
+      return 0;
+    memcpy(&entity, packet + offsetof(PMSG_NPC_MOVE_SEND, npcIndex),
+           sizeof(entity));
+    break;
+  default:
+    return 0; // Reliable
+  }
+  return (static_cast<uint32_t>(opcode) << 16 | entity) + 1;
+}
+
+bool SendQueue::Push(const uint8_t *data, size_t len) {
+  if (m_liveBytes + len > CAPACITY)
+    return false;
+
+  size_t pos = 0;
+  while (pos < len) {
+    const uint8_t *p = data + pos;
+    size_t avail = len - pos;
+    size_t size = 0;
+    if (avail >= 2 && (p[0] == 0xC1 || p[0] == 0xC3))
+      size = p[1];
+    else if (avail >= 3 && (p[0] == 0xC2 || p[0] == 0xC4))
+      size = static_cast<size_t>(p[1]) << 8 | p[2];
+    // Not a well-formed packet: keep the rest as one opaque reliable chunk
+    if (size < 2 || size > avail)
+      size = avail;
+    PushPacket(p, size);
+    pos += size;
+  }
+  m_peakDepth = std::max(m_peakDepth, m_liveBytes);
+  return true;
+}
+
+void SendQueue::PushPacket(const uint8_t *packet, size_t len) {
+  uint32_t key = SupersedeKey(packet, len);
+  if (key != 0 && m_liveBytes > SOFT_LIMIT) {
+    auto it = m_latest.find(key);
+    if (it != m_latest.end() && it->second >= m_firstSeq) {
+      Entry &old = m_entries[it->second - m_firstSeq];
+      bool inFlight = it->second == m_firstSeq && m_head > old.start;
+      if (!old.dropped && !inFlight) {
+        old.dropped = true;
+        m_liveBytes -= old.len;
+        m_superseded++;
+        m_supersededBytes += old.len;
+      }
+    }
+  }
+
+  Reserve(len);
+  size_t mask = m_ring.size() - 1;
+  size_t at = static_cast<size_t>(m_tail) & mask;
+  size_t first = std::min(len, m_ring.size() - at);
+  memcpy(m_ring.data() + at, packet, first);
+  memcpy(m_ring.data(), packet + first, len - first);
+
+  m_entries.push_back({m_tail, static_cast<uint32_t>(len), key});
+  if (key != 0)
+    m_latest[key] = m_firstSeq + m_entries.size() - 1;
+  m_tail += len;
+  m_liveBytes += len;
+}
+
+void SendQueue::Reserve(size_t bytes) {
+  if (m_tail - m_head + bytes <= m_ring.size())
+    return;
+
+  // Rebuild into a ring sized for the live bytes, squeezing out dropped
+  // updates. The partially sent front packet keeps only its unsent tail and
+  // becomes reliable, so it can never be dropped mid-stream.
+  size_t size = std::max<size_t>(m_ring.size(), 4096);
+  while (size < m_liveBytes + bytes)
+    size <<= 1;
+  std::vector<uint8_t> ring(size);
+  std::deque<Entry> entries;
+  size_t mask = m_ring.size() - 1;
+  uint64_t out = 0;
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    const Entry &e = m_entries[i];
+    if (e.dropped)
+      continue;
+    uint64_t from = i == 0 ? std::max(m_head, e.start) : e.start;
+    size_t n = static_cast<size_t>(e.start + e.len - from);
+    for (size_t k = 0; k < n; k++)
+      ring[out + k] = m_ring[(from + k) & mask];
+    entries.push_back({out, static_cast<uint32_t>(n), from == e.start ? e.key : 0});
+    out += n;
+  }
+
+  m_ring.swap(ring);
+  m_entries.swap(entries);
+  m_head = 0;
+  m_tail = out;
+  m_firstSeq = 0;
+  m_latest.clear();
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    if (m_entries[i].key != 0)
+      m_latest[m_entries[i].key] = i;
+  }
+}
+
+bool SendQueue::Flush(int fd) {
+  static constexpr int MAX_IOV = 64;
+  while (!m_entries.empty()) {
+    while (!m_entries.empty() && m_entries.front().dropped) {
+      m_head = m_entries.front().start + m_entries.front().len;
+      PopFront();
+    }
+    if (m_entries.empty())
+      break;
+
+    // Gather live packets (two segments when one wraps around the ring)
+    struct iovec iov[MAX_IOV];
+    int iovCount = 0;
+    size_t total = 0;
+    size_t mask = m_ring.size() - 1;
+    for (size_t i = 0; i < m_entries.size() && iovCount + 2 <= MAX_IOV; i++) {
+      const Entry &e = m_entries[i];
+      if (e.dropped)
+        continue;
+      uint64_t from = i == 0 ? m_head : e.start;
+      size_t n = static_cast<size_t>(e.start + e.len - from);
+      size_t at = static_cast<size_t>(from) & mask;
+      size_t first = std::min(n, m_ring.size() - at);
+      iov[iovCount++] = {m_ring.data() + at, first};
+      if (n > first)
+        iov[iovCount++] = {m_ring.data(), n - first};
+      total += n;
+    }
+
+    ssize_t sent = writev(fd, iov, iovCount);
+    if (sent < 0) {
+      if (errno == EINTR)
+        continue;
+      return errno == EAGAIN || errno == EWOULDBLOCK; // Would block = retry later
+    }
+    Consume(static_cast<size_t>(sent));
+    if (static_cast<size_t>(sent) < total)
+      break; // Socket buffer full
+  }
+
+  if (m_entries.empty()) {
+    m_head = m_tail = 0;
+    m_firstSeq = 0;
+    m_latest.clear();
+  }
+  return true;
+}
+
+std::vector<uint8_t> SendQueue::TakePending() {
+  std::vector<uint8_t> out;
+  out.reserve(m_liveBytes);
+  size_t mask = m_ring.size() - 1;
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    const Entry &e = m_entries[i];
+    if (e.dropped)
+      continue;
+    for (uint64_t k = i == 0 ? m_head : e.start; k < e.start + e.len; k++)
+      out.push_back(m_ring[k & mask]);
+  }
+  m_entries.clear();
+  m_head = m_tail = 0;
+  m_firstSeq = 0;
+  m_latest.clear();
+  m_liveBytes = 0;
+  return out;
+}
+
+void SendQueue::Consume(size_t bytes) {
+  while (bytes > 0 && !m_entries.empty()) {
+    Entry &e = m_entries.front();
+    if (e.dropped) {
+      // Skipped by the gather, costs nothing on the wire
+      m_head = e.start + e.len;
+      PopFront();
+      continue;
+    }
+    uint64_t end = e.start + e.len;
+    size_t take = std::min<size_t>(bytes, static_cast<size_t>(end - m_head));
+    m_head += take;
+    m_liveBytes -= take;
+    bytes -= take;
+    if (m_head == end)
+      PopFront();
+  }
+}
+
+void SendQueue::PopFront() {
+  m_entries.pop_front();
+  m_firstSeq++;
+}
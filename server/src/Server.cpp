@@ -1,4 +1,6 @@
 #include "Server.hpp"
+#include "Handoff.hpp"
+#include "PacketCompression.hpp"
 #include "PacketDefs.hpp"
 #include "PacketHandler.hpp"
 #include "StatCalculator.hpp"
@@ -7,6 +9,7 @@
 #include "handlers/InventoryHandler.hpp"
 #include "handlers/WorldHandler.hpp"
 #include "handlers/QuestHandler.hpp"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <cerrno>
 #include <chrono>
@@ -22,32 +25,120 @@
 static volatile bool g_sigint = false;
 static void sigHandler(int) { g_sigint = true; }
 
-bool Server::Start(uint16_t port) {
+bool Server::SetGatewaySecret(const std::string &secret) {
+  if (secret.size() < 16 || secret.size() > m_gatewayKey.size())
+    return false;
+  m_gatewayKey.fill(0);
+  memcpy(m_gatewayKey.data(), secret.data(), secret.size());
+  m_hasGatewaySecret = true;
+  return true;
+}
+
+bool Server::Start(uint16_t port, const DatabaseTuning &dbTuning,
+                   int ioThreads, const std::string &handoffPath) {
+  if (IsBackend() && !m_hasGatewaySecret) {
+    printf("[Gateway] A map backend needs MU_GATEWAY_SECRET (16-32 bytes)\n");
+    return false;
+  }
+  using Clock = std::chrono::steady_clock;
+  auto bootStart = Clock::now();
+  auto lapStart = bootStart;
+  auto lapMs = [&lapStart]() {
+    auto now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - lapStart).count();
+    lapStart = now;
+    return ms;
+  };
+
   // Open database
-  if (!m_db.Open("mu_server.db")) {
+  if (!m_db.Open("mu_server.db", dbTuning)) {
     printf("[Server] Failed to open database\n");
     return false;
   }
-  m_db.CreateDefaultAccount();
-  m_db.SeedNpcSpawns();
-  m_db.SeedMonsterSpawns();
-  m_db.SeedItemDefinitions();
+  if (m_persistenceOwner) {
+    m_db.CreateDefaultAccount();
+    m_db.SeedNpcSpawns();
+    m_db.SeedMonsterSpawns();
+    m_db.SeedItemDefinitions();
+  }
+  double dbMs = lapMs();
 
   // No longer seeding default equipment by name; use DB status
 
-  // Load terrain attributes for both maps (walkability checks / monster AI)
+  // Terrain attributes per map (walkability checks / monster AI)
   // CMake symlinks client/Data/ into server/build/Data/
-  m_world.LoadTerrainAttributesForMap(0, "Data/World1/EncTerrain1.att");
-  m_world.LoadTerrainAttributesForMap(1, "Data/World2/EncTerrain2.att");
-  m_world.LoadTerrainAttributesForMap(2, "Data/World3/EncTerrain3.att");
-  m_world.LoadTerrainAttributesForMap(3, "Data/World4/EncTerrain4.att");
-  m_world.SetActiveMap(0);
+  const WorldSnapshot::TerrainSources terrainFiles = {
+      "Data/World1/EncTerrain1.att", "Data/World2/EncTerrain2.att",
+      "Data/World3/EncTerrain3.att", "Data/World4/EncTerrain4.att"};
+
+  // Static world data (items, spawns, terrain, connectivity) comes from a
+  // prebuilt snapshot, regenerated only when its sources change
+  static const char *SNAPSHOT_PATH = "world.snapshot";
+  uint64_t sourceKey = WorldSnapshot::ComputeSourceKey(m_db, terrainFiles);
+  const char *snapshotState = "mapped";
+  if (!m_snapshot.Open(SNAPSHOT_PATH, sourceKey) && !m_persistenceOwner) {
+    snapshotState = "not built yet (owner builds it)";
+  } else if (!m_snapshot.IsOpen()) {
+    snapshotState = "rebuilt";
+    if (!WorldSnapshot::Build(SNAPSHOT_PATH, sourceKey, m_db, terrainFiles) ||
+        !m_snapshot.Open(SNAPSHOT_PATH, sourceKey))
+      snapshotState = "unavailable";
+  }
+  double snapshotMs = lapMs();
+
+  if (m_snapshot.IsOpen()) {
+    m_db.SetItemDefinitionCache(m_snapshot.GetItemDefinitions());
+    m_world.AttachSnapshot(&m_snapshot);
+  } else {
+    for (size_t mapId = 0; mapId < terrainFiles.size(); mapId++)
+      m_world.LoadTerrainAttributesForMap(static_cast<uint8_t>(mapId),
+                                          terrainFiles[mapId]);
+  }
+  // Standalone servers start in Lorencia; a gateway backend only ever runs
+  // its own map
+  uint8_t startMap = IsBackend() ? static_cast<uint8_t>(m_hostedMap) : 0;
+  m_world.SetActiveMap(startMap);
+
+  // Load NPC and monster data (snapshot, or database as fallback)
+  m_world.LoadNpcsFromDB(m_db, startMap);
+  m_world.LoadMonstersFromDB(m_db, startMap);
+  double worldMs = lapMs();
+
+  m_ioThreadCount = std::max(1, ioThreads);
+
+  // Hot restart: take the sockets and live state over from a running server
+  bool tookOver = false;
+  if (!handoffPath.empty()) {
+    int sock = Handoff::Connect(handoffPath);
+    if (sock >= 0) {
+      tookOver = TakeOver(sock);
+      close(sock);
+      if (!tookOver)
+        return false; // The old server keeps running
+    }
+  }
+  if (!tookOver && !OpenListenSocket(port))
+    return false;
+
+  if (!handoffPath.empty()) {
+    m_handoffPath = handoffPath;
+    m_handoffFd = Handoff::Listen(handoffPath);
+    if (m_handoffFd >= 0)
+      printf("[Handoff] Accepting takeovers on %s\n", handoffPath.c_str());
+  }
 
-  // Load NPC and monster data from database
-  m_world.LoadNpcsFromDB(m_db, 0); // map 0 = Lorencia
-  m_world.LoadMonstersFromDB(m_db, 0);
+  printf("[Server] Startup: database %.1f ms, snapshot %.1f ms (%s), "
+         "world %.1f ms, total %.1f ms\n",
+         dbMs, snapshotMs, snapshotState, worldMs,
+         std::chrono::duration<double, std::milli>(Clock::now() - bootStart)
+             .count());
+  printf("[Server] Listening on port %d (%d I/O thread(s)%s)\n", port,
+         m_ioThreadCount, tookOver ? ", taken over" : "");
+  m_running = true;
+  return true;
+}
 
-  // Create listen socket
+bool Server::OpenListenSocket(uint16_t port) {
   m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
   if (m_listenFd < 0) {
     perror("[Server] socket");
@@ -61,9 +152,10 @@ bool Server::Start(uint16_t port) {
   int flags = fcntl(m_listenFd, F_GETFL, 0);
   fcntl(m_listenFd, F_SETFL, flags | O_NONBLOCK);
 
+  // Backends only talk to a gateway on this host; clients must not reach them
   struct sockaddr_in addr{};
   addr.sin_family = AF_INET;
-  addr.sin_addr.s_addr = INADDR_ANY;
+  addr.sin_addr.s_addr = htonl(IsBackend() ? INADDR_LOOPBACK : INADDR_ANY);
   addr.sin_port = htons(port);
 
   if (bind(m_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
@@ -78,8 +170,6 @@ bool Server::Start(uint16_t port) {
     return false;
   }
 
-  printf("[Server] Listening on port %d\n", port);
-  m_running = true;
   return true;
 }
 
@@ -89,10 +179,18 @@ void Server::Run() {
 
   srand(static_cast<unsigned int>(time(NULL)));
 
+  if (!StartIo())
+    return;
+
   auto lastTick = std::chrono::steady_clock::now();
   float autosaveTimer = 0.0f;
   static constexpr float AUTOSAVE_INTERVAL =
       60.0f; // Save all characters every 60s
+  float compressReportTimer = 0.0f;
+  PacketCompression::Stats compressReported;
+  float chatFlushTimer = 0.0f;
+  static constexpr float CHAT_FLUSH_INTERVAL =
+      5.0f; // Batch chat log rows, at most this old when written
 
   while (m_running && !g_sigint) {
     // Calculate delta time
@@ -318,74 +416,8 @@ void Server::Run() {
           }
 
           auto *mon = m_world.FindMonster(hit.monsterIndex);
-          int xp = 0;
-          if (ownerSession) {
-            xp = ServerConfig::CalculateXP(ownerSession->level,
-                                           mon ? mon->level : 1);
-
-            PMSG_MONSTER_DEATH_SEND deathPkt{};
-            deathPkt.h = MakeC1Header(sizeof(deathPkt), Opcode::MON_DEATH);
-            deathPkt.monsterIndex = hit.monsterIndex;
-            deathPkt.killerCharId = static_cast<uint16_t>(ownerSession->characterId);
-            deathPkt.xpReward = static_cast<uint32_t>(xp);
-            Broadcast(&deathPkt, sizeof(deathPkt));
-
-            ownerSession->experience += xp;
-            bool leveledUp = false;
-            while (true) {
-              uint64_t nextXP = Database::GetXPForLevel(ownerSession->level);
-              if (ownerSession->experience >= nextXP && ownerSession->level < 400) {
-                ownerSession->level++;
-                CharacterClass cls = static_cast<CharacterClass>(ownerSession->classCode);
-                ownerSession->levelUpPoints += StatCalculator::GetLevelUpPoints(cls);
-                ownerSession->maxHp = StatCalculator::CalculateMaxHP(cls, ownerSession->level, ownerSession->vitality) + ownerSession->petBonusMaxHp;
-                ownerSession->maxMana = StatCalculator::CalculateMaxMP(cls, ownerSession->level, ownerSession->energy);
-                ownerSession->maxAg = StatCalculator::CalculateMaxAG(ownerSession->strength, ownerSession->dexterity, ownerSession->vitality, ownerSession->energy);
-                ownerSession->hp = ownerSession->maxHp;
-                ownerSession->mana = ownerSession->maxMana;
-                ownerSession->ag = ownerSession->maxAg;
-                leveledUp = true;
-              } else {
-                break;
-              }
-            }
-
-            if (xp > 0) {
-              char xpBuf[64];
-              snprintf(xpBuf, sizeof(xpBuf), "+%d Experience", xp);
-              m_db.SaveChatMessage(ownerSession->characterId, 1, 0xFFFF78B4, xpBuf);
-            }
-            if (leveledUp) {
-              char lvlBuf[64];
-              snprintf(lvlBuf, sizeof(lvlBuf), "Congratulations! Level %d reached!", (int)ownerSession->level);
-              m_db.SaveChatMessage(ownerSession->characterId, 2, 0xFF64FFFF, lvlBuf);
-              // Rescale active summon to match new owner level
-              if (ownerSession->activeSummonIndex > 0)
-                m_world.RescaleSummon(ownerSession->activeSummonIndex, ownerSession->level);
-            }
-            if (leveledUp || xp > 0)
-              CharacterHandler::SendCharStats(*ownerSession);
-
-            // Spawn drops
-            if (mon) {
-              auto drops = m_world.SpawnDrops(mon->worldX, mon->worldZ, mon->level, mon->type, m_db);
-              for (auto &drop : drops) {
-                PMSG_DROP_SPAWN_SEND dropPkt{};
-                dropPkt.h = MakeC1Header(sizeof(dropPkt), Opcode::DROP_SPAWN);
-                dropPkt.dropIndex = drop.index;
-                dropPkt.defIndex = drop.defIndex;
-                dropPkt.quantity = drop.quantity;
-                dropPkt.itemLevel = drop.itemLevel;
-                dropPkt.worldX = drop.worldX;
-                dropPkt.worldZ = drop.worldZ;
-                Broadcast(&dropPkt, sizeof(dropPkt));
-              }
-            }
-
-            // Quest kill tracking
-            if (mon)
-              QuestHandler::OnMonsterKill(*ownerSession, mon->type, mon->isSummon(), m_db);
-
+          if (ownerSession && mon) {
+            QueueKill(*ownerSession, *mon);
             // Clear stale target on session
             ownerSession->attackTargetMonsterIdx = 0;
           }
@@ -444,6 +476,7 @@ void Server::Run() {
             if (s->hp <= 0) {
               s->hp = 0;
               s->dead = true;
+              s->StopMoving();
               // Clear buffs and debuffs on death
               s->buffs[0].active = false;
               s->buffs[1].active = false;
@@ -473,7 +506,7 @@ void Server::Run() {
             if (atk.damage > 0 && s->classCode == 16 && s->ag < s->maxAg) {
               int agGain = std::max(1, s->maxAg / 30); // ~3% of maxAG
               s->ag = std::min(s->ag + agGain, s->maxAg);
-              CharacterHandler::SendCharStats(*s);
+              CharacterHandler::MarkStatsDirty(*s, STATS_AG);
             }
 
             // Send monster attack packet to client
@@ -537,62 +570,9 @@ void Server::Run() {
       auto *mon = m_world.FindMonster(tick.monsterIndex);
       if (mon && mon->aiState == MonsterInstance::AIState::DYING &&
           mon->hp <= 0 && attacker) {
-        int xp = ServerConfig::CalculateXP(attacker->level, mon->level);
-
-        PMSG_MONSTER_DEATH_SEND deathPkt{};
-        deathPkt.h = MakeC1Header(sizeof(deathPkt), Opcode::MON_DEATH);
-        deathPkt.monsterIndex = mon->index;
-        deathPkt.killerCharId = static_cast<uint16_t>(attacker->characterId);
-        deathPkt.xpReward = static_cast<uint32_t>(xp);
-        Broadcast(&deathPkt, sizeof(deathPkt));
-
-        attacker->experience += xp;
-        bool leveledUp = false;
-        while (true) {
-          uint64_t nextXP = Database::GetXPForLevel(attacker->level);
-          if (attacker->experience >= nextXP && attacker->level < 400) {
-            attacker->level++;
-            CharacterClass cls =
-                static_cast<CharacterClass>(attacker->classCode);
-            attacker->levelUpPoints += StatCalculator::GetLevelUpPoints(cls);
-            attacker->maxHp = StatCalculator::CalculateMaxHP(
-                cls, attacker->level, attacker->vitality) +
-                attacker->petBonusMaxHp;
-            attacker->maxMana = StatCalculator::CalculateMaxMP(
-                cls, attacker->level, attacker->energy);
-            attacker->maxAg = StatCalculator::CalculateMaxAG(
-                attacker->strength, attacker->dexterity,
-                attacker->vitality, attacker->energy);
-            attacker->hp = attacker->maxHp;
-            attacker->mana = attacker->maxMana;
-            attacker->ag = attacker->maxAg;
-            leveledUp = true;
-          } else {
-            break;
-          }
-        }
-        if (leveledUp) {
-          if (attacker->activeSummonIndex > 0)
-            m_world.RescaleSummon(attacker->activeSummonIndex, attacker->level);
-        }
-        if (leveledUp || xp > 0)
-          CharacterHandler::SendCharStats(*attacker);
-
-        auto drops = m_world.SpawnDrops(mon->worldX, mon->worldZ, mon->level,
-                                        mon->type, m_db);
-        for (auto &drop : drops) {
-          PMSG_DROP_SPAWN_SEND dropPkt{};
-          dropPkt.h = MakeC1Header(sizeof(dropPkt), Opcode::DROP_SPAWN);
-          dropPkt.dropIndex = drop.index;
-          dropPkt.defIndex = drop.defIndex;
-          dropPkt.quantity = drop.quantity;
-          dropPkt.itemLevel = drop.itemLevel;
-          dropPkt.worldX = drop.worldX;
-          dropPkt.worldZ = drop.worldZ;
-          Broadcast(&dropPkt, sizeof(dropPkt));
-        }
-        printf("[Poison] Mon %d killed by poison (fd=%d, xp=%d, drops=%zu)\n",
-               mon->index, tick.attackerFd, xp, drops.size());
+        QueueKill(*attacker, *mon);
+        printf("[Poison] Mon %d killed by poison (fd=%d)\n", mon->index,
+               tick.attackerFd);
       }
     }
 
@@ -601,43 +581,84 @@ void Server::Run() {
     if (autosaveTimer >= AUTOSAVE_INTERVAL) {
       autosaveTimer = 0.0f;
       int saved = 0;
+      Database::Transaction tx(m_db);
       for (auto &s : m_sessions) {
         if (s->IsAlive() && s->inWorld) {
           SaveSession(*s);
           saved++;
         }
       }
-      if (saved > 0)
+      if (!tx.Commit())
+        printf("[Server] Autosave failed, retrying next interval\n");
+      else if (saved > 0)
         printf("[Server] Autosave: saved %d character(s)\n", saved);
     }
 
-    // Build poll fd array: listen socket + all sessions
-    std::vector<struct pollfd> fds;
-    fds.push_back({m_listenFd, POLLIN, 0});
-    for (auto &s : m_sessions) {
-      short events = POLLIN;
-      events |= POLLOUT;
-      fds.push_back({s->GetFd(), events, 0});
+    // Chat log batch (SaveSession also flushes on logout/autosave)
+    chatFlushTimer += dt;
+    if (chatFlushTimer >= CHAT_FLUSH_INTERVAL) {
+      chatFlushTimer = 0.0f;
+      m_db.FlushChatLog();
     }
 
-    int ret = poll(fds.data(), static_cast<nfds_t>(fds.size()),
-                   16); // 16ms for ~60Hz tick
+    // Compression report (every 10 seconds, quiet while idle)
+    compressReportTimer += dt;
+    if (compressReportTimer >= 10.0f) {
+      compressReportTimer = 0.0f;
+      const PacketCompression::Stats &now = PacketCompression::GetStats();
+      uint64_t packets = now.packets - compressReported.packets;
+      uint64_t skipped = now.incompressible - compressReported.incompressible;
+      if (packets + skipped > 0) {
+        uint64_t raw = now.rawBytes - compressReported.rawBytes;
+        uint64_t wire = now.wireBytes - compressReported.wireBytes;
+        printf("[Net] Compressed %llu packet(s) %llu -> %llu bytes (%.0f%%), "
+               "%llu incompressible, %.2f ms CPU\n",
+               (unsigned long long)packets, (unsigned long long)raw,
+               (unsigned long long)wire, raw ? 100.0 * wire / raw : 0.0,
+               (unsigned long long)skipped,
+               (now.cpuUs - compressReported.cpuUs) / 1000.0);
+      }
+      compressReported = now;
+    }
+
+    // Sleep until the I/O threads queue something, a successor process
+    // connects for a hot restart, or the next tick
+    struct pollfd waitFds[2] = {{m_wakePipe[0], POLLIN, 0},
+                                {m_handoffFd, POLLIN, 0}};
+    int ret = poll(waitFds, 2, 16); // 16ms for ~60Hz tick
     if (ret < 0) {
       if (errno == EINTR)
         continue;
       perror("[Server] poll");
       break;
     }
-
-    // Check listen socket
-    if (fds[0].revents & POLLIN) {
-      AcceptNewClients();
+    if (waitFds[0].revents & POLLIN) {
+      uint8_t tmp[64];
+      while (read(m_wakePipe[0], tmp, sizeof(tmp)) > 0) {
+      }
+    }
+    if (waitFds[1].revents & POLLIN) {
+      ServeHandoff();
+      if (m_handedOff)
+        break;
     }
 
+    // Packets held back by the rate limiter go first (arrival order), then
+    // new connections, packets (dispatched to handlers) and disconnects
+    ProcessDeferredPackets(dt);
+    DrainIoEvents();
+
     // Process sessions
     for (size_t i = 0; i < m_sessions.size(); i++) {
       auto &session = m_sessions[i];
-      auto &pfd = fds[i + 1];
+
+      if (session->inWorld && !session->dead) {
+        bool wasMoving = session->IsMoving();
+        WorldHandler::UpdateMovement(*session, dt);
+        // Check if player walked into a gate zone
+        if (wasMoving)
+          CheckGateZones(*session);
+      }
 
       // Tick cooldowns
       if (session->potionCooldown > 0.0f) {
@@ -689,6 +710,7 @@ void Server::Run() {
           if (session->hp <= 0) {
             session->hp = 0;
             session->dead = true;
+            session->StopMoving();
             session->poisoned = false;
             // Clear buffs on death
             session->buffs[0].active = false;
@@ -701,7 +723,7 @@ void Server::Run() {
           pkt.damage = (float)poisonDmg;
           pkt.remainingHp = (float)session->hp;
           session->Send(&pkt, sizeof(pkt));
-          CharacterHandler::SendCharStats(*session);
+          CharacterHandler::MarkStatsDirty(*session, STATS_HP);
         }
       }
       if (session->gateTransitionCooldown > 0.0f) {
@@ -755,7 +777,7 @@ void Server::Run() {
           int gain = (int)session->hpRemainder;
           session->hp = std::min(session->hp + gain, (int)session->maxHp);
           session->hpRemainder -= (float)gain;
-          CharacterHandler::SendCharStats(*session);
+          CharacterHandler::MarkStatsDirty(*session, STATS_HP);
         }
       }
 
@@ -769,7 +791,7 @@ void Server::Run() {
             int gain = (int)session->idleHpRemainder;
             session->hp = std::min(session->hp + gain, (int)session->maxHp);
             session->idleHpRemainder -= (float)gain;
-            CharacterHandler::SendCharStats(*session);
+            CharacterHandler::MarkStatsDirty(*session, STATS_HP);
           }
         }
       }
@@ -786,7 +808,7 @@ void Server::Run() {
             int gain = (int)session->manaRemainder;
             session->manaRemainder -= (float)gain;
             session->mana = std::min(session->mana + gain, session->maxMana);
-            CharacterHandler::SendCharStats(*session);
+            CharacterHandler::MarkStatsDirty(*session, STATS_MANA);
           }
         } else {
           session->manaRemainder = 0.0f;
@@ -817,30 +839,19 @@ void Server::Run() {
             printf("[Regen] FD=%d AG +%d (%d/%d) Rate: %.0f%%\n",
                    session->GetFd(), gain, session->ag, session->maxAg,
                    totalRate);
-            CharacterHandler::SendCharStats(*session);
+            CharacterHandler::MarkStatsDirty(*session, STATS_AG);
           }
         }
       }
+    }
 
-      if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
-        session->Kill();
-        continue;
-      }
+    // Resolve all kills from this tick (summon, poison and packet handlers)
+    ResolveKills();
 
-      if (pfd.revents & POLLIN) {
-        auto packets = session->ReadPackets();
-        for (auto &pkt : packets) {
-          HandlePacket(*session, pkt);
-        }
-        // Check if player walked into a gate zone (after position updates)
-        if (session->inWorld && session->IsAlive()) {
-          CheckGateZones(*session);
-        }
-      }
-
-      if (pfd.revents & POLLOUT) {
-        session->FlushSend();
-      }
+    // One coalesced stats delta per session for everything changed this tick
+    for (auto &s : m_sessions) {
+      if (s->statsDirty && s->IsAlive())
+        CharacterHandler::FlushStatsDelta(*s);
     }
 
     // Remove dead sessions (save before removing)
@@ -850,6 +861,9 @@ void Server::Run() {
                          if (!s->IsAlive()) {
                            if (s->inWorld)
                              SaveSession(*s);
+                           // Its next session may be on another backend
+                           if (IsBackend() && s->characterId > 0)
+                             m_db.EvictChatHistory(s->characterId);
                            // Despawn summon on disconnect
                            if (s->activeSummonIndex > 0) {
                              PMSG_SUMMON_DESPAWN_SEND dpkt{};
@@ -861,27 +875,215 @@ void Server::Run() {
                              s->activeSummonType = -1;
                            }
                            m_world.ClearGuardInteractionsForPlayer(s->GetFd());
+                           if (s->packetsDeferred > 0)
+                             printf("[RateLimit] fd=%d: %llu packet(s) "
+                                    "deferred, %.1f ms handler time\n",
+                                    s->GetFd(),
+                                    (unsigned long long)s->packetsDeferred,
+                                    s->handlerUsTotal / 1000.0);
                            printf("[Server] Client fd=%d disconnected\n",
                                   s->GetFd());
+                           ReleaseSession(*s);
                            return true;
                          }
                          return false;
                        }),
         m_sessions.end());
+
+    // Hand this iteration's output to the I/O threads
+    FlushSessionOutput();
+  }
+
+  if (m_handedOff) {
+    printf("[Server] Handed off, exiting\n");
+    return;
   }
 
   // Save all sessions before shutdown
-  for (auto &s : m_sessions) {
-    if (s->IsAlive() && s->inWorld)
-      SaveSession(*s);
+  {
+    Database::Transaction tx(m_db);
+    for (auto &s : m_sessions) {
+      if (s->IsAlive() && s->inWorld)
+        SaveSession(*s);
+    }
+    tx.Commit();
   }
   printf("[Server] Shutting down...\n");
+  StopIo();
+}
+
+void Server::QueueKill(Session &killer, const MonsterInstance &mon) {
+  KillEvent ev;
+  ev.killerFd = killer.GetFd();
+  ev.monsterIndex = mon.index;
+  ev.monsterType = mon.type;
+  ev.monsterLevel = mon.level;
+  ev.worldX = mon.worldX;
+  ev.worldZ = mon.worldZ;
+  ev.isSummon = mon.isSummon();
+  m_pendingKills.push_back(ev);
+}
+
+void Server::ResolveKills() {
+  if (m_pendingKills.empty())
+    return;
+
+  // Per-killer aggregate: one stats packet / quest update per player per tick
+  struct KillerState {
+    Session *session;
+    int xpGained = 0;
+    bool leveledUp = false;
+    bool questChanged = false;
+  };
+  std::vector<KillerState> killers;
+
+  // Death + drop packets for every kill, broadcast once as a single stream
+  std::vector<uint8_t> batch;
+  auto append = [&batch](const void *data, size_t len) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    batch.insert(batch.end(), bytes, bytes + len);
+  };
+
+  for (auto &ev : m_pendingKills) {
+    Session *killer = nullptr;
+    for (auto &s : m_sessions) {
+      if (s->GetFd() == ev.killerFd && s->IsAlive()) {
+        killer = s.get();
+        break;
+      }
+    }
+
+    KillerState *ks = nullptr;
+    if (killer) {
+      for (auto &k : killers) {
+        if (k.session == killer) {
+          ks = &k;
+          break;
+        }
+      }
+      if (!ks) {
+        killers.push_back({killer});
+        ks = &killers.back();
+      }
+    }
+
+    // XP is computed per kill against the killer's running level so AoE
+    // multi-kills scale exactly as if they had been resolved one by one
+    int xp = killer ? ServerConfig::CalculateXP(killer->level, ev.monsterLevel)
+                    : 0;
+
+    PMSG_MONSTER_DEATH_SEND deathPkt{};
+    deathPkt.h = MakeC1Header(sizeof(deathPkt), Opcode::MON_DEATH);
+    deathPkt.monsterIndex = ev.monsterIndex;
+    deathPkt.killerCharId =
+        killer ? static_cast<uint16_t>(killer->characterId) : 0;
+    deathPkt.xpReward = static_cast<uint32_t>(xp);
+    append(&deathPkt, sizeof(deathPkt));
+
+    if (killer) {
+      killer->experience += xp;
+      ks->xpGained += xp;
+      while (true) {
+        uint64_t nextXP = Database::GetXPForLevel(killer->level);
+        if (killer->experience >= nextXP && killer->level < 400) {
+          killer->level++;
+          CharacterClass cls = static_cast<CharacterClass>(killer->classCode);
+          killer->levelUpPoints += StatCalculator::GetLevelUpPoints(cls);
+          killer->maxHp = StatCalculator::CalculateMaxHP(cls, killer->level,
+                                                         killer->vitality) +
+                          killer->petBonusMaxHp;
+          killer->maxMana = StatCalculator::CalculateMaxMP(cls, killer->level,
+                                                           killer->energy);
+          killer->maxAg = StatCalculator::CalculateMaxAG(
+              killer->strength, killer->dexterity, killer->vitality,
+              killer->energy);
+          killer->hp = killer->maxHp;
+          killer->mana = killer->maxMana;
+          killer->ag = killer->maxAg;
+          ks->leveledUp = true;
+          printf("[Combat] Char %d leveled up to %d! Total XP: %llu\n",
+                 killer->characterId, (int)killer->level,
+                 (unsigned long long)killer->experience);
+
+          char lvlBuf[64];
+          snprintf(lvlBuf, sizeof(lvlBuf), "Congratulations! Level %d reached!",
+                   (int)killer->level);
+          // yellow: IM_COL32(255, 255, 100, 255) = 0xFF64FFFF
+          m_db.SaveChatMessage(killer->characterId, 2, 0xFF64FFFF, lvlBuf);
+        } else {
+          break;
+        }
+      }
+
+      if (xp > 0) {
+        char xpBuf[64];
+        snprintf(xpBuf, sizeof(xpBuf), "+%d Experience", xp);
+        // purple: IM_COL32(180, 120, 255, 255) = 0xFFFF78B4
+        m_db.SaveChatMessage(killer->characterId, 1, 0xFFFF78B4, xpBuf);
+      }
+
+      auto drops = m_world.SpawnDrops(ev.worldX, ev.worldZ, ev.monsterLevel,
+                                      ev.monsterType, m_db);
+      for (auto &drop : drops) {
+        PMSG_DROP_SPAWN_SEND dropPkt{};
+        dropPkt.h = MakeC1Header(sizeof(dropPkt), Opcode::DROP_SPAWN);
+        dropPkt.dropIndex = drop.index;
+        dropPkt.defIndex = drop.defIndex;
+        dropPkt.quantity = drop.quantity;
+        dropPkt.itemLevel = drop.itemLevel;
+        dropPkt.worldX = drop.worldX;
+        dropPkt.worldZ = drop.worldZ;
+        append(&dropPkt, sizeof(dropPkt));
+      }
+
+      if (QuestHandler::OnMonsterKill(*killer, ev.monsterType, ev.isSummon))
+        ks->questChanged = true;
+    }
+  }
+  size_t killCount = m_pendingKills.size();
+  m_pendingKills.clear();
+
+  Broadcast(batch.data(), batch.size());
+
+  for (auto &k : killers) {
+    Session &s = *k.session;
+    if (k.leveledUp && s.activeSummonIndex > 0)
+      m_world.RescaleSummon(s.activeSummonIndex, s.level);
+    if (k.leveledUp)
+      CharacterHandler::SendCharStats(s);
+    else if (k.xpGained > 0)
+      CharacterHandler::MarkStatsDirty(s, STATS_XP);
+    if (k.questChanged)
+      QuestHandler::SendQuestState(s);
+  }
+
+  // Quest progress persisted in a single transaction (chat lines are only
+  // cached here, see FlushChatLog)
+  Database::Transaction tx(m_db);
+  for (auto &k : killers) {
+    if (!k.questChanged)
+      continue;
+    for (auto &aq : k.session->activeQuests)
+      m_db.SaveQuestProgress(k.session->characterId, aq.questId,
+                             aq.killCount[0], aq.killCount[1],
+                             aq.killCount[2], false);
+  }
+  tx.Commit();
+
+  if (killCount > 1)
+    printf("[Server] Resolved %zu kills for %zu player(s)\n", killCount,
+           killers.size());
 }
 
 void Server::SaveSession(Session &session) {
   if (session.characterId <= 0)
     return;
 
+  // One transaction for the whole character (stats, inventory, equipment,
+  // quests, pending chat log) — joins the caller's transaction during autosave
+  Database::Transaction tx(m_db);
+  m_db.FlushChatLog();
+
   // Convert world position back to grid coordinates
   uint8_t posX = static_cast<uint8_t>(session.worldZ / 100.0f);
   uint8_t posY = static_cast<uint8_t>(session.worldX / 100.0f);
@@ -929,49 +1131,462 @@ void Server::SaveSession(Session &session) {
     m_db.SaveQuestProgress(session.characterId, aq.questId,
                            aq.killCount[0], aq.killCount[1], aq.killCount[2], false);
   }
+  tx.Commit();
 }
 
 void Server::Stop() {
   m_running = false;
+  StopIo();
   if (m_listenFd >= 0) {
     close(m_listenFd);
     m_listenFd = -1;
   }
+  if (m_handoffFd >= 0) {
+    close(m_handoffFd);
+    m_handoffFd = -1;
+    // After a handoff the path belongs to the successor's socket
+    if (!m_handedOff)
+      unlink(m_handoffPath.c_str());
+  }
   m_sessions.clear();
   m_db.Close();
 }
 
-void Server::AcceptNewClients() {
-  while (true) {
-    struct sockaddr_in clientAddr{};
-    socklen_t addrLen = sizeof(clientAddr);
-    int clientFd =
-        accept(m_listenFd, reinterpret_cast<sockaddr *>(&clientAddr), &addrLen);
-    if (clientFd < 0) {
-      if (errno == EAGAIN || errno == EWOULDBLOCK)
-        break;
-      perror("[Server] accept");
-      break;
-    }
+// ─── Network I/O ───────────────────────────────────────────────────────
 
-    // Set non-blocking
-    int flags = fcntl(clientFd, F_GETFL, 0);
-    fcntl(clientFd, F_SETFL, flags | O_NONBLOCK);
+bool Server::StartIo() {
+  if (pipe(m_wakePipe) < 0) {
+    perror("[Server] pipe");
+    return false;
+  }
+  for (int fd : m_wakePipe) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  }
 
-    // Disable Nagle's algorithm for low latency
-    int tcpNoDelay = 1;
-    setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &tcpNoDelay,
-               sizeof(tcpNoDelay));
+  for (int i = 0; i < m_ioThreadCount; i++)
+    m_reactors.push_back(
+        std::make_unique<IoReactor>(i, m_listenFd, m_wakePipe[1]));
+  // Connections inherited from a hot restart go back to their session's reactor
+  for (auto &conn : m_adoptConns)
+    m_reactors[m_sessionsByFd[conn.fd]->GetReactor()]->Adopt(std::move(conn));
+  m_adoptConns.clear();
+
+  for (auto &reactor : m_reactors) {
+    if (!reactor->Start()) {
+      StopIo();
+      return false;
+    }
+  }
+  m_ioBacklog.assign(m_reactors.size(), {});
+  m_ioWake.assign(m_reactors.size(), false);
+  return true;
+}
 
-    char ip[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &clientAddr.sin_addr, ip, sizeof(ip));
-    printf("[Server] New client from %s:%d (fd=%d)\n", ip,
-           ntohs(clientAddr.sin_port), clientFd);
+void Server::StopIo() {
+  // Joining the reactors closes every client socket they still own
+  for (auto &reactor : m_reactors)
+    reactor->Stop();
+  m_reactors.clear();
+  m_ioBacklog.clear();
+  m_ioWake.clear();
+  m_sessionsByFd.clear();
+  for (int &fd : m_wakePipe) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+}
+
+std::vector<IoHandoffConn> Server::DetachIo() {
+  FlushSessionOutput();
+  std::vector<IoHandoffConn> conns;
+  for (size_t r = 0; r < m_reactors.size(); r++) {
+    auto part = m_reactors[r]->Detach(m_ioBacklog[r]);
+    for (auto &conn : part)
+      conns.push_back(std::move(conn));
+  }
+  m_reactors.clear();
+  m_ioBacklog.clear();
+  m_ioWake.clear();
+  for (int &fd : m_wakePipe) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+  return conns;
+}
 
-    auto session = std::make_unique<Session>(clientFd);
+void Server::AdoptConnections(std::vector<IoHandoffConn> &&conns) {
+  for (auto &conn : conns) {
+    if (m_sessionsByFd.count(conn.fd))
+      continue;
+    // Accepted while the handoff was under way: greet it like a new client
+    auto session = std::make_unique<Session>(
+        conn.fd, static_cast<int>(m_sessions.size() % m_ioThreadCount));
+    m_sessionsByFd[conn.fd] = session.get();
     OnClientConnected(*session);
     m_sessions.push_back(std::move(session));
   }
+  m_adoptConns = std::move(conns);
+}
+
+void Server::DrainIoEvents() {
+  IoEvent ev;
+  for (auto &reactor : m_reactors) {
+    // Bounded per loop so a packet flood can't hold the tick forever
+    for (size_t n = 0; n < IoReactor::QUEUE_CAPACITY && reactor->PopEvent(ev);
+         n++) {
+      if (ev.type == IoEvent::CONNECTED) {
+        auto session = std::make_unique<Session>(ev.fd, reactor->GetIndex());
+        m_sessionsByFd[ev.fd] = session.get();
+        OnClientConnected(*session);
+        m_sessions.push_back(std::move(session));
+        continue;
+      }
+
+      // Events for a session we already released are stale, ignore them
+      auto it = m_sessionsByFd.find(ev.fd);
+      if (it == m_sessionsByFd.end())
+        continue;
+      Session &session = *it->second;
+
+      if (ev.type == IoEvent::DISCONNECTED) {
+        session.Kill();
+        continue;
+      }
+      if (!session.IsAlive())
+        continue;
+      // Anything already waiting goes first, so order is kept per session
+      if (!session.deferredPackets.empty() || !DispatchPacket(session, ev.data))
+        DeferPacket(session, std::move(ev.data));
+    }
+  }
+}
+
+bool Server::DispatchPacket(Session &session,
+                            const std::vector<uint8_t> &packet) {
+  // The first packet of a tick always fits the budget, so one slow handler
+  // delays the session's next packets instead of starving it
+  if (session.tickHandlerUs >= RateLimit::TICK_BUDGET_US) {
+    m_rateStats.budgetDeferred++;
+    return false;
+  }
+
+  size_t opcodeAt = (packet[0] == 0xC2 || packet[0] == 0xC4) ? 3 : 2;
+  if (packet.size() > opcodeAt) {
+    int rule = RateLimit::RuleFor(packet[opcodeAt]);
+    if (rule >= 0) {
+      if (session.rateTokens[rule] < 1.0f) {
+        m_rateStats.rateDeferred++;
+        return false;
+      }
+      session.rateTokens[rule] -= 1.0f;
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  HandlePacket(session, packet);
+  // Check if player walked into a gate zone (after position updates)
+  if (session.inWorld && session.IsAlive() && !session.dead)
+    CheckGateZones(session);
+  int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+  session.tickHandlerUs += us;
+  session.handlerUsTotal += us;
+  return true;
+}
+
+void Server::DeferPacket(Session &session, std::vector<uint8_t> &&packet) {
+  session.deferredPackets.push_back(std::move(packet));
+  session.packetsDeferred++;
+  if (session.deferredPackets.size() <= static_cast<size_t>(m_kickBacklog))
+    return;
+
+  // Sending faster than any client would, for long enough to fill the backlog
+  printf("[RateLimit] fd=%d (%s) has %zu packets waiting (limit %d), "
+         "disconnecting\n",
+         session.GetFd(), session.characterName.c_str(),
+         session.deferredPackets.size(), m_kickBacklog);
+  session.deferredPackets.clear();
+  session.Kill();
+  m_rateStats.kicked++;
+}
+
+void Server::ProcessDeferredPackets(float dt) {
+  size_t backlogged = 0;
+  for (size_t i = 0; i < m_sessions.size(); i++) {
+    Session &session = *m_sessions[i];
+    for (int r = 0; r < RateLimit::RULE_COUNT; r++) {
+      const RateLimit::Rule &rule = RateLimit::GetRule(r);
+      session.rateTokens[r] =
+          std::min(rule.burst, session.rateTokens[r] + rule.perSecond * dt);
+    }
+    session.tickHandlerUs = 0;
+
+    while (!session.deferredPackets.empty() && session.IsAlive() &&
+           DispatchPacket(session, session.deferredPackets.front()))
+      session.deferredPackets.pop_front();
+    if (!session.deferredPackets.empty())
+      backlogged++;
+  }
+
+  // Quiet unless something was actually limited
+  static constexpr float REPORT_INTERVAL = 10.0f;
+  m_rateReportTimer += dt;
+  if (m_rateReportTimer < REPORT_INTERVAL)
+    return;
+  m_rateReportTimer = 0.0f;
+  const RateLimitStats &now = m_rateStats, &last = m_rateStatsReported;
+  if (now.rateDeferred != last.rateDeferred ||
+      now.budgetDeferred != last.budgetDeferred || now.kicked != last.kicked)
+    printf("[RateLimit] Last %.0fs: %llu packet(s) over rate, %llu over tick "
+           "budget, %zu session(s) backlogged, %llu kicked\n",
+           REPORT_INTERVAL,
+           (unsigned long long)(now.rateDeferred - last.rateDeferred),
+           (unsigned long long)(now.budgetDeferred - last.budgetDeferred),
+           backlogged, (unsigned long long)(now.kicked - last.kicked));
+  m_rateStatsReported = m_rateStats;
+}
+
+void Server::SubmitIo(int reactor, IoCommand &cmd) {
+  // Keep per-reactor ordering: once backlogged, queue behind the backlog
+  auto &backlog = m_ioBacklog[reactor];
+  if (!backlog.empty() || !m_reactors[reactor]->PushCommand(cmd))
+    backlog.push_back(std::move(cmd));
+  m_ioWake[reactor] = true;
+}
+
+void Server::FlushSessionOutput() {
+  for (size_t r = 0; r < m_reactors.size(); r++) {
+    auto &backlog = m_ioBacklog[r];
+    size_t pushed = 0;
+    while (pushed < backlog.size() && m_reactors[r]->PushCommand(backlog[pushed]))
+      pushed++;
+    if (pushed > 0) {
+      backlog.erase(backlog.begin(), backlog.begin() + pushed);
+      m_ioWake[r] = true;
+    }
+  }
+
+  IoCommand cmd;
+  for (auto &s : m_sessions) {
+    if (!s->HasPendingSend() || s->GetFd() < 0)
+      continue;
+    cmd.type = IoCommand::SEND;
+    cmd.fd = s->GetFd();
+    cmd.data = s->TakeSendBuffer();
+    SubmitIo(s->GetReactor(), cmd);
+  }
+
+  for (size_t r = 0; r < m_reactors.size(); r++) {
+    if (m_ioWake[r]) {
+      m_ioWake[r] = false;
+      m_reactors[r]->Wake();
+    }
+  }
+}
+
+void Server::ReleaseSession(Session &session) {
+  if (session.GetFd() < 0 || m_reactors.empty())
+    return;
+  m_sessionsByFd.erase(session.GetFd());
+  IoCommand cmd;
+  cmd.type = IoCommand::CLOSE;
+  cmd.fd = session.GetFd();
+  SubmitIo(session.GetReactor(), cmd);
+}
+
+// ─── Hot restart ───────────────────────────────────────────────────────
+
+// Per-connection record in the handoff blob
+enum HandoffSession : uint8_t { HANDOFF_NO_SESSION, HANDOFF_ALIVE, HANDOFF_KILLED };
+
+void Server::ServeHandoff() {
+  int sock = accept4(m_handoffFd, nullptr, nullptr, SOCK_CLOEXEC);
+  if (sock < 0)
+    return;
+  Handoff::SetTimeout(sock, 30);
+
+  Handoff::Hello hello;
+  Handoff::Offer offer;
+  if (!Handoff::RecvAll(sock, &hello, sizeof(hello)) ||
+      hello.magic != Handoff::MAGIC) {
+    close(sock);
+    return;
+  }
+  if (hello.version != Handoff::VERSION ||
+      hello.layoutKey != Handoff::LayoutKey()) {
+    printf("[Handoff] Refusing takeover: state format differs (version %u, "
+           "ours %u); restart normally instead\n",
+           hello.version, Handoff::VERSION);
+    Handoff::SendAll(sock, &offer, sizeof(offer));
+    close(sock);
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  printf("[Handoff] Successor connected, handing over %zu session(s)\n",
+         m_sessions.size());
+
+  // The database is current whatever happens next
+  {
+    Database::Transaction tx(m_db);
+    for (auto &s : m_sessions) {
+      if (s->IsAlive() && s->inWorld)
+        SaveSession(*s);
+    }
+    tx.Commit();
+  }
+
+  std::vector<IoHandoffConn> conns = DetachIo();
+
+  Handoff::Writer blob;
+  m_world.SaveState(blob);
+  blob.Put<uint32_t>(static_cast<uint32_t>(conns.size()));
+  std::vector<int> fds = {m_listenFd};
+  for (const auto &conn : conns) {
+    fds.push_back(conn.fd);
+    blob.Put<int32_t>(conn.fd);
+    blob.Put<uint8_t>(conn.open);
+    blob.PutBlob(conn.input);
+    blob.PutBlob(conn.output);
+    auto it = m_sessionsByFd.find(conn.fd);
+    if (it == m_sessionsByFd.end()) {
+      blob.Put<uint8_t>(HANDOFF_NO_SESSION);
+      continue;
+    }
+    blob.Put<uint8_t>(it->second->IsAlive() ? HANDOFF_ALIVE : HANDOFF_KILLED);
+    Handoff::WriteSession(blob, *it->second);
+  }
+
+  offer.accepted = 1;
+  offer.fdCount = static_cast<uint32_t>(fds.size());
+  offer.blobSize = blob.Data().size();
+  Handoff::Ack ack;
+  bool done = Handoff::SendAll(sock, &offer, sizeof(offer)) &&
+              Handoff::SendFds(sock, fds) &&
+              Handoff::SendAll(sock, blob.Data().data(), blob.Data().size()) &&
+              Handoff::RecvAll(sock, &ack, sizeof(ack)) &&
+              ack.magic == Handoff::MAGIC && ack.ok;
+  close(sock);
+
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+  if (done) {
+    printf("[Handoff] Handed over %zu connection(s), %.1f KiB of state, in "
+           "%.1f ms\n",
+           conns.size(), blob.Data().size() / 1024.0, ms);
+    // The successor holds its own copies of every socket
+    for (const auto &conn : conns)
+      close(conn.fd);
+    m_handedOff = true;
+    m_running = false;
+    return;
+  }
+
+  printf("[Handoff] Takeover failed after %.1f ms, resuming with %zu "
+         "connection(s)\n",
+         ms, conns.size());
+  AdoptConnections(std::move(conns));
+  if (!StartIo())
+    m_running = false;
+}
+
+bool Server::TakeOver(int sock) {
+  auto start = std::chrono::steady_clock::now();
+  Handoff::SetTimeout(sock, 30);
+
+  Handoff::Hello hello;
+  hello.layoutKey = Handoff::LayoutKey();
+  Handoff::Offer offer;
+  if (!Handoff::SendAll(sock, &hello, sizeof(hello)) ||
+      !Handoff::RecvAll(sock, &offer, sizeof(offer)) ||
+      offer.magic != Handoff::MAGIC) {
+    printf("[Handoff] No answer from the running server\n");
+    return false;
+  }
+  if (!offer.accepted) {
+    printf("[Handoff] Running server refused the takeover (different build "
+           "state format); stop it and start normally\n");
+    return false;
+  }
+
+  std::vector<int> fds;
+  std::vector<uint8_t> blob(offer.blobSize);
+  bool ok = Handoff::RecvFds(sock, offer.fdCount, fds) &&
+            Handoff::RecvAll(sock, blob.data(), blob.size()) &&
+            ImportState(fds, blob);
+  Handoff::Ack ack;
+  ack.ok = ok;
+  if (!ok || !Handoff::SendAll(sock, &ack, sizeof(ack))) {
+    // Without our ack the old process resumes with its own copies
+    printf("[Handoff] Takeover failed\n");
+    for (int fd : fds)
+      close(fd);
+    m_listenFd = -1;
+    m_adoptConns.clear();
+    m_sessionsByFd.clear();
+    m_sessions.clear();
+    return false;
+  }
+
+  printf("[Handoff] Took over %zu session(s), %.1f KiB of state, in %.1f ms\n",
+         m_sessions.size(), blob.size() / 1024.0,
+         std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+             .count());
+  return true;
+}
+
+bool Server::ImportState(const std::vector<int> &fds,
+                         const std::vector<uint8_t> &blob) {
+  Handoff::Reader in(blob.data(), blob.size());
+  uint32_t connCount = 0;
+  if (!m_world.LoadState(in) || !in.Get(connCount) ||
+      static_cast<size_t>(connCount) + 1 != fds.size())
+    return false;
+
+  std::unordered_map<int, int> fdMap; // Old process fd -> ours
+  std::vector<IoHandoffConn> conns;
+  for (uint32_t i = 0; i < connCount; i++) {
+    IoHandoffConn conn;
+    conn.fd = fds[i + 1];
+    int32_t oldFd = -1;
+    uint8_t open = 0, state = HANDOFF_NO_SESSION;
+    in.Get(oldFd);
+    in.Get(open);
+    in.GetBlob(conn.input);
+    in.GetBlob(conn.output);
+    in.Get(state);
+    if (!in.Ok())
+      return false;
+    conn.open = open != 0;
+
+    if (state != HANDOFF_NO_SESSION) {
+      auto session = std::make_unique<Session>(
+          conn.fd, static_cast<int>(i % m_ioThreadCount));
+      if (!Handoff::ReadSession(in, *session))
+        return false;
+      if (state == HANDOFF_KILLED)
+        session->Kill();
+      fdMap[oldFd] = conn.fd;
+      m_sessionsByFd[conn.fd] = session.get();
+      m_sessions.push_back(std::move(session));
+    }
+    conns.push_back(std::move(conn));
+  }
+  if (!in.AtEnd())
+    return false;
+
+  m_world.RemapPlayerFds(fdMap);
+  m_listenFd = fds[0];
+  AdoptConnections(std::move(conns));
+  return true;
 }
 
 void Server::OnClientConnected(Session &session) {
@@ -1069,6 +1684,11 @@ void Server::CheckGateZones(Session &session) {
 
 void Server::TransitionMap(Session &session, uint8_t newMapId,
                            uint8_t spawnX, uint8_t spawnY) {
+  if (!HostsMap(newMapId)) {
+    MigrateSession(session, newMapId, spawnX, spawnY);
+    return;
+  }
+
   printf("[Server] Map transition: fd=%d map %d -> %d spawn (%d,%d)\n",
          session.GetFd(), session.mapId, newMapId, spawnX, spawnY);
 
@@ -1088,16 +1708,19 @@ void Server::TransitionMap(Session &session, uint8_t newMapId,
   session.gateTransitionCooldown = 3.0f; // 3 second cooldown
   session.worldX = spawnY * 100.0f;
   session.worldZ = spawnX * 100.0f;
+  session.StopMoving();
   session.wasInSafeZone = false; // Reset — new map spawn is outside safe zone initially
 
   // Save position to DB immediately (including map change)
   m_db.UpdatePosition(session.characterId, spawnX, spawnY, newMapId);
 
-  // Reload world data for new map
-  m_world.ClearWorldData();
-  m_world.SetActiveMap(newMapId);
-  m_world.LoadNpcsFromDB(m_db, newMapId);
-  m_world.LoadMonstersFromDB(m_db, newMapId);
+  // Reload world data for new map (a backend's world is always its map)
+  if (!IsBackend()) {
+    m_world.ClearWorldData();
+    m_world.SetActiveMap(newMapId);
+    m_world.LoadNpcsFromDB(m_db, newMapId);
+    m_world.LoadMonstersFromDB(m_db, newMapId);
+  }
 
   // Send map change packet to client
   PMSG_MAP_CHANGE_SEND pkt{};
@@ -1155,3 +1778,151 @@ void Server::TransitionMap(Session &session, uint8_t newMapId,
          newMapId, m_world.GetNpcs().size(),
          m_world.GetMonsterInstances().size());
 }
+
+// ─── Gateway backend ───────────────────────────────────────────────────
+
+static void sendMigrate(Session &session, GatewayMigrateKind kind,
+                        uint8_t mapId, uint8_t spawnX, uint8_t spawnY,
+                        const uint8_t *payload, size_t len) {
+  PMSG_GATEWAY_MIGRATE_HEAD head{};
+  size_t total = sizeof(head) + len;
+  head.h = MakeC2Header(static_cast<uint16_t>(total), Opcode::GATEWAY);
+  head.subcode = Opcode::SUB_GATEWAY_MIGRATE;
+  head.kind = kind;
+  head.mapId = mapId;
+  head.spawnX = spawnX;
+  head.spawnY = spawnY;
+  head.accountId = session.accountId;
+  std::vector<uint8_t> pkt(total);
+  memcpy(pkt.data(), &head, sizeof(head));
+  memcpy(pkt.data() + sizeof(head), payload, len);
+  session.Send(pkt.data(), pkt.size());
+}
+
+void Server::MigrateSession(Session &session, uint8_t mapId, uint8_t spawnX,
+                            uint8_t spawnY) {
+  // The summon belongs to this backend's world (type kept for a respawn)
+  if (session.activeSummonIndex > 0) {
+    PMSG_SUMMON_DESPAWN_SEND dpkt{};
+    dpkt.h = MakeC1Header(sizeof(dpkt), Opcode::SUMMON_DESPAWN);
+    dpkt.monsterIndex = session.activeSummonIndex;
+    Broadcast(&dpkt, sizeof(dpkt));
+    m_world.DespawnSummon(session.activeSummonIndex);
+    session.activeSummonIndex = 0;
+  }
+  m_world.ClearGuardInteractionsForPlayer(session.GetFd());
+
+  session.mapId = mapId;
+  session.worldX = spawnY * 100.0f;
+  session.worldZ = spawnX * 100.0f;
+  session.StopMoving();
+  session.deferredPackets.clear(); // Meant for this backend
+  SaveSession(session);
+  m_db.EvictChatHistory(session.characterId); // The target backend appends now
+
+  Handoff::Writer blob;
+  Handoff::WriteSession(blob, session);
+  if (blob.Data().size() + sizeof(PMSG_GATEWAY_MIGRATE_HEAD) > 0xFFFF) {
+    printf("[Gateway] Session of fd=%d too large to migrate (%zu bytes)\n",
+           session.GetFd(), blob.Data().size());
+    session.Kill();
+    return;
+  }
+  sendMigrate(session, MIGRATE_SESSION, mapId, spawnX, spawnY,
+              blob.Data().data(), blob.Data().size());
+  printf("[Gateway] fd=%d (%s) migrating to map %d (%zu byte session)\n",
+         session.GetFd(), session.characterName.c_str(), mapId,
+         blob.Data().size());
+
+  // The target backend owns the character now (nothing more is saved here);
+  // the gateway closes this connection
+  session.inWorld = false;
+  session.inCharSelect = false;
+}
+
+void Server::MigrateCharSelect(Session &session, uint8_t mapId,
+                               const std::vector<uint8_t> &selectPacket) {
+  sendMigrate(session, MIGRATE_CHARSELECT, mapId, 0, 0, selectPacket.data(),
+              selectPacket.size());
+  printf("[Gateway] fd=%d selecting a character on map %d, migrating\n",
+         session.GetFd(), mapId);
+  session.inWorld = false;
+  session.inCharSelect = false;
+}
+
+void Server::ResumeSession(Session &session,
+                           const std::vector<uint8_t> &packet) {
+  // Only a fresh gateway connection may be resumed
+  if (!IsBackend() || session.characterId != 0 || session.inWorld ||
+      packet.size() < sizeof(PMSG_GATEWAY_MIGRATE_HEAD)) {
+    printf("[Gateway] Unexpected RESUME on fd=%d, ignoring\n",
+           session.GetFd());
+    return;
+  }
+  PMSG_GATEWAY_MIGRATE_HEAD head;
+  memcpy(&head, packet.data(), sizeof(head));
+  uint8_t keyDiff = 0; // Constant time
+  for (size_t i = 0; i < GATEWAY_KEY_SIZE; i++)
+    keyDiff |= head.key[i] ^ m_gatewayKey[i];
+  if (keyDiff != 0) {
+    printf("[Gateway] RESUME with a bad gateway key on fd=%d, dropping\n",
+           session.GetFd());
+    session.Kill();
+    return;
+  }
+  const uint8_t *payload = packet.data() + sizeof(head);
+  size_t payloadLen = packet.size() - sizeof(head);
+  if (!HostsMap(head.mapId)) {
+    printf("[Gateway] RESUME for map %d on the map %d backend, dropping fd=%d\n",
+           head.mapId, m_hostedMap, session.GetFd());
+    session.Kill();
+    return;
+  }
+
+  // Output before this (welcome, character list) is dropped by the gateway
+  PMSG_GATEWAY_RESUMED_SEND ack{};
+  ack.h = MakeC1SubHeader(sizeof(ack), Opcode::GATEWAY,
+                          Opcode::SUB_GATEWAY_RESUMED);
+  session.Send(&ack, sizeof(ack));
+  session.accountId = head.accountId;
+
+  if (head.kind == MIGRATE_CHARSELECT) {
+    std::vector<uint8_t> select(payload, payload + payloadLen);
+    CharacterSelectHandler::HandleCharSelect(session, select, m_db, m_world,
+                                             *this);
+    return;
+  }
+
+  Handoff::Reader in(payload, payloadLen);
+  if (!Handoff::ReadSession(in, session)) {
+    printf("[Gateway] Bad session blob on fd=%d\n", session.GetFd());
+    session.Kill();
+    return;
+  }
+  // Stored state comes from the database (the old backend saved it before
+  // migrating); the blob only supplies what isn't persisted, like timers
+  CharacterData stored = m_db.GetCharacterById(session.characterId);
+  Database::CharacterLoad load;
+  if (stored.id == 0 || stored.accountId != head.accountId ||
+      !m_db.LoadCharacter(stored.name, load) ||
+      load.character.id != stored.id) {
+    printf("[Gateway] RESUME for character %d not owned by account %d, "
+           "dropping fd=%d\n",
+           session.characterId, head.accountId, session.GetFd());
+    session.Kill();
+    return;
+  }
+  session.accountId = head.accountId;
+  CharacterSelectHandler::ApplyStoredCharacter(session, m_db, load);
+  session.activeSummonType = load.character.summonType;
+  // Object indexes from the old backend mean nothing in this world
+  session.activeSummonIndex = 0;
+  session.attackTargetMonsterIdx = 0;
+  session.deferredPackets.clear();
+  session.inWorld = true;
+  session.inCharSelect = false;
+  printf("[Gateway] fd=%d (%s) resumed from another backend\n",
+         session.GetFd(), session.characterName.c_str());
+  // Same client-side flow as a local gate: MAP_CHANGE, then the viewport
+  TransitionMap(session, head.mapId, head.spawnX, head.spawnY);
+}
@@ -0,0 +1,381 @@
+#include "WorldSnapshot.hpp"
+#include "GameWorld.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ─── Source key ──────────────────────────────────────────────────────────────
+
+static uint64_t HashBytes(uint64_t h, const void *data, size_t len) {
+  // FNV-1a 64
+  auto *p = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 0x100000001B3ull;
+  }
+  return h;
+}
+
+template <typename T> static uint64_t HashValue(uint64_t h, const T &v) {
+  return HashBytes(h, &v, sizeof(v));
+}
+
+uint64_t WorldSnapshot::ComputeSourceKey(Database &db,
+                                         const TerrainSources &terrain) {
+  uint64_t h = 0xCBF29CE484222325ull;
+  h = HashValue(h, VERSION);
+  h = HashValue(h, Database::ITEM_SEED_REVISION);
+  h = HashValue(h, db.GetWorldTablesRevision());
+  for (auto &path : terrain) {
+    h = HashBytes(h, path.data(), path.size());
+    struct stat st {};
+    if (!path.empty() && stat(path.c_str(), &st) == 0) {
+      h = HashValue(h, static_cast<int64_t>(st.st_size));
+      h = HashValue(h, static_cast<int64_t>(st.st_mtime));
+    }
+  }
+  return h;
+}
+
+// ─── Build ───────────────────────────────────────────────────────────────────
+
+// 8-connected flood fill over walkable cells (same neighbourhood as PathFinder).
+// False if the map has more regions than a uint16_t label can tell apart.
+bool WorldSnapshot::LabelRegions(const uint8_t *attributes,
+                                 uint16_t *outLabels) {
+  static constexpr int8_t DX[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+  static constexpr int8_t DY[8] = {-1, 0, 1, 0, -1, 1, 1, -1};
+  const int size = GameWorld::TERRAIN_SIZE;
+  auto walkable = [&](int i) {
+    return (attributes[i] & (GameWorld::TW_NOMOVE | GameWorld::TW_NOGROUND)) ==
+           0;
+  };
+
+  std::memset(outLabels, 0, CELLS * sizeof(uint16_t));
+  std::vector<int> stack;
+  uint16_t next = 1;
+  for (int seed = 0; seed < CELLS; seed++) {
+    if (outLabels[seed] || !walkable(seed))
+      continue;
+    if (next == 0)
+      return false; // Wrapped past 0xFFFF
+    uint16_t label = next++;
+    outLabels[seed] = label;
+    stack.push_back(seed);
+    while (!stack.empty()) {
+      int cur = stack.back();
+      stack.pop_back();
+      int cx = cur % size, cy = cur / size;
+      for (int d = 0; d < 8; d++) {
+        int nx = cx + DX[d], ny = cy + DY[d];
+        if (nx < 0 || ny < 0 || nx >= size || ny >= size)
+          continue;
+        int n = ny * size + nx;
+        if (outLabels[n] || !walkable(n))
+          continue;
+        outLabels[n] = label;
+        stack.push_back(n);
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+static void AppendSection(std::vector<uint8_t> &payload,
+                          std::vector<uint64_t> &offsets, const T *data,
+                          size_t count) {
+  payload.resize((payload.size() + 7) & ~size_t(7));
+  offsets.push_back(payload.size());
+  auto *bytes = reinterpret_cast<const uint8_t *>(data);
+  payload.insert(payload.end(), bytes, bytes + count * sizeof(T));
+}
+
+// False (and nothing copied) if src doesn't fit with its terminator
+static bool CopyName(char *dst, size_t dstSize, const std::string &src) {
+  std::memset(dst, 0, dstSize);
+  if (src.size() >= dstSize)
+    return false;
+  std::memcpy(dst, src.data(), src.size());
+  return true;
+}
+
+bool WorldSnapshot::Build(const std::string &path, uint64_t sourceKey,
+                          Database &db, const TerrainSources &terrain) {
+  std::vector<Section> sections;
+  std::vector<uint64_t> offsets;
+  std::vector<uint8_t> payload;
+
+  // Items
+  std::vector<ItemRecord> items;
+  for (auto &def : db.GetAllItemDefinitions()) {
+    ItemRecord r{};
+    r.id = def.id;
+    r.category = def.category;
+    r.itemIndex = def.itemIndex;
+    r.attackSpeed = def.attackSpeed;
+    r.twoHanded = def.twoHanded;
+    r.width = def.width;
+    r.height = def.height;
+    r.level = def.level;
+    r.damageMin = def.damageMin;
+    r.damageMax = def.damageMax;
+    r.defense = def.defense;
+    r.reqStrength = def.reqStrength;
+    r.reqDexterity = def.reqDexterity;
+    r.reqVitality = def.reqVitality;
+    r.reqEnergy = def.reqEnergy;
+    r.magicPower = def.magicPower;
+    r.classFlags = def.classFlags;
+    r.buyPrice = def.buyPrice;
+    if (!CopyName(r.name, sizeof(r.name), def.name) ||
+        !CopyName(r.modelFile, sizeof(r.modelFile), def.modelFile)) {
+      printf("[Snapshot] Item %d: name '%s' or model '%s' longer than %zu "
+             "characters, not building %s\n",
+             def.id, def.name.c_str(), def.modelFile.c_str(),
+             sizeof(r.name) - 1, path.c_str());
+      return false;
+    }
+    items.push_back(r);
+  }
+  sections.push_back({SECTION_ITEMS, 0, 0, items.size() * sizeof(ItemRecord)});
+  AppendSection(payload, offsets, items.data(), items.size());
+
+  // Spawns (all maps in one table each)
+  std::vector<NpcRecord> npcs;
+  std::vector<MonsterRecord> monsters;
+  for (int mapId = 0; mapId < MAX_MAPS; mapId++) {
+    for (auto &s : db.GetNpcSpawns(static_cast<uint8_t>(mapId))) {
+      NpcRecord r{};
+      r.id = s.id;
+      r.type = s.type;
+      r.mapId = s.mapId;
+      r.posX = s.posX;
+      r.posY = s.posY;
+      r.direction = s.direction;
+      if (!CopyName(r.name, sizeof(r.name), s.name)) {
+        printf("[Snapshot] NPC spawn %d: name '%s' longer than %zu "
+               "characters, not building %s\n",
+               s.id, s.name.c_str(), sizeof(r.name) - 1, path.c_str());
+        return false;
+      }
+      npcs.push_back(r);
+    }
+    for (auto &s : db.GetMonsterSpawns(static_cast<uint8_t>(mapId)))
+      monsters.push_back({s.id, s.type, s.mapId, s.posX, s.posY, s.direction});
+  }
+  sections.push_back(
+      {SECTION_NPC_SPAWNS, 0, 0, npcs.size() * sizeof(NpcRecord)});
+  AppendSection(payload, offsets, npcs.data(), npcs.size());
+  sections.push_back(
+      {SECTION_MONSTER_SPAWNS, 0, 0, monsters.size() * sizeof(MonsterRecord)});
+  AppendSection(payload, offsets, monsters.data(), monsters.size());
+
+  // Terrain attributes + derived connectivity
+  std::vector<uint16_t> labels(CELLS);
+  for (size_t mapId = 0; mapId < terrain.size() && mapId < MAX_MAPS; mapId++) {
+    std::vector<uint8_t> attrs;
+    if (terrain[mapId].empty() ||
+        !GameWorld::ParseTerrainAttributeFile(terrain[mapId], attrs))
+      continue;
+    if (!LabelRegions(attrs.data(), labels.data())) {
+      printf("[Snapshot] Map %zu has more than %d walkable regions, not "
+             "building %s\n",
+             mapId, 0xFFFF, path.c_str());
+      return false;
+    }
+    sections.push_back({SECTION_TERRAIN, static_cast<uint32_t>(mapId), 0,
+                        static_cast<uint64_t>(CELLS)});
+    AppendSection(payload, offsets, attrs.data(), attrs.size());
+    sections.push_back({SECTION_REGIONS, static_cast<uint32_t>(mapId), 0,
+                        CELLS * sizeof(uint16_t)});
+    AppendSection(payload, offsets, labels.data(), labels.size());
+  }
+
+  Header header{MAGIC, VERSION, sourceKey,
+                static_cast<uint32_t>(sections.size()), 0};
+  uint64_t dataStart = sizeof(Header) + sections.size() * sizeof(Section);
+  dataStart = (dataStart + 7) & ~uint64_t(7);
+  for (size_t i = 0; i < sections.size(); i++)
+    sections[i].offset = dataStart + offsets[i];
+
+  // Write to a temp file and rename, so a crash never leaves a torn snapshot
+  std::string tmpPath = path + ".tmp";
+  FILE *f = fopen(tmpPath.c_str(), "wb");
+  if (!f) {
+    printf("[Snapshot] Cannot write %s\n", tmpPath.c_str());
+    return false;
+  }
+  static const uint8_t pad[8] = {};
+  size_t headerBytes = sizeof(Header) + sections.size() * sizeof(Section);
+  bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+            fwrite(sections.data(), sizeof(Section), sections.size(), f) ==
+                sections.size() &&
+            fwrite(pad, 1, dataStart - headerBytes, f) ==
+                dataStart - headerBytes &&
+            fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+  ok = (fclose(f) == 0) && ok;
+  if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+    printf("[Snapshot] Failed to write %s\n", path.c_str());
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  printf("[Snapshot] Built %s: %zu items, %zu NPC spawns, %zu monster spawns, "
+         "%zu sections, %llu bytes\n",
+         path.c_str(), items.size(), npcs.size(), monsters.size(),
+         sections.size(),
+         static_cast<unsigned long long>(dataStart + payload.size()));
+  return true;
+}
+
+// ─── Open / access ───────────────────────────────────────────────────────────
+
+WorldSnapshot::~WorldSnapshot() { Close(); }
+
+bool WorldSnapshot::Open(const std::string &path, uint64_t sourceKey) {
+  Close();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+    close(fd);
+    return false;
+  }
+  void *base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return false;
+
+  m_base = static_cast<const uint8_t *>(base);
+  m_size = static_cast<size_t>(st.st_size);
+
+  auto *header = reinterpret_cast<const Header *>(m_base);
+  bool valid = header->magic == MAGIC && header->version == VERSION &&
+               header->sourceKey == sourceKey &&
+               sizeof(Header) + header->sectionCount * sizeof(Section) <= m_size;
+  for (uint32_t i = 0; valid && i < header->sectionCount; i++) {
+    auto &s = reinterpret_cast<const Section *>(m_base + sizeof(Header))[i];
+    valid = s.offset % 8 == 0 && s.offset + s.size <= m_size;
+  }
+  if (!valid) {
+    printf("[Snapshot] %s is stale or invalid\n", path.c_str());
+    Close();
+    return false;
+  }
+  printf("[Snapshot] Mapped %s (%zu bytes, %u sections)\n", path.c_str(),
+         m_size, header->sectionCount);
+  return true;
+}
+
+void WorldSnapshot::Close() {
+  if (m_base) {
+    munmap(const_cast<uint8_t *>(m_base), m_size);
+    m_base = nullptr;
+    m_size = 0;
+  }
+}
+
+const WorldSnapshot::Section *WorldSnapshot::FindSection(uint32_t id,
+                                                         uint32_t mapId) const {
+  if (!m_base)
+    return nullptr;
+  auto *header = reinterpret_cast<const Header *>(m_base);
+  auto *sections = reinterpret_cast<const Section *>(m_base + sizeof(Header));
+  for (uint32_t i = 0; i < header->sectionCount; i++) {
+    if (sections[i].id == id && sections[i].mapId == mapId)
+      return &sections[i];
+  }
+  return nullptr;
+}
+
+template <typename T>
+const T *WorldSnapshot::SectionData(uint32_t id, uint32_t mapId,
+                                    size_t &count) const {
+  const Section *s = FindSection(id, mapId);
+  count = s ? s->size / sizeof(T) : 0;
+  return s ? reinterpret_cast<const T *>(m_base + s->offset) : nullptr;
+}
+
+std::vector<ItemDefinition> WorldSnapshot::GetItemDefinitions() const {
+  std::vector<ItemDefinition> items;
+  size_t count = 0;
+  auto *records = SectionData<ItemRecord>(SECTION_ITEMS, 0, count);
+  items.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const ItemRecord &r = records[i];
+    ItemDefinition def;
+    def.id = r.id;
+    def.category = r.category;
+    def.itemIndex = r.itemIndex;
+    def.name = r.name;
+    def.modelFile = r.modelFile;
+    def.level = r.level;
+    def.damageMin = r.damageMin;
+    def.damageMax = r.damageMax;
+    def.defense = r.defense;
+    def.attackSpeed = r.attackSpeed;
+    def.twoHanded = r.twoHanded;
+    def.width = r.width;
+    def.height = r.height;
+    def.reqStrength = r.reqStrength;
+    def.reqDexterity = r.reqDexterity;
+    def.reqVitality = r.reqVitality;
+    def.reqEnergy = r.reqEnergy;
+    def.classFlags = r.classFlags;
+    def.buyPrice = r.buyPrice;
+    def.magicPower = r.magicPower;
+    items.push_back(std::move(def));
+  }
+  return items;
+}
+
+std::vector<NpcSpawnData> WorldSnapshot::GetNpcSpawns(uint8_t mapId) const {
+  std::vector<NpcSpawnData> npcs;
+  size_t count = 0;
+  auto *records = SectionData<NpcRecord>(SECTION_NPC_SPAWNS, 0, count);
+  for (size_t i = 0; i < count; i++) {
+    const NpcRecord &r = records[i];
+    if (r.mapId != mapId)
+      continue;
+    NpcSpawnData n;
+    n.id = r.id;
+    n.type = r.type;
+    n.mapId = r.mapId;
+    n.posX = r.posX;
+    n.posY = r.posY;
+    n.direction = r.direction;
+    n.name = r.name;
+    npcs.push_back(std::move(n));
+  }
+  return npcs;
+}
+
+std::vector<MonsterSpawnData>
+WorldSnapshot::GetMonsterSpawns(uint8_t mapId) const {
+  std::vector<MonsterSpawnData> monsters;
+  size_t count = 0;
+  auto *records = SectionData<MonsterRecord>(SECTION_MONSTER_SPAWNS, 0, count);
+  for (size_t i = 0; i < count; i++) {
+    const MonsterRecord &r = records[i];
+    if (r.mapId == mapId)
+      monsters.push_back({r.id, r.type, r.mapId, r.posX, r.posY, r.direction});
+  }
+  return monsters;
+}
+
+const uint8_t *WorldSnapshot::GetTerrainAttributes(uint8_t mapId) const {
+  size_t count = 0;
+  auto *data = SectionData<uint8_t>(SECTION_TERRAIN, mapId, count);
+  return count == CELLS ? data : nullptr;
+}
+
+const uint16_t *WorldSnapshot::GetRegionLabels(uint8_t mapId) const {
+  size_t count = 0;
+  auto *data = SectionData<uint16_t>(SECTION_REGIONS, mapId, count);
+  return count == CELLS ? data : nullptr;
+}
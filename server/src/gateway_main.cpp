@@ -0,0 +1,56 @@
+#include "Gateway.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char *argv[]) {
+    setbuf(stdout, nullptr); // Disable buffering for log visibility
+    printf("=== MU Online Gateway ===\n\n");
+
+    // Usage: MuGateway [port] --backend=MAP@HOST:PORT [--backend=...]
+    // The first backend is the lobby (login and character select). The
+    // backends' MU_GATEWAY_SECRET must be set in the environment too.
+    uint16_t port = 44405;
+    std::vector<Gateway::Backend> backends;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strncmp(arg, "--backend=", 10) == 0) {
+            std::string spec = arg + 10;
+            size_t at = spec.find('@');
+            size_t colon = spec.rfind(':');
+            if (at == std::string::npos || colon == std::string::npos ||
+                colon < at) {
+                printf("Invalid backend (want MAP@HOST:PORT): %s\n", arg + 10);
+                return 1;
+            }
+            Gateway::Backend b;
+            b.mapId = static_cast<uint8_t>(std::atoi(spec.substr(0, at).c_str()));
+            b.host = spec.substr(at + 1, colon - at - 1);
+            b.port = static_cast<uint16_t>(std::atoi(spec.c_str() + colon + 1));
+            backends.push_back(b);
+        } else if (arg[0] != '-') {
+            port = static_cast<uint16_t>(std::atoi(arg));
+        } else {
+            printf("Unknown option: %s\n", arg);
+            return 1;
+        }
+    }
+
+    Gateway gateway;
+    const char *secret = std::getenv("MU_GATEWAY_SECRET");
+    if (!secret || !gateway.SetSecret(secret)) {
+        printf("MU_GATEWAY_SECRET must be set to 16-32 bytes\n");
+        return 1;
+    }
+    if (!gateway.Start(port, std::move(backends))) {
+        printf("Failed to start gateway\n");
+        return 1;
+    }
+
+    gateway.Run();
+    gateway.Stop();
+
+    printf("Gateway stopped.\n");
+    return 0;
+}
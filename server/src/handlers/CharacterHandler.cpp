@@ -2,6 +2,7 @@
 #include "PacketDefs.hpp"
 #include "StatCalculator.hpp"
 #include "handlers/InventoryHandler.hpp"
+#include "handlers/WorldHandler.hpp"
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
@@ -17,9 +18,12 @@ void SendCharStats(Session &session, Database &db, int characterId) {
     printf("[Character] Character %d not found for stats send\n", characterId);
     return;
   }
+  SendCharStats(session, db, c, db.GetCharacterEquipment(characterId));
+}
 
+void SendCharStats(Session &session, Database &db, const CharacterData &c,
+                   const std::vector<EquipmentSlot> &equip) {
   // Pre-calculate equipment defense using same formula as RefreshCombatStats
-  auto equip = db.GetCharacterEquipment(characterId);
   session.totalDefense = 0;
   for (auto &slot : equip) {
     auto itemDef = db.GetItemDefinition(slot.category, slot.itemIndex);
@@ -151,11 +155,72 @@ void SendCharStats(Session &session) {
   pkt.rmcSkillId = session.rmcSkillId; // New: Populate rmcSkillId
 
   session.Send(&pkt, sizeof(pkt));
+
+  // A full packet covers everything pending for the delta flush
+  auto &sent = session.statsSent;
+  sent.valid = true;
+  sent.hp = pkt.life;
+  sent.maxHp = pkt.maxLife;
+  sent.mana = pkt.mana;
+  sent.maxMana = pkt.maxMana;
+  sent.ag = pkt.ag;
+  sent.maxAg = pkt.maxAg;
+  sent.experience = session.experience;
+  session.statsDirty = 0;
+}
+
+void FlushStatsDelta(Session &session) {
+  if (!session.statsDirty)
+    return;
+  auto &sent = session.statsSent;
+  if (!sent.valid) {
+    SendCharStats(session);
+    return;
+  }
+
+  uint8_t buf[sizeof(PMSG_CHARSTATS_DELTA_HEAD) + 6 * sizeof(uint16_t) +
+              sizeof(uint64_t)];
+  size_t len = sizeof(PMSG_CHARSTATS_DELTA_HEAD);
+  uint16_t fields = 0;
+  auto put16 = [&](uint16_t bit, int value, int &sentValue) {
+    uint16_t v = static_cast<uint16_t>(value);
+    if (!(session.statsDirty & bit) || v == static_cast<uint16_t>(sentValue))
+      return;
+    memcpy(buf + len, &v, sizeof(v));
+    len += sizeof(v);
+    fields |= bit;
+    sentValue = v;
+  };
+  // Bit order = wire order
+  put16(STATS_HP, session.hp, sent.hp);
+  put16(STATS_MAX_HP, session.maxHp, sent.maxHp);
+  put16(STATS_MANA, session.mana, sent.mana);
+  put16(STATS_MAX_MANA, session.maxMana, sent.maxMana);
+  put16(STATS_AG, session.ag, sent.ag);
+  put16(STATS_MAX_AG, session.maxAg, sent.maxAg);
+  if ((session.statsDirty & STATS_XP) && session.experience != sent.experience) {
+    memcpy(buf + len, &session.experience, sizeof(uint64_t));
+    len += sizeof(uint64_t);
+    fields |= STATS_XP;
+    sent.experience = session.experience;
+  }
+  session.statsDirty = 0;
+  if (!fields)
+    return; // Changes cancelled out within the tick
+
+  PMSG_CHARSTATS_DELTA_HEAD head{};
+  head.h = MakeC1Header(static_cast<uint8_t>(len), Opcode::CHARSTATS_DELTA);
+  head.fields = fields;
+  memcpy(buf, &head, sizeof(head));
+  session.Send(buf, len);
 }
 
 void SendEquipment(Session &session, Database &db, int characterId) {
-  auto equip = db.GetCharacterEquipment(characterId);
+  SendEquipment(session, db, db.GetCharacterEquipment(characterId));
+}
 
+void SendEquipment(Session &session, Database &db,
+                   const std::vector<EquipmentSlot> &equip) {
   // Match PMSG_EQUIPMENT_SLOT: slot(1) + cat(1) + idx(1) + lvl(1) + qty(1) + model(32) = 37
   size_t entrySize = sizeof(PMSG_EQUIPMENT_SLOT);
   size_t totalSize = 5 + equip.size() * entrySize;
@@ -219,7 +284,11 @@ static int GetDefenseLevelBonus(int category, int itemLevel) {
 }
 
 void RefreshCombatStats(Session &session, Database &db, int characterId) {
-  auto equip = db.GetCharacterEquipment(characterId);
+  RefreshCombatStats(session, db, db.GetCharacterEquipment(characterId));
+}
+
+void RefreshCombatStats(Session &session, Database &db,
+                        const std::vector<EquipmentSlot> &equip) {
   session.weaponDamageMin = 0;
   session.weaponDamageMax = 0;
   session.totalDefense = 0;
@@ -322,7 +391,7 @@ void RefreshCombatStats(Session &session, Database &db, int characterId) {
 }
 
 void HandleCharSave(Session &session, const std::vector<uint8_t> &packet,
-                    Database &db) {
+                    Database &db, const GameWorld &world) {
   if (packet.size() < sizeof(PMSG_CHARSAVE_RECV))
     return;
   const auto *save =
@@ -336,6 +405,11 @@ void HandleCharSave(Session &session, const std::vector<uint8_t> &packet,
   memcpy(session.potionBar, save->potionBar, 8);
   session.rmcSkillId = save->rmcSkillId; // New: Save rmcSkillId to session
 
+  // Respawn in town: the server moves the player, not a position report
+  bool respawning = session.dead && save->life > 0;
+  if (respawning)
+    WorldHandler::MoveToTownSpot(session, world, /*respawn=*/true);
+
   uint8_t posX = static_cast<uint8_t>(session.worldZ / 100.0f);
   uint8_t posY = static_cast<uint8_t>(session.worldX / 100.0f);
   db.SaveCharacterFull(
@@ -349,7 +423,7 @@ void HandleCharSave(Session &session, const std::vector<uint8_t> &packet,
       session.zen, posX, posY, session.mapId, session.skillBar,
       session.potionBar, save->rmcSkillId, -1, &session);
 
-  if (session.dead && save->life > 0) {
+  if (respawning) {
     // Respawn: enforce full HP and AG/mana server-side
     session.dead = false;
     session.hp = session.maxHp;
@@ -379,6 +453,9 @@ void HandleEquip(Session &session, const std::vector<uint8_t> &packet,
   if (charId <= 0)
     charId = 1;
 
+  // Equip may touch several equipment + inventory rows; commit them together
+  Database::Transaction tx(db);
+
   // Authoritative requirement check (if not un-equipping)
   if (eq->category != 0xFF) {
     auto itemDef = db.GetItemDefinition(eq->category, eq->itemIndex);
@@ -796,6 +873,7 @@ void HandleEquip(Session &session, const std::vector<uint8_t> &packet,
   }
 
   RefreshCombatStats(session, db, charId);
+  tx.Commit();
 
   printf("[Character] Equipment change fd=%d: char=%d slot=%d cat=%d idx=%d "
          "+%d (weapon=%d-%d def=%d)\n",
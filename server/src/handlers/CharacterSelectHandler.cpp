@@ -13,7 +13,9 @@
 namespace CharacterSelectHandler {
 
 void SendCharList(Session &session, Database &db) {
+  // Two queries however many characters: the rows, then all their equipment
   auto chars = db.GetCharacterList(session.accountId);
+  auto accountEquip = db.GetAccountEquipment(session.accountId);
 
   size_t totalSize =
       sizeof(PMSG_CHARLIST_HEAD) + chars.size() * sizeof(PMSG_CHARLIST_ENTRY);
@@ -49,8 +51,7 @@ void SendCharList(Session &session, Database &db) {
     // Layout: [1..2]=rightHand, [3..4]=leftHand, [5..6]=helm,
     //         [7..8]=armor, [9..10]=pants, [11..12]=gloves, [13..14]=boots
     // charSet[15..16] = slot 8 (pet/mount): category, itemIndex
-    auto equip = db.GetCharacterEquipment(chars[i].id);
-    for (auto &eq : equip) {
+    for (auto &eq : accountEquip[chars[i].id]) {
       int offset = -1;
       int lvlIdx = -1;
       switch (eq.slot) {
@@ -132,6 +133,7 @@ void HandleCharCreate(Session &session, const std::vector<uint8_t> &packet,
     return;
   }
 
+  Database::Transaction tx(db); // Character row + starter skills/equipment
   int charId = db.CreateCharacter(session.accountId, name, classCode);
   if (charId < 0) {
     result.result = 0;
@@ -159,6 +161,11 @@ void HandleCharCreate(Session &session, const std::vector<uint8_t> &packet,
     db.UpdateEquipment(charId, 1, 4, 15, 0, 255); // Left hand: 255 Arrows
     printf("[CharSelect] ELF '%s' equipped Short Bow + 255 Arrows\n", name);
   }
+  if (!tx.Commit()) {
+    result.result = 0;
+    session.Send(&result, sizeof(result));
+    return;
+  }
 
   // Find the slot that was assigned
   auto chars = db.GetCharacterList(session.accountId);
@@ -217,6 +224,105 @@ void HandleCharDelete(Session &session, const std::vector<uint8_t> &packet,
   SendCharList(session, db);
 }
 
+void ApplyStoredCharacter(Session &session, Database &db,
+                          const Database::CharacterLoad &load) {
+  const CharacterData &c = load.character;
+
+  // Clear old equipment cache to prevent bleed-through
+  for (int i = 0; i < Session::NUM_EQUIP_SLOTS; i++) {
+    session.equipment[i] = {};
+    session.equipment[i].category = 0xFF;
+  }
+
+  session.characterId = c.id;
+  session.characterName = c.name;
+  session.charClass = c.charClass;
+  session.classCode = c.charClass;
+
+  // Cache stats
+  session.cameraZoom = c.cameraZoom;
+  session.strength = c.strength;
+  session.dexterity = c.dexterity;
+  session.vitality = c.vitality;
+  session.energy = c.energy;
+  session.level = c.level;
+  session.levelUpPoints = c.levelUpPoints;
+  session.experience = c.experience;
+
+  CharacterClass charCls = static_cast<CharacterClass>(session.classCode);
+  session.maxHp =
+      StatCalculator::CalculateMaxHP(charCls, session.level, session.vitality);
+  session.hp = std::min(static_cast<int>(c.life), session.maxHp);
+  // Prevent loading with 0 HP (dead state from previous session)
+  if (session.hp <= 0)
+    session.hp = session.maxHp;
+  session.maxMana = StatCalculator::CalculateMaxManaOrAG(
+      charCls, session.level, session.strength, session.dexterity,
+      session.vitality, session.energy);
+  session.mana = std::min(static_cast<int>(c.mana), session.maxMana);
+  if (session.mana <= 0)
+    session.mana = session.maxMana;
+
+  if (charCls == CharacterClass::CLASS_DK) {
+    session.maxAg = StatCalculator::CalculateMaxAG(c.strength, c.dexterity,
+                                                    c.vitality, c.energy);
+  } else {
+    session.maxAg = StatCalculator::CalculateMaxManaOrAG(
+        charCls, session.level, session.strength, session.dexterity,
+        session.vitality, session.energy);
+  }
+  session.ag = std::min(static_cast<int>(c.ag), session.maxAg);
+  memcpy(session.skillBar, c.skillBar, 10);
+  memcpy(session.potionBar, c.potionBar, 8);
+  session.rmcSkillId = c.rmcSkillId;
+
+  // Load equipment into session cache
+  for (auto &e : load.equipment) {
+    if (e.slot < Session::NUM_EQUIP_SLOTS) {
+      session.equipment[e.slot].category = e.category;
+      session.equipment[e.slot].itemIndex = e.itemIndex;
+      session.equipment[e.slot].itemLevel = e.itemLevel;
+    }
+  }
+
+  CharacterHandler::RefreshCombatStats(session, db, load.equipment);
+
+  // Load inventory
+  session.zen = c.money;
+  InventoryHandler::LoadInventory(session, db, c.id, load.inventory);
+
+  // Learned skills
+  session.learnedSkills = load.skills;
+
+
+  // Quest progress (per-quest tracking)
+  session.activeQuests.clear();
+  session.activeQuests.reserve(load.quests.size());
+  session.completedQuestMask = 0;
+  for (auto &qp : load.quests) {
+    if (qp.completed) {
+      session.completedQuestMask |= (1ULL << qp.questId);
+    } else {
+      Session::ActiveQuest aq;
+      aq.questId = qp.questId;
+      aq.killCount[0] = qp.kc[0];
+      aq.killCount[1] = qp.kc[1];
+      aq.killCount[2] = qp.kc[2];
+      session.activeQuests.push_back(aq);
+    }
+  }
+
+  // Elf buff auras
+  for (int b = 0; b < 2; b++) {
+    uint8_t btype = (b == 0) ? c.buffDefType : c.buffDmgType;
+    float brem = (b == 0) ? c.buffDefRemaining : c.buffDmgRemaining;
+    int bval = (b == 0) ? c.buffDefValue : c.buffDmgValue;
+    session.buffs[b] = {};
+    if (btype > 0 && brem > 0.0f)
+      session.buffs[b] = {btype, brem, bval, true};
+  }
+}
+
 void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
                       Database &db, GameWorld &world, Server &server) {
   if (packet.size() < sizeof(PMSG_CHARSELECT_RECV))
@@ -228,11 +334,13 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
   std::memcpy(name, sel->name, 10);
   printf("[CharSelect] Select: '%s' from fd=%d\n", name, session.GetFd());
 
-  CharacterData c = db.GetCharacter(name);
-  if (c.id == 0) {
+  // Character row, equipment, bag, skills and quests in one pass
+  Database::CharacterLoad load;
+  if (!db.LoadCharacter(name, load)) {
     printf("[CharSelect] Character '%s' not found\n", name);
     return;
   }
+  const CharacterData &c = load.character;
 
   // Verify character belongs to this account
   if (c.accountId != session.accountId) {
@@ -258,16 +366,13 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
            session.characterId, c.id);
   }
 
-  // Clear old equipment cache to prevent bleed-through
-  for (int i = 0; i < Session::NUM_EQUIP_SLOTS; i++) {
-    session.equipment[i] = {};
-    session.equipment[i].category = 0xFF;
+  // Gateway backend: the character's map may live in another process
+  if (!server.HostsMap(c.mapId)) {
+    server.MigrateCharSelect(session, c.mapId, packet);
+    return;
   }
 
-  session.characterId = c.id;
-  session.characterName = c.name;
-  session.charClass = c.charClass;
-  session.classCode = c.charClass;
+  ApplyStoredCharacter(session, db, load);
 
   // Send character info
   PMSG_CHARINFO_SEND info{};
@@ -305,75 +410,22 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
   session.Send(&info, sizeof(info));
   session.inWorld = true;
 
-  // Cache stats
-  session.cameraZoom = c.cameraZoom;
-  session.strength = c.strength;
-  session.dexterity = c.dexterity;
-  session.vitality = c.vitality;
-  session.energy = c.energy;
-  session.level = c.level;
-  session.levelUpPoints = c.levelUpPoints;
-  session.experience = c.experience;
   session.worldX = c.posY * 100.0f;
   session.worldZ = c.posX * 100.0f;
+  session.StopMoving();
   session.mapId = c.mapId;
   session.wasInSafeZone = world.IsSafeZoneGrid(c.posX, c.posY);
-
-  CharacterClass charCls = static_cast<CharacterClass>(session.classCode);
-  session.maxHp =
-      StatCalculator::CalculateMaxHP(charCls, session.level, session.vitality);
-  session.hp = std::min(static_cast<int>(c.life), session.maxHp);
-  // Prevent loading with 0 HP (dead state from previous session)
-  if (session.hp <= 0)
-    session.hp = session.maxHp;
-  session.maxMana = StatCalculator::CalculateMaxManaOrAG(
-      charCls, session.level, session.strength, session.dexterity,
-      session.vitality, session.energy);
-  session.mana = std::min(static_cast<int>(c.mana), session.maxMana);
-  if (session.mana <= 0)
-    session.mana = session.maxMana;
-
-  if (charCls == CharacterClass::CLASS_DK) {
-    session.maxAg = StatCalculator::CalculateMaxAG(c.strength, c.dexterity,
-                                                    c.vitality, c.energy);
-  } else {
-    session.maxAg = StatCalculator::CalculateMaxManaOrAG(
-        charCls, session.level, session.strength, session.dexterity,
-        session.vitality, session.energy);
-  }
-  session.ag = std::min(static_cast<int>(c.ag), session.maxAg);
   session.dead = false;
-  memcpy(session.skillBar, c.skillBar, 10);
-  memcpy(session.potionBar, c.potionBar, 8);
-  session.rmcSkillId = c.rmcSkillId;
 
-  // Load equipment into session cache
-  {
-    auto equip = db.GetCharacterEquipment(c.id);
-    for (auto &e : equip) {
-      if (e.slot < Session::NUM_EQUIP_SLOTS) {
-        session.equipment[e.slot].category = e.category;
-        session.equipment[e.slot].itemIndex = e.itemIndex;
-        session.equipment[e.slot].itemLevel = e.itemLevel;
-      }
-    }
+  // Always reload world data for the character's current map (a gateway
+  // backend's world is always its own map)
+  if (!server.IsBackend()) {
+    world.ClearWorldData();
+    world.SetActiveMap(c.mapId);
+    world.LoadNpcsFromDB(db, c.mapId);
+    world.LoadMonstersFromDB(db, c.mapId);
   }
 
-  CharacterHandler::RefreshCombatStats(session, db, c.id);
-
-  // Load inventory from DB
-  session.zen = c.money;
-  InventoryHandler::LoadInventory(session, db, c.id);
-
-  // Load learned skills from DB
-  session.learnedSkills = db.GetCharacterSkills(c.id);
-
-  // Always reload world data for the character's current map
-  world.ClearWorldData();
-  world.SetActiveMap(c.mapId);
-  world.LoadNpcsFromDB(db, c.mapId);
-  world.LoadMonstersFromDB(db, c.mapId);
-
   // Notify client of non-default map (client starts in Lorencia by default)
   if (c.mapId != 0) {
     PMSG_MAP_CHANGE_SEND mapPkt{};
@@ -396,9 +448,9 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
   InventoryHandler::SendInventorySync(session);
   // IMPORTANT: Send CharStats BEFORE Equipment so the client knows the class
   // before body parts are equipped (LoadStats class-change resets body parts)
-  CharacterHandler::SendCharStats(session, db, session.characterId);
+  CharacterHandler::SendCharStats(session, db, c, load.equipment);
   CharacterHandler::SendSkillList(session);
-  CharacterHandler::SendEquipment(session, db, c.id);
+  CharacterHandler::SendEquipment(session, db, load.equipment);
 
   // Send existing ground drops
   for (auto &drop : world.GetDrops()) {
@@ -415,7 +467,7 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
 
   // Send chat log history
   {
-    auto history = db.GetChatHistory(c.id, 200);
+    const auto history = db.GetChatHistory(c.id); // Cached after first login
     if (!history.empty()) {
       // Build C2 variable-length packet:
       // C2 header (4 bytes) + count(uint16_t) + entries
@@ -447,26 +499,9 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
     }
   }
 
-  // Load quest progress (per-quest tracking) and send to client
-  {
-    auto allProgress = db.LoadAllQuestProgress(c.id);
-    session.activeQuests.clear();
-    session.completedQuestMask = 0;
-    for (auto &qp : allProgress) {
-      if (qp.completed) {
-        session.completedQuestMask |= (1ULL << qp.questId);
-      } else {
-        Session::ActiveQuest aq;
-        aq.questId = qp.questId;
-        aq.killCount[0] = qp.kc[0];
-        aq.killCount[1] = qp.kc[1];
-        aq.killCount[2] = qp.kc[2];
-        session.activeQuests.push_back(aq);
-      }
-    }
-    QuestHandler::SendQuestCatalog(session);
-    QuestHandler::SendQuestState(session);
-  }
+  // Quest progress was loaded by ApplyStoredCharacter
+  QuestHandler::SendQuestCatalog(session);
+  QuestHandler::SendQuestState(session);
 
   // Restore summon if character had an active one saved
   session.activeSummonType = c.summonType;
@@ -539,13 +574,12 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
     }
   }
 
-  // Restore elf buff auras from DB
+  // Show the elf buff auras restored by ApplyStoredCharacter
   for (int b = 0; b < 2; b++) {
-    uint8_t btype = (b == 0) ? c.buffDefType : c.buffDmgType;
-    float brem = (b == 0) ? c.buffDefRemaining : c.buffDmgRemaining;
-    int bval = (b == 0) ? c.buffDefValue : c.buffDmgValue;
-    if (btype > 0 && brem > 0.0f) {
-      session.buffs[b] = {btype, brem, bval, true};
+    uint8_t btype = session.buffs[b].type;
+    float brem = session.buffs[b].remaining;
+    int bval = session.buffs[b].value;
+    if (session.buffs[b].active) {
       PMSG_BUFF_EFFECT_SEND bpkt{};
       bpkt.h = MakeC1Header(sizeof(bpkt), Opcode::BUFF_EFFECT);
       bpkt.buffType = btype;
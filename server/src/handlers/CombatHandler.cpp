@@ -5,7 +5,6 @@
 #include "Server.hpp"
 #include "StatCalculator.hpp"
 #include "handlers/CharacterHandler.hpp"
-#include "handlers/QuestHandler.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
@@ -14,6 +13,19 @@
 
 namespace CombatHandler {
 
+// Capacity of the stack buffers passed to GameWorld::QueryCircle/QueryCapsule.
+// AoE hits beyond this many monsters in one cast are dropped and logged
+// (LogDroppedHits); pack assist just recruits the first ones found.
+static constexpr size_t MAX_QUERY_RESULTS = 128;
+
+static void LogDroppedHits(const Session &session, uint8_t skillId,
+                           size_t dropped) {
+  if (dropped > 0)
+    printf("[Combat] fd=%d skill %d: %zu AoE hits over the %zu-monster cap "
+           "dropped\n",
+           session.GetFd(), skillId, dropped, MAX_QUERY_RESULTS);
+}
+
 // Skill definitions for all classes
 // resourceCost: AG for DK, Mana for DW/ELF/MG
 // aoeRange: world units (0 = single target, 200 = 2 grid cells, etc.)
@@ -205,9 +217,17 @@ static void ApplyDamageToMonster(Session &session, MonsterInstance *mon,
       mon->moveTimer = mon->moveDelay;
     }
 
-    // Pack assist (same-type monsters within 3 cells join aggro)
+    // Pack assist (same-type monsters within 3 cells join aggro). Query a
+    // circle around the 7x7-cell box (plus one cell for monsters mid-step);
+    // the Chebyshev check below is authoritative. Capped at
+    // MAX_QUERY_RESULTS: in a bigger crowd only the first ones found join.
     if (mon->aggressive) {
-      for (auto &ally : world.GetMonsterInstancesMut()) {
+      MonsterInstance *nearby[MAX_QUERY_RESULTS];
+      size_t nearbyCount = world.QueryCircle(mon->worldX, mon->worldZ,
+                                             4.0f * 100.0f * 1.4143f, nearby,
+                                             MAX_QUERY_RESULTS);
+      for (size_t n = 0; n < nearbyCount; n++) {
+        auto &ally = *nearby[n];
         if (ally.index == mon->index)
           continue;
         if (ally.isSummon())
@@ -253,86 +273,8 @@ static void ApplyDamageToMonster(Session &session, MonsterInstance *mon,
       if (session.attackTargetMonsterIdx == mon->index)
         session.attackTargetMonsterIdx = 0;
 
-      int xp = ServerConfig::CalculateXP(session.level, mon->level);
-
-      PMSG_MONSTER_DEATH_SEND deathPkt{};
-      deathPkt.h = MakeC1Header(sizeof(deathPkt), Opcode::MON_DEATH);
-      deathPkt.monsterIndex = mon->index;
-      deathPkt.killerCharId = static_cast<uint16_t>(session.characterId);
-      deathPkt.xpReward = static_cast<uint32_t>(xp);
-      server.Broadcast(&deathPkt, sizeof(deathPkt));
-
-      session.experience += xp;
-      bool leveledUp = false;
-      while (true) {
-        uint64_t nextXP = Database::GetXPForLevel(session.level);
-        if (session.experience >= nextXP && session.level < 400) {
-          session.level++;
-
-          CharacterClass charCls2 =
-              static_cast<CharacterClass>(session.classCode);
-          session.levelUpPoints += StatCalculator::GetLevelUpPoints(charCls2);
-
-          session.maxHp = StatCalculator::CalculateMaxHP(
-              charCls2, session.level, session.vitality) +
-              session.petBonusMaxHp;
-          session.maxMana = StatCalculator::CalculateMaxMP(
-              charCls2, session.level, session.energy);
-          session.maxAg = StatCalculator::CalculateMaxAG(
-              session.strength, session.dexterity, session.vitality,
-              session.energy);
-
-          session.hp = session.maxHp;
-          session.mana = session.maxMana;
-          session.ag = session.maxAg;
-          leveledUp = true;
-          printf("[Combat] Char %d leveled up to %d! Total XP: %llu\n",
-                 session.characterId, (int)session.level,
-                 (unsigned long long)session.experience);
-        } else {
-          break;
-        }
-      }
-
-      // Save XP/level messages to chat log
-      if (xp > 0) {
-        char xpBuf[64];
-        snprintf(xpBuf, sizeof(xpBuf), "+%d Experience", xp);
-        // purple: IM_COL32(180, 120, 255, 255) = 0xFFFF78B4
-        server.GetDB().SaveChatMessage(session.characterId, 1, 0xFFFF78B4, xpBuf);
-      }
-      if (leveledUp) {
-        char lvlBuf[64];
-        snprintf(lvlBuf, sizeof(lvlBuf), "Congratulations! Level %d reached!",
-                 (int)session.level);
-        // yellow: IM_COL32(255, 255, 100, 255) = 0xFF64FFFF
-        server.GetDB().SaveChatMessage(session.characterId, 2, 0xFF64FFFF, lvlBuf);
-        // Rescale active summon to match new owner level
-        if (session.activeSummonIndex > 0)
-          world.RescaleSummon(session.activeSummonIndex, session.level);
-      }
-
-      if (leveledUp || xp > 0) {
-        CharacterHandler::SendCharStats(session);
-      }
-
-      auto drops = world.SpawnDrops(mon->worldX, mon->worldZ, mon->level,
-                                    mon->type, server.GetDB());
-      for (auto &drop : drops) {
-        PMSG_DROP_SPAWN_SEND dropPkt{};
-        dropPkt.h = MakeC1Header(sizeof(dropPkt), Opcode::DROP_SPAWN);
-        dropPkt.dropIndex = drop.index;
-        dropPkt.defIndex = drop.defIndex;
-        dropPkt.quantity = drop.quantity;
-        dropPkt.itemLevel = drop.itemLevel;
-        dropPkt.worldX = drop.worldX;
-        dropPkt.worldZ = drop.worldZ;
-        server.Broadcast(&dropPkt, sizeof(dropPkt));
-      }
-
-      // Quest kill tracking
-      QuestHandler::OnMonsterKill(session, mon->type, mon->isSummon(), server.GetDB());
-
+      // XP, level-ups, drops and quest credit are resolved once per tick
+      server.QueueKill(session, *mon);
     }
   }
 
@@ -416,7 +358,7 @@ void HandleAttack(Session &session, const std::vector<uint8_t> &packet,
   if (session.classCode == 16 && session.ag < session.maxAg) {
     int agGain = std::max(1, session.maxAg / 50); // 2% of maxAG
     session.ag = std::min(session.ag + agGain, session.maxAg);
-    CharacterHandler::SendCharStats(session);
+    CharacterHandler::MarkStatsDirty(session, STATS_AG);
   }
 }
 
@@ -478,7 +420,7 @@ void HandleSkillAttack(Session &session, const std::vector<uint8_t> &packet,
 
   // Teleport (skill 6) — no damage, just utility
   if (skillDef->skillId == 6) {
-    CharacterHandler::SendCharStats(session);
+    CharacterHandler::MarkStatsDirty(session, STATS_MANA | STATS_AG);
     return;
   }
 
@@ -587,7 +529,7 @@ void HandleSkillAttack(Session &session, const std::vector<uint8_t> &packet,
       server.Broadcast(&spawnPkt, sizeof(spawnPkt));
     }
 
-    CharacterHandler::SendCharStats(session);
+    CharacterHandler::MarkStatsDirty(session, STATS_MANA | STATS_AG);
     session.attackCooldown = 1.0f; // Summon cast GCD
     return;
   }
@@ -630,7 +572,7 @@ void HandleSkillAttack(Session &session, const std::vector<uint8_t> &packet,
       pkt.duration = 1800.0f;
       session.Send(&pkt, sizeof(pkt));
     }
-    CharacterHandler::SendCharStats(session);
+    CharacterHandler::MarkStatsDirty(session, STATS_HP | STATS_MANA | STATS_AG);
     session.attackCooldown = 1.0f;
     return;
   }
@@ -643,7 +585,6 @@ void HandleSkillAttack(Session &session, const std::vector<uint8_t> &packet,
     float px = session.worldX, pz = session.worldZ;
     float tx = (atk->targetX != 0) ? atk->targetX : px;
     float tz = (atk->targetZ != 0) ? atk->targetZ : pz;
-    float r2 = skillDef->aoeRange * skillDef->aoeRange;
     int aoeHits = 0;
 
     // Evil Spirit / Hellfire are caster-centered AoE (radiate from caster, not click)
@@ -669,42 +610,36 @@ void HandleSkillAttack(Session &session, const std::vector<uint8_t> &packet,
       }
     }
 
-    for (auto &other : world.GetMonsterInstancesMut()) {
+    // Line skills: monsters near the segment caster → target.
+    // Other AoE skills: circle at the target position.
+    // At most MAX_QUERY_RESULTS monsters are hit; the rest are logged.
+    MonsterInstance *hits[MAX_QUERY_RESULTS];
+    size_t dropped = 0;
+    size_t hitCount =
+        (isLinePath && lenSq > 0.01f)
+            ? world.QueryCapsule(px, pz, tx, tz, skillDef->aoeRange, hits,
+                                 MAX_QUERY_RESULTS, &dropped)
+            : world.QueryCircle(tx, tz, skillDef->aoeRange, hits,
+                                MAX_QUERY_RESULTS, &dropped);
+    LogDroppedHits(session, skillDef->skillId, dropped);
+    for (size_t h = 0; h < hitCount; h++) {
+      auto &other = *hits[h];
       if (other.aiState == MonsterInstance::AIState::DYING ||
           other.aiState == MonsterInstance::AIState::DEAD)
         continue;
 
-      bool inRange = false;
-      if (isLinePath && lenSq > 0.01f) {
-        // Distance from monster to line segment (caster → target)
-        float mx = other.worldX - px, mz = other.worldZ - pz;
-        float t = (mx * ldx + mz * ldz) / lenSq;
-        if (t < 0.0f) t = 0.0f;
-        if (t > 1.0f) t = 1.0f;
-        float nx = px + ldx * t - other.worldX;
-        float nz = pz + ldz * t - other.worldZ;
-        inRange = (nx * nx + nz * nz <= r2);
-      } else {
-        // Circle check at target position (other AoE skills)
-        float dx = other.worldX - tx;
-        float dz = other.worldZ - tz;
-        inRange = (dx * dx + dz * dz <= r2);
-      }
-
-      if (inRange) {
+      ApplyDamageToMonster(session, &other, skillDef->damageBonus, world,
+                           server, skillDef->isMagic);
+      // Twisting Slash (skill 41): double hit (spin start + spin end)
+      if (skillDef->skillId == 41 && other.hp > 0) {
         ApplyDamageToMonster(session, &other, skillDef->damageBonus, world,
                              server, skillDef->isMagic);
-        // Twisting Slash (skill 41): double hit (spin start + spin end)
-        if (skillDef->skillId == 41 && other.hp > 0) {
-          ApplyDamageToMonster(session, &other, skillDef->damageBonus, world,
-                               server, skillDef->isMagic);
-        }
-        if ((skillDef->skillId == 8 || skillDef->skillId == 9) && other.hp > 0)
-          other.stormTime = 10;
-        aoeHits++;
       }
+      if ((skillDef->skillId == 8 || skillDef->skillId == 9) && other.hp > 0)
+        other.stormTime = 10;
+      aoeHits++;
     }
-    CharacterHandler::SendCharStats(session);
+    CharacterHandler::MarkStatsDirty(session, STATS_MANA | STATS_AG);
     return;
   }
 
@@ -751,29 +686,31 @@ void HandleSkillAttack(Session &session, const std::vector<uint8_t> &packet,
   // AoE: hit all nearby monsters within skill range (OpenMU: AreaSkillAutomaticHits)
   int aoeHits = 0;
   if (skillDef->aoeRange > 0) {
-    float cx = mon->worldX, cz = mon->worldZ;
-    float r2 = skillDef->aoeRange * skillDef->aoeRange;
-    for (auto &other : world.GetMonsterInstancesMut()) {
+    // At most MAX_QUERY_RESULTS monsters are hit; the rest are logged
+    MonsterInstance *hits[MAX_QUERY_RESULTS];
+    size_t dropped = 0;
+    size_t hitCount = world.QueryCircle(mon->worldX, mon->worldZ,
+                                        skillDef->aoeRange, hits,
+                                        MAX_QUERY_RESULTS, &dropped);
+    LogDroppedHits(session, skillDef->skillId, dropped);
+    for (size_t h = 0; h < hitCount; h++) {
+      auto &other = *hits[h];
       if (other.index == mon->index)
         continue;
       if (other.aiState == MonsterInstance::AIState::DYING ||
           other.aiState == MonsterInstance::AIState::DEAD)
         continue;
-      float dx = other.worldX - cx;
-      float dz = other.worldZ - cz;
-      if (dx * dx + dz * dz <= r2) {
-        ApplyDamageToMonster(session, &other, skillDef->damageBonus, world,
-                             server, skillDef->isMagic);
-        // Main 5.2: Twister/Evil Spirit stuns AoE targets too (only if alive)
-        if ((skillDef->skillId == 8 || skillDef->skillId == 9) && other.hp > 0)
-          other.stormTime = 10;
-        aoeHits++;
-      }
+      ApplyDamageToMonster(session, &other, skillDef->damageBonus, world,
+                           server, skillDef->isMagic);
+      // Main 5.2: Twister/Evil Spirit stuns AoE targets too (only if alive)
+      if ((skillDef->skillId == 8 || skillDef->skillId == 9) && other.hp > 0)
+        other.stormTime = 10;
+      aoeHits++;
     }
   }
 
   // Send updated stats (so client sees AG decrease)
-  CharacterHandler::SendCharStats(session);
+  CharacterHandler::MarkStatsDirty(session, STATS_MANA | STATS_AG);
 
   // Server-side GCD: minimum time between skill casts
   session.attackCooldown = 0.3f; // 0.3s minimum between skill attacks
@@ -836,6 +773,7 @@ void HandleTeleport(Session &session, const std::vector<uint8_t> &packet,
   // Update session position (grid -> world coords)
   session.worldX = (float)gy * 100.0f;
   session.worldZ = (float)gx * 100.0f;
+  session.StopMoving();
 
   // Move summon to near teleport destination and broadcast new position
   if (session.activeSummonIndex > 0) {
@@ -854,6 +792,7 @@ void HandleTeleport(Session &session, const std::vector<uint8_t> &packet,
               summon->gridY = (uint8_t)ny;
               summon->worldX = summon->gridY * 100.0f;
               summon->worldZ = summon->gridX * 100.0f;
+              world.InvalidateSpatialIndex();
               summon->currentPath.clear();
               summon->pathStep = 0;
               summon->moveTimer = 0.0f;
@@ -878,7 +817,7 @@ void HandleTeleport(Session &session, const std::vector<uint8_t> &packet,
   }
 
   // Send updated stats (mana deducted)
-  CharacterHandler::SendCharStats(session);
+  CharacterHandler::MarkStatsDirty(session, STATS_MANA | STATS_AG);
 }
 
 } // namespace CombatHandler
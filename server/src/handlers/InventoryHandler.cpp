@@ -43,11 +43,15 @@ void SendInventorySync(Session &session) {
 }
 
 void LoadInventory(Session &session, Database &db, int characterId) {
+  LoadInventory(session, db, characterId, db.GetCharacterInventory(characterId));
+}
+
+void LoadInventory(Session &session, Database &db, int characterId,
+                   const std::vector<Database::InventorySlotData> &invItems) {
   // Clear bag before loading to avoid stale data
   for (int i = 0; i < 64; i++) {
     session.bag[i] = {};
   }
-  auto invItems = db.GetCharacterInventory(characterId);
   printf("[Inventory] Loading %zu inventory items from DB for char %d\n",
          invItems.size(), characterId);
   for (auto &item : invItems) {
@@ -152,8 +156,10 @@ void HandleInventoryMove(Session &session, const std::vector<uint8_t> &packet,
           }
         }
       }
+      Database::Transaction tx(db);
       db.DeleteCharacterInventoryItem(session.characterId, from);
       db.SaveCharacterInventory(session.characterId, defIdx, qty, lvl, to);
+      tx.Commit();
       printf("[Inventory] Server-side move def=%d from %d to %d\n", defIdx,
              from, to);
     } else {
@@ -341,6 +347,7 @@ void HandleItemUse(Session &session, const std::vector<uint8_t> &packet,
     return;
   }
 
+  Database::Transaction tx(db); // Skill learn / consume / character save
   auto &item = session.bag[req->slot];
   if (!item.occupied || !item.primary) {
     printf("[Inventory] Rejecting item use fd=%d: Slot %d empty or secondary\n",
@@ -423,6 +430,8 @@ void HandleItemUse(Session &session, const std::vector<uint8_t> &packet,
         db.DeleteCharacterInventoryItem(session.characterId, req->slot);
       }
 
+      tx.Commit();
+
       // Send updated skill list and inventory
       CharacterHandler::SendSkillList(session);
       SendInventorySync(session);
@@ -503,6 +512,8 @@ void HandleItemUse(Session &session, const std::vector<uint8_t> &packet,
         db.DeleteCharacterInventoryItem(session.characterId, req->slot);
       }
 
+      tx.Commit();
+
       // Send updated skill list and inventory
       CharacterHandler::SendSkillList(session);
       SendInventorySync(session);
@@ -622,6 +633,7 @@ void HandleItemUse(Session &session, const std::vector<uint8_t> &packet,
           session.experience, session.zen, posX, posY, session.mapId,
           session.skillBar, session.potionBar, session.rmcSkillId, -1, &session);
     }
+    tx.Commit();
   }
 }
 
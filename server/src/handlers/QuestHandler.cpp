@@ -712,6 +712,9 @@ void HandleQuestComplete(Session &session, const std::vector<uint8_t> &packet,
   session.zen += q.zenReward;
   session.experience += q.xpReward;
 
+  // Rewards, progress, zen and chat log commit as one transaction
+  Database::Transaction tx(db);
+
   // Give class-specific rewards only
   int classIdx = session.classCode / 16; // DW=0, DK=1, ELF=2, MG=3
   if (classIdx >= 0 && classIdx < 4) {
@@ -727,6 +730,7 @@ void HandleQuestComplete(Session &session, const std::vector<uint8_t> &packet,
 
   db.SaveQuestProgress(session.characterId, questId, 0, 0, 0, true);
   db.UpdateCharacterMoney(session.characterId, session.zen);
+  tx.Commit();
 
   // Send reward notification
   PMSG_QUEST_REWARD_SEND reward{};
@@ -792,8 +796,8 @@ void HandleQuestAbandon(Session &session, const std::vector<uint8_t> &packet,
 // Monster kill — check all active quests
 // ═══════════════════════════════════════════════════════
 
-void OnMonsterKill(Session &session, uint16_t monsterType, bool isSummon, Database &db) {
-  if (isSummon) return; // Killing a summon doesn't count for quests
+bool OnMonsterKill(Session &session, uint16_t monsterType, bool isSummon) {
+  if (isSummon) return false; // Killing a summon doesn't count for quests
   for (auto &aq : session.activeQuests) {
     if (aq.questId < 0 || aq.questId >= QUEST_COUNT)
       continue;
@@ -805,13 +809,11 @@ void OnMonsterKill(Session &session, uint16_t monsterType, bool isSummon, Databa
         printf("[Quest] fd=%d quest %d target %d: kill %d/%d (monType=%d)\n",
                session.GetFd(), aq.questId, i, aq.killCount[i],
                q.targets[i].killsRequired, monsterType);
-        db.SaveQuestProgress(session.characterId, aq.questId,
-                             aq.killCount[0], aq.killCount[1], aq.killCount[2], false);
-        SendQuestState(session);
-        return; // Only count once per kill
+        return true; // Only count once per kill
       }
     }
   }
+  return false;
 }
 
 } // namespace QuestHandler
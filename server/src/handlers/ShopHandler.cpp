@@ -238,6 +238,7 @@ void HandleShopBuy(Session &session, const std::vector<uint8_t> &packet,
 
   printf("[Shop] Buying item defIdx=%d (qty=%u, price=%u)\n", recv->defIndex,
          buyStack, price);
+  Database::Transaction tx(db); // Zen + inventory row
 
   // Stackable items: try merge into existing stack first
   if (isStackable) {
@@ -254,6 +255,7 @@ void HandleShopBuy(Session &session, const std::vector<uint8_t> &packet,
         db.SaveCharacterInventory(
             session.characterId, recv->defIndex, session.bag[i].quantity,
             session.bag[i].itemLevel, static_cast<uint8_t>(i));
+        tx.Commit();
         res.result = 1;
         res.quantity = session.bag[i].quantity;
         session.Send(&res, sizeof(res));
@@ -321,6 +323,7 @@ void HandleShopBuy(Session &session, const std::vector<uint8_t> &packet,
 
   db.SaveCharacterInventory(session.characterId, recv->defIndex,
                             session.bag[slot].quantity, recv->itemLevel, slot);
+  tx.Commit();
 
   res.result = 1;
   session.Send(&res, sizeof(res));
@@ -363,6 +366,7 @@ void HandleShopSell(Session &session, const std::vector<uint8_t> &packet,
       sellPrice = 10; // Absolute minimum so all items are sellable
   }
 
+  Database::Transaction tx(db); // Zen + inventory row
   session.zen += sellPrice;
   db.UpdateCharacterMoney(session.characterId, session.zen);
 
@@ -376,6 +380,7 @@ void HandleShopSell(Session &session, const std::vector<uint8_t> &packet,
   }
 
   db.DeleteCharacterInventoryItem(session.characterId, recv->bagSlot);
+  tx.Commit();
 
   res.result = 1;
   res.zenGained = sellPrice;
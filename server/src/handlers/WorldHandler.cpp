@@ -1,11 +1,13 @@
 #include "handlers/WorldHandler.hpp"
 #include "GameWorld.hpp"
 #include "PacketDefs.hpp"
+#include "PathFinder.hpp"
 #include "StatCalculator.hpp"
 #include "handlers/CharacterHandler.hpp"
 #include "handlers/InventoryHandler.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
 
@@ -37,16 +39,13 @@ void SendMonsterViewport(Session &session, const GameWorld &world) {
          world.GetMonsterInstances().size(), session.GetFd());
 }
 
-void HandleMove(Session &session, const std::vector<uint8_t> &packet,
-                Database &db) {
+void HandleMove(Session &session, const std::vector<uint8_t> &packet) {
   if (packet.size() < sizeof(PMSG_MOVE_RECV))
     return;
-  const auto *move = reinterpret_cast<const PMSG_MOVE_RECV *>(packet.data());
 
-  // Don't update worldX/worldZ here — D7 PrecisePosition is the authoritative
-  // source for player position. D4 only provides grid-quantized coordinates and
-  // updating from it causes the server to briefly use a stale/wrong position
-  // (race with D7), breaking monster AI distance checks and safe zone validation.
+  // Legacy grid move (pre-MOVE_PATH clients). Don't update worldX/worldZ here:
+  // D4 only provides grid-quantized coordinates. Position is persisted by
+  // SaveSession, not per packet.
 
   // Player started walking — reset idle regen timer
   session.idleTimer = 0.0f;
@@ -54,12 +53,112 @@ void HandleMove(Session &session, const std::vector<uint8_t> &packet,
 
   // Cancel summon attack target — summon should follow instead of fighting
   session.attackTargetMonsterIdx = 0;
+}
+
+void HandleMovePath(Session &session, const std::vector<uint8_t> &packet,
+                    const GameWorld &world) {
+  static constexpr size_t HEAD_SIZE = offsetof(PMSG_MOVE_PATH_RECV, path);
+  if (packet.size() < HEAD_SIZE)
+    return;
+  const auto *move =
+      reinterpret_cast<const PMSG_MOVE_PATH_RECV *>(packet.data());
+  int count = std::min<int>(move->count, Session::MAX_MOVE_PATH);
+  if (packet.size() < HEAD_SIZE + static_cast<size_t>(count) * 2)
+    return;
+
+  session.StopMoving();
+  if (count == 0 || session.dead)
+    return;
+
+  // Always walk from where the server thinks we are; the client's start cell
+  // only tells us how far apart the two views are
+  GridPoint cur{static_cast<uint8_t>(session.worldZ / 100.0f),
+                static_cast<uint8_t>(session.worldX / 100.0f)};
+  GridPoint dest{move->path[count - 1][0], move->path[count - 1][1]};
+  bool useClientRoute =
+      count > 1 &&
+      PathFinder::ChebyshevDist(cur, {move->startX, move->startY}) <= 1;
+  for (int i = 0; useClientRoute && i < count; i++) {
+    GridPoint prev = i == 0 ? cur : GridPoint{move->path[i - 1][0],
+                                              move->path[i - 1][1]};
+    GridPoint next{move->path[i][0], move->path[i][1]};
+    useClientRoute = PathFinder::ChebyshevDist(prev, next) <= 1 &&
+                     world.IsWalkableGrid(next.x, next.y);
+  }
 
-  if (session.characterId > 0) {
-    db.UpdatePosition(session.characterId, move->x, move->y);
+  if (useClientRoute) {
+    for (int i = 0; i < count; i++) {
+      session.movePathX[i] = move->path[i][0];
+      session.movePathY[i] = move->path[i][1];
+    }
+    session.movePathLen = static_cast<uint8_t>(count);
+  } else {
+    auto path = world.FindPlayerPath(cur, dest, Session::MAX_MOVE_PATH);
+    for (size_t i = 0; i < path.size(); i++) {
+      session.movePathX[i] = path[i].x;
+      session.movePathY[i] = path[i].y;
+    }
+    session.movePathLen = static_cast<uint8_t>(path.size());
+  }
+
+  if (session.IsMoving()) {
+    session.idleTimer = 0.0f;
+    session.idleHpRemainder = 0.0f;
+    // Cancel summon attack target — summon should follow instead of fighting
+    session.attackTargetMonsterIdx = 0;
   }
 }
 
+void HandleTownReturn(Session &session, const GameWorld &world) {
+  // Cross-map returns (Dungeon -> Lorencia) go through WARP_COMMAND
+  if (session.dead || !MoveToTownSpot(session, world, /*respawn=*/false))
+    return;
+  printf("[Move] fd=%d returned to town (%d,%d)\n", session.GetFd(),
+         (int)(session.worldZ / 100.0f), (int)(session.worldX / 100.0f));
+}
+
+bool MoveToTownSpot(Session &session, const GameWorld &world, bool respawn) {
+  GridPoint spot;
+  if (!world.FindTownSpot(session.mapId, respawn, spot))
+    return false;
+  // Cell corner, exactly where the client puts the hero
+  session.worldX = spot.y * 100.0f;
+  session.worldZ = spot.x * 100.0f;
+  session.StopMoving();
+  return true;
+}
+
+void UpdateMovement(Session &session, float dt) {
+  session.correctionAllowance =
+      std::min(session.correctionAllowance +
+                   ServerConfig::POSITION_CORRECTION_RATE * dt,
+               ServerConfig::POSITION_CORRECTION_MAX);
+  if (!session.IsMoving())
+    return;
+
+  // Walk cell centres at the server's speed (gridX -> worldZ, gridY -> worldX)
+  float budget = ServerConfig::PLAYER_MOVE_SPEED * dt;
+  while (budget > 0.0f && session.IsMoving()) {
+    float tx = (session.movePathY[session.movePathStep] + 0.5f) * 100.0f;
+    float tz = (session.movePathX[session.movePathStep] + 0.5f) * 100.0f;
+    float dx = tx - session.worldX;
+    float dz = tz - session.worldZ;
+    float dist = std::sqrt(dx * dx + dz * dz);
+    if (dist <= budget) {
+      session.worldX = tx;
+      session.worldZ = tz;
+      budget -= dist;
+      session.movePathStep++;
+    } else {
+      session.worldX += dx / dist * budget;
+      session.worldZ += dz / dist * budget;
+      budget = 0.0f;
+    }
+  }
+  session.idleTimer = 0.0f;
+  session.idleHpRemainder = 0.0f;
+}
+
 void HandlePrecisePosition(Session &session,
                            const std::vector<uint8_t> &packet,
                            GameWorld &world) {
@@ -67,15 +166,32 @@ void HandlePrecisePosition(Session &session,
     return;
   const auto *pos =
       reinterpret_cast<const PMSG_PRECISE_POS_RECV *>(packet.data());
-  // Reset idle timer if position actually changed
-  if (std::abs(session.worldX - pos->worldX) > 1.0f ||
-      std::abs(session.worldZ - pos->worldZ) > 1.0f) {
+  // Correction of the simulated position. The server owns movement speed:
+  // a report can only pull the position as far as the correction allowance
+  // (refilled at a fraction of walk speed) permits.
+  float dx = pos->worldX - session.worldX;
+  float dz = pos->worldZ - session.worldZ;
+  float dist = std::sqrt(dx * dx + dz * dz);
+  if (dist > 1.0f) {
     session.idleTimer = 0.0f;
     session.idleHpRemainder = 0.0f;
   }
-  session.worldX = pos->worldX;
-  session.worldZ = pos->worldZ;
-  // PrecisePos logging suppressed (fires ~20/s, causes log spam)
+  if (session.worldX == 0.0f && session.worldZ == 0.0f) {
+    // No position yet (fresh session): accept as-is
+    session.worldX = pos->worldX;
+    session.worldZ = pos->worldZ;
+  } else if (dist <= session.correctionAllowance) {
+    session.worldX = pos->worldX;
+    session.worldZ = pos->worldZ;
+    session.correctionAllowance -= dist;
+  } else if (dist > 0.0f) {
+    float step = session.correctionAllowance / dist;
+    session.worldX += dx * step;
+    session.worldZ += dz * step;
+    session.correctionAllowance = 0.0f;
+    printf("[Move] fd=%d position report %.0f units off, clamped\n",
+           session.GetFd(), dist);
+  }
 
   // If client just loaded a new map (pending viewport), send NPCs/monsters now.
   // Guard: only trigger if at least 0.5s has passed since TransitionMap
@@ -247,6 +363,7 @@ void HandleCharSelect(Session &session, const std::vector<uint8_t> &packet,
   session.experience = c.experience;
   session.worldX = c.posY * 100.0f;
   session.worldZ = c.posX * 100.0f;
+  session.StopMoving();
   session.wasInSafeZone = world.IsSafeZoneGrid(c.posX, c.posY);
 
   CharacterClass charCls = static_cast<CharacterClass>(session.classCode);
@@ -1,18 +1,84 @@
+#include "Bench.hpp"
 #include "Server.hpp"
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char *argv[]) {
     setbuf(stdout, nullptr); // Disable buffering for log visibility
     printf("=== MU Online Server (Lorencia) ===\n");
     printf("0.97d compatible — minimal implementation\n\n");
 
+    // Usage: MuServer [port] [--db-profile=fast|safe] [--io-threads=N]
+    //                 [--kick-backlog=N] [--handoff=PATH]
+    //                 [--map=N [--db-owner]]  (gateway backend, see Gateway.hpp;
+    //                                          needs MU_GATEWAY_SECRET)
+    //                 [--bench-saves[=N]] [--bench-monsters[=N]]
+    //                 [--bench-logins[=N]]
     uint16_t port = 44405;
-    if (argc > 1) {
-        port = static_cast<uint16_t>(std::atoi(argv[1]));
+    DatabaseTuning dbTuning = DatabaseTuning::Fast();
+    int ioThreads = Server::DEFAULT_IO_THREADS;
+    int kickBacklog = RateLimit::DEFAULT_KICK_BACKLOG;
+    std::string handoffPath;
+    int hostedMap = -1;
+    bool dbOwner = false;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--db-profile=safe") == 0) {
+            dbTuning = DatabaseTuning::Safe();
+        } else if (strcmp(arg, "--db-profile=fast") == 0) {
+            dbTuning = DatabaseTuning::Fast();
+        } else if (strncmp(arg, "--io-threads=", 13) == 0) {
+            ioThreads = std::atoi(arg + 13);
+            if (ioThreads < 1) {
+                printf("Invalid I/O thread count: %s\n", arg + 13);
+                return 1;
+            }
+        } else if (strncmp(arg, "--kick-backlog=", 15) == 0) {
+            kickBacklog = std::atoi(arg + 15);
+            if (kickBacklog < 1) {
+                printf("Invalid kick backlog: %s\n", arg + 15);
+                return 1;
+            }
+        } else if (strncmp(arg, "--handoff=", 10) == 0) {
+            handoffPath = arg + 10;
+        } else if (strncmp(arg, "--map=", 6) == 0) {
+            hostedMap = std::atoi(arg + 6);
+            if (hostedMap < 0 || hostedMap > 255) {
+                printf("Invalid map id: %s\n", arg + 6);
+                return 1;
+            }
+        } else if (strcmp(arg, "--db-owner") == 0) {
+            dbOwner = true;
+        } else if (strncmp(arg, "--bench-saves", 13) == 0) {
+            int count = arg[13] == '=' ? std::atoi(arg + 14) : 500;
+            return Bench::RunSaveBenchmark(count > 0 ? count : 500);
+        } else if (strncmp(arg, "--bench-logins", 14) == 0) {
+            int count = arg[14] == '=' ? std::atoi(arg + 15) : 200;
+            return Bench::RunLoginBenchmark(count > 0 ? count : 200);
+        } else if (strncmp(arg, "--bench-monsters", 16) == 0) {
+            int count = arg[16] == '=' ? std::atoi(arg + 17) : 10000;
+            return Bench::RunMonsterBenchmark(count > 0 ? count : 10000);
+        } else if (arg[0] != '-') {
+            port = static_cast<uint16_t>(std::atoi(arg));
+        } else {
+            printf("Unknown option: %s\n", arg);
+            return 1;
+        }
     }
 
     Server server;
-    if (!server.Start(port)) {
+    server.SetKickBacklog(kickBacklog);
+    if (hostedMap >= 0) {
+        server.SetHostedMap(hostedMap);
+        server.SetPersistenceOwner(dbOwner);
+        const char *secret = std::getenv("MU_GATEWAY_SECRET");
+        if (secret && !server.SetGatewaySecret(secret)) {
+            printf("MU_GATEWAY_SECRET must be 16-32 bytes\n");
+            return 1;
+        }
+    }
+    if (!server.Start(port, dbTuning, ioThreads, handoffPath)) {
         printf("Failed to start server\n");
         return 1;
     }